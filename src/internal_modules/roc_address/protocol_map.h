@@ -69,7 +69,7 @@ public:
 private:
     friend class core::Singleton<ProtocolMap>;
 
-    enum { MaxProtos = 8 };
+    enum { MaxProtos = 10 };
 
     ProtocolMap();
 
@@ -128,6 +128,15 @@ bool SocketAddr::multicast() const {
     }
 }
 
+bool SocketAddr::broadcast() const {
+    switch (saddr_family_()) {
+    case AF_INET:
+        return core::ntoh32u(saddr_.addr4.sin_addr.s_addr) == INADDR_BROADCAST;
+    default:
+        return false;
+    }
+}
+
 bool SocketAddr::get_host(char* buf, size_t bufsz) const {
     switch (saddr_family_()) {
     case AF_INET:
@@ -186,6 +195,37 @@ bool SocketAddr::operator!=(const SocketAddr& other) const {
     return !(*this == other);
 }
 
+core::hashsum_t SocketAddr::hash() const {
+    // hash only fields compared by operator==
+    uint8_t buf[sizeof(sa_family_t) + sizeof(in_port_t) + sizeof(in6_addr)];
+    size_t size = 0;
+
+    const sa_family_t family = saddr_family_();
+    memcpy(buf + size, &family, sizeof(family));
+    size += sizeof(family);
+
+    switch (family) {
+    case AF_INET:
+        memcpy(buf + size, &saddr_.addr4.sin_port, sizeof(saddr_.addr4.sin_port));
+        size += sizeof(saddr_.addr4.sin_port);
+        memcpy(buf + size, &saddr_.addr4.sin_addr, sizeof(saddr_.addr4.sin_addr));
+        size += sizeof(saddr_.addr4.sin_addr);
+        break;
+
+    case AF_INET6:
+        memcpy(buf + size, &saddr_.addr6.sin6_port, sizeof(saddr_.addr6.sin6_port));
+        size += sizeof(saddr_.addr6.sin6_port);
+        memcpy(buf + size, &saddr_.addr6.sin6_addr, sizeof(saddr_.addr6.sin6_addr));
+        size += sizeof(saddr_.addr6.sin6_addr);
+        break;
+
+    default:
+        break;
+    }
+
+    return core::hashsum_mem(buf, size);
+}
+
 socklen_t SocketAddr::saddr_size_(sa_family_t family) {
     switch (family) {
     case AF_INET:
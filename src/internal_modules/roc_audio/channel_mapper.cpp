@@ -8,17 +8,97 @@
 
 #include "roc_audio/channel_mapper.h"
 #include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
 
 namespace roc {
 namespace audio {
 
+namespace {
+
+// Speaker positions of lower bits of channel mask.
+enum ChannelPosition {
+    Chan_FL = 0,
+    Chan_FR = 1,
+    Chan_FC = 2,
+    Chan_LFE = 3,
+    Chan_BL = 4,
+    Chan_BR = 5,
+    Chan_SL = 6,
+    Chan_SR = 7,
+    Chan_Max = 8
+};
+
+// -3dB
+const sample_t FoldGain = 0.70710678f;
+
+// Absent left or right source for upmix.
+const size_t NoChan = (size_t)-1;
+
+bool has_chan(packet::channel_mask_t mask, size_t ch) {
+    return ((mask >> ch) & 1) != 0;
+}
+
+size_t first_chan(packet::channel_mask_t mask) {
+    size_t ch = 0;
+    while (!has_chan(mask, ch)) {
+        ch++;
+    }
+    return ch;
+}
+
+// Fold channel to the first of two other channels present in mask.
+void fold_chan(sample_t* gains_col,
+               packet::channel_mask_t out_mask,
+               size_t first_ch,
+               sample_t first_gain,
+               size_t second_ch,
+               sample_t second_gain) {
+    if (has_chan(out_mask, first_ch)) {
+        gains_col[first_ch] += first_gain;
+    } else if (has_chan(out_mask, second_ch)) {
+        gains_col[second_ch] += second_gain;
+    }
+}
+
+void add_gain(sample_t* gains_row, size_t in_ch, sample_t gain) {
+    if (in_ch != NoChan) {
+        gains_row[in_ch] += gain;
+    }
+}
+
+// Derive surround channel from its pair (back from side, or side from back),
+// if it's present in input, or otherwise from front channel of same side.
+void upmix_surround(sample_t* gains_row,
+                    packet::channel_mask_t in_mask,
+                    size_t pair_ch,
+                    size_t front_ch) {
+    if (has_chan(in_mask, pair_ch)) {
+        gains_row[pair_ch] += 1;
+    } else {
+        add_gain(gains_row, front_ch, FoldGain);
+    }
+}
+
+} // namespace
+
 ChannelMapper::ChannelMapper(packet::channel_mask_t in_chans,
                              packet::channel_mask_t out_chans)
     : in_chan_mask_(in_chans)
     , out_chan_mask_(out_chans)
     , in_chan_count_(packet::num_channels(in_chans))
     , out_chan_count_(packet::num_channels(out_chans))
-    , inout_chan_mask_(in_chans | out_chans) {
+    , map_func_(NULL) {
+    if (in_chan_count_ == 0 || out_chan_count_ == 0) {
+        roc_panic("channel mapper: empty channel mask");
+    }
+
+    // gains[out_ch][in_ch], indexed by channel bit
+    sample_t gains[MaxChannels][MaxChannels];
+    memset(gains, 0, sizeof(gains));
+
+    build_(gains);
+    compile_(gains);
+    select_func_();
 }
 
 void ChannelMapper::map(const Frame& in_frame, Frame& out_frame) {
@@ -37,24 +117,290 @@ void ChannelMapper::map(const Frame& in_frame, Frame& out_frame) {
 
     const size_t n_samples = in_frame.num_samples() / in_chan_count_;
 
-    const sample_t* in_samples = in_frame.samples();
-    sample_t* out_samples = out_frame.samples();
+    (this->*map_func_)(in_frame.samples(), out_frame.samples(), n_samples);
+}
+
+void ChannelMapper::build_(sample_t gains[MaxChannels][MaxChannels]) const {
+    if (in_chan_count_ == 1) {
+        // mono input
+        const size_t in_ch = first_chan(in_chan_mask_);
 
-    for (size_t ns = 0; ns < n_samples; ns++) {
-        for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask_ && ch != 0; ch <<= 1) {
-            if (in_chan_mask_ & ch) {
-                if (out_chan_mask_ & ch) {
-                    *out_samples++ = *in_samples;
+        if (out_chan_count_ == 1) {
+            gains[first_chan(out_chan_mask_)][in_ch] = 1;
+        } else if (has_chan(out_chan_mask_, Chan_FL)
+                   && has_chan(out_chan_mask_, Chan_FR)) {
+            gains[Chan_FL][in_ch] = 1;
+            gains[Chan_FR][in_ch] = 1;
+        } else if (has_chan(out_chan_mask_, Chan_FC)) {
+            gains[Chan_FC][in_ch] = 1;
+        } else if (has_chan(out_chan_mask_, in_ch)) {
+            gains[in_ch][in_ch] = 1;
+        }
+
+        if (out_chan_count_ > 1) {
+            // mono is both left and right source for derived channels
+            upmix_(gains, in_ch, in_ch);
+        }
+    } else if (out_chan_count_ == 1) {
+        // mono output
+        const size_t out_ch = first_chan(out_chan_mask_);
+
+        for (size_t in_ch = 0; in_ch < MaxChannels; in_ch++) {
+            if (!has_chan(in_chan_mask_, in_ch)) {
+                continue;
+            }
+            if (in_ch == Chan_LFE) {
+                continue;
+            }
+            if (in_ch >= Chan_Max) {
+                if (in_ch == out_ch) {
+                    gains[out_ch][in_ch] = 1;
+                }
+                continue;
+            }
+            gains[out_ch][in_ch] = in_ch >= Chan_BL ? FoldGain : 1;
+        }
+    } else {
+        sample_t col[MaxChannels];
+
+        for (size_t in_ch = 0; in_ch < MaxChannels; in_ch++) {
+            if (!has_chan(in_chan_mask_, in_ch)) {
+                continue;
+            }
+
+            if (has_chan(out_chan_mask_, in_ch)) {
+                gains[in_ch][in_ch] = 1;
+                continue;
+            }
+
+            memset(col, 0, sizeof(col));
+
+            switch (in_ch) {
+            case Chan_FL:
+            case Chan_FR:
+                if (has_chan(out_chan_mask_, Chan_FC)) {
+                    col[Chan_FC] = FoldGain;
                 }
-                in_samples++;
-            } else {
-                if (out_chan_mask_ & ch) {
-                    *out_samples++ = 0;
+                break;
+
+            case Chan_FC:
+                if (has_chan(out_chan_mask_, Chan_FL)
+                    && has_chan(out_chan_mask_, Chan_FR)) {
+                    col[Chan_FL] = FoldGain;
+                    col[Chan_FR] = FoldGain;
                 }
+                break;
+
+            case Chan_BL:
+                fold_chan(col, out_chan_mask_, Chan_SL, 1, Chan_FL, FoldGain);
+                break;
+
+            case Chan_BR:
+                fold_chan(col, out_chan_mask_, Chan_SR, 1, Chan_FR, FoldGain);
+                break;
+
+            case Chan_SL:
+                fold_chan(col, out_chan_mask_, Chan_BL, 1, Chan_FL, FoldGain);
+                break;
+
+            case Chan_SR:
+                fold_chan(col, out_chan_mask_, Chan_BR, 1, Chan_FR, FoldGain);
+                break;
+
+            default:
+                // LFE and channels without position are dropped
+                break;
+            }
+
+            for (size_t out_ch = 0; out_ch < Chan_Max; out_ch++) {
+                gains[out_ch][in_ch] += col[out_ch];
+            }
+        }
+
+        upmix_(gains, has_chan(in_chan_mask_, Chan_FL) ? (size_t)Chan_FL : NoChan,
+               has_chan(in_chan_mask_, Chan_FR) ? (size_t)Chan_FR : NoChan);
+    }
+
+    // Scale every output channel separately to avoid clipping, so that
+    // channels which don't mix anything keep unity gain.
+    for (size_t out_ch = 0; out_ch < MaxChannels; out_ch++) {
+        sample_t sum = 0;
+        for (size_t in_ch = 0; in_ch < MaxChannels; in_ch++) {
+            sum += gains[out_ch][in_ch];
+        }
+
+        if (sum > 1) {
+            for (size_t in_ch = 0; in_ch < MaxChannels; in_ch++) {
+                gains[out_ch][in_ch] /= sum;
             }
         }
     }
 }
 
+void ChannelMapper::upmix_(sample_t gains[MaxChannels][MaxChannels],
+                           size_t left_ch,
+                           size_t right_ch) const {
+    for (size_t out_ch = 0; out_ch < Chan_Max; out_ch++) {
+        if (!has_chan(out_chan_mask_, out_ch) || has_chan(in_chan_mask_, out_ch)) {
+            continue;
+        }
+
+        // channel already gets signal from downmix
+        bool has_gain = false;
+        for (size_t in_ch = 0; in_ch < MaxChannels; in_ch++) {
+            if (gains[out_ch][in_ch] > 0) {
+                has_gain = true;
+            }
+        }
+        if (has_gain) {
+            continue;
+        }
+
+        switch (out_ch) {
+        case Chan_FC:
+            add_gain(gains[out_ch], left_ch, FoldGain);
+            add_gain(gains[out_ch], right_ch, FoldGain);
+            break;
+
+        case Chan_BL:
+            upmix_surround(gains[out_ch], in_chan_mask_, Chan_SL, left_ch);
+            break;
+
+        case Chan_BR:
+            upmix_surround(gains[out_ch], in_chan_mask_, Chan_SR, right_ch);
+            break;
+
+        case Chan_SL:
+            upmix_surround(gains[out_ch], in_chan_mask_, Chan_BL, left_ch);
+            break;
+
+        case Chan_SR:
+            upmix_surround(gains[out_ch], in_chan_mask_, Chan_BR, right_ch);
+            break;
+
+        default:
+            // front left and right come from mono or downmix;
+            // LFE would need a low-pass filter, so it stays silent
+            break;
+        }
+    }
+}
+
+void ChannelMapper::compile_(sample_t gains[MaxChannels][MaxChannels]) {
+    const bool use_matrix =
+        in_chan_count_ <= MaxMatrixChannels && out_chan_count_ <= MaxMatrixChannels;
+
+    memset(matrix_, 0, sizeof(matrix_));
+
+    size_t n_entries = 0;
+    size_t out_index = 0;
+
+    for (size_t out_ch = 0; out_ch < MaxChannels; out_ch++) {
+        if (!has_chan(out_chan_mask_, out_ch)) {
+            continue;
+        }
+
+        out_entries_[out_index] = n_entries;
+
+        size_t in_index = 0;
+
+        for (size_t in_ch = 0; in_ch < MaxChannels; in_ch++) {
+            if (!has_chan(in_chan_mask_, in_ch)) {
+                continue;
+            }
+
+            const sample_t gain = gains[out_ch][in_ch];
+
+            if (gain > 0) {
+                roc_panic_if_msg(n_entries == MaxEntries,
+                                 "channel mapper: too many table entries");
+
+                entries_[n_entries].in_index = in_index;
+                entries_[n_entries].gain = gain;
+                n_entries++;
+
+                if (use_matrix) {
+                    matrix_[out_index * in_chan_count_ + in_index] = gain;
+                }
+            }
+
+            in_index++;
+        }
+
+        out_index++;
+    }
+
+    out_entries_[out_index] = n_entries;
+}
+
+void ChannelMapper::select_func_() {
+    if (in_chan_mask_ == out_chan_mask_) {
+        map_func_ = &ChannelMapper::map_copy_;
+    } else if (in_chan_count_ == 1 && out_chan_count_ == 2) {
+        map_func_ = &ChannelMapper::map_matrix_<1, 2>;
+    } else if (in_chan_count_ == 2 && out_chan_count_ == 1) {
+        map_func_ = &ChannelMapper::map_matrix_<2, 1>;
+    } else if (in_chan_count_ == 2 && out_chan_count_ == 6) {
+        map_func_ = &ChannelMapper::map_matrix_<2, 6>;
+    } else if (in_chan_count_ == 6 && out_chan_count_ == 2) {
+        map_func_ = &ChannelMapper::map_matrix_<6, 2>;
+    } else if (in_chan_count_ == 2 && out_chan_count_ == 8) {
+        map_func_ = &ChannelMapper::map_matrix_<2, 8>;
+    } else if (in_chan_count_ == 8 && out_chan_count_ == 2) {
+        map_func_ = &ChannelMapper::map_matrix_<8, 2>;
+    } else if (in_chan_count_ == 6 && out_chan_count_ == 8) {
+        map_func_ = &ChannelMapper::map_matrix_<6, 8>;
+    } else if (in_chan_count_ == 8 && out_chan_count_ == 6) {
+        map_func_ = &ChannelMapper::map_matrix_<8, 6>;
+    } else {
+        map_func_ = &ChannelMapper::map_table_;
+    }
+}
+
+void ChannelMapper::map_copy_(const sample_t* in_samples,
+                              sample_t* out_samples,
+                              size_t n_samples) {
+    memcpy(out_samples, in_samples, n_samples * in_chan_count_ * sizeof(sample_t));
+}
+
+template <size_t InCh, size_t OutCh>
+void ChannelMapper::map_matrix_(const sample_t* in_samples,
+                                sample_t* out_samples,
+                                size_t n_samples) {
+    // local copy lets compiler keep gains in registers
+    sample_t matrix[OutCh * InCh];
+    memcpy(matrix, matrix_, sizeof(matrix));
+
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        for (size_t oc = 0; oc < OutCh; oc++) {
+            sample_t acc = 0;
+            for (size_t ic = 0; ic < InCh; ic++) {
+                acc += in_samples[ic] * matrix[oc * InCh + ic];
+            }
+            out_samples[oc] = acc;
+        }
+
+        in_samples += InCh;
+        out_samples += OutCh;
+    }
+}
+
+void ChannelMapper::map_table_(const sample_t* in_samples,
+                               sample_t* out_samples,
+                               size_t n_samples) {
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        for (size_t oc = 0; oc < out_chan_count_; oc++) {
+            sample_t acc = 0;
+            for (size_t ne = out_entries_[oc]; ne < out_entries_[oc + 1]; ne++) {
+                acc += in_samples[entries_[ne].in_index] * entries_[ne].gain;
+            }
+            out_samples[oc] = acc;
+        }
+
+        in_samples += in_chan_count_;
+        out_samples += out_chan_count_;
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -13,6 +13,7 @@
 #define ROC_AUDIO_CHANNEL_MAPPER_H_
 
 #include "roc_audio/frame.h"
+#include "roc_audio/sample.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/noncopyable.h"
 #include "roc_packet/units.h"
@@ -22,6 +23,27 @@ namespace audio {
 
 //! Channel mapper.
 //! Converts between frames with specified channel masks.
+//!
+//! Lower bits of channel mask are treated as speaker positions, in order:
+//! front left, front right, front center, LFE, back left, back right,
+//! side left, side right. So 0x3 is stereo, 0x3F is 5.1, and 0xFF is 7.1.
+//! Mask with a single channel is treated as mono. Higher bits have no
+//! position and are only passed through or dropped.
+//!
+//! Channels present in both masks are copied. Mono is duplicated to front
+//! left and right (or front center if there are no front left and right).
+//! When downmixing, channels missing in output are folded into nearby
+//! channels with -3dB gain, and LFE is dropped. When upmixing, output
+//! channels missing in input are derived from front left and right (or
+//! mono): center gets both with -3dB gain, back and side channels get
+//! their pair if present, or front channel of the same side with -3dB
+//! gain. LFE and channels without position are not derived and are
+//! filled with zeros. Every output channel is scaled separately so that
+//! its total gain doesn't exceed one.
+//!
+//! The mixing matrix is computed once in constructor. Common layouts are
+//! handled by kernels specialized for channel counts, other layouts use
+//! sparse table of input indices and gains per output channel.
 class ChannelMapper : public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -31,13 +53,52 @@ public:
     void map(const Frame& in_frame, Frame& out_frame);
 
 private:
+    enum {
+        MaxChannels = sizeof(packet::channel_mask_t) * 8,
+        // every input channel goes to at most two output channels
+        MaxEntries = MaxChannels * 2,
+        // max number of channels for specialized kernels
+        MaxMatrixChannels = 8
+    };
+
+    struct Entry {
+        size_t in_index;
+        sample_t gain;
+    };
+
+    typedef void (ChannelMapper::*map_func_t)(const sample_t* in_samples,
+                                              sample_t* out_samples,
+                                              size_t n_samples);
+
+    void build_(sample_t gains[MaxChannels][MaxChannels]) const;
+    void upmix_(sample_t gains[MaxChannels][MaxChannels],
+                size_t left_ch,
+                size_t right_ch) const;
+    void compile_(sample_t gains[MaxChannels][MaxChannels]);
+    void select_func_();
+
+    void map_copy_(const sample_t* in_samples, sample_t* out_samples, size_t n_samples);
+
+    template <size_t InCh, size_t OutCh>
+    void
+    map_matrix_(const sample_t* in_samples, sample_t* out_samples, size_t n_samples);
+
+    void map_table_(const sample_t* in_samples, sample_t* out_samples, size_t n_samples);
+
     const packet::channel_mask_t in_chan_mask_;
     const packet::channel_mask_t out_chan_mask_;
 
     const size_t in_chan_count_;
     const size_t out_chan_count_;
 
-    const packet::channel_mask_t inout_chan_mask_;
+    // entries of n-th output channel are in [out_entries_[n]; out_entries_[n+1])
+    Entry entries_[MaxEntries];
+    size_t out_entries_[MaxChannels + 1];
+
+    // dense matrix for specialized kernels, out_chan_count_ x in_chan_count_
+    sample_t matrix_[MaxMatrixChannels * MaxMatrixChannels];
+
+    map_func_t map_func_;
 };
 
 } // namespace audio
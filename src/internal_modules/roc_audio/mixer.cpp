@@ -14,33 +14,52 @@
 namespace roc {
 namespace audio {
 
-namespace {
-
-sample_t clamp(const sample_t x) {
-    if (x > SampleMax) {
-        return SampleMax;
-    } else if (x < SampleMin) {
-        return SampleMin;
-    } else {
-        return x;
-    }
+Mixer::Mixer(core::BufferFactory<sample_t>& buffer_factory,
+             core::nanoseconds_t frame_length,
+             const audio::SampleSpec& sample_spec)
+    : buffer_factory_(buffer_factory)
+    , worker_pool_(NULL)
+    , parallel_read_size_(0)
+    , kernel_(NULL)
+    , num_active_(0)
+    , skip_blank_(true)
+    , valid_(false) {
+    init_(frame_length, sample_spec);
 }
 
-} // namespace
-
 Mixer::Mixer(core::BufferFactory<sample_t>& buffer_factory,
              core::nanoseconds_t frame_length,
-             const audio::SampleSpec& sample_spec)
-    : valid_(false) {
+             const audio::SampleSpec& sample_spec,
+             core::WorkerPool& worker_pool,
+             core::IAllocator& allocator)
+    : buffer_factory_(buffer_factory)
+    , worker_pool_(&worker_pool)
+    , inputs_(allocator)
+    , parallel_read_size_(0)
+    , kernel_(NULL)
+    , num_active_(0)
+    , skip_blank_(true)
+    , valid_(false) {
+    init_(frame_length, sample_spec);
+}
+
+void Mixer::init_(core::nanoseconds_t frame_length,
+                  const audio::SampleSpec& sample_spec) {
     size_t frame_size = sample_spec.ns_2_samples_overall(frame_length);
-    roc_log(LogDebug, "mixer: initializing: frame_size=%lu", (unsigned long)frame_size);
+
+    const MixerKernel kernel = mixer_kernel_select();
+    kernel_ = mixer_kernel_func(kernel);
+
+    roc_log(LogDebug, "mixer: initializing: frame_size=%lu kernel=%s num_threads=%lu",
+            (unsigned long)frame_size, mixer_kernel_to_str(kernel),
+            (unsigned long)(worker_pool_ ? worker_pool_->num_threads() + 1 : 1));
 
     if (frame_size == 0) {
         roc_log(LogError, "mixer: frame size cannot be 0");
         return;
     }
 
-    temp_buf_ = buffer_factory.new_buffer();
+    temp_buf_ = buffer_factory_.new_buffer();
     if (!temp_buf_) {
         roc_log(LogError, "mixer: can't allocate temporary buffer");
         return;
@@ -63,12 +82,32 @@ void Mixer::add_input(IFrameReader& reader) {
     roc_panic_if(!valid_);
 
     readers_.push_back(reader);
+
+    if (worker_pool_) {
+        add_parallel_input_(reader);
+    }
 }
 
 void Mixer::remove_input(IFrameReader& reader) {
     roc_panic_if(!valid_);
 
     readers_.remove(reader);
+
+    if (worker_pool_) {
+        remove_parallel_input_(reader);
+    }
+}
+
+void Mixer::set_skip_blank(bool enabled) {
+    roc_panic_if(!valid_);
+
+    skip_blank_ = enabled;
+}
+
+size_t Mixer::num_active_inputs() const {
+    roc_panic_if(!valid_);
+
+    return num_active_;
 }
 
 bool Mixer::read(Frame& frame) {
@@ -76,6 +115,7 @@ bool Mixer::read(Frame& frame) {
 
     if (readers_.size() == 1) {
         readers_.front()->read(frame);
+        num_active_ = is_active_(frame.flags()) ? 1 : 0;
         return true;
     }
 
@@ -85,6 +125,7 @@ bool Mixer::read(Frame& frame) {
     size_t n_samples = frame.num_samples();
 
     unsigned flags = 0;
+    size_t num_active = 0;
 
     while (n_samples != 0) {
         size_t n_read = n_samples;
@@ -92,36 +133,167 @@ bool Mixer::read(Frame& frame) {
             n_read = max_read;
         }
 
-        read_(samples, n_read, flags);
+        num_active = std::max(num_active, read_(samples, n_read, flags));
 
         samples += n_read;
         n_samples -= n_read;
     }
 
     frame.set_flags(flags);
+    num_active_ = num_active;
 
     return true;
 }
 
-void Mixer::read_(sample_t* data, size_t size, unsigned& flags) {
+bool Mixer::is_active_(unsigned flags) const {
+    return !skip_blank_ || (flags & Frame::FlagNonblank);
+}
+
+size_t Mixer::read_(sample_t* data, size_t size, unsigned& flags) {
     roc_panic_if(!data);
     roc_panic_if(size == 0);
 
-    memset(data, 0, size * sizeof(sample_t));
+    // If some input couldn't be added to array, keep reading sequentially.
+    if (worker_pool_ && inputs_.size() == readers_.size()) {
+        return read_parallel_(data, size, flags);
+    }
+
+    size_t num_active = 0;
 
     for (IFrameReader* rp = readers_.front(); rp; rp = readers_.nextof(*rp)) {
-        sample_t* temp_data = temp_buf_.data();
+        // Until we have a non-blank input, read directly into output.
+        sample_t* read_data = num_active == 0 ? data : temp_buf_.data();
+
+        Frame read_frame(read_data, size);
+        if (!rp->read(read_frame)) {
+            continue;
+        }
+
+        flags |= read_frame.flags();
+
+        // Blank frame is all zeros, nothing to add.
+        if (!is_active_(read_frame.flags())) {
+            continue;
+        }
+
+        if (num_active != 0) {
+            kernel_(data, read_data, size);
+        }
+
+        num_active++;
+    }
+
+    if (num_active == 0) {
+        memset(data, 0, size * sizeof(sample_t));
+    }
+
+    return num_active;
+}
+
+size_t Mixer::read_parallel_(sample_t* data, size_t size, unsigned& flags) {
+    // Read inputs having own buffers on worker threads.
+    parallel_read_size_ = size;
+    worker_pool_->run(*this, inputs_.size());
+
+    size_t num_active = 0;
+
+    for (size_t n = 0; n < inputs_.size(); n++) {
+        Input& input = inputs_[n];
+
+        sample_t* read_data = NULL;
+        unsigned read_flags = 0;
+
+        if (input.buf) {
+            if (!input.ok) {
+                continue;
+            }
+            read_data = input.buf.data();
+            read_flags = input.flags;
+        } else {
+            // Input without own buffer is read here, as in sequential mode.
+            read_data = num_active == 0 ? data : temp_buf_.data();
+
+            Frame read_frame(read_data, size);
+            if (!input.reader->read(read_frame)) {
+                continue;
+            }
+            read_flags = read_frame.flags();
+        }
+
+        flags |= read_flags;
+
+        if (!is_active_(read_flags)) {
+            continue;
+        }
+
+        if (num_active == 0) {
+            if (read_data != data) {
+                memcpy(data, read_data, size * sizeof(sample_t));
+            }
+        } else {
+            kernel_(data, read_data, size);
+        }
+
+        num_active++;
+    }
+
+    if (num_active == 0) {
+        memset(data, 0, size * sizeof(sample_t));
+    }
+
+    return num_active;
+}
 
-        Frame temp_frame(temp_data, size);
-        if (!rp->read(temp_frame)) {
+void Mixer::run_item(size_t index) {
+    Input& input = inputs_[index];
+
+    if (!input.buf) {
+        return;
+    }
+
+    Frame read_frame(input.buf.data(), parallel_read_size_);
+
+    input.ok = input.reader->read(read_frame);
+    input.flags = read_frame.flags();
+}
+
+void Mixer::add_parallel_input_(IFrameReader& reader) {
+    Input input;
+    input.reader = &reader;
+
+    input.buf = buffer_factory_.new_buffer();
+    if (!input.buf || input.buf.capacity() < temp_buf_.size()) {
+        roc_log(LogError,
+                "mixer: can't allocate input buffer, input will be read sequentially");
+        input.buf = core::Slice<sample_t>();
+    } else {
+        input.buf.reslice(0, temp_buf_.size());
+    }
+
+    if (!inputs_.grow_exp(inputs_.size() + 1)) {
+        roc_log(LogError, "mixer: can't allocate input, falling back to sequential mode");
+        return;
+    }
+
+    inputs_.push_back(input);
+}
+
+void Mixer::remove_parallel_input_(IFrameReader& reader) {
+    for (size_t n = 0; n < inputs_.size(); n++) {
+        if (inputs_[n].reader != &reader) {
             continue;
         }
 
-        for (size_t n = 0; n < size; n++) {
-            data[n] = clamp(data[n] + temp_data[n]);
+        // Keep order of remaining inputs.
+        for (size_t m = n + 1; m < inputs_.size(); m++) {
+            inputs_[m - 1] = inputs_[m];
+        }
+
+        if (!inputs_.resize(inputs_.size() - 1)) {
+            roc_panic("mixer: can't shrink array");
         }
 
-        flags |= temp_frame.flags();
+        return;
     }
 }
 
@@ -13,13 +13,18 @@
 #define ROC_AUDIO_MIXER_H_
 
 #include "roc_audio/iframe_reader.h"
+#include "roc_audio/mixer_kernel.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
 #include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/iworker_job.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
 #include "roc_core/time.h"
+#include "roc_core/worker_pool.h"
 #include "roc_packet/units.h"
 
 namespace roc {
@@ -28,6 +33,14 @@ namespace audio {
 //! Mixer.
 //! Mixes multiple input streams into one output stream.
 //!
+//! Samples are summed and clamped using the fastest mixer kernel supported
+//! by the CPU, which is selected when the mixer is constructed.
+//!
+//! Input frames without Frame::FlagNonblank are known to be zero and are
+//! not added (unless skipping blank inputs is disabled). The first non-blank
+//! input is read directly into the output frame, so if there is only one
+//! non-blank input, no copying is performed.
+//!
 //! For example, these two input streams:
 //! @code
 //!  1, 2, 3, ...
@@ -38,7 +51,12 @@ namespace audio {
 //! @code
 //!  5, 7, 9, ...
 //! @endcode
-class Mixer : public IFrameReader, public core::NonCopyable<> {
+//!
+//! Optionally, inputs may be read in parallel using a worker pool. In this
+//! mode, every input is read into its own buffer on worker threads, and then
+//! buffers are mixed on the calling thread in the order in which inputs were
+//! added, so the result is the same as when inputs are read sequentially.
+class Mixer : public IFrameReader, private core::IWorkerJob, public core::NonCopyable<> {
 public:
     //! Initialize.
     //!
@@ -51,6 +69,20 @@ public:
           core::nanoseconds_t frame_length,
           const audio::SampleSpec& sample_spec);
 
+    //! Initialize with parallel reading of inputs.
+    //!
+    //! @b Parameters
+    //!  - @p buffer_factory, @p frame_length, and @p sample_spec are the same
+    //!    as above; @p buffer_factory is also used to allocate a buffer for
+    //!    every input
+    //!  - @p worker_pool is used to read inputs in parallel
+    //!  - @p allocator is used to allocate array of inputs
+    Mixer(core::BufferFactory<sample_t>& buffer_factory,
+          core::nanoseconds_t frame_length,
+          const audio::SampleSpec& sample_spec,
+          core::WorkerPool& worker_pool,
+          core::IAllocator& allocator);
+
     //! Check if the mixer was succefully constructed.
     bool valid() const;
 
@@ -60,6 +92,20 @@ public:
     //! Remove input reader.
     void remove_input(IFrameReader&);
 
+    //! Enable or disable skipping of blank inputs.
+    //! @remarks
+    //!  Enabled by default. Should be disabled when blank frames may still
+    //!  contain non-zero samples, e.g. when depacketizer writes beeps instead
+    //!  of silence on packet loss.
+    void set_skip_blank(bool enabled);
+
+    //! Get number of inputs that contributed to last frame.
+    //! @remarks
+    //!  Returns number of inputs that were mixed during last read() call,
+    //!  i.e. inputs that returned non-blank samples, or all inputs if
+    //!  skipping of blank inputs is disabled.
+    size_t num_active_inputs() const;
+
     //! Read audio frame.
     //! @remarks
     //!  Reads samples from every input reader, mixes them, and fills @p frame
@@ -67,11 +113,45 @@ public:
     virtual bool read(Frame& frame);
 
 private:
-    void read_(sample_t* out_data, size_t out_sz, unsigned& flags);
+    struct Input {
+        IFrameReader* reader;
+        core::Slice<sample_t> buf;
+        unsigned flags;
+        bool ok;
+
+        Input()
+            : reader(NULL)
+            , flags(0)
+            , ok(false) {
+        }
+    };
+
+    void init_(core::nanoseconds_t frame_length, const audio::SampleSpec& sample_spec);
+
+    void add_parallel_input_(IFrameReader& reader);
+    void remove_parallel_input_(IFrameReader& reader);
+
+    bool is_active_(unsigned flags) const;
+
+    size_t read_(sample_t* out_data, size_t out_sz, unsigned& flags);
+    size_t read_parallel_(sample_t* out_data, size_t out_sz, unsigned& flags);
+
+    virtual void run_item(size_t index);
+
+    core::BufferFactory<sample_t>& buffer_factory_;
 
     core::List<IFrameReader, core::NoOwnership> readers_;
     core::Slice<sample_t> temp_buf_;
 
+    core::WorkerPool* worker_pool_;
+    core::Array<Input> inputs_;
+    size_t parallel_read_size_;
+
+    mixer_kernel_func_t kernel_;
+
+    size_t num_active_;
+    bool skip_blank_;
+
     bool valid_;
 };
 
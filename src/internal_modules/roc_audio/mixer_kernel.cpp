@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/attributes.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/cpu_traits.h"
+
+#if ROC_CPU_HAS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+#if ROC_CPU_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+void mix_scalar(sample_t* out_data, const sample_t* in_data, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        const sample_t s = out_data[n] + in_data[n];
+
+        if (s > SampleMax) {
+            out_data[n] = SampleMax;
+        } else if (s < SampleMin) {
+            out_data[n] = SampleMin;
+        } else {
+            out_data[n] = s;
+        }
+    }
+}
+
+#if ROC_CPU_HAS_X86_DISPATCH
+
+ROC_ATTR_TARGET("sse2")
+void mix_sse2(sample_t* out_data, const sample_t* in_data, size_t n_samples) {
+    const __m128 lo = _mm_set1_ps(SampleMin);
+    const __m128 hi = _mm_set1_ps(SampleMax);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        __m128 a0 = _mm_loadu_ps(out_data + n);
+        __m128 a1 = _mm_loadu_ps(out_data + n + 4);
+
+        a0 = _mm_add_ps(a0, _mm_loadu_ps(in_data + n));
+        a1 = _mm_add_ps(a1, _mm_loadu_ps(in_data + n + 4));
+
+        _mm_storeu_ps(out_data + n, _mm_min_ps(_mm_max_ps(a0, lo), hi));
+        _mm_storeu_ps(out_data + n + 4, _mm_min_ps(_mm_max_ps(a1, lo), hi));
+    }
+
+    mix_scalar(out_data + n, in_data + n, n_samples - n);
+}
+
+ROC_ATTR_TARGET("avx2")
+void mix_avx2(sample_t* out_data, const sample_t* in_data, size_t n_samples) {
+    const __m256 lo = _mm256_set1_ps(SampleMin);
+    const __m256 hi = _mm256_set1_ps(SampleMax);
+
+    size_t n = 0;
+
+    for (; n + 16 <= n_samples; n += 16) {
+        __m256 a0 = _mm256_loadu_ps(out_data + n);
+        __m256 a1 = _mm256_loadu_ps(out_data + n + 8);
+
+        a0 = _mm256_add_ps(a0, _mm256_loadu_ps(in_data + n));
+        a1 = _mm256_add_ps(a1, _mm256_loadu_ps(in_data + n + 8));
+
+        _mm256_storeu_ps(out_data + n, _mm256_min_ps(_mm256_max_ps(a0, lo), hi));
+        _mm256_storeu_ps(out_data + n + 8, _mm256_min_ps(_mm256_max_ps(a1, lo), hi));
+    }
+
+    // Avoid AVX-SSE transition penalty in the scalar tail and in the caller.
+    _mm256_zeroupper();
+
+    mix_scalar(out_data + n, in_data + n, n_samples - n);
+}
+
+#endif // ROC_CPU_HAS_X86_DISPATCH
+
+#if ROC_CPU_HAS_NEON
+
+void mix_neon(sample_t* out_data, const sample_t* in_data, size_t n_samples) {
+    const float32x4_t lo = vdupq_n_f32(SampleMin);
+    const float32x4_t hi = vdupq_n_f32(SampleMax);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        float32x4_t a0 = vld1q_f32(out_data + n);
+        float32x4_t a1 = vld1q_f32(out_data + n + 4);
+
+        a0 = vaddq_f32(a0, vld1q_f32(in_data + n));
+        a1 = vaddq_f32(a1, vld1q_f32(in_data + n + 4));
+
+        vst1q_f32(out_data + n, vminq_f32(vmaxq_f32(a0, lo), hi));
+        vst1q_f32(out_data + n + 4, vminq_f32(vmaxq_f32(a1, lo), hi));
+    }
+
+    mix_scalar(out_data + n, in_data + n, n_samples - n);
+}
+
+#endif // ROC_CPU_HAS_NEON
+
+} // namespace
+
+mixer_kernel_func_t mixer_kernel_func(MixerKernel kernel) {
+    const unsigned features = core::cpu_features();
+
+    switch (kernel) {
+    case MixerKernel_Scalar:
+        return &mix_scalar;
+
+    case MixerKernel_SSE2:
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (features & core::CpuFeature_SSE2) {
+            return &mix_sse2;
+        }
+#endif
+        break;
+
+    case MixerKernel_AVX2:
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (features & core::CpuFeature_AVX2) {
+            return &mix_avx2;
+        }
+#endif
+        break;
+
+    case MixerKernel_NEON:
+#if ROC_CPU_HAS_NEON
+        if (features & core::CpuFeature_NEON) {
+            return &mix_neon;
+        }
+#endif
+        break;
+
+    case MixerKernel_Max:
+        break;
+    }
+
+    (void)features;
+
+    return NULL;
+}
+
+MixerKernel mixer_kernel_select() {
+    if (mixer_kernel_func(MixerKernel_AVX2)) {
+        return MixerKernel_AVX2;
+    }
+
+    if (mixer_kernel_func(MixerKernel_SSE2)) {
+        return MixerKernel_SSE2;
+    }
+
+    if (mixer_kernel_func(MixerKernel_NEON)) {
+        return MixerKernel_NEON;
+    }
+
+    return MixerKernel_Scalar;
+}
+
+const char* mixer_kernel_to_str(MixerKernel kernel) {
+    switch (kernel) {
+    case MixerKernel_Scalar:
+        return "scalar";
+
+    case MixerKernel_SSE2:
+        return "sse2";
+
+    case MixerKernel_AVX2:
+        return "avx2";
+
+    case MixerKernel_NEON:
+        return "neon";
+
+    case MixerKernel_Max:
+        break;
+    }
+
+    return "<invalid>";
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/mixer_kernel.h
+//! @brief Mixer kernels.
+
+#ifndef ROC_AUDIO_MIXER_KERNEL_H_
+#define ROC_AUDIO_MIXER_KERNEL_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Mixer kernel implementations.
+enum MixerKernel {
+    //! Portable implementation.
+    MixerKernel_Scalar,
+
+    //! x86 SSE2 implementation.
+    MixerKernel_SSE2,
+
+    //! x86 AVX2 implementation.
+    MixerKernel_AVX2,
+
+    //! ARM NEON implementation.
+    MixerKernel_NEON,
+
+    //! Number of kernels.
+    MixerKernel_Max
+};
+
+//! Mixer kernel function.
+//! Adds @p n_samples samples from @p in_data to @p out_data and clamps
+//! every sum to [SampleMin; SampleMax].
+typedef void (*mixer_kernel_func_t)(sample_t* out_data,
+                                    const sample_t* in_data,
+                                    size_t n_samples);
+
+//! Get kernel function.
+//! @returns
+//!  NULL if the kernel is not supported by the build or by the CPU.
+mixer_kernel_func_t mixer_kernel_func(MixerKernel kernel);
+
+//! Select fastest kernel supported by the build and by the CPU.
+MixerKernel mixer_kernel_select();
+
+//! Get string name of mixer kernel.
+const char* mixer_kernel_to_str(MixerKernel kernel);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_MIXER_KERNEL_H_
@@ -7,9 +7,18 @@
 
 #include "roc_audio/pcm_format.h"
 #include "roc_core/attributes.h"
+#include "roc_core/cpu_features.h"
 #include "roc_core/cpu_traits.h"
 #include "roc_core/stddefs.h"
 
+#if ROC_CPU_HAS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+#if ROC_CPU_HAS_NEON
+#include <arm_neon.h>
+#endif
+
 namespace roc {
 namespace audio {
 
@@ -12744,10 +12753,636 @@ typedef void (*pcm_mapper_func_t)(
     size_t& out_bit_off,
     size_t n_samples);
 
+// Vectorized mapper for byte-aligned hot pairs
+template <PcmEncoding InEnc, PcmEncoding OutEnc, PcmEndian InEnd, PcmEndian OutEnd>
+struct pcm_simd_mapper {
+    // No vectorized kernel, use scalar mapper
+    static inline pcm_mapper_func_t select() {
+        return NULL;
+    }
+};
+
+// Vectorized kernel
+// Maps as many samples as it can in whole blocks and returns their number
+typedef size_t (*pcm_simd_kernel_t)(const uint8_t* in, uint8_t* out, size_t n_samples);
+
+// Map byte-aligned samples using vectorized kernel and the rest using scalar mapper
+template <class ScalarMapper, pcm_simd_kernel_t Kernel, size_t InBits, size_t OutBits>
+void pcm_simd_map(const uint8_t* in_data,
+                  size_t& in_bit_off,
+                  uint8_t* out_data,
+                  size_t& out_bit_off,
+                  size_t n_samples) {
+    size_t n = 0;
+
+    if (((in_bit_off | out_bit_off) & 0x7u) == 0) {
+        n = Kernel(in_data + (in_bit_off >> 3), out_data + (out_bit_off >> 3), n_samples);
+
+        in_bit_off += n * InBits;
+        out_bit_off += n * OutBits;
+    }
+
+    ScalarMapper::map(in_data, in_bit_off, out_data, out_bit_off, n_samples - n);
+}
+
+#if ROC_CPU_ENDIAN == ROC_CPU_LE
+#if ROC_CPU_HAS_X86_DISPATCH
+
+// SInt16 to native Float32, 8 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_sint16_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const __m128i swap =
+        _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m128 scale = _mm_set1_ps(float(1.0 / ((double)pcm_sint16_max + 1.0)));
+
+    size_t n = 0;
+    for (; n + 8 <= n_samples; n += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + n * 2));
+        if (Swap) {
+            v = _mm_shuffle_epi8(v, swap);
+        }
+
+        // sign-extend to 32 bits
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+        _mm_storeu_ps((float*)(void*)(out + n * 4),
+                      _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps((float*)(void*)(out + n * 4 + 16),
+                      _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt16, 8 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_float32_to_sint16(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const __m128i swap =
+        _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m128 scale = _mm_set1_ps((float)pcm_sint16_max + 1.0f);
+    const __m128 min_val = _mm_set1_ps((float)pcm_sint16_min);
+    const __m128 max_val = _mm_set1_ps((float)pcm_sint16_max);
+
+    size_t n = 0;
+    for (; n + 8 <= n_samples; n += 8) {
+        __m128 a = _mm_loadu_ps((const float*)(const void*)(in + n * 4));
+        __m128 b = _mm_loadu_ps((const float*)(const void*)(in + n * 4 + 16));
+
+        // clip
+        a = _mm_max_ps(_mm_min_ps(_mm_mul_ps(a, scale), max_val), min_val);
+        b = _mm_max_ps(_mm_min_ps(_mm_mul_ps(b, scale), max_val), min_val);
+
+        __m128i v = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+        if (Swap) {
+            v = _mm_shuffle_epi8(v, swap);
+        }
+
+        _mm_storeu_si128((__m128i*)(void*)(out + n * 2), v);
+    }
+
+    return n;
+}
+
+// SInt24 to native Float32, 4 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_sint24_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    // move 3 octets of every sample to upper octets of 32-bit lane
+    const __m128i unpack = Swap
+        ? _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9)
+        : _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    const __m128 scale = _mm_set1_ps(float(1.0 / ((double)pcm_sint24_max + 1.0)));
+
+    size_t n = 0;
+    // every iteration loads 16 octets but consumes only 12
+    for (; n + 6 <= n_samples; n += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + n * 3));
+
+        // sign-extend to 32 bits
+        v = _mm_srai_epi32(_mm_shuffle_epi8(v, unpack), 8);
+
+        _mm_storeu_ps((float*)(void*)(out + n * 4),
+                      _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt24, 4 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_float32_to_sint24(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    // move lower 3 octets of every 32-bit lane to first 12 octets
+    const __m128i pack = Swap
+        ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+        : _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m128 scale = _mm_set1_ps((float)pcm_sint24_max + 1.0f);
+    const __m128 min_val = _mm_set1_ps((float)pcm_sint24_min);
+    const __m128 max_val = _mm_set1_ps((float)pcm_sint24_max);
+
+    size_t n = 0;
+    // every iteration stores 16 octets, last 4 are overwritten by next samples
+    for (; n + 6 <= n_samples; n += 4) {
+        __m128 a = _mm_loadu_ps((const float*)(const void*)(in + n * 4));
+
+        // clip
+        a = _mm_max_ps(_mm_min_ps(_mm_mul_ps(a, scale), max_val), min_val);
+
+        _mm_storeu_si128((__m128i*)(void*)(out + n * 3),
+                         _mm_shuffle_epi8(_mm_cvttps_epi32(a), pack));
+    }
+
+    return n;
+}
+
+// SInt32 to native Float32, 4 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_sint32_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const __m128i swap =
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128 scale = _mm_set1_ps(float(1.0 / ((double)pcm_sint32_max + 1.0)));
+
+    size_t n = 0;
+    for (; n + 4 <= n_samples; n += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + n * 4));
+        if (Swap) {
+            v = _mm_shuffle_epi8(v, swap);
+        }
+
+        _mm_storeu_ps((float*)(void*)(out + n * 4),
+                      _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt32, 4 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_float32_to_sint32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const __m128i swap =
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128 scale = _mm_set1_ps((float)pcm_sint32_max + 1.0f);
+
+    size_t n = 0;
+    for (; n + 4 <= n_samples; n += 4) {
+        const __m128 a =
+            _mm_mul_ps(_mm_loadu_ps((const float*)(const void*)(in + n * 4)), scale);
+
+        // conversion returns min value on overflow, flip it to max value
+        // for positive overflow; negative overflow is already clipped
+        __m128i v = _mm_xor_si128(_mm_cvttps_epi32(a),
+                                  _mm_castps_si128(_mm_cmpge_ps(a, scale)));
+        if (Swap) {
+            v = _mm_shuffle_epi8(v, swap);
+        }
+
+        _mm_storeu_si128((__m128i*)(void*)(out + n * 4), v);
+    }
+
+    return n;
+}
+
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+
+// SInt16 to native Float32, 8 samples per iteration
+template <bool Swap>
+size_t pcm_neon_sint16_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const float scale = float(1.0 / ((double)pcm_sint16_max + 1.0));
+
+    size_t n = 0;
+    for (; n + 8 <= n_samples; n += 8) {
+        uint8x16_t v = vld1q_u8(in + n * 2);
+        if (Swap) {
+            v = vrev16q_u8(v);
+        }
+
+        const int16x8_t s = vreinterpretq_s16_u8(v);
+
+        const float32x4_t lo =
+            vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), scale);
+        const float32x4_t hi =
+            vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), scale);
+
+        vst1q_u8(out + n * 4, vreinterpretq_u8_f32(lo));
+        vst1q_u8(out + n * 4 + 16, vreinterpretq_u8_f32(hi));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt16, 8 samples per iteration
+template <bool Swap>
+size_t pcm_neon_float32_to_sint16(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const float scale = (float)pcm_sint16_max + 1.0f;
+    const float32x4_t min_val = vdupq_n_f32((float)pcm_sint16_min);
+    const float32x4_t max_val = vdupq_n_f32((float)pcm_sint16_max);
+
+    size_t n = 0;
+    for (; n + 8 <= n_samples; n += 8) {
+        float32x4_t a = vreinterpretq_f32_u8(vld1q_u8(in + n * 4));
+        float32x4_t b = vreinterpretq_f32_u8(vld1q_u8(in + n * 4 + 16));
+
+        // clip
+        a = vmaxq_f32(vminq_f32(vmulq_n_f32(a, scale), max_val), min_val);
+        b = vmaxq_f32(vminq_f32(vmulq_n_f32(b, scale), max_val), min_val);
+
+        uint8x16_t v = vreinterpretq_u8_s16(vcombine_s16(
+            vmovn_s32(vcvtq_s32_f32(a)), vmovn_s32(vcvtq_s32_f32(b))));
+        if (Swap) {
+            v = vrev16q_u8(v);
+        }
+
+        vst1q_u8(out + n * 2, v);
+    }
+
+    return n;
+}
+
+// SInt32 to native Float32, 4 samples per iteration
+template <bool Swap>
+size_t pcm_neon_sint32_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const float scale = float(1.0 / ((double)pcm_sint32_max + 1.0));
+
+    size_t n = 0;
+    for (; n + 4 <= n_samples; n += 4) {
+        uint8x16_t v = vld1q_u8(in + n * 4);
+        if (Swap) {
+            v = vrev32q_u8(v);
+        }
+
+        const float32x4_t f =
+            vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u8(v)), scale);
+
+        vst1q_u8(out + n * 4, vreinterpretq_u8_f32(f));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt32, 4 samples per iteration
+template <bool Swap>
+size_t pcm_neon_float32_to_sint32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const float scale = (float)pcm_sint32_max + 1.0f;
+
+    size_t n = 0;
+    for (; n + 4 <= n_samples; n += 4) {
+        const float32x4_t a =
+            vmulq_n_f32(vreinterpretq_f32_u8(vld1q_u8(in + n * 4)), scale);
+
+        // conversion saturates on overflow
+        uint8x16_t v = vreinterpretq_u8_s32(vcvtq_s32_f32(a));
+        if (Swap) {
+            v = vrev32q_u8(v);
+        }
+
+        vst1q_u8(out + n * 4, v);
+    }
+
+    return n;
+}
+
+#endif // ROC_CPU_HAS_NEON
+
+// SInt16 Big-Endian to Float32 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_SInt16,
+                       PcmEncoding_Float32,
+                       PcmEndian_Big,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_SInt16,
+                       PcmEncoding_Float32,
+                       PcmEndian_Big,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_sint16_to_float32<true>,
+                                 16, 32>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_sint16_to_float32<true>,
+                                 16, 32>;
+        }
+#endif // ROC_CPU_HAS_NEON
+        return NULL;
+    }
+};
+
+// Float32 Little-Endian to SInt16 Big-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt16,
+                       PcmEndian_Little,
+                       PcmEndian_Big> {
+    typedef pcm_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt16,
+                       PcmEndian_Little,
+                       PcmEndian_Big>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_float32_to_sint16<true>,
+                                 32, 16>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_float32_to_sint16<true>,
+                                 32, 16>;
+        }
+#endif // ROC_CPU_HAS_NEON
+        return NULL;
+    }
+};
+
+// SInt16 Little-Endian to Float32 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_SInt16,
+                       PcmEncoding_Float32,
+                       PcmEndian_Little,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_SInt16,
+                       PcmEncoding_Float32,
+                       PcmEndian_Little,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_sint16_to_float32<false>,
+                                 16, 32>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_sint16_to_float32<false>,
+                                 16, 32>;
+        }
+#endif // ROC_CPU_HAS_NEON
+        return NULL;
+    }
+};
+
+// Float32 Little-Endian to SInt16 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt16,
+                       PcmEndian_Little,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt16,
+                       PcmEndian_Little,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_float32_to_sint16<false>,
+                                 32, 16>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_float32_to_sint16<false>,
+                                 32, 16>;
+        }
+#endif // ROC_CPU_HAS_NEON
+        return NULL;
+    }
+};
+
+// SInt24 Big-Endian to Float32 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_SInt24,
+                       PcmEncoding_Float32,
+                       PcmEndian_Big,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_SInt24,
+                       PcmEncoding_Float32,
+                       PcmEndian_Big,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_sint24_to_float32<true>,
+                                 24, 32>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+        return NULL;
+    }
+};
+
+// Float32 Little-Endian to SInt24 Big-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt24,
+                       PcmEndian_Little,
+                       PcmEndian_Big> {
+    typedef pcm_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt24,
+                       PcmEndian_Little,
+                       PcmEndian_Big>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_float32_to_sint24<true>,
+                                 32, 24>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+        return NULL;
+    }
+};
+
+// SInt24 Little-Endian to Float32 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_SInt24,
+                       PcmEncoding_Float32,
+                       PcmEndian_Little,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_SInt24,
+                       PcmEncoding_Float32,
+                       PcmEndian_Little,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_sint24_to_float32<false>,
+                                 24, 32>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+        return NULL;
+    }
+};
+
+// Float32 Little-Endian to SInt24 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt24,
+                       PcmEndian_Little,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt24,
+                       PcmEndian_Little,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_float32_to_sint24<false>,
+                                 32, 24>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+        return NULL;
+    }
+};
+
+// SInt32 Big-Endian to Float32 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_SInt32,
+                       PcmEncoding_Float32,
+                       PcmEndian_Big,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_SInt32,
+                       PcmEncoding_Float32,
+                       PcmEndian_Big,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_sint32_to_float32<true>,
+                                 32, 32>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_sint32_to_float32<true>,
+                                 32, 32>;
+        }
+#endif // ROC_CPU_HAS_NEON
+        return NULL;
+    }
+};
+
+// Float32 Little-Endian to SInt32 Big-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt32,
+                       PcmEndian_Little,
+                       PcmEndian_Big> {
+    typedef pcm_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt32,
+                       PcmEndian_Little,
+                       PcmEndian_Big>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_float32_to_sint32<true>,
+                                 32, 32>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_float32_to_sint32<true>,
+                                 32, 32>;
+        }
+#endif // ROC_CPU_HAS_NEON
+        return NULL;
+    }
+};
+
+// SInt32 Little-Endian to Float32 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_SInt32,
+                       PcmEncoding_Float32,
+                       PcmEndian_Little,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_SInt32,
+                       PcmEncoding_Float32,
+                       PcmEndian_Little,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_sint32_to_float32<false>,
+                                 32, 32>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_sint32_to_float32<false>,
+                                 32, 32>;
+        }
+#endif // ROC_CPU_HAS_NEON
+        return NULL;
+    }
+};
+
+// Float32 Little-Endian to SInt32 Little-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt32,
+                       PcmEndian_Little,
+                       PcmEndian_Little> {
+    typedef pcm_mapper<PcmEncoding_Float32,
+                       PcmEncoding_SInt32,
+                       PcmEndian_Little,
+                       PcmEndian_Little>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_float32_to_sint32<false>,
+                                 32, 32>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_float32_to_sint32<false>,
+                                 32, 32>;
+        }
+#endif // ROC_CPU_HAS_NEON
+        return NULL;
+    }
+};
+
+#endif // ROC_CPU_ENDIAN == ROC_CPU_LE
+
 // Select mapper function
 template <PcmEncoding InEnc, PcmEncoding OutEnc, PcmEndian InEnd, PcmEndian OutEnd>
 pcm_mapper_func_t pcm_mapper_func() {
-    return &pcm_mapper<InEnc, OutEnc, InEnd, OutEnd>::map;
+    pcm_mapper_func_t func = pcm_simd_mapper<InEnc, OutEnc, InEnd, OutEnd>::select();
+    if (!func) {
+        func = &pcm_mapper<InEnc, OutEnc, InEnd, OutEnd>::map;
+    }
+    return func;
 }
 
 // Select mapper function
@@ -406,6 +406,35 @@ for enc in encodings:
     enc['significant_octets'], enc['packed_octets'], enc['unpacked_octets'] = \
       compute_octets(enc)
 
+# Byte-aligned pairs with vectorized kernels, float is always native (little) endian
+simd_pairs = []
+
+for enc in encodings:
+    if enc['encoding'] not in ['SInt16', 'SInt24', 'SInt32']:
+        continue
+    for endian in ['Big', 'Little']:
+        for direction in ['decode', 'encode']:
+            if direction == 'decode':
+                in_enc, in_end, out_enc, out_end = enc['encoding'], endian, 'Float32', 'Little'
+                kernel = f"{enc['encoding'].lower()}_to_float32"
+                in_bits, out_bits = enc['packed_width'], 32
+            else:
+                in_enc, in_end, out_enc, out_end = 'Float32', 'Little', enc['encoding'], endian
+                kernel = f"float32_to_{enc['encoding'].lower()}"
+                in_bits, out_bits = 32, enc['packed_width']
+            simd_pairs.append({
+                'in_encoding': in_enc,
+                'in_endian': in_end,
+                'out_encoding': out_enc,
+                'out_endian': out_end,
+                'kernel': kernel,
+                'swap': 'true' if endian == 'Big' else 'false',
+                'in_bits': in_bits,
+                'out_bits': out_bits,
+                # 24-bit kernels need byte shuffle, which is implemented only for x86
+                'has_neon': enc['width'] != 24,
+            })
+
 env = jinja2.Environment(
     trim_blocks=True,
     lstrip_blocks=True,
@@ -421,9 +450,18 @@ template = env.from_string('''
 
 #include "roc_audio/pcm_format.h"
 #include "roc_core/attributes.h"
+#include "roc_core/cpu_features.h"
 #include "roc_core/cpu_traits.h"
 #include "roc_core/stddefs.h"
 
+#if ROC_CPU_HAS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+#if ROC_CPU_HAS_NEON
+#include <arm_neon.h>
+#endif
+
 namespace roc {
 namespace audio {
 
@@ -733,10 +771,345 @@ typedef void (*pcm_mapper_func_t)(
     size_t& out_bit_off,
     size_t n_samples);
 
+// Vectorized mapper for byte-aligned hot pairs
+template <PcmEncoding InEnc, PcmEncoding OutEnc, PcmEndian InEnd, PcmEndian OutEnd>
+struct pcm_simd_mapper {
+    // No vectorized kernel, use scalar mapper
+    static inline pcm_mapper_func_t select() {
+        return NULL;
+    }
+};
+
+// Vectorized kernel
+// Maps as many samples as it can in whole blocks and returns their number
+typedef size_t (*pcm_simd_kernel_t)(const uint8_t* in, uint8_t* out, size_t n_samples);
+
+// Map byte-aligned samples using vectorized kernel and the rest using scalar mapper
+template <class ScalarMapper, pcm_simd_kernel_t Kernel, size_t InBits, size_t OutBits>
+void pcm_simd_map(const uint8_t* in_data,
+                  size_t& in_bit_off,
+                  uint8_t* out_data,
+                  size_t& out_bit_off,
+                  size_t n_samples) {
+    size_t n = 0;
+
+    if (((in_bit_off | out_bit_off) & 0x7u) == 0) {
+        n = Kernel(in_data + (in_bit_off >> 3), out_data + (out_bit_off >> 3), n_samples);
+
+        in_bit_off += n * InBits;
+        out_bit_off += n * OutBits;
+    }
+
+    ScalarMapper::map(in_data, in_bit_off, out_data, out_bit_off, n_samples - n);
+}
+
+#if ROC_CPU_ENDIAN == ROC_CPU_LE
+#if ROC_CPU_HAS_X86_DISPATCH
+
+// SInt16 to native Float32, 8 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_sint16_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const __m128i swap =
+        _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m128 scale = _mm_set1_ps(float(1.0 / ((double)pcm_sint16_max + 1.0)));
+
+    size_t n = 0;
+    for (; n + 8 <= n_samples; n += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + n * 2));
+        if (Swap) {
+            v = _mm_shuffle_epi8(v, swap);
+        }
+
+        // sign-extend to 32 bits
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+        _mm_storeu_ps((float*)(void*)(out + n * 4),
+                      _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps((float*)(void*)(out + n * 4 + 16),
+                      _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt16, 8 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_float32_to_sint16(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const __m128i swap =
+        _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m128 scale = _mm_set1_ps((float)pcm_sint16_max + 1.0f);
+    const __m128 min_val = _mm_set1_ps((float)pcm_sint16_min);
+    const __m128 max_val = _mm_set1_ps((float)pcm_sint16_max);
+
+    size_t n = 0;
+    for (; n + 8 <= n_samples; n += 8) {
+        __m128 a = _mm_loadu_ps((const float*)(const void*)(in + n * 4));
+        __m128 b = _mm_loadu_ps((const float*)(const void*)(in + n * 4 + 16));
+
+        // clip
+        a = _mm_max_ps(_mm_min_ps(_mm_mul_ps(a, scale), max_val), min_val);
+        b = _mm_max_ps(_mm_min_ps(_mm_mul_ps(b, scale), max_val), min_val);
+
+        __m128i v = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+        if (Swap) {
+            v = _mm_shuffle_epi8(v, swap);
+        }
+
+        _mm_storeu_si128((__m128i*)(void*)(out + n * 2), v);
+    }
+
+    return n;
+}
+
+// SInt24 to native Float32, 4 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_sint24_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    // move 3 octets of every sample to upper octets of 32-bit lane
+    const __m128i unpack = Swap
+        ? _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9)
+        : _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    const __m128 scale = _mm_set1_ps(float(1.0 / ((double)pcm_sint24_max + 1.0)));
+
+    size_t n = 0;
+    // every iteration loads 16 octets but consumes only 12
+    for (; n + 6 <= n_samples; n += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + n * 3));
+
+        // sign-extend to 32 bits
+        v = _mm_srai_epi32(_mm_shuffle_epi8(v, unpack), 8);
+
+        _mm_storeu_ps((float*)(void*)(out + n * 4),
+                      _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt24, 4 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_float32_to_sint24(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    // move lower 3 octets of every 32-bit lane to first 12 octets
+    const __m128i pack = Swap
+        ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+        : _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m128 scale = _mm_set1_ps((float)pcm_sint24_max + 1.0f);
+    const __m128 min_val = _mm_set1_ps((float)pcm_sint24_min);
+    const __m128 max_val = _mm_set1_ps((float)pcm_sint24_max);
+
+    size_t n = 0;
+    // every iteration stores 16 octets, last 4 are overwritten by next samples
+    for (; n + 6 <= n_samples; n += 4) {
+        __m128 a = _mm_loadu_ps((const float*)(const void*)(in + n * 4));
+
+        // clip
+        a = _mm_max_ps(_mm_min_ps(_mm_mul_ps(a, scale), max_val), min_val);
+
+        _mm_storeu_si128((__m128i*)(void*)(out + n * 3),
+                         _mm_shuffle_epi8(_mm_cvttps_epi32(a), pack));
+    }
+
+    return n;
+}
+
+// SInt32 to native Float32, 4 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_sint32_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const __m128i swap =
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128 scale = _mm_set1_ps(float(1.0 / ((double)pcm_sint32_max + 1.0)));
+
+    size_t n = 0;
+    for (; n + 4 <= n_samples; n += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + n * 4));
+        if (Swap) {
+            v = _mm_shuffle_epi8(v, swap);
+        }
+
+        _mm_storeu_ps((float*)(void*)(out + n * 4),
+                      _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt32, 4 samples per iteration
+template <bool Swap>
+ROC_ATTR_TARGET("ssse3")
+size_t pcm_ssse3_float32_to_sint32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const __m128i swap =
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128 scale = _mm_set1_ps((float)pcm_sint32_max + 1.0f);
+
+    size_t n = 0;
+    for (; n + 4 <= n_samples; n += 4) {
+        const __m128 a =
+            _mm_mul_ps(_mm_loadu_ps((const float*)(const void*)(in + n * 4)), scale);
+
+        // conversion returns min value on overflow, flip it to max value
+        // for positive overflow; negative overflow is already clipped
+        __m128i v = _mm_xor_si128(_mm_cvttps_epi32(a),
+                                  _mm_castps_si128(_mm_cmpge_ps(a, scale)));
+        if (Swap) {
+            v = _mm_shuffle_epi8(v, swap);
+        }
+
+        _mm_storeu_si128((__m128i*)(void*)(out + n * 4), v);
+    }
+
+    return n;
+}
+
+#endif // ROC_CPU_HAS_X86_DISPATCH
+#if ROC_CPU_HAS_NEON
+
+// SInt16 to native Float32, 8 samples per iteration
+template <bool Swap>
+size_t pcm_neon_sint16_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const float scale = float(1.0 / ((double)pcm_sint16_max + 1.0));
+
+    size_t n = 0;
+    for (; n + 8 <= n_samples; n += 8) {
+        uint8x16_t v = vld1q_u8(in + n * 2);
+        if (Swap) {
+            v = vrev16q_u8(v);
+        }
+
+        const int16x8_t s = vreinterpretq_s16_u8(v);
+
+        const float32x4_t lo =
+            vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), scale);
+        const float32x4_t hi =
+            vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), scale);
+
+        vst1q_u8(out + n * 4, vreinterpretq_u8_f32(lo));
+        vst1q_u8(out + n * 4 + 16, vreinterpretq_u8_f32(hi));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt16, 8 samples per iteration
+template <bool Swap>
+size_t pcm_neon_float32_to_sint16(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const float scale = (float)pcm_sint16_max + 1.0f;
+    const float32x4_t min_val = vdupq_n_f32((float)pcm_sint16_min);
+    const float32x4_t max_val = vdupq_n_f32((float)pcm_sint16_max);
+
+    size_t n = 0;
+    for (; n + 8 <= n_samples; n += 8) {
+        float32x4_t a = vreinterpretq_f32_u8(vld1q_u8(in + n * 4));
+        float32x4_t b = vreinterpretq_f32_u8(vld1q_u8(in + n * 4 + 16));
+
+        // clip
+        a = vmaxq_f32(vminq_f32(vmulq_n_f32(a, scale), max_val), min_val);
+        b = vmaxq_f32(vminq_f32(vmulq_n_f32(b, scale), max_val), min_val);
+
+        uint8x16_t v = vreinterpretq_u8_s16(vcombine_s16(
+            vmovn_s32(vcvtq_s32_f32(a)), vmovn_s32(vcvtq_s32_f32(b))));
+        if (Swap) {
+            v = vrev16q_u8(v);
+        }
+
+        vst1q_u8(out + n * 2, v);
+    }
+
+    return n;
+}
+
+// SInt32 to native Float32, 4 samples per iteration
+template <bool Swap>
+size_t pcm_neon_sint32_to_float32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const float scale = float(1.0 / ((double)pcm_sint32_max + 1.0));
+
+    size_t n = 0;
+    for (; n + 4 <= n_samples; n += 4) {
+        uint8x16_t v = vld1q_u8(in + n * 4);
+        if (Swap) {
+            v = vrev32q_u8(v);
+        }
+
+        const float32x4_t f =
+            vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u8(v)), scale);
+
+        vst1q_u8(out + n * 4, vreinterpretq_u8_f32(f));
+    }
+
+    return n;
+}
+
+// Native Float32 to SInt32, 4 samples per iteration
+template <bool Swap>
+size_t pcm_neon_float32_to_sint32(const uint8_t* in, uint8_t* out, size_t n_samples) {
+    const float scale = (float)pcm_sint32_max + 1.0f;
+
+    size_t n = 0;
+    for (; n + 4 <= n_samples; n += 4) {
+        const float32x4_t a =
+            vmulq_n_f32(vreinterpretq_f32_u8(vld1q_u8(in + n * 4)), scale);
+
+        // conversion saturates on overflow
+        uint8x16_t v = vreinterpretq_u8_s32(vcvtq_s32_f32(a));
+        if (Swap) {
+            v = vrev32q_u8(v);
+        }
+
+        vst1q_u8(out + n * 4, v);
+    }
+
+    return n;
+}
+
+#endif // ROC_CPU_HAS_NEON
+
+{% for p in simd_pairs %}
+// {{ p.in_encoding }} {{ p.in_endian }}-Endian to {{ p.out_encoding }} {{ p.out_endian }}-Endian vectorized mapper
+template <>
+struct pcm_simd_mapper<PcmEncoding_{{ p.in_encoding }},
+                       PcmEncoding_{{ p.out_encoding }},
+                       PcmEndian_{{ p.in_endian }},
+                       PcmEndian_{{ p.out_endian }}> {
+    typedef pcm_mapper<PcmEncoding_{{ p.in_encoding }},
+                       PcmEncoding_{{ p.out_encoding }},
+                       PcmEndian_{{ p.in_endian }},
+                       PcmEndian_{{ p.out_endian }}>
+        scalar_mapper;
+
+    static inline pcm_mapper_func_t select() {
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (core::cpu_features() & core::CpuFeature_SSSE3) {
+            return &pcm_simd_map<scalar_mapper, &pcm_ssse3_{{ p.kernel }}<{{ p.swap }}>,
+                                 {{ p.in_bits }}, {{ p.out_bits }}>;
+        }
+#endif // ROC_CPU_HAS_X86_DISPATCH
+{% if p.has_neon %}
+#if ROC_CPU_HAS_NEON
+        if (core::cpu_features() & core::CpuFeature_NEON) {
+            return &pcm_simd_map<scalar_mapper, &pcm_neon_{{ p.kernel }}<{{ p.swap }}>,
+                                 {{ p.in_bits }}, {{ p.out_bits }}>;
+        }
+#endif // ROC_CPU_HAS_NEON
+{% endif %}
+        return NULL;
+    }
+};
+
+{% endfor %}
+#endif // ROC_CPU_ENDIAN == ROC_CPU_LE
+
 // Select mapper function
 template <PcmEncoding InEnc, PcmEncoding OutEnc, PcmEndian InEnd, PcmEndian OutEnd>
 pcm_mapper_func_t pcm_mapper_func() {
-    return &pcm_mapper<InEnc, OutEnc, InEnd, OutEnd>::map;
+    pcm_mapper_func_t func = pcm_simd_mapper<InEnc, OutEnc, InEnd, OutEnd>::select();
+    if (!func) {
+        func = &pcm_mapper<InEnc, OutEnc, InEnd, OutEnd>::map;
+    }
+    return func;
 }
 
 // Select mapper function
@@ -269,8 +269,25 @@ size_t BuiltinResampler::pop_output(Frame& out) {
             qt_sample_ += qt_one;
         }
 
-        for (size_t channel = 0; channel < sample_spec_.num_channels(); ++channel) {
-            out_data[out_pos + channel] = resample_(channel);
+        switch (sample_spec_.num_channels()) {
+        case 1:
+            resample_<1>(out_data + out_pos);
+            break;
+        case 2:
+            resample_<2>(out_data + out_pos);
+            break;
+        case 4:
+            resample_<4>(out_data + out_pos);
+            break;
+        case 6:
+            resample_<6>(out_data + out_pos);
+            break;
+        case 8:
+            resample_<8>(out_data + out_pos);
+            break;
+        default:
+            resample_<0>(out_data + out_pos);
+            break;
         }
         qt_sample_ += qt_dt_;
     }
@@ -373,48 +390,45 @@ sample_t BuiltinResampler::sinc_(const fixedpoint_t x, const float fract_x) {
     return scaling_ > 1.0f ? result / scaling_ : result;
 }
 
-sample_t BuiltinResampler::resample_(const size_t channel_offset) {
+template <size_t NumCh> void BuiltinResampler::resample_(sample_t* out_data) {
     roc_panic_if_msg(qt_sinc_step_ == 0,
                      "builtin resampler: set scaling must be called "
                      "before any resampling could be done");
+
+    const size_t num_ch = NumCh != 0 ? NumCh : sample_spec_.num_channels();
+
     // Index of first input sample in window.
     size_t ind_begin_prev;
 
     // Window lasts till that index.
-    const size_t ind_end_prev = channelize_index(frame_size_ch_, channel_offset);
+    const size_t ind_end_prev = frame_size_ch_;
 
     size_t ind_begin_cur;
     size_t ind_end_cur;
 
-    const size_t ind_begin_next = channelize_index(0, channel_offset);
+    const size_t ind_begin_next = 0;
     size_t ind_end_next;
 
     ind_begin_prev = (qt_sample_ >= qt_half_window_size_)
         ? frame_size_ch_
         : fixedpoint_to_size(qceil(qt_sample_ + (qt_frame_size_ - qt_half_window_size_)));
-    // ind_begin_prev is comparable with channel_len_ till we'll convert it to channalyzed
-    // presentation.
     roc_panic_if(ind_begin_prev > frame_size_ch_);
-    ind_begin_prev = channelize_index(ind_begin_prev, channel_offset);
 
     ind_begin_cur = (qt_sample_ >= qt_half_window_size_)
         ? fixedpoint_to_size(qceil(qt_sample_ - qt_half_window_size_))
         : 0;
     roc_panic_if(ind_begin_cur > frame_size_ch_);
-    ind_begin_cur = channelize_index(ind_begin_cur, channel_offset);
 
     ind_end_cur = ((qt_sample_ + qt_half_window_size_) > qt_frame_size_)
         ? frame_size_ch_ - 1
         : fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_size_));
     roc_panic_if(ind_end_cur > frame_size_ch_);
-    ind_end_cur = channelize_index(ind_end_cur, channel_offset);
 
     ind_end_next = ((qt_sample_ + qt_half_window_size_) > qt_frame_size_)
         ? fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_size_ - qt_frame_size_))
             + 1
         : 0;
     roc_panic_if(ind_end_next > frame_size_ch_);
-    ind_end_next = channelize_index(ind_end_next, channel_offset);
 
     // Counter inside window.
     // t_sinc = (t_sample - ceil( t_sample - window_len/cutoff*scale )) * sinc_step
@@ -431,29 +445,49 @@ sample_t BuiltinResampler::resample_(const size_t channel_offset) {
     // Compute fractional part of time position at the begining. It wont change during
     // the run.
     float f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
-    sample_t accumulator = 0;
 
+    // Accumulators for every channel. When number of channels is known at compile
+    // time, inner loops over channels are unrolled and vectorized by compiler.
+    sample_t accumulator[NumCh != 0 ? NumCh : (size_t)MaxChannels];
+    for (size_t ch = 0; ch < num_ch; ch++) {
+        accumulator[ch] = 0;
+    }
+
+    const sample_t* in;
+    sample_t h;
     size_t i;
 
     // Run through previous frame.
-    for (i = ind_begin_prev; i < ind_end_prev; i += sample_spec_.num_channels()) {
-        accumulator += prev_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (i = ind_begin_prev; i < ind_end_prev; i++) {
+        in = prev_frame_ + i * num_ch;
+        h = sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            accumulator[ch] += in[ch] * h;
+        }
         qt_sinc_cur -= qt_sinc_inc;
     }
 
     // Run through current frame through the left windows side. qt_sinc_cur is decreasing.
     i = ind_begin_cur;
 
-    accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    in = curr_frame_ + i * num_ch;
+    h = sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (size_t ch = 0; ch < num_ch; ch++) {
+        accumulator[ch] += in[ch] * h;
+    }
     while (qt_sinc_cur >= qt_sinc_step_) {
-        i += sample_spec_.num_channels();
+        i++;
         qt_sinc_cur -= qt_sinc_inc;
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        in = curr_frame_ + i * num_ch;
+        h = sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            accumulator[ch] += in[ch] * h;
+        }
     }
 
-    i += sample_spec_.num_channels();
+    i++;
 
-    roc_panic_if(i > channelize_index(frame_size_ch_, channel_offset));
+    roc_panic_if(i > frame_size_ch_);
 
     // Crossing zero -- we just need to switch qt_sinc_cur.
     // -1 ------------ 0 ------------- +1
@@ -464,18 +498,28 @@ sample_t BuiltinResampler::resample_(const size_t channel_offset) {
     f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
 
     // Run through right side of the window, increasing qt_sinc_cur.
-    for (; i <= ind_end_cur; i += sample_spec_.num_channels()) {
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (; i <= ind_end_cur; i++) {
+        in = curr_frame_ + i * num_ch;
+        h = sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            accumulator[ch] += in[ch] * h;
+        }
         qt_sinc_cur += qt_sinc_inc;
     }
 
     // Next frames run.
-    for (i = ind_begin_next; i < ind_end_next; i += sample_spec_.num_channels()) {
-        accumulator += next_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    for (i = ind_begin_next; i < ind_end_next; i++) {
+        in = next_frame_ + i * num_ch;
+        h = sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            accumulator[ch] += in[ch] * h;
+        }
         qt_sinc_cur += qt_sinc_inc;
     }
 
-    return accumulator;
+    for (size_t ch = 0; ch < num_ch; ch++) {
+        out_data[ch] = accumulator[ch];
+    }
 }
 
 } // namespace audio
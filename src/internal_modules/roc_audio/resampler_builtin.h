@@ -67,11 +67,9 @@ private:
     typedef int32_t signed_fixedpoint_t;
     typedef int64_t signed_long_fixedpoint_t;
 
-    const audio::SampleSpec sample_spec_;
+    enum { MaxChannels = sizeof(packet::channel_mask_t) * 8 };
 
-    inline size_t channelize_index(const size_t i, const size_t ch_offset) const {
-        return i * sample_spec_.num_channels() + ch_offset;
-    }
+    const audio::SampleSpec sample_spec_;
 
     bool alloc_frames_(core::BufferFactory<sample_t>&);
 
@@ -80,10 +78,10 @@ private:
     bool fill_sinc_();
     sample_t sinc_(fixedpoint_t x, float fract_x);
 
-    // Computes single sample of the particular audio channel.
-    // channel_offset a serial number of the channel
-    //  (e.g. left -- 0, right -- 1, etc.).
-    sample_t resample_(size_t channel_offset);
+    // Computes one output sample for every channel.
+    // Walks the window once and applies every sinc coefficient to all channels.
+    // NumCh is number of channels if it's known at compile time, or zero.
+    template <size_t NumCh> void resample_(sample_t* out_data);
 
     core::Slice<sample_t> frames_[3];
     size_t n_ready_frames_;
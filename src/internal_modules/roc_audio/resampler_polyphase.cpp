@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_polyphase.h"
+#include "roc_core/attributes.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+#if ROC_CPU_HAS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+#if ROC_CPU_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+const unsigned FracBits = 32;
+const uint64_t FracMask = 0xFFFFFFFFu;
+
+// Leave some room for filter transition band.
+const double CutoffFreq = 0.9;
+
+typedef void (*dot_func_t)(const sample_t* h0,
+                           const sample_t* h1,
+                           const sample_t* x,
+                           size_t n,
+                           sample_t& r0,
+                           sample_t& r1);
+
+size_t get_num_taps(ResamplerProfile profile) {
+    switch (profile) {
+    case ResamplerProfile_Low:
+        return 16;
+
+    case ResamplerProfile_Medium:
+        return 32;
+
+    case ResamplerProfile_High:
+        return 64;
+    }
+
+    roc_panic("polyphase resampler: unexpected profile");
+}
+
+size_t get_phase_bits(ResamplerProfile profile) {
+    switch (profile) {
+    case ResamplerProfile_Low:
+        return 6;
+
+    case ResamplerProfile_Medium:
+        return 7;
+
+    case ResamplerProfile_High:
+        return 8;
+    }
+
+    roc_panic("polyphase resampler: unexpected profile");
+}
+
+void dot_scalar(const sample_t* h0,
+                const sample_t* h1,
+                const sample_t* x,
+                size_t n,
+                sample_t& r0,
+                sample_t& r1) {
+    sample_t acc0 = 0, acc1 = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        acc0 += h0[i] * x[i];
+        acc1 += h1[i] * x[i];
+    }
+
+    r0 = acc0;
+    r1 = acc1;
+}
+
+#if ROC_CPU_HAS_X86_DISPATCH
+
+ROC_ATTR_TARGET("sse2")
+sample_t hsum_sse2(__m128 v) {
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 0x55));
+    return _mm_cvtss_f32(v);
+}
+
+ROC_ATTR_TARGET("sse2")
+void dot_sse2(const sample_t* h0,
+              const sample_t* h1,
+              const sample_t* x,
+              size_t n,
+              sample_t& r0,
+              sample_t& r1) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        const __m128 xv = _mm_loadu_ps(x + i);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(h0 + i), xv));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(h1 + i), xv));
+    }
+
+    sample_t s0 = hsum_sse2(acc0), s1 = hsum_sse2(acc1);
+
+    for (; i < n; i++) {
+        s0 += h0[i] * x[i];
+        s1 += h1[i] * x[i];
+    }
+
+    r0 = s0;
+    r1 = s1;
+}
+
+ROC_ATTR_TARGET("avx2")
+void dot_avx2(const sample_t* h0,
+              const sample_t* h1,
+              const sample_t* x,
+              size_t n,
+              sample_t& r0,
+              sample_t& r1) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        const __m256 xv = _mm256_loadu_ps(x + i);
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(h0 + i), xv));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(h1 + i), xv));
+    }
+
+    __m128 lo0 = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    __m128 lo1 = _mm_add_ps(_mm256_castps256_ps128(acc1), _mm256_extractf128_ps(acc1, 1));
+
+    lo0 = _mm_add_ps(lo0, _mm_movehl_ps(lo0, lo0));
+    lo0 = _mm_add_ss(lo0, _mm_shuffle_ps(lo0, lo0, 0x55));
+    lo1 = _mm_add_ps(lo1, _mm_movehl_ps(lo1, lo1));
+    lo1 = _mm_add_ss(lo1, _mm_shuffle_ps(lo1, lo1, 0x55));
+
+    sample_t s0 = _mm_cvtss_f32(lo0), s1 = _mm_cvtss_f32(lo1);
+
+    // Avoid AVX-SSE transition penalty in the scalar tail and in the caller.
+    _mm256_zeroupper();
+
+    for (; i < n; i++) {
+        s0 += h0[i] * x[i];
+        s1 += h1[i] * x[i];
+    }
+
+    r0 = s0;
+    r1 = s1;
+}
+
+#endif // ROC_CPU_HAS_X86_DISPATCH
+
+#if ROC_CPU_HAS_NEON
+
+sample_t hsum_neon(float32x4_t v) {
+    float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+}
+
+void dot_neon(const sample_t* h0,
+              const sample_t* h1,
+              const sample_t* x,
+              size_t n,
+              sample_t& r0,
+              sample_t& r1) {
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t xv = vld1q_f32(x + i);
+        acc0 = vmlaq_f32(acc0, vld1q_f32(h0 + i), xv);
+        acc1 = vmlaq_f32(acc1, vld1q_f32(h1 + i), xv);
+    }
+
+    sample_t s0 = hsum_neon(acc0), s1 = hsum_neon(acc1);
+
+    for (; i < n; i++) {
+        s0 += h0[i] * x[i];
+        s1 += h1[i] * x[i];
+    }
+
+    r0 = s0;
+    r1 = s1;
+}
+
+#endif // ROC_CPU_HAS_NEON
+
+dot_func_t select_dot_func(const char*& name) {
+    const unsigned features = core::cpu_features();
+
+#if ROC_CPU_HAS_X86_DISPATCH
+    if (features & core::CpuFeature_AVX2) {
+        name = "avx2";
+        return &dot_avx2;
+    }
+    if (features & core::CpuFeature_SSE2) {
+        name = "sse2";
+        return &dot_sse2;
+    }
+#endif
+
+#if ROC_CPU_HAS_NEON
+    if (features & core::CpuFeature_NEON) {
+        name = "neon";
+        return &dot_neon;
+    }
+#endif
+
+    (void)features;
+
+    name = "scalar";
+    return &dot_scalar;
+}
+
+} // namespace
+
+PolyphaseResampler::PolyphaseResampler(core::IAllocator& allocator,
+                                       core::BufferFactory<sample_t>& buffer_factory,
+                                       ResamplerProfile profile,
+                                       core::nanoseconds_t frame_length,
+                                       const audio::SampleSpec& sample_spec)
+    : num_ch_(sample_spec.num_channels())
+    , frame_size_(sample_spec.ns_2_samples_overall(frame_length))
+    , frame_size_ch_(num_ch_ ? frame_size_ / num_ch_ : 0)
+    , num_taps_(get_num_taps(profile))
+    , num_phases_((size_t)1 << get_phase_bits(profile))
+    , phase_bits_(get_phase_bits(profile))
+    , bank_(allocator)
+    , bank_in_rate_(0)
+    , bank_out_rate_(0)
+    , hist_(allocator)
+    , hist_stride_(num_taps_ + frame_size_ch_)
+    , hist_size_(num_taps_)
+    , pos_((uint64_t)num_taps_ << FracBits)
+    , step_(0)
+    , dot_func_(NULL)
+    , valid_(false) {
+    if (num_ch_ == 0 || frame_size_ != frame_size_ch_ * num_ch_) {
+        roc_log(LogError,
+                "polyphase resampler: frame_size is not multiple of num_channels:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)num_ch_);
+        return;
+    }
+
+    if (frame_size_ch_ < num_taps_) {
+        roc_log(LogError,
+                "polyphase resampler: frame_size is less than window size:"
+                " frame_size=%lu window_size=%lu",
+                (unsigned long)frame_size_ch_, (unsigned long)num_taps_);
+        return;
+    }
+
+    in_frame_ = buffer_factory.new_buffer();
+    if (!in_frame_) {
+        roc_log(LogError, "polyphase resampler: can't allocate frame buffer");
+        return;
+    }
+    if (in_frame_.capacity() < frame_size_) {
+        roc_log(LogError, "polyphase resampler: allocated buffer is too small");
+        return;
+    }
+    in_frame_.reslice(0, frame_size_);
+
+    if (!hist_.resize(hist_stride_ * num_ch_)) {
+        roc_log(LogError, "polyphase resampler: can't allocate history buffer");
+        return;
+    }
+    for (size_t n = 0; n < hist_.size(); n++) {
+        hist_[n] = 0;
+    }
+
+    if (!bank_.resize((num_phases_ + 1) * num_taps_)) {
+        roc_log(LogError, "polyphase resampler: can't allocate filter bank");
+        return;
+    }
+
+    const char* kernel_name = NULL;
+    dot_func_ = select_dot_func(kernel_name);
+
+    roc_log(LogDebug,
+            "polyphase resampler: initializing: "
+            "num_taps=%lu num_phases=%lu frame_size=%lu num_channels=%lu kernel=%s",
+            (unsigned long)num_taps_, (unsigned long)num_phases_,
+            (unsigned long)frame_size_, (unsigned long)num_ch_, kernel_name);
+
+    valid_ = true;
+}
+
+PolyphaseResampler::~PolyphaseResampler() {
+}
+
+bool PolyphaseResampler::valid() const {
+    return valid_;
+}
+
+bool PolyphaseResampler::set_scaling(size_t input_rate,
+                                     size_t output_rate,
+                                     float multiplier) {
+    roc_panic_if_not(valid());
+
+    if (input_rate == 0 || output_rate == 0) {
+        roc_log(LogError, "polyphase resampler: invalid rate");
+        return false;
+    }
+
+    const double scaling = double(input_rate) / output_rate * (double)multiplier;
+
+    // Each output sample may advance at most by one frame, otherwise we would
+    // need to keep more than one frame of input.
+    if (scaling <= 0 || scaling >= (double)(frame_size_ch_ - num_taps_ / 2)) {
+        roc_log(LogError, "polyphase resampler: scaling out of range: scaling=%.5f",
+                scaling);
+        return false;
+    }
+
+    if (input_rate != bank_in_rate_ || output_rate != bank_out_rate_) {
+        if (!build_bank_(input_rate, output_rate)) {
+            return false;
+        }
+    }
+
+    step_ = (uint64_t)(scaling * (double)((uint64_t)1 << FracBits));
+
+    return true;
+}
+
+const core::Slice<sample_t>& PolyphaseResampler::begin_push_input() {
+    roc_panic_if_not(valid());
+
+    return in_frame_;
+}
+
+void PolyphaseResampler::end_push_input() {
+    roc_panic_if_not(valid());
+
+    const uint64_t frame_len = (uint64_t)frame_size_ch_ << FracBits;
+
+    if (hist_size_ == hist_stride_) {
+        roc_panic_if_msg(pos_ < frame_len + ((uint64_t)(num_taps_ / 2) << FracBits),
+                         "polyphase resampler: input pushed before output was popped");
+
+        // Keep tail of previous input, which is still needed by the window.
+        for (size_t ch = 0; ch < num_ch_; ch++) {
+            sample_t* hist = &hist_[ch * hist_stride_];
+            memmove(hist, hist + frame_size_ch_, num_taps_ * sizeof(sample_t));
+        }
+
+        pos_ -= frame_len;
+        hist_size_ = num_taps_;
+    }
+
+    // Deinterleave input into per-channel history, so that dot products run
+    // over contiguous memory.
+    const sample_t* in = in_frame_.data();
+
+    for (size_t ch = 0; ch < num_ch_; ch++) {
+        sample_t* hist = &hist_[ch * hist_stride_ + hist_size_];
+        for (size_t n = 0; n < frame_size_ch_; n++) {
+            hist[n] = in[n * num_ch_ + ch];
+        }
+    }
+
+    hist_size_ += frame_size_ch_;
+}
+
+size_t PolyphaseResampler::pop_output(Frame& out) {
+    roc_panic_if_not(valid());
+
+    roc_panic_if_msg(step_ == 0,
+                     "polyphase resampler: set scaling must be called "
+                     "before any resampling could be done");
+
+    const size_t half_taps = num_taps_ / 2;
+    const float phase_scale = 1.0f / (float)((uint64_t)1 << (FracBits - phase_bits_));
+
+    const sample_t* bank = bank_.data();
+    const sample_t* hist = hist_.data();
+
+    sample_t* out_data = out.samples();
+    size_t out_pos = 0;
+
+    for (; out_pos < out.num_samples(); out_pos += num_ch_) {
+        const size_t ind = (size_t)(pos_ >> FracBits);
+
+        // Window is [ind - half_taps + 1; ind + half_taps].
+        if (ind + half_taps >= hist_size_) {
+            break;
+        }
+
+        const uint64_t frac = pos_ & FracMask;
+        const size_t phase = (size_t)(frac >> (FracBits - phase_bits_));
+        const float phase_frac =
+            (float)(frac & (((uint64_t)1 << (FracBits - phase_bits_)) - 1)) * phase_scale;
+
+        const sample_t* h0 = bank + phase * num_taps_;
+        const sample_t* h1 = h0 + num_taps_;
+
+        const size_t begin = ind + 1 - half_taps;
+
+        for (size_t ch = 0; ch < num_ch_; ch++) {
+            sample_t r0, r1;
+            dot_func_(h0, h1, hist + ch * hist_stride_ + begin, num_taps_, r0, r1);
+
+            out_data[out_pos + ch] = r0 + phase_frac * (r1 - r0);
+        }
+
+        pos_ += step_;
+    }
+
+    return out_pos;
+}
+
+bool PolyphaseResampler::build_bank_(size_t input_rate, size_t output_rate) {
+    // When downsampling, cutoff is lowered to output Nyquist frequency.
+    double cutoff = CutoffFreq;
+    if (output_rate < input_rate) {
+        cutoff *= double(output_rate) / input_rate;
+    }
+
+    const double half_taps = (double)(num_taps_ / 2);
+
+    for (size_t p = 0; p <= num_phases_; p++) {
+        const double phase = double(p) / num_phases_;
+
+        sample_t* h = &bank_[p * num_taps_];
+        double sum = 0;
+
+        for (size_t j = 0; j < num_taps_; j++) {
+            // Distance between input sample and output position.
+            const double d = double(j) - (half_taps - 1) - phase;
+
+            double sinc = 1;
+            if (std::abs(d) > 1e-9) {
+                sinc = std::sin(M_PI * cutoff * d) / (M_PI * cutoff * d);
+            }
+
+            // Blackman window.
+            const double x = d / half_taps;
+            double window = 0;
+            if (std::abs(x) < 1) {
+                window = 0.42 + 0.5 * std::cos(M_PI * x) + 0.08 * std::cos(2 * M_PI * x);
+            }
+
+            const double coeff = sinc * window;
+            h[j] = (sample_t)coeff;
+            sum += coeff;
+        }
+
+        // Normalize to unity gain.
+        if (sum > 0) {
+            for (size_t j = 0; j < num_taps_; j++) {
+                h[j] = (sample_t)((double)h[j] / sum);
+            }
+        }
+    }
+
+    roc_log(LogDebug,
+            "polyphase resampler: built filter bank:"
+            " in_rate=%lu out_rate=%lu cutoff=%.3f",
+            (unsigned long)input_rate, (unsigned long)output_rate, cutoff);
+
+    bank_in_rate_ = input_rate;
+    bank_out_rate_ = output_rate;
+
+    return true;
+}
+
+} // namespace audio
+} // namespace roc
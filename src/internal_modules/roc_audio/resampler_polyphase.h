@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_polyphase.h
+//! @brief Polyphase resampler.
+
+#ifndef ROC_AUDIO_RESAMPLER_POLYPHASE_H_
+#define ROC_AUDIO_RESAMPLER_POLYPHASE_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_profile.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Resamples audio stream using precomputed polyphase filter bank.
+//!
+//! The bank holds windowed sinc filters for a fixed number of phases between
+//! two input samples. Filters are designed for the nominal ratio between input
+//! and output rates, and the bank is rebuilt only when these rates change.
+//!
+//! Small corrections of the ratio, like those made by the latency monitor,
+//! only change the step between output samples. Filters for fractional
+//! positions between two phases are obtained by linear interpolation, so
+//! every output sample costs two SIMD dot products per channel.
+class PolyphaseResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PolyphaseResampler(core::IAllocator& allocator,
+                       core::BufferFactory<sample_t>& buffer_factory,
+                       ResamplerProfile profile,
+                       core::nanoseconds_t frame_length,
+                       const audio::SampleSpec& sample_spec);
+
+    ~PolyphaseResampler();
+
+    //! Check if object is successfully constructed.
+    virtual bool valid() const;
+
+    //! Set new resample factor.
+    //! @remarks
+    //!  Rebuilds filter bank if input or output rate was changed.
+    virtual bool set_scaling(size_t input_rate, size_t output_rate, float multiplier);
+
+    //! Get buffer to be filled with input data.
+    virtual const core::Slice<sample_t>& begin_push_input();
+
+    //! Commit buffer with input data.
+    virtual void end_push_input();
+
+    //! Read samples from input frame and fill output frame.
+    virtual size_t pop_output(Frame& out);
+
+private:
+    bool build_bank_(size_t input_rate, size_t output_rate);
+
+    const size_t num_ch_;
+
+    const size_t frame_size_;
+    const size_t frame_size_ch_;
+
+    // number of taps in every filter, even
+    const size_t num_taps_;
+
+    // number of phases between two input samples, power of two
+    const size_t num_phases_;
+    const size_t phase_bits_;
+
+    // (num_phases_ + 1) filters, num_taps_ coefficients each
+    core::Array<sample_t> bank_;
+
+    size_t bank_in_rate_;
+    size_t bank_out_rate_;
+
+    core::Slice<sample_t> in_frame_;
+
+    // per-channel input history, (num_taps_ + frame_size_ch_) samples per channel
+    core::Array<sample_t> hist_;
+    const size_t hist_stride_;
+    size_t hist_size_;
+
+    // position of next output sample in terms of input samples in history,
+    // 32.32 fixed-point
+    uint64_t pos_;
+
+    // distance between two output samples, 32.32 fixed-point
+    uint64_t step_;
+
+    // computes dot products of input with two adjacent filters
+    void (*dot_func_)(const sample_t* h0,
+                      const sample_t* h1,
+                      const sample_t* x,
+                      size_t n,
+                      sample_t& r0,
+                      sample_t& r1);
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_POLYPHASE_H_
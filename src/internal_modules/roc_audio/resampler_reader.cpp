@@ -20,8 +20,13 @@ ResamplerReader::ResamplerReader(IFrameReader& reader,
     , reader_(reader)
     , in_sample_spec_(in_sample_spec)
     , out_sample_spec_(out_sample_spec)
+    , flags_history_pos_(0)
     , scaling_(1.0f)
     , valid_(false) {
+    for (size_t n = 0; n < FlagsHistory; n++) {
+        flags_history_[n] = 0;
+    }
+
     if (in_sample_spec_.channel_mask() != out_sample_spec_.channel_mask()) {
         roc_panic("resampler reader: input and output channel mask should be equal");
     }
@@ -55,6 +60,7 @@ bool ResamplerReader::read(Frame& out) {
     roc_panic_if_not(valid());
 
     size_t out_pos = 0;
+    unsigned flags = window_flags_();
 
     while (out_pos < out.num_samples()) {
         Frame out_part(out.samples() + out_pos, out.num_samples() - out_pos);
@@ -62,7 +68,7 @@ bool ResamplerReader::read(Frame& out) {
         const size_t num_popped = resampler_.pop_output(out_part);
 
         if (num_popped < out_part.num_samples()) {
-            if (!push_input_()) {
+            if (!push_input_(flags)) {
                 return false;
             }
         }
@@ -70,10 +76,12 @@ bool ResamplerReader::read(Frame& out) {
         out_pos += num_popped;
     }
 
+    out.set_flags(flags);
+
     return true;
 }
 
-bool ResamplerReader::push_input_() {
+bool ResamplerReader::push_input_(unsigned& flags) {
     const core::Slice<sample_t>& buff = resampler_.begin_push_input();
 
     Frame frame(buff.data(), buff.size());
@@ -83,8 +91,25 @@ bool ResamplerReader::push_input_() {
     }
 
     resampler_.end_push_input();
+
+    flags_history_[flags_history_pos_] = frame.flags();
+    flags_history_pos_ = (flags_history_pos_ + 1) % FlagsHistory;
+
+    flags |= frame.flags();
     return true;
 }
 
+unsigned ResamplerReader::window_flags_() const {
+    unsigned flags = 0;
+
+    for (size_t n = 0; n < FlagsHistory; n++) {
+        flags |= flags_history_[n];
+    }
+
+    // Only non-blank flag describes samples that are still in resampler window,
+    // other flags are reported once, for the read that pushed the frame.
+    return flags & Frame::FlagNonblank;
+}
+
 } // namespace audio
 } // namespace roc
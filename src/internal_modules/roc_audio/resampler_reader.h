@@ -27,6 +27,10 @@ namespace roc {
 namespace audio {
 
 //! Resampler element for reading pipeline.
+//!
+//! Output frame flags are combined from input frames. Since resampler may
+//! keep a few input frames in its window, output frame is reported non-blank
+//! while any of recently pushed input frames were non-blank.
 class ResamplerReader : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -45,7 +49,14 @@ public:
     virtual bool read(Frame&);
 
 private:
-    bool push_input_();
+    // Number of recently pushed input frames which flags are kept. Builtin
+    // resampler keeps previous, current, and next input frames in its window,
+    // and other backends keep less, so their samples may appear in output
+    // during at most this number of pushes.
+    enum { FlagsHistory = 3 };
+
+    bool push_input_(unsigned& flags);
+    unsigned window_flags_() const;
 
     IResampler& resampler_;
     IFrameReader& reader_;
@@ -53,6 +64,9 @@ private:
     const audio::SampleSpec in_sample_spec_;
     const audio::SampleSpec out_sample_spec_;
 
+    unsigned flags_history_[FlagsHistory];
+    size_t flags_history_pos_;
+
     float scaling_;
     bool valid_;
 };
@@ -55,6 +55,12 @@
 #define ROC_ATTR_ALIGNED(x) __attribute__((aligned(x)))
 #endif
 
+#if HEDLEY_GCC_HAS_ATTRIBUTE(target, 4, 9, 0)
+//! Compile function for given instruction set extensions, e.g. "avx2".
+//! Such function may be called only if cpu_features() reports the extension.
+#define ROC_ATTR_TARGET(x) __attribute__((target(x)))
+#endif
+
 #if HEDLEY_HAS_ATTRIBUTE(no_sanitize)
 //! Suppress undefined behavior sanitizer for a particular function.
 #define ROC_ATTR_NO_SANITIZE_UB __attribute__((no_sanitize("undefined")))
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/cpu_features.h"
+
+namespace roc {
+namespace core {
+
+unsigned cpu_features() {
+    unsigned features = 0;
+
+#if ROC_CPU_HAS_X86_DISPATCH
+    // Safe to call multiple times; needed if we're called before
+    // static constructors of libgcc were run.
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse2")) {
+        features |= CpuFeature_SSE2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        features |= CpuFeature_SSSE3;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        features |= CpuFeature_AVX2;
+    }
+#endif
+
+#if ROC_CPU_HAS_NEON
+    features |= CpuFeature_NEON;
+#endif
+
+    return features;
+}
+
+const char* cpu_feature_to_str(CpuFeature feature) {
+    switch (feature) {
+    case CpuFeature_SSE2:
+        return "sse2";
+    case CpuFeature_SSSE3:
+        return "ssse3";
+    case CpuFeature_AVX2:
+        return "avx2";
+    case CpuFeature_NEON:
+        return "neon";
+    }
+
+    return "<invalid>";
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/cpu_features.h
+//! @brief CPU features.
+
+#ifndef ROC_CORE_CPU_FEATURES_H_
+#define ROC_CORE_CPU_FEATURES_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/cpu_traits.h"
+
+#if ROC_CPU_FAMILY == ROC_CPU_X86 && defined(ROC_ATTR_TARGET)                          \
+    && HEDLEY_GCC_HAS_BUILTIN(__builtin_cpu_supports, 4, 9, 0)
+//! Defined if x86 SIMD code can be compiled and selected at run time.
+#define ROC_CPU_HAS_X86_DISPATCH 1
+#else
+//! Defined if x86 SIMD code can be compiled and selected at run time.
+#define ROC_CPU_HAS_X86_DISPATCH 0
+#endif
+
+namespace roc {
+namespace core {
+
+//! CPU instruction set extensions.
+enum CpuFeature {
+    //! x86 SSE2.
+    CpuFeature_SSE2 = (1 << 0),
+
+    //! x86 SSSE3.
+    CpuFeature_SSSE3 = (1 << 1),
+
+    //! x86 AVX2.
+    CpuFeature_AVX2 = (1 << 2),
+
+    //! ARM NEON.
+    CpuFeature_NEON = (1 << 3)
+};
+
+//! Get extensions supported by both the CPU we're running on and the build.
+//! @returns
+//!  bitmask of CpuFeature values.
+//! @remarks
+//!  x86 extensions are detected at run time, so that a generic build still
+//!  can use them. NEON is reported only if it was enabled at compile time.
+unsigned cpu_features();
+
+//! Get human-readable name of a single CPU feature.
+const char* cpu_feature_to_str(CpuFeature feature);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_CPU_FEATURES_H_
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/iworker_job.h
+//! @brief Worker job interface.
+
+#ifndef ROC_CORE_IWORKER_JOB_H_
+#define ROC_CORE_IWORKER_JOB_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Worker job interface.
+//! Job consists of independent items, which are processed by WorkerPool.
+class IWorkerJob {
+public:
+    virtual ~IWorkerJob();
+
+    //! Process one item of the job.
+    //! @remarks
+    //!  Called concurrently from multiple threads for different items.
+    //!  Each item is processed exactly once.
+    virtual void run_item(size_t index) = 0;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_IWORKER_JOB_H_
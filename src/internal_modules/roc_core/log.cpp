@@ -7,7 +7,9 @@
  */
 
 #include "roc_core/log.h"
+#include "roc_core/aligned_storage.h"
 #include "roc_core/global_destructor.h"
+#include "roc_core/log_flusher.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/thread.h"
@@ -24,10 +26,13 @@ void backend_handler(const LogMessage& msg, void** args) {
     ((LogBackend*)args[0])->handle(msg);
 }
 
+AlignedStorage<sizeof(LogFlusher)> flusher_storage;
+
 } // namespace
 
 Logger::Logger()
     : level_(LogError)
+    , flusher_(NULL)
     , colors_mode_(ColorsDisabled)
     , location_mode_(LocationDisabled) {
     handler_ = &backend_handler;
@@ -70,9 +75,9 @@ void Logger::set_level(LogLevel level) {
     }
 
     if ((int)level >= LogDebug) {
-        location_mode_ = LocationEnabled;
+        AtomicOps::store_relaxed(location_mode_, LocationEnabled);
     } else {
-        location_mode_ = LocationDisabled;
+        AtomicOps::store_relaxed(location_mode_, LocationDisabled);
     }
 
     AtomicOps::store_relaxed(level_, level);
@@ -81,7 +86,7 @@ void Logger::set_level(LogLevel level) {
 void Logger::set_colors(ColorsMode mode) {
     Mutex::Lock lock(mutex_);
 
-    colors_mode_ = mode;
+    AtomicOps::store_relaxed(colors_mode_, mode);
 }
 
 void Logger::set_handler(LogHandler handler, void** args, size_t n_args) {
@@ -103,25 +108,62 @@ void Logger::set_handler(LogHandler handler, void** args, size_t n_args) {
     }
 }
 
+bool Logger::set_async(bool enabled) {
+    if (!enabled) {
+        if (LogFlusher* flusher = AtomicOps::load_acquire(flusher_)) {
+            flusher->stop();
+        }
+        return true;
+    }
+
+    LogFlusher* flusher = get_flusher_();
+
+    if (!flusher->valid()) {
+        roc_log(LogError, "logger: can't initialize log flusher");
+        return false;
+    }
+
+    if (!flusher->start()) {
+        roc_log(LogError, "logger: can't start log flusher thread");
+        return false;
+    }
+
+    return true;
+}
+
 void Logger::writef(LogLevel level,
                     const char* module,
                     const char* file,
                     int line,
                     const char* format,
                     ...) {
-    Mutex::Lock lock(mutex_);
-
-    if (level > level_ || level == LogNone) {
+    if (level > get_level() || level == LogNone) {
         return;
     }
 
-    // If user installed custom log handler and did not uninstall it until process
-    // exit, it may happen that user's library will deinitialize before our
-    // library (if we're in different shared libraries). If this happened, attempt
-    // to invoke handler at this point may cause crashes. To reduce probability of
-    // this, we stop using user handler as soon as we have detected it.
-    if (handler_ != &backend_handler && GlobalDestructor::is_destroying()) {
-        return;
+    LogMessage msg;
+    msg.level = level;
+    msg.module = module;
+    msg.file = file;
+    msg.line = line;
+    msg.time = timestamp(ClockUnix);
+    msg.pid = Thread::get_pid();
+    msg.tid = Thread::get_tid();
+    msg.location_mode = get_location_mode_();
+    msg.colors_mode = get_colors_mode_();
+
+    LogFlusher* flusher = AtomicOps::load_acquire(flusher_);
+
+    if (flusher) {
+        // don't block, message will be passed to handler from flusher thread
+        va_list args;
+        va_start(args, format);
+        const bool written = flusher->writef(msg, format, args);
+        va_end(args);
+
+        if (written) {
+            return;
+        }
     }
 
     char text[256] = {};
@@ -132,20 +174,54 @@ void Logger::writef(LogLevel level,
     }
     va_end(args);
 
-    LogMessage msg;
-    msg.level = level;
-    msg.module = module;
-    msg.file = file;
-    msg.line = line;
-    msg.time = timestamp(ClockUnix);
-    msg.pid = Thread::get_pid();
-    msg.tid = Thread::get_tid();
     msg.text = text;
-    msg.location_mode = location_mode_;
-    msg.colors_mode = colors_mode_;
+
+    handle_(msg);
+}
+
+LogFlusher* Logger::get_flusher_() {
+    Mutex::Lock lock(mutex_);
+
+    if (!flusher_) {
+        LogFlusher* flusher = new (flusher_storage.memory()) LogFlusher(*this);
+
+        // flush pending messages before exit
+        if (atexit(&Logger::disable_async_at_exit_) != 0) {
+            roc_panic("logger: can't register atexit handler");
+        }
+
+        AtomicOps::store_release(flusher_, flusher);
+    }
+
+    return flusher_;
+}
+
+void Logger::handle_(const LogMessage& msg) {
+    Mutex::Lock lock(mutex_);
+
+    // If user installed custom log handler and did not uninstall it until process
+    // exit, it may happen that user's library will deinitialize before our
+    // library (if we're in different shared libraries). If this happened, attempt
+    // to invoke handler at this point may cause crashes. To reduce probability of
+    // this, we stop using user handler as soon as we have detected it.
+    if (handler_ != &backend_handler && GlobalDestructor::is_destroying()) {
+        return;
+    }
 
     handler_(msg, handler_args_);
 }
 
+LocationMode Logger::get_location_mode_() const {
+    return (LocationMode)AtomicOps::load_relaxed(location_mode_);
+}
+
+ColorsMode Logger::get_colors_mode_() const {
+    return (ColorsMode)AtomicOps::load_relaxed(colors_mode_);
+}
+
+void Logger::disable_async_at_exit_() {
+    Logger::instance().set_async(false);
+}
+
 } // namespace core
 } // namespace roc
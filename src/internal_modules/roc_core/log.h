@@ -97,6 +97,8 @@ struct LogMessage {
 //! Log handler.
 typedef void (*LogHandler)(const LogMessage& message, void** args);
 
+class LogFlusher;
+
 //! Logger.
 class Logger : public NonCopyable<> {
 public:
@@ -144,13 +146,37 @@ public:
     //!  Other threads will see the change immediately.
     void set_handler(LogHandler handler, void** args, size_t n_args);
 
+    //! Enable or disable asynchronous mode.
+    //! @remarks
+    //!  In asynchronous mode, writef() only formats the message into a lock-free
+    //!  ring, and a background thread passes messages to log handler. writef()
+    //!  never blocks, but drops messages if the ring is full or if the calling
+    //!  thread writes messages too often. Number of dropped messages is reported
+    //!  to the log.
+    //!
+    //!  Disabling asynchronous mode flushes pending messages. It is also disabled
+    //!  automatically at process exit.
+    //! @returns
+    //!  false if background thread can't be started.
+    bool set_async(bool enabled);
+
 private:
     friend class Singleton<Logger>;
+    friend class LogFlusher;
 
     enum { MaxArgs = 8 };
 
     Logger();
 
+    LogFlusher* get_flusher_();
+
+    void handle_(const LogMessage& msg);
+
+    LocationMode get_location_mode_() const;
+    ColorsMode get_colors_mode_() const;
+
+    static void disable_async_at_exit_();
+
     int level_;
 
     Mutex mutex_;
@@ -160,8 +186,11 @@ private:
 
     LogBackend backend_;
 
-    ColorsMode colors_mode_;
-    LocationMode location_mode_;
+    // non-NULL if asynchronous mode was ever enabled
+    LogFlusher* flusher_;
+
+    int colors_mode_;
+    int location_mode_;
 };
 
 } // namespace core
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/log_flusher.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// how often every thread may write MaxRecordsPerPeriod records
+const nanoseconds_t RateLimitPeriod = 100 * Millisecond;
+
+// how often background thread checks the ring
+const nanoseconds_t FlushInterval = 5 * Millisecond;
+
+// after how long a thread that doesn't write loses its rate limiting slot
+const nanoseconds_t SlotExpiry = 10 * RateLimitPeriod;
+
+// how often stop() checks for writers in progress
+const nanoseconds_t WriterWaitInterval = 100 * Microsecond;
+
+} // namespace
+
+LogFlusher::LogFlusher(Logger& logger)
+    : logger_(logger)
+    , ring_(RingSize, allocator_)
+    , n_rate_dropped_(0)
+    , n_reported_ring_dropped_(0)
+    , n_reported_rate_dropped_(0)
+    , running_(false)
+    , stop_(false)
+    , n_writers_(0) {
+    for (size_t n = 0; n < MaxThreads; n++) {
+        slots_[n].tid = 0;
+        slots_[n].period_start = 0;
+        slots_[n].n_records = 0;
+    }
+}
+
+bool LogFlusher::valid() const {
+    return ring_.valid();
+}
+
+bool LogFlusher::running() const {
+    return AtomicOps::load_acquire(running_);
+}
+
+bool LogFlusher::start() {
+    Mutex::Lock lock(mutex_);
+
+    roc_panic_if(!valid());
+
+    if (AtomicOps::load_relaxed(running_)) {
+        return true;
+    }
+
+    AtomicOps::store_relaxed(stop_, false);
+
+    thread_.reset(new (allocator_) FlusherThread(*this), allocator_);
+    if (!thread_) {
+        return false;
+    }
+
+    if (!thread_->start()) {
+        thread_.reset();
+        return false;
+    }
+
+    AtomicOps::store_release(running_, true);
+
+    return true;
+}
+
+void LogFlusher::stop() {
+    Mutex::Lock lock(mutex_);
+
+    if (!AtomicOps::load_relaxed(running_)) {
+        return;
+    }
+
+    // new messages will be written synchronously
+    AtomicOps::store_seq_cst(running_, false);
+
+    // writers that found flusher running may still be adding records;
+    // wait for them, so that their records are flushed below
+    while (AtomicOps::load_seq_cst(n_writers_) != 0) {
+        sleep_for(ClockMonotonic, WriterWaitInterval);
+    }
+
+    // thread drains the ring before exiting
+    AtomicOps::store_release(stop_, true);
+
+    thread_->join();
+    thread_.reset();
+}
+
+bool LogFlusher::writef(const LogMessage& msg, const char* format, va_list args) {
+    // writer is counted before checking running flag, so that stop() either
+    // sees the writer and waits for it, or the writer sees that flusher is
+    // stopped and falls back to synchronous mode
+    AtomicOps::fetch_add_seq_cst(n_writers_, 1);
+
+    if (!AtomicOps::load_seq_cst(running_)) {
+        AtomicOps::fetch_sub_release(n_writers_, 1);
+        return false;
+    }
+
+    if (allow_(msg.tid)) {
+        (void)ring_.write(msg, format, args);
+    } else {
+        AtomicOps::fetch_add_relaxed(n_rate_dropped_, 1);
+    }
+
+    AtomicOps::fetch_sub_release(n_writers_, 1);
+    return true;
+}
+
+void LogFlusher::run_() {
+    while (!AtomicOps::load_acquire(stop_)) {
+        flush_();
+        sleep_for(ClockMonotonic, FlushInterval);
+    }
+
+    flush_();
+}
+
+void LogFlusher::flush_() {
+    LogMessage msg;
+    char text[LogRing::MaxTextSize];
+
+    while (ring_.read(msg, text, sizeof(text))) {
+        logger_.handle_(msg);
+    }
+
+    report_dropped_();
+}
+
+void LogFlusher::report_dropped_() {
+    const size_t n_ring_dropped = ring_.num_dropped();
+    const size_t n_rate_dropped = AtomicOps::load_relaxed(n_rate_dropped_);
+
+    if (n_ring_dropped == n_reported_ring_dropped_
+        && n_rate_dropped == n_reported_rate_dropped_) {
+        return;
+    }
+
+    char text[LogRing::MaxTextSize] = {};
+    if (snprintf(text, sizeof(text),
+                 "log flusher: dropped messages: ring_full=%lu rate_limited=%lu",
+                 (unsigned long)(n_ring_dropped - n_reported_ring_dropped_),
+                 (unsigned long)(n_rate_dropped - n_reported_rate_dropped_))
+        < 0) {
+        text[0] = '\0';
+    }
+
+    n_reported_ring_dropped_ = n_ring_dropped;
+    n_reported_rate_dropped_ = n_rate_dropped;
+
+    LogMessage msg;
+    msg.level = LogInfo;
+    msg.module = ROC_STRINGIZE(ROC_MODULE);
+    msg.file = __FILE__;
+    msg.line = __LINE__;
+    msg.time = timestamp(ClockUnix);
+    msg.pid = Thread::get_pid();
+    msg.tid = Thread::get_tid();
+    msg.text = text;
+    msg.location_mode = logger_.get_location_mode_();
+    msg.colors_mode = logger_.get_colors_mode_();
+
+    logger_.handle_(msg);
+}
+
+bool LogFlusher::allow_(uint64_t tid) {
+    ThreadSlot* slot = find_slot_(tid);
+    if (!slot) {
+        // too many threads, don't limit rate
+        return true;
+    }
+
+    // slot is normally accessed only by its owner thread, but it may be
+    // taken over if the owner didn't write for SlotExpiry
+    const nanoseconds_t now = timestamp(ClockMonotonic);
+
+    if (now - AtomicOps::load_relaxed(slot->period_start) >= RateLimitPeriod) {
+        AtomicOps::store_relaxed(slot->period_start, now);
+        AtomicOps::store_relaxed(slot->n_records, 0);
+    }
+
+    const size_t n_records = AtomicOps::load_relaxed(slot->n_records);
+    if (n_records >= MaxRecordsPerPeriod) {
+        return false;
+    }
+
+    AtomicOps::store_relaxed(slot->n_records, n_records + 1);
+    return true;
+}
+
+LogFlusher::ThreadSlot* LogFlusher::find_slot_(uint64_t tid) {
+    if (tid == 0) {
+        return NULL;
+    }
+
+    const size_t start = (size_t)(tid % MaxThreads);
+    const nanoseconds_t now = timestamp(ClockMonotonic);
+
+    ThreadSlot* stale_slot = NULL;
+
+    for (size_t n = 0; n < MaxThreads; n++) {
+        ThreadSlot& slot = slots_[(start + n) % MaxThreads];
+
+        uint64_t slot_tid = AtomicOps::load_acquire(slot.tid);
+
+        if (slot_tid == tid) {
+            return &slot;
+        }
+
+        if (slot_tid == 0) {
+            // try to take free slot
+            if (AtomicOps::compare_exchange_acq_rel(slot.tid, slot_tid, tid)) {
+                AtomicOps::store_relaxed(slot.period_start, now);
+                return &slot;
+            }
+            // slot was taken concurrently, slot_tid was updated
+            if (slot_tid == tid) {
+                return &slot;
+            }
+        }
+
+        if (!stale_slot
+            && now - AtomicOps::load_relaxed(slot.period_start) >= SlotExpiry) {
+            stale_slot = &slot;
+        }
+    }
+
+    if (!stale_slot) {
+        return NULL;
+    }
+
+    // all slots are taken, reuse slot of a thread that didn't write for
+    // a while (e.g. because it has exited)
+    uint64_t stale_tid = AtomicOps::load_acquire(stale_slot->tid);
+
+    if (stale_tid == 0
+        || !AtomicOps::compare_exchange_acq_rel(stale_slot->tid, stale_tid, tid)) {
+        return NULL;
+    }
+
+    AtomicOps::store_relaxed(stale_slot->period_start, now);
+    AtomicOps::store_relaxed(stale_slot->n_records, 0);
+
+    return stale_slot;
+}
+
+LogFlusher::FlusherThread::FlusherThread(LogFlusher& flusher)
+    : flusher_(flusher) {
+}
+
+LogFlusher::FlusherThread::~FlusherThread() {
+}
+
+void LogFlusher::FlusherThread::run() {
+    flusher_.run_();
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/log_flusher.h
+//! @brief Asynchronous log flusher.
+
+#ifndef ROC_CORE_LOG_FLUSHER_H_
+#define ROC_CORE_LOG_FLUSHER_H_
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/log.h"
+#include "roc_core/log_ring.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+//! Asynchronous log flusher.
+//!
+//! @remarks
+//!  Used by Logger in asynchronous mode. Threads that write messages only
+//!  format them into a lock-free ring, and a background thread periodically
+//!  takes records from the ring and passes them to the log handler. This way,
+//!  slow log output never blocks realtime threads.
+//!
+//!  Every thread may write only a limited number of records per period of
+//!  time, so that a single noisy thread can't fill the whole ring.
+//!  Records that don't fit into the ring or exceed the limit are dropped, and
+//!  the flusher reports number of dropped records.
+class LogFlusher : public NonCopyable<> {
+public:
+    //! Initialize.
+    explicit LogFlusher(Logger& logger);
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Check if background thread is running.
+    bool running() const;
+
+    //! Start background thread.
+    //! @remarks
+    //!  Does nothing if the thread is already running.
+    bool start();
+
+    //! Stop background thread.
+    //! @remarks
+    //!  Waits until concurrent writef() calls that found the flusher running
+    //!  are finished, then blocks until the thread is finished and all
+    //!  records are flushed.
+    void stop();
+
+    //! Format message and add it to the ring.
+    //! @remarks
+    //!  Can be called concurrently. Never blocks. If the message exceeds
+    //!  rate limit or doesn't fit into the ring, it's dropped.
+    //! @returns
+    //!  false if the flusher is not running and the message should be
+    //!  written synchronously by caller.
+    bool writef(const LogMessage& msg, const char* format, va_list args);
+
+private:
+    class FlusherThread : public Thread {
+    public:
+        explicit FlusherThread(LogFlusher& flusher);
+        virtual ~FlusherThread();
+
+    private:
+        virtual void run();
+
+        LogFlusher& flusher_;
+    };
+
+    enum { RingSize = 1024 };
+
+    enum { MaxThreads = 64 };
+    enum { MaxRecordsPerPeriod = 200 };
+
+    // per-thread rate limiting state
+    // slot is owned by thread which tid it holds; slot of a thread that
+    // didn't write for a while may be taken over by another thread
+    struct ThreadSlot {
+        uint64_t tid;
+        nanoseconds_t period_start;
+        size_t n_records;
+    };
+
+    void run_();
+    void flush_();
+    void report_dropped_();
+
+    bool allow_(uint64_t tid);
+    ThreadSlot* find_slot_(uint64_t tid);
+
+    Logger& logger_;
+
+    HeapAllocator allocator_;
+    LogRing ring_;
+
+    ThreadSlot slots_[MaxThreads];
+    size_t n_rate_dropped_;
+
+    size_t n_reported_ring_dropped_;
+    size_t n_reported_rate_dropped_;
+
+    ScopedPtr<FlusherThread> thread_;
+
+    int running_;
+    int stop_;
+
+    // number of writef() calls in progress
+    int n_writers_;
+
+    Mutex mutex_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_LOG_FLUSHER_H_
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/log_ring.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+LogRing::LogRing(size_t capacity, IAllocator& allocator)
+    : cells_(allocator)
+    , mask_(0)
+    , tail_(0)
+    , n_dropped_(0)
+    , head_(0) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    if (!cells_.resize(size)) {
+        return;
+    }
+
+    for (size_t n = 0; n < size; n++) {
+        cells_[n].seq = n;
+        cells_[n].text[0] = '\0';
+    }
+
+    mask_ = size - 1;
+}
+
+bool LogRing::valid() const {
+    return cells_.size() != 0;
+}
+
+size_t LogRing::capacity() const {
+    return cells_.size();
+}
+
+size_t LogRing::num_dropped() const {
+    return AtomicOps::load_relaxed(n_dropped_);
+}
+
+bool LogRing::write(const LogMessage& msg, const char* format, va_list args) {
+    roc_panic_if(!valid());
+
+    size_t pos = AtomicOps::load_relaxed(tail_);
+    Cell* cell = NULL;
+
+    for (;;) {
+        cell = &cells_[pos & mask_];
+
+        const size_t seq = AtomicOps::load_acquire(cell->seq);
+        const ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+
+        if (diff == 0) {
+            // cell is free, try to take position
+            if (AtomicOps::compare_exchange_relaxed(tail_, pos, pos + 1)) {
+                break;
+            }
+            // pos was updated by compare_exchange
+        } else if (diff < 0) {
+            // cell still holds record written one lap ago
+            AtomicOps::fetch_add_relaxed(n_dropped_, 1);
+            return false;
+        } else {
+            // another producer has taken this position
+            pos = AtomicOps::load_relaxed(tail_);
+        }
+    }
+
+    cell->msg = msg;
+    cell->msg.text = NULL;
+
+    if (vsnprintf(cell->text, sizeof(cell->text), format, args) < 0) {
+        cell->text[0] = '\0';
+    }
+
+    AtomicOps::store_release(cell->seq, pos + 1);
+
+    return true;
+}
+
+bool LogRing::read(LogMessage& msg, char* text, size_t text_size) {
+    roc_panic_if(!valid());
+    roc_panic_if(!text || text_size == 0);
+
+    Cell& cell = cells_[head_ & mask_];
+
+    const size_t seq = AtomicOps::load_acquire(cell.seq);
+    if (seq != head_ + 1) {
+        return false;
+    }
+
+    msg = cell.msg;
+
+    strncpy(text, cell.text, text_size - 1);
+    text[text_size - 1] = '\0';
+    msg.text = text;
+
+    // make cell free for producers on the next lap
+    AtomicOps::store_release(cell.seq, head_ + mask_ + 1);
+    head_++;
+
+    return true;
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/log_ring.h
+//! @brief Lock-free ring of formatted log records.
+
+#ifndef ROC_CORE_LOG_RING_H_
+#define ROC_CORE_LOG_RING_H_
+
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/log.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Lock-free bounded multi-producer single-consumer ring of log records.
+//!
+//! Unlike MpscRing, stores records by value in preallocated cells, so writing
+//! a record does not allocate memory. The message is formatted by producer
+//! directly into the cell, and then the cell is published to consumer.
+//!
+//! When the ring is full, the record is dropped and counted, so that producers
+//! never block.
+//!
+//! Uses the same algorithm as MpscRing.
+class LogRing : public NonCopyable<> {
+public:
+    //! Maximum length of message text, including terminating zero.
+    enum { MaxTextSize = 256 };
+
+    //! Initialize.
+    //! @remarks
+    //!  Capacity is rounded up to a power of two, and is at least two.
+    LogRing(size_t capacity, IAllocator& allocator);
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Get ring capacity.
+    size_t capacity() const;
+
+    //! Get number of records dropped because the ring was full.
+    size_t num_dropped() const;
+
+    //! Format message and add it to the end of the ring.
+    //! Can be called concurrently.
+    //! @remarks
+    //!  Copies all fields of @p msg except text, which is formatted from
+    //!  @p format and @p args.
+    //! @returns
+    //!  false if the ring is full and the message was dropped.
+    //! @note
+    //!  This operation is lock-free.
+    bool write(const LogMessage& msg, const char* format, va_list args);
+
+    //! Remove record from the beginning of the ring.
+    //! Should NOT be called concurrently.
+    //! @remarks
+    //!  Fills @p msg and copies message text into @p text of @p text_size bytes.
+    //!  @p msg.text is set to @p text.
+    //! @returns
+    //!  false if the ring is empty, or if the first record is still being
+    //!  written by concurrent write().
+    bool read(LogMessage& msg, char* text, size_t text_size);
+
+private:
+    struct Cell {
+        size_t seq;
+        LogMessage msg;
+        char text[MaxTextSize];
+    };
+
+    enum { CacheLineSize = 64 };
+
+    Array<Cell> cells_;
+    size_t mask_;
+
+    // producers and consumer don't share cache lines
+    ROC_ATTR_UNUSED char pad1_[CacheLineSize];
+    size_t tail_;
+    size_t n_dropped_;
+
+    ROC_ATTR_UNUSED char pad2_[CacheLineSize];
+    size_t head_;
+
+    ROC_ATTR_UNUSED char pad3_[CacheLineSize];
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_LOG_RING_H_
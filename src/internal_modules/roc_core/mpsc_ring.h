@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/mpsc_ring.h
+//! @brief Bounded multi-producer single-consumer ring.
+
+#ifndef ROC_CORE_MPSC_RING_H_
+#define ROC_CORE_MPSC_RING_H_
+
+#include "roc_core/array.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/ownership_policy.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Thread-safe lock-free bounded multi-producer single-consumer ring of pointers.
+//!
+//! Unlike MpscQueue, stores pointers in a preallocated array instead of linking
+//! objects, so it has fixed capacity and does not touch objects when they are
+//! moved through the ring. When the ring is full, push_back() fails and the
+//! caller decides what to do with the object.
+//!
+//! Producer and consumer positions are placed on separate cache lines.
+//!
+//! Based on Dmitry Vyukov bounded MPMC queue algorithm:
+//!  - https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//!
+//! @tparam T defines object type.
+//!
+//! @tparam OwnershipPolicy defines ownership policy which is used to acquire an
+//! element ownership when it's added to the ring and release ownership when it's
+//! removed from the ring.
+template <class T, template <class TT> class OwnershipPolicy = RefCountedOwnership>
+class MpscRing : public NonCopyable<> {
+public:
+    //! Pointer type.
+    //! @remarks
+    //!  either raw or smart pointer depending on the ownership policy.
+    typedef typename OwnershipPolicy<T>::Pointer Pointer;
+
+    //! Initialize.
+    //! @remarks
+    //!  Capacity is rounded up to a power of two, and is at least two, because
+    //!  with a single cell, published and free sequence numbers would coincide.
+    MpscRing(size_t capacity, IAllocator& allocator)
+        : cells_(allocator)
+        , mask_(0)
+        , tail_(0)
+        , head_(0) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        if (!cells_.resize(size)) {
+            return;
+        }
+
+        for (size_t n = 0; n < size; n++) {
+            cells_[n].seq = n;
+            cells_[n].obj = NULL;
+        }
+
+        mask_ = size - 1;
+    }
+
+    ~MpscRing() {
+        // release ownership of all objects
+        while (try_pop_front_exclusive()) {
+        }
+    }
+
+    //! Check if the object was successfully constructed.
+    bool valid() const {
+        return cells_.size() != 0;
+    }
+
+    //! Get ring capacity.
+    size_t capacity() const {
+        return cells_.size();
+    }
+
+    //! Try to add object to the end of the ring.
+    //! Can be called concurrently.
+    //! Acquires ownership of @p obj if succeeded.
+    //! @returns
+    //!  false if the ring is full.
+    //! @note
+    //!  This operation is lock-free, but not wait-free: it retries if another
+    //!  push_back() has taken the same position concurrently.
+    bool push_back(T& obj) {
+        roc_panic_if(!valid());
+
+        size_t pos = AtomicOps::load_relaxed(tail_);
+        Cell* cell = NULL;
+
+        for (;;) {
+            cell = &cells_[pos & mask_];
+
+            const size_t seq = AtomicOps::load_acquire(cell->seq);
+            const ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+
+            if (diff == 0) {
+                // cell is free, try to take position
+                if (AtomicOps::compare_exchange_relaxed(tail_, pos, pos + 1)) {
+                    break;
+                }
+                // pos was updated by compare_exchange
+            } else if (diff < 0) {
+                // cell still holds object pushed one lap ago
+                return false;
+            } else {
+                // another producer has taken this position
+                pos = AtomicOps::load_relaxed(tail_);
+            }
+        }
+
+        OwnershipPolicy<T>::acquire(obj);
+
+        cell->obj = &obj;
+        AtomicOps::store_release(cell->seq, pos + 1);
+
+        return true;
+    }
+
+    //! Try to add up to @p n_objs objects to the end of the ring.
+    //! Can be called concurrently.
+    //! Acquires ownership of added objects.
+    //! @returns
+    //!  number of objects added, which are always the first objects of @p objs;
+    //!  less than @p n_objs if the ring became full.
+    //! @remarks
+    //!  Takes all positions with a single atomic operation, so objects from one
+    //!  batch are not interleaved with objects from other producers.
+    size_t push_back_batch(const Pointer* objs, size_t n_objs) {
+        roc_panic_if(!valid());
+
+        size_t pos = AtomicOps::load_relaxed(tail_);
+        size_t n_free = 0;
+
+        for (;;) {
+            // count free cells following pos
+            n_free = 0;
+            bool taken = false;
+
+            while (n_free < n_objs) {
+                const size_t seq =
+                    AtomicOps::load_acquire(cells_[(pos + n_free) & mask_].seq);
+                const ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + n_free);
+
+                if (diff != 0) {
+                    // either ring is full, or another producer has taken
+                    // this position
+                    taken = diff > 0;
+                    break;
+                }
+
+                n_free++;
+            }
+
+            if (n_free == 0) {
+                if (!taken) {
+                    return 0;
+                }
+                pos = AtomicOps::load_relaxed(tail_);
+                continue;
+            }
+
+            // cells can't be taken by others until tail moves past them
+            if (AtomicOps::compare_exchange_relaxed(tail_, pos, pos + n_free)) {
+                break;
+            }
+            // pos was updated by compare_exchange
+        }
+
+        for (size_t n = 0; n < n_free; n++) {
+            Cell& cell = cells_[(pos + n) & mask_];
+            T& obj = *objs[n];
+
+            OwnershipPolicy<T>::acquire(obj);
+
+            cell.obj = &obj;
+            AtomicOps::store_release(cell.seq, pos + n + 1);
+        }
+
+        return n_free;
+    }
+
+    //! Try to remove object from the beginning of the ring.
+    //! Should NOT be called concurrently.
+    //! Releases ownership of the returned object.
+    //! @remarks
+    //!  Returns NULL if the ring is empty, or if the first object is still
+    //!  being added by concurrent push_back().
+    Pointer try_pop_front_exclusive() {
+        T* obj = pop_();
+        if (!obj) {
+            return NULL;
+        }
+
+        Pointer ptr = obj;
+        OwnershipPolicy<T>::release(*obj);
+
+        return ptr;
+    }
+
+    //! Remove up to @p max_objs objects from the beginning of the ring.
+    //! Should NOT be called concurrently.
+    //! Releases ownership of the returned objects.
+    //! @returns
+    //!  number of objects written to @p objs.
+    size_t pop_front_batch_exclusive(Pointer* objs, size_t max_objs) {
+        size_t n_objs = 0;
+
+        while (n_objs < max_objs) {
+            T* obj = pop_();
+            if (!obj) {
+                break;
+            }
+
+            objs[n_objs++] = obj;
+            OwnershipPolicy<T>::release(*obj);
+        }
+
+        return n_objs;
+    }
+
+private:
+    enum { CacheLineSize = 64 };
+
+    struct Cell {
+        size_t seq;
+        T* obj;
+    };
+
+    T* pop_() {
+        if (!valid()) {
+            return NULL;
+        }
+
+        Cell& cell = cells_[head_ & mask_];
+
+        const size_t seq = AtomicOps::load_acquire(cell.seq);
+        if (seq != head_ + 1) {
+            return NULL;
+        }
+
+        T* obj = cell.obj;
+        cell.obj = NULL;
+
+        // make cell free for producers on the next lap
+        AtomicOps::store_release(cell.seq, head_ + mask_ + 1);
+        head_++;
+
+        return obj;
+    }
+
+    Array<Cell> cells_;
+    size_t mask_;
+
+    // producers and consumer don't share cache lines
+    ROC_ATTR_UNUSED char pad1_[CacheLineSize];
+    size_t tail_;
+
+    ROC_ATTR_UNUSED char pad2_[CacheLineSize];
+    size_t head_;
+
+    ROC_ATTR_UNUSED char pad3_[CacheLineSize];
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_MPSC_RING_H_
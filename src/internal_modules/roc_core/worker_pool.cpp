@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/worker_pool.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+WorkerPool::WorkerPool(size_t num_threads, IAllocator& allocator)
+    : num_threads_(0)
+    , job_(NULL)
+    , n_items_(0)
+    , next_item_(0)
+    , stop_(0)
+    , valid_(false) {
+    roc_log(LogDebug, "worker pool: initializing: num_threads=%lu",
+            (unsigned long)num_threads);
+
+    if (num_threads == 0 || num_threads > MaxThreads) {
+        roc_log(LogError,
+                "worker pool: number of threads should be in range [1; %lu], got %lu",
+                (unsigned long)MaxThreads, (unsigned long)num_threads);
+        return;
+    }
+
+    for (; num_threads_ < num_threads; num_threads_++) {
+        ScopedPtr<Worker>& worker = workers_[num_threads_];
+
+        worker.reset(new (allocator) Worker(*this), allocator);
+        if (!worker) {
+            roc_log(LogError, "worker pool: can't allocate thread");
+            return;
+        }
+
+        if (!worker->start()) {
+            roc_log(LogError, "worker pool: can't start thread");
+            worker.reset();
+            return;
+        }
+    }
+
+    valid_ = true;
+}
+
+WorkerPool::~WorkerPool() {
+    stop_ = 1;
+
+    for (size_t n = 0; n < num_threads_; n++) {
+        workers_[n]->wake();
+    }
+
+    for (size_t n = 0; n < num_threads_; n++) {
+        workers_[n]->join();
+    }
+}
+
+bool WorkerPool::valid() const {
+    return valid_;
+}
+
+size_t WorkerPool::num_threads() const {
+    return num_threads_;
+}
+
+void WorkerPool::run(IWorkerJob& job, size_t n_items) {
+    roc_panic_if(!valid_);
+
+    if (n_items == 0) {
+        return;
+    }
+
+    job_ = &job;
+    n_items_ = n_items;
+    next_item_ = 0;
+
+    // Calling thread takes one item itself, so don't wake more threads than
+    // there are remaining items.
+    size_t n_woken = n_items - 1;
+    if (n_woken > num_threads_) {
+        n_woken = num_threads_;
+    }
+
+    for (size_t n = 0; n < n_woken; n++) {
+        workers_[n]->wake();
+    }
+
+    process_items_();
+
+    for (size_t n = 0; n < n_woken; n++) {
+        done_sem_.wait();
+    }
+
+    job_ = NULL;
+    n_items_ = 0;
+}
+
+void WorkerPool::process_items_() {
+    for (;;) {
+        const size_t index = (size_t)next_item_++;
+        if (index >= n_items_) {
+            break;
+        }
+        job_->run_item(index);
+    }
+}
+
+WorkerPool::Worker::Worker(WorkerPool& pool)
+    : pool_(pool) {
+}
+
+WorkerPool::Worker::~Worker() {
+}
+
+void WorkerPool::Worker::wake() {
+    wake_sem_.post();
+}
+
+void WorkerPool::Worker::run() {
+    for (;;) {
+        wake_sem_.wait();
+
+        if (pool_.stop_) {
+            break;
+        }
+
+        pool_.process_items_();
+        pool_.done_sem_.post();
+    }
+}
+
+} // namespace core
+} // namespace roc
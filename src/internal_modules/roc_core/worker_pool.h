@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/worker_pool.h
+//! @brief Pool of worker threads.
+
+#ifndef ROC_CORE_WORKER_POOL_H_
+#define ROC_CORE_WORKER_POOL_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/iworker_job.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+//! Pool of worker threads.
+//!
+//! Runs items of a job in parallel and waits until all of them are done
+//! (fork-join). The calling thread processes items too, so a pool with N
+//! threads uses up to N+1 cores.
+//!
+//! Items are distributed dynamically: every thread takes next unprocessed
+//! item until there are no more items, so threads don't wait for each other
+//! when items take different time.
+//!
+//! run() should not be called concurrently.
+class WorkerPool : public NonCopyable<> {
+public:
+    //! Maximum number of worker threads.
+    static const size_t MaxThreads = 32;
+
+    //! Initialize and start threads.
+    WorkerPool(size_t num_threads, IAllocator& allocator);
+
+    //! Stop and join threads.
+    ~WorkerPool();
+
+    //! Check if pool was successfully constructed.
+    bool valid() const;
+
+    //! Get number of worker threads.
+    size_t num_threads() const;
+
+    //! Run job.
+    //! @remarks
+    //!  Invokes job.run_item() for every index in [0; n_items) using worker
+    //!  threads and calling thread. Blocks until all items are processed.
+    void run(IWorkerJob& job, size_t n_items);
+
+private:
+    class Worker : public Thread {
+    public:
+        explicit Worker(WorkerPool& pool);
+        virtual ~Worker();
+
+        void wake();
+
+    private:
+        virtual void run();
+
+        WorkerPool& pool_;
+        Semaphore wake_sem_;
+    };
+
+    void process_items_();
+
+    ScopedPtr<Worker> workers_[MaxThreads];
+    size_t num_threads_;
+
+    IWorkerJob* job_;
+    size_t n_items_;
+    Atomic<long> next_item_;
+
+    Semaphore done_sem_;
+    Atomic<int> stop_;
+
+    bool valid_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_WORKER_POOL_H_
@@ -19,7 +19,7 @@ core::SharedPtr<BasicControlEndpoint>
 ControlInterfaceMap::new_endpoint(address::Interface iface,
                                   address::Protocol proto,
                                   ControlTaskQueue& task_queue,
-                                  netio::NetworkLoop& network_loop,
+                                  netio::NetworkLoopPool& network_loops,
                                   core::IAllocator& allocator) {
     switch (iface) {
     case address::Iface_AudioControl:
@@ -29,7 +29,7 @@ ControlInterfaceMap::new_endpoint(address::Interface iface,
         }
 
         (void)task_queue;
-        (void)network_loop;
+        (void)network_loops;
         (void)allocator;
 
         roc_log(LogError,
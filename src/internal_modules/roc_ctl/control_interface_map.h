@@ -19,7 +19,7 @@
 #include "roc_core/singleton.h"
 #include "roc_ctl/basic_control_endpoint.h"
 #include "roc_ctl/control_task_queue.h"
-#include "roc_netio/network_loop.h"
+#include "roc_netio/network_loop_pool.h"
 
 namespace roc {
 namespace ctl {
@@ -33,11 +33,14 @@ public:
     }
 
     //! Create control endpoint for given interface and protocol.
-    core::SharedPtr<BasicControlEndpoint> new_endpoint(address::Interface iface,
-                                                       address::Protocol proto,
-                                                       ControlTaskQueue& task_queue,
-                                                       netio::NetworkLoop& network_loop,
-                                                       core::IAllocator& allocator);
+    //! @remarks
+    //!  Endpoint should use NetworkLoopPool::select_loop() to place its ports.
+    core::SharedPtr<BasicControlEndpoint>
+    new_endpoint(address::Interface iface,
+                 address::Protocol proto,
+                 ControlTaskQueue& task_queue,
+                 netio::NetworkLoopPool& network_loops,
+                 core::IAllocator& allocator);
 
 private:
     friend class core::Singleton<ControlInterfaceMap>;
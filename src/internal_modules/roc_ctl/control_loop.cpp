@@ -90,8 +90,9 @@ ControlLoop::Tasks::PipelineProcessing::PipelineProcessing(
     , pipeline_(pipeline) {
 }
 
-ControlLoop::ControlLoop(netio::NetworkLoop& network_loop, core::IAllocator& allocator)
-    : network_loop_(network_loop)
+ControlLoop::ControlLoop(netio::NetworkLoopPool& network_loops,
+                         core::IAllocator& allocator)
+    : network_loops_(network_loops)
     , allocator_(allocator) {
 }
 
@@ -134,7 +135,7 @@ ControlTaskResult ControlLoop::task_create_endpoint_(ControlTask& control_task)
 
     core::SharedPtr<BasicControlEndpoint> endpoint =
         ControlInterfaceMap::instance().new_endpoint(
-            task.iface_, task.proto_, task_queue_, network_loop_, allocator_);
+            task.iface_, task.proto_, task_queue_, network_loops_, allocator_);
 
     if (!endpoint) {
         roc_log(LogError, "control loop: can't add endpoint: failed to create");
@@ -20,7 +20,7 @@
 #include "roc_ctl/basic_control_endpoint.h"
 #include "roc_ctl/control_task_executor.h"
 #include "roc_ctl/control_task_queue.h"
-#include "roc_netio/network_loop.h"
+#include "roc_netio/network_loop_pool.h"
 #include "roc_pipeline/pipeline_loop.h"
 
 namespace roc {
@@ -173,7 +173,9 @@ public:
     };
 
     //! Initialize.
-    ControlLoop(netio::NetworkLoop& network_loop, core::IAllocator& allocator);
+    //! @remarks
+    //!  Control endpoints select network loops for their ports from @p network_loops.
+    ControlLoop(netio::NetworkLoopPool& network_loops, core::IAllocator& allocator);
 
     virtual ~ControlLoop();
 
@@ -218,7 +220,7 @@ private:
     ControlTaskResult task_detach_source_(ControlTask&);
     ControlTaskResult task_pipeline_processing_(ControlTask&);
 
-    netio::NetworkLoop& network_loop_;
+    netio::NetworkLoopPool& network_loops_;
     core::IAllocator& allocator_;
 
     ControlTaskQueue task_queue_;
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/block_tuner.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+float clamp_ratio(float value, float min_value, float max_value) {
+    if (value < min_value) {
+        return min_value;
+    }
+    if (value > max_value) {
+        return max_value;
+    }
+    return value;
+}
+
+size_t repair_length(size_t sblen, float repair_ratio) {
+    // small epsilon prevents rounding up because of float imprecision
+    return (size_t)ceil(double(sblen) * double(repair_ratio) - 1e-6);
+}
+
+} // namespace
+
+BlockTuner::BlockTuner(const BlockTunerConfig& config,
+                       const WriterConfig& writer_config,
+                       size_t max_block_length,
+                       core::nanoseconds_t packet_length)
+    : config_(config)
+    , max_block_length_(max_block_length)
+    , packet_length_(packet_length)
+    , base_sblen_(writer_config.n_source_packets)
+    , loss_(0)
+    , repair_ratio_(0)
+    , rtt_(0)
+    , sblen_(writer_config.n_source_packets)
+    , rblen_(writer_config.n_repair_packets)
+    , valid_(false) {
+    if (packet_length_ <= 0) {
+        roc_log(LogError, "fec tuner: invalid packet length: packet_length=%ld",
+                (long)packet_length_);
+        return;
+    }
+
+    if (config_.min_block_duration <= 0
+        || config_.min_block_duration > config_.max_block_duration) {
+        roc_log(LogError,
+                "fec tuner: invalid block duration range: min=%ld max=%ld",
+                (long)config_.min_block_duration, (long)config_.max_block_duration);
+        return;
+    }
+
+    if (config_.min_repair_ratio < 0
+        || config_.min_repair_ratio > config_.max_repair_ratio) {
+        roc_log(LogError, "fec tuner: invalid repair ratio range: min=%f max=%f",
+                (double)config_.min_repair_ratio, (double)config_.max_repair_ratio);
+        return;
+    }
+
+    if (config_.loss_decay <= 0 || config_.loss_decay > 1) {
+        roc_log(LogError, "fec tuner: invalid loss decay: loss_decay=%f",
+                (double)config_.loss_decay);
+        return;
+    }
+
+    if (sblen_ == 0 || sblen_ + rblen_ > max_block_length_) {
+        roc_log(LogError,
+                "fec tuner: invalid initial block size: sblen=%lu rblen=%lu max_blen=%lu",
+                (unsigned long)sblen_, (unsigned long)rblen_,
+                (unsigned long)max_block_length_);
+        return;
+    }
+
+    repair_ratio_ = float(rblen_) / float(sblen_);
+
+    valid_ = true;
+}
+
+bool BlockTuner::valid() const {
+    return valid_;
+}
+
+void BlockTuner::update_loss(float fract_loss) {
+    roc_panic_if(!valid_);
+
+    fract_loss = clamp_ratio(fract_loss, 0.0f, 1.0f);
+
+    // react to growing loss immediately and to decreasing loss slowly, so that
+    // a single clean report doesn't remove protection from a lossy link
+    if (fract_loss > loss_) {
+        loss_ = fract_loss;
+    } else {
+        loss_ += (fract_loss - loss_) * config_.loss_decay;
+    }
+
+    repair_ratio_ = clamp_ratio(loss_ * config_.loss_margin, config_.min_repair_ratio,
+                                config_.max_repair_ratio);
+
+    update_sizes_();
+}
+
+void BlockTuner::update_rtt(core::nanoseconds_t rtt) {
+    roc_panic_if(!valid_);
+
+    if (rtt <= 0) {
+        return;
+    }
+
+    rtt_ = rtt;
+
+    update_sizes_();
+}
+
+size_t BlockTuner::n_source_packets() const {
+    return sblen_;
+}
+
+size_t BlockTuner::n_repair_packets() const {
+    return rblen_;
+}
+
+void BlockTuner::update_sizes_() {
+    size_t sblen = base_sblen_;
+
+    if (rtt_ > 0) {
+        core::nanoseconds_t duration = rtt_ / 2;
+        if (duration < config_.min_block_duration) {
+            duration = config_.min_block_duration;
+        }
+        if (duration > config_.max_block_duration) {
+            duration = config_.max_block_duration;
+        }
+
+        sblen = (size_t)(duration / packet_length_);
+        if (sblen == 0) {
+            sblen = 1;
+        }
+    }
+
+    size_t rblen = repair_length(sblen, repair_ratio_);
+
+    if (sblen + rblen > max_block_length_) {
+        // keep repair ratio and shrink block
+        sblen = (size_t)(double(max_block_length_) / (1.0 + double(repair_ratio_)));
+        if (sblen == 0) {
+            sblen = 1;
+        }
+
+        rblen = repair_length(sblen, repair_ratio_);
+        if (sblen + rblen > max_block_length_) {
+            rblen = max_block_length_ - sblen;
+        }
+    }
+
+    if (sblen == sblen_ && rblen == rblen_) {
+        return;
+    }
+
+    roc_log(LogDebug,
+            "fec tuner: update block size:"
+            " loss=%.3f rtt=%.3fms cur_sbl=%lu cur_rbl=%lu new_sbl=%lu new_rbl=%lu",
+            (double)loss_, (double)rtt_ / core::Millisecond, (unsigned long)sblen_,
+            (unsigned long)rblen_, (unsigned long)sblen, (unsigned long)rblen);
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+}
+
+} // namespace fec
+} // namespace roc
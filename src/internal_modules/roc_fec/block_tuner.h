@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/block_tuner.h
+//! @brief FEC block size tuner.
+
+#ifndef ROC_FEC_BLOCK_TUNER_H_
+#define ROC_FEC_BLOCK_TUNER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_fec/writer.h"
+
+namespace roc {
+namespace fec {
+
+//! FEC block size tuner parameters.
+struct BlockTunerConfig {
+    //! Minimum duration of source packets in block, nanoseconds.
+    core::nanoseconds_t min_block_duration;
+
+    //! Maximum duration of source packets in block, nanoseconds.
+    core::nanoseconds_t max_block_duration;
+
+    //! Minimum ratio of repair packets to source packets.
+    float min_repair_ratio;
+
+    //! Maximum ratio of repair packets to source packets.
+    float max_repair_ratio;
+
+    //! How many repair packets to send per each expected lost packet.
+    float loss_margin;
+
+    //! How fast loss estimate goes down, in range (0; 1].
+    //! @remarks
+    //!  When reported loss grows, estimate is updated immediately. When it
+    //!  goes down, estimate moves towards it by this fraction per report.
+    float loss_decay;
+
+    BlockTunerConfig()
+        : min_block_duration(20 * core::Millisecond)
+        , max_block_duration(200 * core::Millisecond)
+        , min_repair_ratio(0.1f)
+        , max_repair_ratio(1.0f)
+        , loss_margin(2.0f)
+        , loss_decay(0.25f) {
+    }
+};
+
+//! FEC block size tuner.
+//!
+//! Computes number of source and repair packets per block from the
+//! loss and RTT reported by receivers:
+//!  - number of repair packets is proportional to estimated loss, so that
+//!    repair overhead is small on clean links and grows on lossy ones;
+//!  - duration of the block follows half of RTT, so that delay added by
+//!    FEC stays small compared to network delay.
+//!
+//! Until loss or RTT is reported, corresponding values from WriterConfig
+//! are used.
+class BlockTuner : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config defines tuning parameters
+    //!  - @p writer_config defines initial block size
+    //!  - @p max_block_length defines maximum supported block length
+    //!  - @p packet_length defines duration of one source packet
+    BlockTuner(const BlockTunerConfig& config,
+               const WriterConfig& writer_config,
+               size_t max_block_length,
+               core::nanoseconds_t packet_length);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Handle fraction of lost packets reported by receiver.
+    void update_loss(float fract_loss);
+
+    //! Handle estimated round-trip time.
+    void update_rtt(core::nanoseconds_t rtt);
+
+    //! Get number of source packets per block.
+    size_t n_source_packets() const;
+
+    //! Get number of repair packets per block.
+    size_t n_repair_packets() const;
+
+private:
+    void update_sizes_();
+
+    const BlockTunerConfig config_;
+
+    const size_t max_block_length_;
+    const core::nanoseconds_t packet_length_;
+    const size_t base_sblen_;
+
+    float loss_;
+    float repair_ratio_;
+    core::nanoseconds_t rtt_;
+
+    size_t sblen_;
+    size_t rblen_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_BLOCK_TUNER_H_
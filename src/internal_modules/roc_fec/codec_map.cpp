@@ -11,6 +11,8 @@
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
 #include "roc_packet/fec_scheme_to_str.h"
 
 #ifdef ROC_TARGET_OPENFEC
@@ -38,10 +40,12 @@ ROC_ATTR_UNUSED I* ctor_func(const CodecConfig& config,
 } // namespace
 
 CodecMap::CodecMap()
-    : n_codecs_(0) {
+    : n_codecs_(0)
+    , n_schemes_(0) {
 #ifdef ROC_TARGET_OPENFEC
     {
         Codec codec;
+        codec.backend = CodecBackend_OpenFEC;
         codec.encoder_ctor = ctor_func<IBlockEncoder, OpenfecEncoder>;
         codec.decoder_ctor = ctor_func<IBlockDecoder, OpenfecDecoder>;
 
@@ -52,25 +56,34 @@ CodecMap::CodecMap()
         add_codec_(codec);
     }
 #endif // ROC_TARGET_OPENFEC
+    {
+        Codec codec;
+        codec.backend = CodecBackend_Builtin;
+        codec.encoder_ctor = ctor_func<IBlockEncoder, Rs8mEncoder>;
+        codec.decoder_ctor = ctor_func<IBlockDecoder, Rs8mDecoder>;
+
+        codec.scheme = packet::FEC_ReedSolomon_M8;
+        add_codec_(codec);
+    }
 }
 
-bool CodecMap::is_supported(packet::FecScheme scheme) const {
-    return find_codec_(scheme);
+bool CodecMap::is_supported(packet::FecScheme scheme, CodecBackend backend) const {
+    return find_codec_(scheme, backend);
 }
 
 size_t CodecMap::num_schemes() const {
-    return n_codecs_;
+    return n_schemes_;
 }
 
 packet::FecScheme CodecMap::nth_scheme(size_t n) const {
-    roc_panic_if(n >= n_codecs_);
-    return codecs_[n].scheme;
+    roc_panic_if(n >= n_schemes_);
+    return schemes_[n];
 }
 
 IBlockEncoder* CodecMap::new_encoder(const CodecConfig& config,
                                      core::BufferFactory<uint8_t>& buffer_factory,
                                      core::IAllocator& allocator) const {
-    const Codec* codec = find_codec_(config.scheme);
+    const Codec* codec = find_codec_(config.scheme, config.backend);
     if (!codec) {
         return NULL;
     }
@@ -80,7 +93,7 @@ IBlockEncoder* CodecMap::new_encoder(const CodecConfig& config,
 IBlockDecoder* CodecMap::new_decoder(const CodecConfig& config,
                                      core::BufferFactory<uint8_t>& buffer_factory,
                                      core::IAllocator& allocator) const {
-    const Codec* codec = find_codec_(config.scheme);
+    const Codec* codec = find_codec_(config.scheme, config.backend);
     if (!codec) {
         return NULL;
     }
@@ -90,17 +103,29 @@ IBlockDecoder* CodecMap::new_decoder(const CodecConfig& config,
 void CodecMap::add_codec_(const Codec& codec) {
     roc_panic_if(n_codecs_ == MaxCodecs);
     codecs_[n_codecs_++] = codec;
+
+    for (size_t n = 0; n < n_schemes_; n++) {
+        if (schemes_[n] == codec.scheme) {
+            return;
+        }
+    }
+    schemes_[n_schemes_++] = codec.scheme;
 }
 
-const CodecMap::Codec* CodecMap::find_codec_(packet::FecScheme scheme) const {
+const CodecMap::Codec* CodecMap::find_codec_(packet::FecScheme scheme,
+                                             CodecBackend backend) const {
     for (size_t n = 0; n < n_codecs_; n++) {
-        if (codecs_[n].scheme == scheme) {
+        if (codecs_[n].scheme != scheme) {
+            continue;
+        }
+        if (backend == CodecBackend_Default || codecs_[n].backend == backend) {
             return &codecs_[n];
         }
     }
 
-    roc_log(LogError, "codec map: no codec available for fec scheme '%s'",
-            packet::fec_scheme_to_str(scheme));
+    roc_log(LogError,
+            "codec map: no codec available for fec scheme '%s' and backend '%s'",
+            packet::fec_scheme_to_str(scheme), codec_backend_to_str(backend));
 
     return NULL;
 }
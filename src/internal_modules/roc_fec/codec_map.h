@@ -32,7 +32,11 @@ public:
     }
 
     //! Check whether given FEC scheme is supported.
-    bool is_supported(packet::FecScheme scheme) const;
+    //! @remarks
+    //!  If @p backend is CodecBackend_Default, checks whether the scheme is
+    //!  supported by any backend.
+    bool is_supported(packet::FecScheme scheme,
+                      CodecBackend backend = CodecBackend_Default) const;
 
     //! Get number of supported FEC schemes.
     size_t num_schemes() const;
@@ -43,7 +47,8 @@ public:
     //! Create a new block encoder.
     //!
     //! @remarks
-    //!  The codec type is determined by @p config.
+    //!  The codec type is determined by @p config. If config.backend is
+    //!  CodecBackend_Default, the first backend supporting the scheme is used.
     //!
     //! @returns
     //!  NULL if parameters are invalid or given codec support is not enabled.
@@ -54,7 +59,8 @@ public:
     //! Create a new block decoder.
     //!
     //! @remarks
-    //!  The codec type is determined by @p config.
+    //!  The codec type is determined by @p config. If config.backend is
+    //!  CodecBackend_Default, the first backend supporting the scheme is used.
     //!
     //! @returns
     //!  NULL if parameters are invalid or given codec support is not enabled.
@@ -65,10 +71,11 @@ public:
 private:
     friend class core::Singleton<CodecMap>;
 
-    enum { MaxCodecs = 2 };
+    enum { MaxCodecs = 3 };
 
     struct Codec {
         packet::FecScheme scheme;
+        CodecBackend backend;
 
         IBlockEncoder* (*encoder_ctor)(const CodecConfig& config,
                                        core::BufferFactory<uint8_t>& buffer_factory,
@@ -82,10 +89,13 @@ private:
     CodecMap();
 
     void add_codec_(const Codec& codec);
-    const Codec* find_codec_(packet::FecScheme scheme) const;
+    const Codec* find_codec_(packet::FecScheme scheme, CodecBackend backend) const;
 
     size_t n_codecs_;
     Codec codecs_[MaxCodecs];
+
+    size_t n_schemes_;
+    packet::FecScheme schemes_[MaxCodecs];
 };
 
 } // namespace fec
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// x^8 + x^4 + x^3 + x^2 + 1
+const unsigned PrimitivePoly = 0x11d;
+
+} // namespace
+
+Gf256::Gf256() {
+    unsigned x = 1;
+
+    for (size_t n = 0; n < Size - 1; n++) {
+        exp_[n] = (uint8_t)x;
+        exp_[n + Size - 1] = (uint8_t)x;
+        log_[x] = (uint8_t)n;
+
+        x <<= 1;
+        if (x & 0x100) {
+            x ^= PrimitivePoly;
+        }
+    }
+
+    // never used, mul() and div() handle zero explicitly
+    log_[0] = 0;
+
+    for (size_t c = 0; c < Size; c++) {
+        for (size_t n = 0; n < 16; n++) {
+            split_tab_[c][n] = mul((uint8_t)c, (uint8_t)n);
+            split_tab_[c][16 + n] = mul((uint8_t)c, (uint8_t)(n << 4));
+        }
+    }
+}
+
+} // namespace fec
+} // namespace roc
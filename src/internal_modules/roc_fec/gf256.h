@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256.h
+//! @brief GF(2^8) arithmetic.
+
+#ifndef ROC_FEC_GF256_H_
+#define ROC_FEC_GF256_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/panic.h"
+#include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! GF(2^8) arithmetic.
+//!
+//! @remarks
+//!  Uses the same field as Reed-Solomon codec of OpenFEC: primitive polynomial
+//!  x^8 + x^4 + x^3 + x^2 + 1 and generator 2. Codecs built on top of it
+//!  produce the same symbols as OpenFEC.
+class Gf256 : public core::NonCopyable<> {
+public:
+    //! Number of field elements.
+    enum { Size = 256 };
+
+    //! Size of split multiplication table.
+    enum { SplitTableSize = 32 };
+
+    //! Get instance.
+    static Gf256& instance() {
+        return core::Singleton<Gf256>::instance();
+    }
+
+    //! Multiply two elements.
+    uint8_t mul(uint8_t a, uint8_t b) const {
+        if (a == 0 || b == 0) {
+            return 0;
+        }
+        return exp_[log_[a] + log_[b]];
+    }
+
+    //! Divide two elements.
+    //! @pre
+    //!  @p b should be non-zero.
+    uint8_t div(uint8_t a, uint8_t b) const {
+        roc_panic_if(b == 0);
+        if (a == 0) {
+            return 0;
+        }
+        return exp_[log_[a] + (Size - 1) - log_[b]];
+    }
+
+    //! Get generator raised to power @p n.
+    uint8_t exp(size_t n) const {
+        return exp_[n % (Size - 1)];
+    }
+
+    //! Get split multiplication table for constant @p c.
+    //! @remarks
+    //!  First 16 bytes are products of @p c and every low nibble value,
+    //!  next 16 bytes are products of @p c and every high nibble value.
+    //!  The product of @p c and byte x is then tab[x & 0xf] ^ tab[16 + (x >> 4)].
+    const uint8_t* split_table(uint8_t c) const {
+        return split_tab_[c];
+    }
+
+private:
+    friend class core::Singleton<Gf256>;
+
+    Gf256();
+
+    uint8_t exp_[(Size - 1) * 2];
+    uint8_t log_[Size];
+
+    uint8_t split_tab_[Size][SplitTableSize];
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_H_
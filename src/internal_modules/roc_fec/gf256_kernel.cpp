@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/gf256_kernel.h"
+#include "roc_core/attributes.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/cpu_traits.h"
+
+#if ROC_CPU_HAS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+#if ROC_CPU_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+void muladd_scalar(uint8_t* dst, const uint8_t* src, const uint8_t* table, size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        dst[n] ^= (uint8_t)(table[src[n] & 0xf] ^ table[16 + (src[n] >> 4)]);
+    }
+}
+
+#if ROC_CPU_HAS_X86_DISPATCH
+
+ROC_ATTR_TARGET("ssse3")
+void muladd_ssse3(uint8_t* dst, const uint8_t* src, const uint8_t* table, size_t size) {
+    const __m128i lo_tab = _mm_loadu_si128((const __m128i*)table);
+    const __m128i hi_tab = _mm_loadu_si128((const __m128i*)(table + 16));
+    const __m128i mask = _mm_set1_epi8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(src + n));
+
+        const __m128i lo = _mm_and_si128(x, mask);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi64(x, 4), mask);
+
+        const __m128i prod =
+            _mm_xor_si128(_mm_shuffle_epi8(lo_tab, lo), _mm_shuffle_epi8(hi_tab, hi));
+
+        _mm_storeu_si128((__m128i*)(dst + n),
+                         _mm_xor_si128(_mm_loadu_si128((const __m128i*)(dst + n)), prod));
+    }
+
+    muladd_scalar(dst + n, src + n, table, size - n);
+}
+
+ROC_ATTR_TARGET("avx2")
+void muladd_avx2(uint8_t* dst, const uint8_t* src, const uint8_t* table, size_t size) {
+    // VPSHUFB shuffles within 128-bit lanes, so tables are duplicated in both lanes
+    const __m256i lo_tab =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)table));
+    const __m256i hi_tab =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(table + 16)));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 32 <= size; n += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + n));
+
+        const __m256i lo = _mm256_and_si256(x, mask);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi64(x, 4), mask);
+
+        const __m256i prod = _mm256_xor_si256(_mm256_shuffle_epi8(lo_tab, lo),
+                                              _mm256_shuffle_epi8(hi_tab, hi));
+
+        _mm256_storeu_si256(
+            (__m256i*)(dst + n),
+            _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(dst + n)), prod));
+    }
+
+    // Avoid AVX-SSE transition penalty in the scalar tail and in the caller.
+    _mm256_zeroupper();
+
+    muladd_scalar(dst + n, src + n, table, size - n);
+}
+
+#endif // ROC_CPU_HAS_X86_DISPATCH
+
+#if ROC_CPU_HAS_NEON
+
+void muladd_neon(uint8_t* dst, const uint8_t* src, const uint8_t* table, size_t size) {
+    // VTBL with two-register table works on both ARMv7 and AArch64
+    uint8x8x2_t lo_tab;
+    lo_tab.val[0] = vld1_u8(table);
+    lo_tab.val[1] = vld1_u8(table + 8);
+
+    uint8x8x2_t hi_tab;
+    hi_tab.val[0] = vld1_u8(table + 16);
+    hi_tab.val[1] = vld1_u8(table + 24);
+
+    const uint8x8_t mask = vdup_n_u8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 8 <= size; n += 8) {
+        const uint8x8_t x = vld1_u8(src + n);
+
+        const uint8x8_t prod = veor_u8(vtbl2_u8(lo_tab, vand_u8(x, mask)),
+                                       vtbl2_u8(hi_tab, vshr_n_u8(x, 4)));
+
+        vst1_u8(dst + n, veor_u8(vld1_u8(dst + n), prod));
+    }
+
+    muladd_scalar(dst + n, src + n, table, size - n);
+}
+
+#endif // ROC_CPU_HAS_NEON
+
+} // namespace
+
+gf256_kernel_func_t gf256_kernel_func(Gf256Kernel kernel) {
+    const unsigned features = core::cpu_features();
+
+    switch (kernel) {
+    case Gf256Kernel_Scalar:
+        return &muladd_scalar;
+
+    case Gf256Kernel_SSSE3:
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (features & core::CpuFeature_SSSE3) {
+            return &muladd_ssse3;
+        }
+#endif
+        break;
+
+    case Gf256Kernel_AVX2:
+#if ROC_CPU_HAS_X86_DISPATCH
+        if (features & core::CpuFeature_AVX2) {
+            return &muladd_avx2;
+        }
+#endif
+        break;
+
+    case Gf256Kernel_NEON:
+#if ROC_CPU_HAS_NEON
+        if (features & core::CpuFeature_NEON) {
+            return &muladd_neon;
+        }
+#endif
+        break;
+
+    case Gf256Kernel_Max:
+        break;
+    }
+
+    (void)features;
+
+    return NULL;
+}
+
+Gf256Kernel gf256_kernel_select() {
+    if (gf256_kernel_func(Gf256Kernel_AVX2)) {
+        return Gf256Kernel_AVX2;
+    }
+
+    if (gf256_kernel_func(Gf256Kernel_SSSE3)) {
+        return Gf256Kernel_SSSE3;
+    }
+
+    if (gf256_kernel_func(Gf256Kernel_NEON)) {
+        return Gf256Kernel_NEON;
+    }
+
+    return Gf256Kernel_Scalar;
+}
+
+const char* gf256_kernel_to_str(Gf256Kernel kernel) {
+    switch (kernel) {
+    case Gf256Kernel_Scalar:
+        return "scalar";
+
+    case Gf256Kernel_SSSE3:
+        return "ssse3";
+
+    case Gf256Kernel_AVX2:
+        return "avx2";
+
+    case Gf256Kernel_NEON:
+        return "neon";
+
+    case Gf256Kernel_Max:
+        break;
+    }
+
+    return "<invalid>";
+}
+
+} // namespace fec
+} // namespace roc
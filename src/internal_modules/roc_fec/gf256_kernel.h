@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256_kernel.h
+//! @brief GF(2^8) region kernels.
+
+#ifndef ROC_FEC_GF256_KERNEL_H_
+#define ROC_FEC_GF256_KERNEL_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! GF(2^8) kernel implementations.
+enum Gf256Kernel {
+    //! Portable implementation.
+    Gf256Kernel_Scalar,
+
+    //! x86 SSSE3 implementation (PSHUFB).
+    Gf256Kernel_SSSE3,
+
+    //! x86 AVX2 implementation (VPSHUFB).
+    Gf256Kernel_AVX2,
+
+    //! ARM NEON implementation (TBL).
+    Gf256Kernel_NEON,
+
+    //! Number of kernels.
+    Gf256Kernel_Max
+};
+
+//! GF(2^8) multiply-add kernel function.
+//! Multiplies @p size bytes from @p src by a constant and adds (xors) the
+//! products to @p dst. The constant is given by its split multiplication
+//! table, see Gf256::split_table().
+typedef void (*gf256_kernel_func_t)(uint8_t* dst,
+                                    const uint8_t* src,
+                                    const uint8_t* table,
+                                    size_t size);
+
+//! Get kernel function.
+//! @returns
+//!  NULL if the kernel is not supported by the build or by the CPU.
+gf256_kernel_func_t gf256_kernel_func(Gf256Kernel kernel);
+
+//! Select fastest kernel supported by the build and by the CPU.
+Gf256Kernel gf256_kernel_select();
+
+//! Get string name of GF(2^8) kernel.
+const char* gf256_kernel_to_str(Gf256Kernel kernel);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_KERNEL_H_
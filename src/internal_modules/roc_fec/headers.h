@@ -82,8 +82,9 @@ public:
     }
 
     //! Set encoding symbol ID.
-    void set_esi(uint16_t val) {
-        esi_ = core::hton16u(val);
+    void set_esi(uint32_t val) {
+        roc_panic_if((val >> 16) != 0);
+        esi_ = core::hton16u((uint16_t)val);
     }
 
     //! Get source block length.
@@ -158,8 +159,9 @@ public:
     }
 
     //! Set encoding symbol ID.
-    void set_esi(uint16_t val) {
-        esi_ = core::hton16u(val);
+    void set_esi(uint32_t val) {
+        roc_panic_if((val >> 16) != 0);
+        esi_ = core::hton16u((uint16_t)val);
     }
 
     //! Get source block length.
@@ -235,7 +237,7 @@ public:
     }
 
     //! Set encoding symbol ID.
-    void set_esi(uint16_t val) {
+    void set_esi(uint32_t val) {
         roc_panic_if((val >> 8) != 0);
         esi_ = (uint8_t)val;
     }
@@ -260,6 +262,160 @@ public:
     }
 } ROC_ATTR_PACKED_END;
 
+//! RLC Source FEC Payload ID (RFC 8681).
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                   Encoding Symbol ID (ESI)                    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+//!
+//! There are no blocks in sliding window codes, so SBN, k, and n are
+//! always zero.
+ROC_ATTR_PACKED_BEGIN class RLC_Source_PayloadID {
+private:
+    //! Encoding symbol ID.
+    uint32_t esi_;
+
+public:
+    //! Get FEC scheme to which these packets belong to.
+    static packet::FecScheme fec_scheme() {
+        return packet::FEC_RLC;
+    }
+
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get source block number.
+    uint16_t sbn() const {
+        return 0;
+    }
+
+    //! Set source block number.
+    void set_sbn(uint16_t) {
+    }
+
+    //! Get encoding symbol ID.
+    uint32_t esi() const {
+        return core::ntoh32u(esi_);
+    }
+
+    //! Set encoding symbol ID.
+    void set_esi(uint32_t val) {
+        esi_ = core::hton32u(val);
+    }
+
+    //! Get source block length.
+    uint16_t k() const {
+        return 0;
+    }
+
+    //! Set source block length.
+    void set_k(uint16_t) {
+    }
+
+    //! Get number encoding symbols.
+    uint16_t n() const {
+        return 0;
+    }
+
+    //! Set number encoding symbols.
+    void set_n(uint16_t) {
+    }
+} ROC_ATTR_PACKED_END;
+
+//! RLC Repair FEC Payload ID (RFC 8681).
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |       Repair_Key              |  DT   |NSS (# src symb in ew) |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                            ESI of first source symbol in ew   |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+//!
+//! Repair key is exposed as SBN, and number of source symbols in encoding
+//! window (NSS) is exposed as k. Density threshold (DT) is always 15, i.e.
+//! all coefficients are non-zero.
+ROC_ATTR_PACKED_BEGIN class RLC_Repair_PayloadID {
+private:
+    //! Repair key.
+    uint16_t repair_key_;
+
+    //! Density threshold (4 bits) and number of source symbols (12 bits).
+    uint16_t dt_nss_;
+
+    //! ESI of first source symbol in encoding window.
+    uint32_t esi_;
+
+public:
+    //! Density threshold for dense codes.
+    enum { DenseThreshold = 15 };
+
+    //! Get FEC scheme to which these packets belong to.
+    static packet::FecScheme fec_scheme() {
+        return packet::FEC_RLC;
+    }
+
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get repair key.
+    uint16_t sbn() const {
+        return core::ntoh16u(repair_key_);
+    }
+
+    //! Set repair key.
+    void set_sbn(uint16_t val) {
+        repair_key_ = core::hton16u(val);
+    }
+
+    //! Get ESI of first source symbol in encoding window.
+    uint32_t esi() const {
+        return core::ntoh32u(esi_);
+    }
+
+    //! Set ESI of first source symbol in encoding window.
+    void set_esi(uint32_t val) {
+        esi_ = core::hton32u(val);
+    }
+
+    //! Get density threshold.
+    uint8_t dt() const {
+        return uint8_t(core::ntoh16u(dt_nss_) >> 12);
+    }
+
+    //! Get number of source symbols in encoding window.
+    uint16_t k() const {
+        return uint16_t(core::ntoh16u(dt_nss_) & 0xfff);
+    }
+
+    //! Set number of source symbols in encoding window.
+    //! @remarks
+    //!  Also sets density threshold.
+    void set_k(uint16_t val) {
+        roc_panic_if((val >> 12) != 0);
+        dt_nss_ = core::hton16u(uint16_t((DenseThreshold << 12) | val));
+    }
+
+    //! Get number encoding symbols.
+    uint16_t n() const {
+        return 0;
+    }
+
+    //! Set number encoding symbols.
+    void set_n(uint16_t) {
+    }
+} ROC_ATTR_PACKED_END;
+
 } // namespace fec
 } // namespace roc
 
@@ -35,12 +35,20 @@ public:
 
     //! Store source or repair packet buffer for current block.
     //!
+    //! @remarks
+    //!  May be called after repair(). If the packet was already repaired,
+    //!  the call is ignored.
+    //!
     //! @pre
     //!  This method may be called only between begin() and end() calls.
     virtual void set(size_t index, const core::Slice<uint8_t>& buffer) = 0;
 
     //! Repair source packet buffer.
     //!
+    //! @remarks
+    //!  Decoded symbols are kept until end(), so repeated calls don't decode
+    //!  the block again unless new packets were added.
+    //!
     //! @pre
     //!  This method may be called only between begin() and end() calls.
     virtual core::Slice<uint8_t> repair(size_t index) = 0;
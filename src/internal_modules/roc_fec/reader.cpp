@@ -35,6 +35,8 @@ Reader::Reader(const ReaderConfig& config,
     , alive_(true)
     , started_(false)
     , can_repair_(false)
+    , decoding_(false)
+    , n_block_packets_(0)
     , next_packet_(0)
     , cur_sbn_(0)
     , payload_size_(0)
@@ -168,8 +170,14 @@ void Reader::next_block_() {
         repair_block_[n] = NULL;
     }
 
+    if (decoding_) {
+        decoder_.end();
+        decoding_ = false;
+    }
+
     cur_sbn_++;
     next_packet_ = 0;
+    n_block_packets_ = 0;
 
     source_block_resized_ = false;
     repair_block_resized_ = false;
@@ -180,6 +188,11 @@ void Reader::next_block_() {
     fill_block_();
 }
 
+// Repairs only the packets that are requested right now, i.e. the missing
+// packets starting from next_packet_ up to the first repaired one. The rest
+// are repaired when the reader reaches them. The decoder block stays open
+// until next_block_(), so the decoder keeps already decoded symbols between
+// calls and new packets are added to it incrementally.
 void Reader::try_repair_() {
     if (!can_repair_) {
         return;
@@ -189,6 +202,40 @@ void Reader::try_repair_() {
         return;
     }
 
+    // no codec can repair anything with less packets than the source block size
+    if (n_block_packets_ < source_block_.size()) {
+        return;
+    }
+
+    // next packet is not missing, nothing is requested
+    if (next_packet_ >= source_block_.size() || source_block_[next_packet_]) {
+        return;
+    }
+
+    if (!decoding_ && !begin_decoding_()) {
+        return;
+    }
+
+    for (size_t n = next_packet_; n < source_block_.size() && !source_block_[n]; n++) {
+        core::Slice<uint8_t> buffer = decoder_.repair(n);
+        if (!buffer) {
+            continue;
+        }
+
+        packet::PacketPtr pp = parse_repaired_packet_(buffer);
+        if (!pp) {
+            continue;
+        }
+
+        source_block_[n] = pp;
+        return;
+    }
+
+    // nothing more can be repaired until new packets arrive
+    can_repair_ = false;
+}
+
+bool Reader::begin_decoding_() {
     if (!decoder_.begin(source_block_.size(), repair_block_.size(), payload_size_)) {
         roc_log(LogDebug,
                 "fec reader: can't begin decoder block, shutting down:"
@@ -196,7 +243,7 @@ void Reader::try_repair_() {
                 (unsigned long)source_block_.size(), (unsigned long)repair_block_.size(),
                 (unsigned long)payload_size_);
         alive_ = false;
-        return;
+        return false;
     }
 
     for (size_t n = 0; n < source_block_.size(); n++) {
@@ -213,26 +260,9 @@ void Reader::try_repair_() {
         decoder_.set(source_block_.size() + n, repair_block_[n]->fec()->payload);
     }
 
-    for (size_t n = 0; n < source_block_.size(); n++) {
-        if (source_block_[n]) {
-            continue;
-        }
+    decoding_ = true;
 
-        core::Slice<uint8_t> buffer = decoder_.repair(n);
-        if (!buffer) {
-            continue;
-        }
-
-        packet::PacketPtr pp = parse_repaired_packet_(buffer);
-        if (!pp) {
-            continue;
-        }
-
-        source_block_[n] = pp;
-    }
-
-    decoder_.end();
-    can_repair_ = false;
+    return true;
 }
 
 packet::PacketPtr Reader::parse_repaired_packet_(const core::Slice<uint8_t>& buffer) {
@@ -254,27 +284,32 @@ packet::PacketPtr Reader::parse_repaired_packet_(const core::Slice<uint8_t>& buf
 }
 
 void Reader::fetch_packets_() {
+    if (!fetch_queue_(source_reader_, source_queue_)) {
+        return;
+    }
+
+    fetch_queue_(repair_reader_, repair_queue_);
+}
+
+bool Reader::fetch_queue_(packet::IReader& reader, packet::SortedQueue& queue) {
+    packet::PacketPtr packets[FetchBatchSize];
+
     for (;;) {
-        if (packet::PacketPtr pp = source_reader_.read()) {
-            if (!validate_fec_packet_(pp)) {
-                return;
-            }
-            source_queue_.write(pp);
-        } else {
+        const size_t n_packets = reader.read_batch(packets, FetchBatchSize);
+        if (n_packets == 0) {
             break;
         }
-    }
 
-    for (;;) {
-        if (packet::PacketPtr pp = repair_reader_.read()) {
-            if (!validate_fec_packet_(pp)) {
-                return;
+        for (size_t n = 0; n < n_packets; n++) {
+            if (!validate_fec_packet_(packets[n])) {
+                return false;
             }
-            repair_queue_.write(pp);
-        } else {
-            break;
         }
+
+        queue.write_batch(packets, n_packets);
     }
+
+    return true;
 }
 
 void Reader::fill_block_() {
@@ -337,7 +372,12 @@ void Reader::fill_source_block_() {
         if (!source_block_[p_num]) {
             can_repair_ = true;
             source_block_[p_num] = pp;
+            n_block_packets_++;
             n_added++;
+
+            if (decoding_) {
+                decoder_.set(p_num, fec.payload);
+            }
         }
     }
 
@@ -403,7 +443,12 @@ void Reader::fill_repair_block_() {
         if (!repair_block_[p_num]) {
             can_repair_ = true;
             repair_block_[p_num] = pp;
+            n_block_packets_++;
             n_added++;
+
+            if (decoding_) {
+                decoder_.set(fec.encoding_symbol_id, fec.payload);
+            }
         }
     }
 
@@ -72,6 +72,8 @@ public:
     virtual packet::PacketPtr read();
 
 private:
+    enum { FetchBatchSize = 32 };
+
     packet::PacketPtr read_();
 
     packet::PacketPtr get_first_packet_();
@@ -79,10 +81,12 @@ private:
 
     void next_block_();
     void try_repair_();
+    bool begin_decoding_();
 
     packet::PacketPtr parse_repaired_packet_(const core::Slice<uint8_t>& buffer);
 
     void fetch_packets_();
+    bool fetch_queue_(packet::IReader& reader, packet::SortedQueue& queue);
 
     void fill_block_();
     void fill_source_block_();
@@ -126,6 +130,12 @@ private:
     bool started_;
     bool can_repair_;
 
+    // decoder block is open and receives packets as soon as they're added
+    bool decoding_;
+
+    // number of received source and repair packets in current block
+    size_t n_block_packets_;
+
     size_t next_packet_;
     packet::blknum_t cur_sbn_;
 
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_coefficients.h
+//! @brief RLC coding coefficients.
+
+#ifndef ROC_FEC_RLC_COEFFICIENTS_H_
+#define ROC_FEC_RLC_COEFFICIENTS_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Generate RLC coding coefficients for a repair packet.
+//!
+//! @remarks
+//!  Implements generate_coding_coefficients() from RFC 8681 for GF(2^8)
+//!  and density threshold 15: @p coefs is filled with @p n_coefs non-zero
+//!  coefficients drawn from TinyMT32 seeded with @p repair_key. i-th
+//!  coefficient corresponds to i-th source symbol of encoding window.
+void rlc_coefficients(uint16_t repair_key, uint8_t* coefs, size_t n_coefs);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_COEFFICIENTS_H_
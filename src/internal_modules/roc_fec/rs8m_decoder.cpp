@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+Rs8mDecoder::Rs8mDecoder(const CodecConfig& config,
+                         core::BufferFactory<uint8_t>& buffer_factory,
+                         core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , gf_(Gf256::instance())
+    , muladd_(NULL)
+    , matrix_(allocator)
+    , buffer_factory_(buffer_factory)
+    , buff_tab_(allocator)
+    , recv_tab_(allocator)
+    , n_received_(0)
+    , prepared_(false)
+    , lost_tab_(allocator)
+    , lost_pos_(allocator)
+    , syndrome_tab_(allocator)
+    , inv_matrix_(allocator)
+    , tmp_matrix_(allocator)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_ReedSolomon_M8) {
+        roc_panic("rs8m decoder: unexpected fec scheme");
+    }
+
+    if (config.rs_m != 8) {
+        roc_log(LogError, "rs8m decoder: unsupported m parameter: m=%u",
+                (unsigned)config.rs_m);
+        return;
+    }
+
+    const Gf256Kernel kernel = gf256_kernel_select();
+    muladd_ = gf256_kernel_func(kernel);
+
+    roc_log(LogDebug, "rs8m decoder: initializing: kernel=%s",
+            gf256_kernel_to_str(kernel));
+
+    valid_ = true;
+}
+
+Rs8mDecoder::~Rs8mDecoder() {
+}
+
+bool Rs8mDecoder::valid() const {
+    return valid_;
+}
+
+size_t Rs8mDecoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return Rs8mMatrix::MaxBlockLength;
+}
+
+bool Rs8mDecoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!matrix_.build(sblen, rblen)) {
+        return false;
+    }
+
+    if (!resize_tabs_(sblen + rblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    n_received_ = 0;
+    prepared_ = false;
+
+    return true;
+}
+
+void Rs8mDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m decoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("rs8m decoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (recv_tab_[index]) {
+        roc_panic("rs8m decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    if (buff_tab_[index]) {
+        // already repaired
+        return;
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    n_received_++;
+}
+
+core::Slice<uint8_t> Rs8mDecoder::repair(size_t index) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (buff_tab_[index]) {
+        return buff_tab_[index];
+    }
+
+    // like OpenFEC, we don't repair repair packets
+    if (index >= sblen_) {
+        return core::Slice<uint8_t>();
+    }
+
+    if (!prepare_()) {
+        return core::Slice<uint8_t>();
+    }
+
+    return restore_(index);
+}
+
+void Rs8mDecoder::end() {
+    roc_panic_if_not(valid());
+
+    report_();
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    for (size_t i = 0; i < syndrome_tab_.size(); ++i) {
+        syndrome_tab_[i] = core::Slice<uint8_t>();
+    }
+
+    n_received_ = 0;
+    prepared_ = false;
+}
+
+bool Rs8mDecoder::resize_tabs_(size_t size) {
+    if (!buff_tab_.resize(size)) {
+        return false;
+    }
+    if (!recv_tab_.resize(size)) {
+        return false;
+    }
+    if (!lost_pos_.resize(size)) {
+        return false;
+    }
+    if (!lost_tab_.grow(size)) {
+        return false;
+    }
+
+    return true;
+}
+
+bool Rs8mDecoder::prepare_() {
+    if (prepared_) {
+        return true;
+    }
+
+    // MDS code: any sblen packets are enough
+    if (n_received_ < sblen_) {
+        return false;
+    }
+
+    if (!lost_tab_.resize(0)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < sblen_; i++) {
+        if (!recv_tab_[i]) {
+            lost_pos_[i] = lost_tab_.size();
+            lost_tab_.push_back(i);
+        }
+    }
+
+    const size_t n_lost = lost_tab_.size();
+
+    if (!syndrome_tab_.resize(n_lost) || !tmp_matrix_.resize(n_lost * n_lost)
+        || !inv_matrix_.resize(n_lost * n_lost)) {
+        roc_log(LogError, "rs8m decoder: can't allocate decoding matrix");
+        return false;
+    }
+
+    size_t n_used = 0;
+
+    for (size_t i = sblen_; i < sblen_ + rblen_ && n_used < n_lost; i++) {
+        if (!recv_tab_[i]) {
+            continue;
+        }
+
+        const size_t r = i - sblen_;
+
+        for (size_t n = 0; n < n_lost; n++) {
+            tmp_matrix_[n_used * n_lost + n] = matrix_.coef(r, lost_tab_[n]);
+        }
+
+        core::Slice<uint8_t> syndrome = new_buffer_();
+        if (!syndrome) {
+            return false;
+        }
+
+        memcpy(syndrome.data(), buff_tab_[i].data(), payload_size_);
+
+        for (size_t j = 0; j < sblen_; j++) {
+            if (!recv_tab_[j]) {
+                continue;
+            }
+            const uint8_t c = matrix_.coef(r, j);
+            if (c == 0) {
+                continue;
+            }
+            muladd_(syndrome.data(), buff_tab_[j].data(), gf_.split_table(c),
+                    payload_size_);
+        }
+
+        syndrome_tab_[n_used++] = syndrome;
+    }
+
+    roc_panic_if(n_used != n_lost);
+
+    if (!invert_(n_lost)) {
+        roc_log(LogError, "rs8m decoder: decoding matrix is singular");
+        return false;
+    }
+
+    prepared_ = true;
+
+    return true;
+}
+
+// Gauss-Jordan elimination of tmp_matrix_, result goes to inv_matrix_
+bool Rs8mDecoder::invert_(size_t size) {
+    for (size_t r = 0; r < size; r++) {
+        for (size_t c = 0; c < size; c++) {
+            inv_matrix_[r * size + c] = (r == c ? 1 : 0);
+        }
+    }
+
+    for (size_t c = 0; c < size; c++) {
+        size_t pivot = c;
+        while (pivot < size && tmp_matrix_[pivot * size + c] == 0) {
+            pivot++;
+        }
+        if (pivot == size) {
+            return false;
+        }
+
+        if (pivot != c) {
+            for (size_t n = 0; n < size; n++) {
+                uint8_t t = tmp_matrix_[c * size + n];
+                tmp_matrix_[c * size + n] = tmp_matrix_[pivot * size + n];
+                tmp_matrix_[pivot * size + n] = t;
+
+                t = inv_matrix_[c * size + n];
+                inv_matrix_[c * size + n] = inv_matrix_[pivot * size + n];
+                inv_matrix_[pivot * size + n] = t;
+            }
+        }
+
+        const uint8_t scale = gf_.div(1, tmp_matrix_[c * size + c]);
+
+        for (size_t n = 0; n < size; n++) {
+            tmp_matrix_[c * size + n] = gf_.mul(tmp_matrix_[c * size + n], scale);
+            inv_matrix_[c * size + n] = gf_.mul(inv_matrix_[c * size + n], scale);
+        }
+
+        for (size_t r = 0; r < size; r++) {
+            const uint8_t f = tmp_matrix_[r * size + c];
+            if (r == c || f == 0) {
+                continue;
+            }
+            for (size_t n = 0; n < size; n++) {
+                tmp_matrix_[r * size + n] ^= gf_.mul(f, tmp_matrix_[c * size + n]);
+                inv_matrix_[r * size + n] ^= gf_.mul(f, inv_matrix_[c * size + n]);
+            }
+        }
+    }
+
+    return true;
+}
+
+core::Slice<uint8_t> Rs8mDecoder::restore_(size_t index) {
+    core::Slice<uint8_t> buffer = new_buffer_();
+    if (!buffer) {
+        return core::Slice<uint8_t>();
+    }
+
+    memset(buffer.data(), 0, payload_size_);
+
+    const size_t n_lost = lost_tab_.size();
+    const size_t pos = lost_pos_[index];
+
+    for (size_t n = 0; n < n_lost; n++) {
+        const uint8_t c = inv_matrix_[pos * n_lost + n];
+        if (c == 0) {
+            continue;
+        }
+        muladd_(buffer.data(), syndrome_tab_[n].data(), gf_.split_table(c),
+                payload_size_);
+    }
+
+    buff_tab_[index] = buffer;
+
+    return buffer;
+}
+
+core::Slice<uint8_t> Rs8mDecoder::new_buffer_() {
+    core::Slice<uint8_t> buffer = buffer_factory_.new_buffer();
+
+    if (!buffer) {
+        roc_log(LogError, "rs8m decoder: can't allocate buffer");
+        return core::Slice<uint8_t>();
+    }
+
+    if (buffer.capacity() < payload_size_) {
+        roc_log(LogError, "rs8m decoder: packet size too large: size=%lu max=%lu",
+                (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+        return core::Slice<uint8_t>();
+    }
+
+    buffer.reslice(0, payload_size_);
+
+    return buffer;
+}
+
+void Rs8mDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t i = 0; i < sblen_; ++i) {
+        if (recv_tab_[i]) {
+            continue;
+        }
+        n_lost++;
+        if (buff_tab_[i]) {
+            n_repaired++;
+        }
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m decoder: repaired %u/%u/%u", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)buff_tab_.size());
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_decoder.h
+//! @brief Built-in Reed-Solomon GF(2^8) decoder.
+
+#ifndef ROC_FEC_RS8M_DECODER_H_
+#define ROC_FEC_RS8M_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/iblock_decoder.h"
+#include "roc_fec/rs8m_matrix.h"
+
+namespace roc {
+namespace fec {
+
+//! Built-in Reed-Solomon GF(2^8) decoder.
+//!
+//! @remarks
+//!  Compatible with OpenFEC Reed-Solomon codec.
+//!
+//!  When there are enough packets to repair the block, the decoder picks
+//!  as many received repair symbols as there are lost source symbols,
+//!  subtracts contribution of received source symbols from them, and inverts
+//!  the small square matrix that maps lost source symbols to the rest.
+//!  After that, every lost source symbol is restored on demand, when
+//!  repair() is called for it for the first time.
+class Rs8mDecoder : public IBlockDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit Rs8mDecoder(const CodecConfig& config,
+                         core::BufferFactory<uint8_t>& buffer_factory,
+                         core::IAllocator& allocator);
+
+    virtual ~Rs8mDecoder();
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Start block.
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Finish block.
+    virtual void end();
+
+private:
+    bool resize_tabs_(size_t size);
+
+    bool prepare_();
+    bool invert_(size_t size);
+    core::Slice<uint8_t> restore_(size_t index);
+
+    core::Slice<uint8_t> new_buffer_();
+
+    void report_();
+
+    size_t sblen_;
+    size_t rblen_;
+    size_t payload_size_;
+
+    const Gf256& gf_;
+    gf256_kernel_func_t muladd_;
+
+    Rs8mMatrix matrix_;
+
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
+    // received and repaired source and repair packets
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    // true if packet is received, false if it's lost or repaired
+    core::Array<bool> recv_tab_;
+
+    size_t n_received_;
+
+    // set when the linear system for lost packets is solved
+    bool prepared_;
+
+    // indices of lost source packets
+    core::Array<size_t> lost_tab_;
+
+    // for every lost source packet, its position in lost_tab_
+    core::Array<size_t> lost_pos_;
+
+    // received repair packets minus contribution of received source packets,
+    // one per lost source packet
+    core::Array<core::Slice<uint8_t> > syndrome_tab_;
+
+    // inverse of the matrix that maps lost source packets to syndromes
+    core::Array<uint8_t> inv_matrix_;
+    core::Array<uint8_t> tmp_matrix_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_DECODER_H_
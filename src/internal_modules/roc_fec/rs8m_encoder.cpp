@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+Rs8mEncoder::Rs8mEncoder(const CodecConfig& config,
+                         core::BufferFactory<uint8_t>&,
+                         core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , gf_(Gf256::instance())
+    , muladd_(NULL)
+    , matrix_(allocator)
+    , buff_tab_(allocator)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_ReedSolomon_M8) {
+        roc_panic("rs8m encoder: unexpected fec scheme");
+    }
+
+    if (config.rs_m != 8) {
+        roc_log(LogError, "rs8m encoder: unsupported m parameter: m=%u",
+                (unsigned)config.rs_m);
+        return;
+    }
+
+    const Gf256Kernel kernel = gf256_kernel_select();
+    muladd_ = gf256_kernel_func(kernel);
+
+    roc_log(LogDebug, "rs8m encoder: initializing: kernel=%s",
+            gf256_kernel_to_str(kernel));
+
+    valid_ = true;
+}
+
+Rs8mEncoder::~Rs8mEncoder() {
+}
+
+bool Rs8mEncoder::valid() const {
+    return valid_;
+}
+
+size_t Rs8mEncoder::alignment() const {
+    return Alignment;
+}
+
+size_t Rs8mEncoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return Rs8mMatrix::MaxBlockLength;
+}
+
+bool Rs8mEncoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!matrix_.build(sblen, rblen)) {
+        return false;
+    }
+
+    if (!buff_tab_.resize(sblen + rblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return true;
+}
+
+void Rs8mEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m encoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m encoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("rs8m encoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    buff_tab_[index] = buffer;
+}
+
+void Rs8mEncoder::fill() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < sblen_ + rblen_; i++) {
+        if (!buff_tab_[i]) {
+            roc_panic("rs8m encoder: missing buffer: index=%lu", (unsigned long)i);
+        }
+    }
+
+    for (size_t r = 0; r < rblen_; r++) {
+        uint8_t* repair = buff_tab_[sblen_ + r].data();
+
+        memset(repair, 0, payload_size_);
+
+        for (size_t j = 0; j < sblen_; j++) {
+            const uint8_t c = matrix_.coef(r, j);
+            if (c == 0) {
+                continue;
+            }
+            muladd_(repair, buff_tab_[j].data(), gf_.split_table(c), payload_size_);
+        }
+    }
+}
+
+void Rs8mEncoder::end() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_matrix.h"
+#include "roc_core/log.h"
+
+namespace roc {
+namespace fec {
+
+Rs8mMatrix::Rs8mMatrix(core::IAllocator& allocator)
+    : gf_(Gf256::instance())
+    , sblen_(0)
+    , rblen_(0)
+    , weights_(allocator)
+    , coefs_(allocator) {
+}
+
+bool Rs8mMatrix::build(size_t sblen, size_t rblen) {
+    if (sblen == sblen_ && rblen == rblen_) {
+        return true;
+    }
+
+    if (sblen == 0 || sblen + rblen > MaxBlockLength) {
+        roc_log(LogError, "rs8m matrix: invalid block size: sblen=%lu rblen=%lu max=%lu",
+                (unsigned long)sblen, (unsigned long)rblen,
+                (unsigned long)MaxBlockLength);
+        return false;
+    }
+
+    if (!weights_.resize(sblen) || !coefs_.resize(sblen * rblen)) {
+        roc_log(LogError, "rs8m matrix: can't allocate matrix: sblen=%lu rblen=%lu",
+                (unsigned long)sblen, (unsigned long)rblen);
+        sblen_ = rblen_ = 0;
+        return false;
+    }
+
+    // weights_[j] = prod (x_j - x_m) for m != j
+    for (size_t j = 0; j < sblen; j++) {
+        uint8_t w = 1;
+        for (size_t m = 0; m < sblen; m++) {
+            if (m != j) {
+                w = gf_.mul(w, point_(j) ^ point_(m));
+            }
+        }
+        weights_[j] = w;
+    }
+
+    // coefs_[r][j] = L_j(x) = prod (x - x_m) / ((x - x_j) * weights_[j])
+    for (size_t r = 0; r < rblen; r++) {
+        const uint8_t x = point_(sblen + r);
+
+        uint8_t p = 1;
+        for (size_t m = 0; m < sblen; m++) {
+            p = gf_.mul(p, x ^ point_(m));
+        }
+
+        for (size_t j = 0; j < sblen; j++) {
+            coefs_[r * sblen + j] = gf_.div(p, gf_.mul(x ^ point_(j), weights_[j]));
+        }
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+
+    return true;
+}
+
+uint8_t Rs8mMatrix::point_(size_t index) const {
+    if (index == 0) {
+        return 0;
+    }
+    return gf_.exp(index - 1);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_matrix.h
+//! @brief Reed-Solomon GF(2^8) generator matrix.
+
+#ifndef ROC_FEC_RS8M_MATRIX_H_
+#define ROC_FEC_RS8M_MATRIX_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon GF(2^8) generator matrix.
+//!
+//! @remarks
+//!  Holds repair rows of the systematic generator matrix used by OpenFEC
+//!  Reed-Solomon codec. OpenFEC evaluates a Vandermonde matrix at points
+//!  0, 1, g, g^2, ..., g^(n-2), and multiplies it by the inverse of its top
+//!  k x k part. Row i of the result is the vector of Lagrange basis polynomials
+//!  over the first k points evaluated at point i, which we compute directly
+//!  in O(k * (k + r)) instead of inverting the matrix.
+class Rs8mMatrix : public core::NonCopyable<> {
+public:
+    //! Maximum number of source and repair symbols in block.
+    enum { MaxBlockLength = Gf256::Size - 1 };
+
+    //! Initialize.
+    explicit Rs8mMatrix(core::IAllocator& allocator);
+
+    //! Compute repair rows for given block size.
+    //! @remarks
+    //!  Does nothing if the block size didn't change.
+    //! @returns
+    //!  false if block size is invalid or allocation failed.
+    bool build(size_t sblen, size_t rblen);
+
+    //! Get coefficient of source symbol in repair symbol.
+    //! @p repair_index is relative to the first repair symbol of the block.
+    uint8_t coef(size_t repair_index, size_t source_index) const {
+        return coefs_[repair_index * sblen_ + source_index];
+    }
+
+private:
+    uint8_t point_(size_t index) const;
+
+    const Gf256& gf_;
+
+    size_t sblen_;
+    size_t rblen_;
+
+    core::Array<uint8_t> weights_;
+    core::Array<uint8_t> coefs_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_MATRIX_H_
@@ -117,24 +117,35 @@ void OpenfecDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
                   (unsigned long)payload_size_, (unsigned long)buffer.size());
     }
 
-    if (buff_tab_[index]) {
+    if (recv_tab_[index]) {
         roc_panic("openfec decoder: can't overwrite buffer: index=%lu",
                   (unsigned long)index);
     }
 
+    if (buff_tab_[index] || data_tab_[index]) {
+        // already repaired by OpenFEC, maybe into its own memory
+        roc_log(LogTrace, "openfec decoder: ignoring repaired packet: index=%lu",
+                (unsigned long)index);
+        return;
+    }
+
     has_new_packets_ = true;
 
     buff_tab_[index] = buffer;
     data_tab_[index] = buffer.data();
     recv_tab_[index] = true;
 
-    // register new packet and try to repair more packets
-    roc_log(LogTrace, "openfec decoder: of_decode_with_new_symbol(): index=%lu",
-            (unsigned long)index);
+    // if the session already finished decoding, decode_() will recreate it
+    // and pass all packets to it when the next repair() needs that
+    if (!decoding_finished_) {
+        // register new packet and try to repair more packets
+        roc_log(LogTrace, "openfec decoder: of_decode_with_new_symbol(): index=%lu",
+                (unsigned long)index);
 
-    if (of_decode_with_new_symbol(of_sess_, data_tab_[index], (unsigned int)index)
-        != OF_STATUS_OK) {
-        roc_panic("openfec decoder: can't add packet to OF session");
+        if (of_decode_with_new_symbol(of_sess_, data_tab_[index], (unsigned int)index)
+            != OF_STATUS_OK) {
+            roc_panic("openfec decoder: can't add packet to OF session");
+        }
     }
 
     if (max_index_ < index) {
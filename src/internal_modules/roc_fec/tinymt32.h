@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/tinymt32.h
+//! @brief TinyMT32 PRNG.
+
+#ifndef ROC_FEC_TINYMT32_H_
+#define ROC_FEC_TINYMT32_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! TinyMT32 pseudo-random number generator.
+//!
+//! @remarks
+//!  Implements the generator and the parameter set defined by RFC 8682.
+//!  Sliding window codes use it to derive coding coefficients from the
+//!  repair key, so its output must be bit-exact on all platforms.
+class TinyMT32 : public core::NonCopyable<> {
+public:
+    //! Initialize generator with given seed.
+    explicit TinyMT32(uint32_t seed);
+
+    //! Generate next 32-bit number.
+    uint32_t generate_uint32();
+
+private:
+    void next_state_();
+    uint32_t temper_() const;
+
+    uint32_t status_[4];
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_TINYMT32_H_
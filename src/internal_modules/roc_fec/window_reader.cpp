@@ -0,0 +1,714 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/window_reader.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/rlc_coefficients.h"
+#include "roc_packet/fec_scheme_to_str.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NoPos = (size_t)-1;
+
+} // namespace
+
+WindowReader::WindowReader(packet::IReader& source_reader,
+                           packet::IReader& repair_reader,
+                           packet::IParser& parser,
+                           packet::PacketFactory& packet_factory,
+                           core::BufferFactory<uint8_t>& buffer_factory,
+                           core::IAllocator& allocator)
+    : source_reader_(source_reader)
+    , repair_reader_(repair_reader)
+    , parser_(parser)
+    , packet_factory_(packet_factory)
+    , buffer_factory_(buffer_factory)
+    , gf_(Gf256::instance())
+    , muladd_(NULL)
+    , source_queue_(0)
+    , symbol_tab_(allocator)
+    , repair_tab_(allocator)
+    , matrix_(allocator)
+    , syndrome_tab_(allocator)
+    , unknown_tab_(allocator)
+    , pivot_tab_(allocator)
+    , n_equations_(0)
+    , n_pivots_(0)
+    , system_payload_size_(0)
+    , unknown_pos_(allocator)
+    , coefs_(allocator)
+    , valid_(false)
+    , alive_(true)
+    , started_(false)
+    , can_repair_(false)
+    , next_esi_(0)
+    , last_esi_(0)
+    , n_packets_(0) {
+    if (!symbol_tab_.resize(SymbolTableSize) || !unknown_pos_.resize(SymbolTableSize)
+        || !repair_tab_.grow(MaxRepairPackets)
+        || !matrix_.resize(MaxRepairPackets * MaxUnknowns)
+        || !syndrome_tab_.resize(MaxRepairPackets) || !unknown_tab_.grow(MaxUnknowns)
+        || !pivot_tab_.resize(MaxRepairPackets) || !coefs_.resize(MaxWindowLength)) {
+        roc_log(LogError, "fec window reader: can't allocate tables");
+        return;
+    }
+
+    for (size_t n = 0; n < unknown_pos_.size(); n++) {
+        unknown_pos_[n] = NoPos;
+    }
+
+    const Gf256Kernel kernel = gf256_kernel_select();
+    muladd_ = gf256_kernel_func(kernel);
+
+    roc_log(LogDebug, "fec window reader: initializing: kernel=%s",
+            gf256_kernel_to_str(kernel));
+
+    valid_ = true;
+}
+
+bool WindowReader::valid() const {
+    return valid_;
+}
+
+bool WindowReader::started() const {
+    return started_;
+}
+
+bool WindowReader::alive() const {
+    return alive_;
+}
+
+packet::PacketPtr WindowReader::read() {
+    roc_panic_if_not(valid());
+
+    if (!alive_) {
+        return NULL;
+    }
+
+    fetch_packets_();
+
+    if (!alive_) {
+        return NULL;
+    }
+
+    if (!started_) {
+        packet::PacketPtr pp = source_queue_.head();
+        if (!pp) {
+            return NULL;
+        }
+
+        next_esi_ = (uint32_t)pp->fec()->encoding_symbol_id;
+        last_esi_ = next_esi_ - 1;
+
+        roc_log(LogDebug,
+                "fec window reader: got first packet, start decoding:"
+                " n_packets_before=%u esi=%lu",
+                n_packets_, (unsigned long)next_esi_);
+
+        started_ = true;
+    }
+
+    packet::PacketPtr pp = get_next_packet_();
+    if (pp) {
+        n_packets_++;
+    }
+
+    return pp;
+}
+
+packet::PacketPtr WindowReader::get_next_packet_() {
+    fill_source_symbols_();
+    drop_stale_repair_packets_();
+
+    for (;;) {
+        const Symbol& symbol = symbol_tab_[next_esi_ & SymbolTableMask];
+
+        if (!symbol.packet) {
+            try_repair_();
+        }
+
+        if (symbol.packet) {
+            packet::PacketPtr pp = symbol.packet;
+            next_symbol_();
+            return pp;
+        }
+
+        if (!has_following_packets_()) {
+            if (source_queue_.size() == 0) {
+                // wait for more packets
+                return NULL;
+            }
+
+            // following packets are too far to be kept in symbol table,
+            // so nothing in between can be restored
+            jump_to_((uint32_t)source_queue_.head()->fec()->encoding_symbol_id);
+        } else {
+            roc_log(LogTrace,
+                    "fec window reader: can't restore packet, skipping: esi=%lu",
+                    (unsigned long)next_esi_);
+            next_symbol_();
+        }
+
+        fill_source_symbols_();
+        drop_stale_repair_packets_();
+    }
+}
+
+bool WindowReader::has_following_packets_() const {
+    return esi_diff_(last_esi_, next_esi_) > 0;
+}
+
+void WindowReader::next_symbol_() {
+    // slot of the oldest symbol in history becomes slot of the newest symbol
+    // in lookahead
+    Symbol& symbol = symbol_tab_[(next_esi_ - HistoryLength) & SymbolTableMask];
+    symbol.packet = NULL;
+    symbol.payload = core::Slice<uint8_t>();
+
+    next_esi_++;
+
+    if (esi_diff_(last_esi_, next_esi_) < 0) {
+        last_esi_ = next_esi_ - 1;
+    }
+
+    // system depends on next symbol, so it should be rebuilt even if
+    // there are no new packets
+    can_repair_ = true;
+}
+
+void WindowReader::jump_to_(uint32_t esi) {
+    roc_log(LogDebug,
+            "fec window reader: jumping to next packet: cur_esi=%lu new_esi=%lu",
+            (unsigned long)next_esi_, (unsigned long)esi);
+
+    for (size_t n = 0; n < symbol_tab_.size(); n++) {
+        symbol_tab_[n].packet = NULL;
+        symbol_tab_[n].payload = core::Slice<uint8_t>();
+    }
+
+    next_esi_ = esi;
+    last_esi_ = next_esi_ - 1;
+
+    can_repair_ = true;
+}
+
+void WindowReader::fetch_packets_() {
+    if (!fetch_source_packets_()) {
+        return;
+    }
+
+    fetch_repair_packets_();
+}
+
+bool WindowReader::fetch_source_packets_() {
+    packet::PacketPtr packets[FetchBatchSize];
+
+    for (;;) {
+        const size_t n_packets = source_reader_.read_batch(packets, FetchBatchSize);
+        if (n_packets == 0) {
+            break;
+        }
+
+        for (size_t n = 0; n < n_packets; n++) {
+            if (!validate_fec_packet_(packets[n])) {
+                return false;
+            }
+        }
+
+        source_queue_.write_batch(packets, n_packets);
+    }
+
+    return true;
+}
+
+bool WindowReader::fetch_repair_packets_() {
+    unsigned n_fetched = 0, n_dropped = 0;
+
+    for (;;) {
+        packet::PacketPtr pp = repair_reader_.read();
+        if (!pp) {
+            break;
+        }
+
+        if (!validate_fec_packet_(pp)) {
+            return false;
+        }
+
+        n_fetched++;
+
+        const packet::FEC& fec = *pp->fec();
+
+        if (fec.source_block_length == 0 || fec.source_block_length > MaxWindowLength
+            || fec.payload.size() == 0) {
+            roc_log(LogTrace,
+                    "fec window reader: dropping invalid repair packet:"
+                    " esi=%lu nss=%lu payload_size=%lu",
+                    (unsigned long)fec.encoding_symbol_id,
+                    (unsigned long)fec.source_block_length,
+                    (unsigned long)fec.payload.size());
+            n_dropped++;
+            continue;
+        }
+
+        if (repair_tab_.size() == MaxRepairPackets) {
+            // drop oldest repair packet
+            for (size_t n = 1; n < repair_tab_.size(); n++) {
+                repair_tab_[n - 1] = repair_tab_[n];
+            }
+            repair_tab_[repair_tab_.size() - 1] = pp;
+            n_dropped++;
+        } else {
+            repair_tab_.push_back(pp);
+        }
+
+        can_repair_ = true;
+    }
+
+    if (n_dropped != 0) {
+        roc_log(LogDebug, "fec window reader: repair queue: fetched=%u dropped=%u",
+                n_fetched, n_dropped);
+    }
+
+    return true;
+}
+
+bool WindowReader::validate_fec_packet_(const packet::PacketPtr& pp) {
+    const packet::FEC* fec = pp->fec();
+
+    if (!fec) {
+        roc_panic("fec window reader: unexpected non-fec packet");
+    }
+
+    if (fec->fec_scheme != packet::FEC_RLC) {
+        roc_log(LogDebug,
+                "fec window reader: unexpected packet fec scheme, shutting down:"
+                " packet_scheme=%s session_scheme=%s",
+                packet::fec_scheme_to_str(fec->fec_scheme),
+                packet::fec_scheme_to_str(packet::FEC_RLC));
+        return (alive_ = false);
+    }
+
+    return true;
+}
+
+void WindowReader::fill_source_symbols_() {
+    unsigned n_fetched = 0, n_added = 0, n_dropped = 0;
+
+    for (;;) {
+        packet::PacketPtr pp = source_queue_.head();
+        if (!pp) {
+            break;
+        }
+
+        const packet::FEC& fec = *pp->fec();
+        const uint32_t esi = (uint32_t)fec.encoding_symbol_id;
+        const int32_t dist = esi_diff_(esi, next_esi_);
+
+        if (dist >= (int32_t)LookaheadLength) {
+            break;
+        }
+
+        (void)source_queue_.read();
+        n_fetched++;
+
+        if (dist < 0) {
+            roc_log(LogTrace,
+                    "fec window reader: dropping late source packet:"
+                    " next_esi=%lu pkt_esi=%lu",
+                    (unsigned long)next_esi_, (unsigned long)esi);
+            n_dropped++;
+            continue;
+        }
+
+        if (fec.payload.size() == 0) {
+            n_dropped++;
+            continue;
+        }
+
+        Symbol& symbol = symbol_tab_[esi & SymbolTableMask];
+
+        if (!symbol.packet) {
+            symbol.packet = pp;
+            symbol.payload = fec.payload;
+            can_repair_ = true;
+            n_added++;
+
+            if (esi_diff_(esi, last_esi_) > 0) {
+                last_esi_ = esi;
+            }
+        }
+    }
+
+    if (n_dropped != 0 || n_fetched != n_added) {
+        roc_log(LogDebug,
+                "fec window reader: source queue: fetched=%u added=%u dropped=%u",
+                n_fetched, n_added, n_dropped);
+    }
+}
+
+void WindowReader::drop_stale_repair_packets_() {
+    size_t n_kept = 0;
+
+    for (size_t n = 0; n < repair_tab_.size(); n++) {
+        const packet::FEC& fec = *repair_tab_[n]->fec();
+
+        const uint32_t end_esi =
+            uint32_t((uint32_t)fec.encoding_symbol_id + fec.source_block_length);
+
+        // all symbols of encoding window are already passed
+        if (esi_diff_(end_esi, next_esi_) <= 0) {
+            continue;
+        }
+
+        repair_tab_[n_kept++] = repair_tab_[n];
+    }
+
+    if (n_kept != repair_tab_.size()) {
+        if (!repair_tab_.resize(n_kept)) {
+            roc_panic("fec window reader: can't shrink repair table");
+        }
+    }
+}
+
+// Builds linear system from repair packets which encoding windows overlap
+// with the missing next symbol and the following symbols, and restores every
+// source symbol that can be determined from it. Repair packets are kept until
+// their windows are passed, so the system is rebuilt from scratch every time
+// new packets arrive.
+void WindowReader::try_repair_() {
+    if (!can_repair_) {
+        return;
+    }
+
+    // nothing more can be restored until new packets arrive or next
+    // symbol changes
+    can_repair_ = false;
+
+    // repair packets of different sizes can't be combined, so the system
+    // is built only from packets of the same size as the ones covering
+    // the missing symbol
+    system_payload_size_ = 0;
+
+    for (size_t n = 0; n < repair_tab_.size(); n++) {
+        const packet::FEC& fec = *repair_tab_[n]->fec();
+        const uint32_t first_esi = (uint32_t)fec.encoding_symbol_id;
+
+        if (esi_diff_(next_esi_, first_esi) >= 0
+            && esi_diff_(uint32_t(first_esi + fec.source_block_length), next_esi_) > 0) {
+            system_payload_size_ = fec.payload.size();
+            break;
+        }
+    }
+
+    if (system_payload_size_ == 0) {
+        return;
+    }
+
+    for (size_t n = 0; n < repair_tab_.size(); n++) {
+        if (n_equations_ == MaxRepairPackets) {
+            break;
+        }
+        add_repair_equation_(repair_tab_[n]);
+    }
+
+    const size_t next_pos = unknown_pos_[next_esi_ & SymbolTableMask];
+
+    if (next_pos != NoPos) {
+        eliminate_();
+        restore_solved_();
+    }
+
+    clear_system_();
+}
+
+bool WindowReader::add_repair_equation_(const packet::PacketPtr& pp) {
+    const packet::FEC& fec = *pp->fec();
+
+    const uint32_t first_esi = (uint32_t)fec.encoding_symbol_id;
+    const size_t n_symbols = fec.source_block_length;
+    const size_t payload_size = fec.payload.size();
+
+    // all symbols of encoding window should fit into symbol table
+    if (esi_diff_(first_esi, next_esi_) < -(int32_t)HistoryLength
+        || esi_diff_(uint32_t(first_esi + n_symbols), next_esi_)
+            > (int32_t)LookaheadLength) {
+        return false;
+    }
+
+    if (payload_size != system_payload_size_) {
+        return false;
+    }
+
+    size_t n_unknowns = 0, n_new_unknowns = 0;
+
+    if (!count_unknowns_(first_esi, n_symbols, payload_size, n_unknowns,
+                         n_new_unknowns)) {
+        return false;
+    }
+
+    // equation doesn't help if all its symbols are known
+    if (n_unknowns == 0) {
+        return false;
+    }
+
+    if (unknown_tab_.size() + n_new_unknowns > MaxUnknowns) {
+        return false;
+    }
+
+    core::Slice<uint8_t> syndrome = new_buffer_(payload_size);
+    if (!syndrome) {
+        return false;
+    }
+
+    memcpy(syndrome.data(), fec.payload.data(), payload_size);
+
+    uint8_t* row = matrix_.data() + n_equations_ * MaxUnknowns;
+    memset(row, 0, MaxUnknowns);
+
+    rlc_coefficients((uint16_t)fec.source_block_number, coefs_.data(), n_symbols);
+
+    for (size_t i = 0; i < n_symbols; i++) {
+        const uint32_t esi = uint32_t(first_esi + i);
+        const Symbol& symbol = symbol_tab_[esi & SymbolTableMask];
+
+        if (symbol.payload) {
+            // subtract known symbol from repair symbol
+            muladd_(syndrome.data(), symbol.payload.data(), gf_.split_table(coefs_[i]),
+                    payload_size);
+            continue;
+        }
+
+        size_t& pos = unknown_pos_[esi & SymbolTableMask];
+        if (pos == NoPos) {
+            pos = unknown_tab_.size();
+            unknown_tab_.push_back(esi);
+        }
+
+        row[pos] = coefs_[i];
+    }
+
+    syndrome_tab_[n_equations_++] = syndrome;
+
+    return true;
+}
+
+// Counts unknown symbols in encoding window, and how many of them are not
+// yet added to system. Fails if window has known symbols of different size.
+bool WindowReader::count_unknowns_(uint32_t first_esi,
+                                   size_t n_symbols,
+                                   size_t payload_size,
+                                   size_t& n_unknowns,
+                                   size_t& n_new_unknowns) const {
+    for (size_t i = 0; i < n_symbols; i++) {
+        const uint32_t esi = uint32_t(first_esi + i);
+        const Symbol& symbol = symbol_tab_[esi & SymbolTableMask];
+
+        if (symbol.payload) {
+            if (symbol.payload.size() != payload_size) {
+                return false;
+            }
+            continue;
+        }
+
+        n_unknowns++;
+
+        if (unknown_pos_[esi & SymbolTableMask] == NoPos) {
+            n_new_unknowns++;
+        }
+    }
+
+    return true;
+}
+
+// Gauss-Jordan elimination of the system. Rows are not normalized, pivots
+// are divided out when restoring symbols.
+void WindowReader::eliminate_() {
+    const size_t n_unknowns = unknown_tab_.size();
+
+    n_pivots_ = 0;
+
+    for (size_t col = 0; col < n_unknowns && n_pivots_ < n_equations_; col++) {
+        size_t pivot = n_pivots_;
+        while (pivot < n_equations_ && matrix_[pivot * MaxUnknowns + col] == 0) {
+            pivot++;
+        }
+        if (pivot == n_equations_) {
+            continue;
+        }
+
+        uint8_t* prow = matrix_.data() + n_pivots_ * MaxUnknowns;
+
+        if (pivot != n_pivots_) {
+            uint8_t* row = matrix_.data() + pivot * MaxUnknowns;
+            for (size_t n = 0; n < n_unknowns; n++) {
+                const uint8_t t = row[n];
+                row[n] = prow[n];
+                prow[n] = t;
+            }
+
+            const core::Slice<uint8_t> t = syndrome_tab_[pivot];
+            syndrome_tab_[pivot] = syndrome_tab_[n_pivots_];
+            syndrome_tab_[n_pivots_] = t;
+        }
+
+        for (size_t r = 0; r < n_equations_; r++) {
+            if (r == n_pivots_) {
+                continue;
+            }
+
+            uint8_t* row = matrix_.data() + r * MaxUnknowns;
+            if (row[col] == 0) {
+                continue;
+            }
+
+            const uint8_t f = gf_.div(row[col], prow[col]);
+
+            for (size_t n = 0; n < n_unknowns; n++) {
+                row[n] ^= gf_.mul(f, prow[n]);
+            }
+
+            muladd_(syndrome_tab_[r].data(), syndrome_tab_[n_pivots_].data(),
+                    gf_.split_table(f), system_payload_size_);
+        }
+
+        pivot_tab_[n_pivots_++] = col;
+    }
+}
+
+void WindowReader::restore_solved_() {
+    const size_t n_unknowns = unknown_tab_.size();
+
+    size_t n_restored = 0;
+
+    for (size_t r = 0; r < n_pivots_; r++) {
+        const uint8_t* row = matrix_.data() + r * MaxUnknowns;
+        const size_t col = pivot_tab_[r];
+
+        // symbol is determined if it's the only unknown left in equation
+        bool solved = true;
+        for (size_t n = 0; n < n_unknowns; n++) {
+            if (n != col && row[n] != 0) {
+                solved = false;
+                break;
+            }
+        }
+        if (!solved) {
+            continue;
+        }
+
+        core::Slice<uint8_t> buffer;
+
+        if (row[col] == 1) {
+            buffer = syndrome_tab_[r];
+        } else {
+            buffer = new_buffer_(system_payload_size_);
+            if (!buffer) {
+                continue;
+            }
+            memset(buffer.data(), 0, system_payload_size_);
+            muladd_(buffer.data(), syndrome_tab_[r].data(),
+                    gf_.split_table(gf_.div(1, row[col])), system_payload_size_);
+        }
+
+        if (restore_symbol_(unknown_tab_[col], buffer)) {
+            n_restored++;
+        }
+    }
+
+    roc_log(LogTrace,
+            "fec window reader: solved system: next_esi=%lu n_equations=%lu"
+            " n_unknowns=%lu n_restored=%lu",
+            (unsigned long)next_esi_, (unsigned long)n_equations_,
+            (unsigned long)n_unknowns, (unsigned long)n_restored);
+}
+
+void WindowReader::clear_system_() {
+    for (size_t n = 0; n < unknown_tab_.size(); n++) {
+        unknown_pos_[unknown_tab_[n] & SymbolTableMask] = NoPos;
+    }
+
+    if (!unknown_tab_.resize(0)) {
+        roc_panic("fec window reader: can't shrink unknown table");
+    }
+
+    for (size_t n = 0; n < n_equations_; n++) {
+        syndrome_tab_[n] = core::Slice<uint8_t>();
+    }
+
+    n_equations_ = 0;
+    n_pivots_ = 0;
+    system_payload_size_ = 0;
+}
+
+bool WindowReader::restore_symbol_(uint32_t esi, const core::Slice<uint8_t>& buffer) {
+    // restored symbols before next one are not returned, but may help
+    // to restore following symbols
+    packet::PacketPtr pp;
+
+    if (esi_diff_(esi, next_esi_) >= 0) {
+        pp = parse_repaired_packet_(buffer);
+        if (!pp) {
+            return false;
+        }
+    }
+
+    Symbol& symbol = symbol_tab_[esi & SymbolTableMask];
+    symbol.packet = pp;
+    symbol.payload = buffer;
+
+    return true;
+}
+
+packet::PacketPtr
+WindowReader::parse_repaired_packet_(const core::Slice<uint8_t>& buffer) {
+    packet::PacketPtr pp = packet_factory_.new_packet();
+    if (!pp) {
+        roc_log(LogError, "fec window reader: can't allocate packet");
+        return NULL;
+    }
+
+    if (!parser_.parse(*pp, buffer)) {
+        roc_log(LogDebug, "fec window reader: can't parse repaired packet");
+        return NULL;
+    }
+
+    pp->set_data(buffer);
+    pp->add_flags(packet::Packet::FlagRestored);
+
+    return pp;
+}
+
+core::Slice<uint8_t> WindowReader::new_buffer_(size_t size) {
+    core::Slice<uint8_t> buffer = buffer_factory_.new_buffer();
+
+    if (!buffer) {
+        roc_log(LogError, "fec window reader: can't allocate buffer");
+        return core::Slice<uint8_t>();
+    }
+
+    if (buffer.capacity() < size) {
+        roc_log(LogError, "fec window reader: packet size too large: size=%lu max=%lu",
+                (unsigned long)size, (unsigned long)buffer.capacity());
+        return core::Slice<uint8_t>();
+    }
+
+    buffer.reslice(0, size);
+
+    return buffer;
+}
+
+int32_t WindowReader::esi_diff_(uint32_t a, uint32_t b) {
+    return int32_t(a - b);
+}
+
+} // namespace fec
+} // namespace roc
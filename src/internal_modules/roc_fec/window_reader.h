@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/window_reader.h
+//! @brief Sliding window FEC reader.
+
+#ifndef ROC_FEC_WINDOW_READER_H_
+#define ROC_FEC_WINDOW_READER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/window_writer.h"
+#include "roc_packet/iparser.h"
+#include "roc_packet/ireader.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/sorted_queue.h"
+
+namespace roc {
+namespace fec {
+
+//! Sliding window FEC reader.
+//!
+//! @remarks
+//!  Decodes sliding window Random Linear Codes over GF(2^8) (RFC 8681)
+//!  produced by WindowWriter.
+//!
+//!  Source packets are returned in order of their encoding symbol IDs.
+//!  The reader keeps recent source packets and repair packets whose encoding
+//!  windows are not passed yet. When the next source packet is missing, the
+//!  reader builds a linear system from repair packets that cover it, and
+//!  solves it by Gauss-Jordan elimination. All packets that become known are
+//!  restored at once. If the next packet can't be restored and there are
+//!  following packets, it is skipped.
+class WindowReader : public packet::IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p source_reader specifies input queue with data packets;
+    //!  - @p repair_reader specifies input queue with FEC packets;
+    //!  - @p parser specifies packet parser for restored packets.
+    //!  - @p packet_factory is used to allocate restored packets
+    //!  - @p buffer_factory is used to allocate buffers for restored packets
+    //!  - @p allocator is used to initialize arrays
+    WindowReader(packet::IReader& source_reader,
+                 packet::IReader& repair_reader,
+                 packet::IParser& parser,
+                 packet::PacketFactory& packet_factory,
+                 core::BufferFactory<uint8_t>& buffer_factory,
+                 core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Did reader get first source packet?
+    bool started() const;
+
+    //! Is reader alive?
+    bool alive() const;
+
+    //! Read packet.
+    //! @remarks
+    //!  When a packet loss is detected, try to restore it from repair packets.
+    virtual packet::PacketPtr read();
+
+private:
+    enum { FetchBatchSize = 32 };
+
+    enum {
+        // maximum number of source symbols in encoding window
+        MaxWindowLength = WindowWriter::MaxWindowLength,
+
+        // number of symbols kept before and after next symbol
+        HistoryLength = MaxWindowLength,
+        LookaheadLength = 257,
+
+        SymbolTableSize = HistoryLength + LookaheadLength,
+        SymbolTableMask = SymbolTableSize - 1,
+
+        // maximum number of repair packets kept and used in linear system
+        MaxRepairPackets = MaxWindowLength,
+
+        // maximum number of unknowns in linear system
+        MaxUnknowns = MaxWindowLength
+    };
+
+    struct Symbol {
+        packet::PacketPtr packet;
+        core::Slice<uint8_t> payload;
+    };
+
+    packet::PacketPtr get_next_packet_();
+    bool has_following_packets_() const;
+    void next_symbol_();
+    void jump_to_(uint32_t esi);
+
+    void fetch_packets_();
+    bool fetch_source_packets_();
+    bool fetch_repair_packets_();
+    bool validate_fec_packet_(const packet::PacketPtr&);
+
+    void fill_source_symbols_();
+    void drop_stale_repair_packets_();
+
+    void try_repair_();
+    bool add_repair_equation_(const packet::PacketPtr&);
+    bool count_unknowns_(uint32_t first_esi,
+                         size_t n_symbols,
+                         size_t payload_size,
+                         size_t& n_unknowns,
+                         size_t& n_new_unknowns) const;
+    void eliminate_();
+    void restore_solved_();
+    void clear_system_();
+
+    bool restore_symbol_(uint32_t esi, const core::Slice<uint8_t>& buffer);
+    packet::PacketPtr parse_repaired_packet_(const core::Slice<uint8_t>& buffer);
+    core::Slice<uint8_t> new_buffer_(size_t size);
+
+    static int32_t esi_diff_(uint32_t a, uint32_t b);
+
+    packet::IReader& source_reader_;
+    packet::IReader& repair_reader_;
+    packet::IParser& parser_;
+    packet::PacketFactory& packet_factory_;
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
+    const Gf256& gf_;
+    gf256_kernel_func_t muladd_;
+
+    packet::SortedQueue source_queue_;
+
+    // received and restored source symbols, indexed by esi & SymbolTableMask
+    core::Array<Symbol> symbol_tab_;
+
+    // repair packets in order of arrival
+    core::Array<packet::PacketPtr> repair_tab_;
+
+    // linear system: for every equation (repair packet), coefficients
+    // of unknown source symbols and repair symbol minus known source symbols
+    core::Array<uint8_t> matrix_;
+    core::Array<core::Slice<uint8_t> > syndrome_tab_;
+    core::Array<uint32_t> unknown_tab_;
+    core::Array<size_t> pivot_tab_;
+    size_t n_equations_;
+    size_t n_pivots_;
+    size_t system_payload_size_;
+
+    // for every symbol table slot, its column in matrix, or -1
+    core::Array<size_t> unknown_pos_;
+
+    core::Array<uint8_t> coefs_;
+
+    bool valid_;
+
+    bool alive_;
+    bool started_;
+    bool can_repair_;
+
+    uint32_t next_esi_;
+    uint32_t last_esi_;
+
+    unsigned n_packets_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_WINDOW_READER_H_
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/window_writer.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/rlc_coefficients.h"
+#include "roc_packet/fec_scheme_to_str.h"
+
+namespace roc {
+namespace fec {
+
+WindowWriter::WindowWriter(const WriterConfig& config,
+                           packet::IWriter& writer,
+                           packet::IComposer& source_composer,
+                           packet::IComposer& repair_composer,
+                           packet::PacketFactory& packet_factory,
+                           core::BufferFactory<uint8_t>& buffer_factory,
+                           core::IAllocator& allocator)
+    : window_len_(0)
+    , n_repair_(0)
+    , payload_size_(0)
+    , writer_(writer)
+    , source_composer_(source_composer)
+    , repair_composer_(repair_composer)
+    , packet_factory_(packet_factory)
+    , buffer_factory_(buffer_factory)
+    , gf_(Gf256::instance())
+    , muladd_(NULL)
+    , window_(allocator)
+    , n_window_packets_(0)
+    , coefs_(allocator)
+    , repair_credit_(0)
+    , valid_(false)
+    , alive_(true) {
+    cur_esi_ = (uint32_t)core::fast_random(0, uint32_t(-1));
+    cur_repair_key_ = (uint16_t)core::fast_random(0, uint16_t(-1));
+
+    if (!resize(config.n_source_packets, config.n_repair_packets)) {
+        return;
+    }
+
+    if (!window_.resize(WindowMask + 1) || !coefs_.resize(MaxWindowLength)) {
+        roc_log(LogError, "fec window writer: can't allocate window memory");
+        return;
+    }
+
+    const Gf256Kernel kernel = gf256_kernel_select();
+    muladd_ = gf256_kernel_func(kernel);
+
+    roc_log(LogDebug, "fec window writer: initializing: kernel=%s",
+            gf256_kernel_to_str(kernel));
+
+    valid_ = true;
+}
+
+bool WindowWriter::valid() const {
+    return valid_;
+}
+
+bool WindowWriter::alive() const {
+    return alive_;
+}
+
+bool WindowWriter::resize(size_t window_len, size_t n_repair) {
+    if (window_len_ == window_len && n_repair_ == n_repair) {
+        return true;
+    }
+
+    if (window_len == 0) {
+        roc_log(LogError, "fec window writer: resize: window length can't be zero");
+        return false;
+    }
+
+    if (window_len > MaxWindowLength) {
+        roc_log(LogDebug,
+                "fec window writer: can't update window length, maximum value exceeded:"
+                " cur_len=%lu new_len=%lu max_len=%lu",
+                (unsigned long)window_len_, (unsigned long)window_len,
+                (unsigned long)MaxWindowLength);
+        return false;
+    }
+
+    roc_log(LogDebug,
+            "fec window writer: update window size:"
+            " cur_len=%lu cur_rpr=%lu new_len=%lu new_rpr=%lu",
+            (unsigned long)window_len_, (unsigned long)n_repair_,
+            (unsigned long)window_len, (unsigned long)n_repair);
+
+    window_len_ = window_len;
+    n_repair_ = n_repair;
+
+    return true;
+}
+
+void WindowWriter::write(const packet::PacketPtr& pp) {
+    roc_panic_if_not(valid());
+    roc_panic_if_not(pp);
+
+    if (!alive_) {
+        return;
+    }
+
+    validate_fec_packet_(pp);
+
+    const size_t payload_size = pp->fec()->payload.size();
+
+    if (payload_size == 0) {
+        roc_log(LogError, "fec window writer: payload size can't be zero");
+        alive_ = false;
+        return;
+    }
+
+    if (payload_size != payload_size_) {
+        // all symbols in encoding window should have the same size, so instead
+        // of padding we start a new window
+        if (payload_size_ != 0) {
+            roc_log(LogDebug,
+                    "fec window writer: payload size changed, resetting window:"
+                    " esi=%lu old_size=%lu new_size=%lu",
+                    (unsigned long)cur_esi_, (unsigned long)payload_size_,
+                    (unsigned long)payload_size);
+        }
+        reset_window_();
+        payload_size_ = payload_size;
+    }
+
+    write_source_packet_(pp);
+
+    repair_credit_ += n_repair_;
+
+    while (repair_credit_ >= window_len_) {
+        repair_credit_ -= window_len_;
+        write_repair_packet_();
+    }
+}
+
+void WindowWriter::reset_window_() {
+    for (size_t i = 0; i < window_.size(); i++) {
+        window_[i] = NULL;
+    }
+    n_window_packets_ = 0;
+    repair_credit_ = 0;
+}
+
+void WindowWriter::write_source_packet_(const packet::PacketPtr& pp) {
+    packet::FEC& fec = *pp->fec();
+
+    fec.encoding_symbol_id = cur_esi_;
+    fec.source_block_number = 0;
+    fec.source_block_length = 0;
+    fec.block_length = 0;
+
+    pp->add_flags(packet::Packet::FlagComposed);
+
+    if (!source_composer_.compose(*pp)) {
+        roc_panic("fec window writer: can't compose source packet");
+    }
+
+    writer_.write(pp);
+
+    window_[cur_esi_ & WindowMask] = pp;
+    if (n_window_packets_ < MaxWindowLength) {
+        n_window_packets_++;
+    }
+
+    cur_esi_++;
+}
+
+void WindowWriter::write_repair_packet_() {
+    const size_t n_symbols =
+        n_window_packets_ < window_len_ ? n_window_packets_ : window_len_;
+
+    packet::PacketPtr rp = make_repair_packet_(n_symbols);
+    if (!rp) {
+        return;
+    }
+
+    encode_repair_packet_(*rp, n_symbols);
+
+    rp->add_flags(packet::Packet::FlagComposed);
+
+    if (!repair_composer_.compose(*rp)) {
+        roc_panic("fec window writer: can't compose repair packet");
+    }
+
+    writer_.write(rp);
+
+    cur_repair_key_++;
+}
+
+packet::PacketPtr WindowWriter::make_repair_packet_(size_t n_symbols) {
+    packet::PacketPtr packet = packet_factory_.new_packet();
+    if (!packet) {
+        roc_log(LogError, "fec window writer: can't allocate packet");
+        return NULL;
+    }
+
+    core::Slice<uint8_t> data = buffer_factory_.new_buffer();
+    if (!data) {
+        roc_log(LogError, "fec window writer: can't allocate buffer");
+        return NULL;
+    }
+
+    if (!repair_composer_.align(data, 0, Alignment)) {
+        roc_log(LogError, "fec window writer: can't align packet buffer");
+        return NULL;
+    }
+
+    if (!repair_composer_.prepare(*packet, data, payload_size_)) {
+        roc_log(LogError, "fec window writer: can't prepare packet");
+        return NULL;
+    }
+
+    if (!packet->fec()) {
+        roc_log(LogError, "fec window writer: unexpected non-fec packet");
+        return NULL;
+    }
+
+    packet->set_data(data);
+
+    validate_fec_packet_(packet);
+
+    packet::FEC& fec = *packet->fec();
+
+    fec.encoding_symbol_id = uint32_t(cur_esi_ - n_symbols);
+    fec.source_block_number = cur_repair_key_;
+    fec.source_block_length = n_symbols;
+    fec.block_length = 0;
+
+    return packet;
+}
+
+void WindowWriter::encode_repair_packet_(packet::Packet& packet, size_t n_symbols) {
+    core::Slice<uint8_t>& payload = packet.fec()->payload;
+
+    roc_panic_if(payload.size() != payload_size_);
+
+    memset(payload.data(), 0, payload_size_);
+
+    rlc_coefficients(cur_repair_key_, coefs_.data(), n_symbols);
+
+    const uint32_t first_esi = uint32_t(cur_esi_ - n_symbols);
+
+    for (size_t i = 0; i < n_symbols; i++) {
+        const packet::PacketPtr& sp = window_[(first_esi + i) & WindowMask];
+        roc_panic_if(!sp);
+
+        muladd_(payload.data(), sp->fec()->payload.data(), gf_.split_table(coefs_[i]),
+                payload_size_);
+    }
+}
+
+void WindowWriter::validate_fec_packet_(const packet::PacketPtr& pp) {
+    const packet::FEC* fec = pp->fec();
+
+    if (!fec) {
+        roc_panic("fec window writer: unexpected non-fec packet");
+    }
+
+    if (fec->fec_scheme != packet::FEC_RLC) {
+        roc_panic("fec window writer: unexpected packet fec scheme:"
+                  " packet_scheme=%s session_scheme=%s",
+                  packet::fec_scheme_to_str(fec->fec_scheme),
+                  packet::fec_scheme_to_str(packet::FEC_RLC));
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/window_writer.h
+//! @brief Sliding window FEC writer.
+
+#ifndef ROC_FEC_WINDOW_WRITER_H_
+#define ROC_FEC_WINDOW_WRITER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/icomposer.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace fec {
+
+//! Sliding window FEC writer.
+//!
+//! @remarks
+//!  Implements sliding window Random Linear Codes over GF(2^8) (RFC 8681).
+//!
+//!  Unlike block codes, there are no blocks: every repair packet is a random
+//!  linear combination of the last source packets, called encoding window,
+//!  and repair packets are interleaved with source packets. A lost source
+//!  packet can be restored as soon as the receiver gets enough repair packets
+//!  that follow it, so repair delay is bounded by the window length instead
+//!  of the block length.
+//!
+//!  WriterConfig is interpreted as follows: n_source_packets defines maximum
+//!  encoding window length, and n_repair_packets defines how many repair
+//!  packets are generated per every n_source_packets source packets.
+class WindowWriter : public packet::IWriter, public core::NonCopyable<> {
+public:
+    //! Maximum encoding window length.
+    enum { MaxWindowLength = 255 };
+
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config contains FEC scheme parameters
+    //!  - @p writer is used to write source and repair packets
+    //!  - @p source_composer is used to format source packets
+    //!  - @p repair_composer is used to format repair packets
+    //!  - @p packet_factory is used to allocate repair packets
+    //!  - @p buffer_factory is used to allocate buffers for repair packets
+    //!  - @p allocator is used to initialize a packet array
+    WindowWriter(const WriterConfig& config,
+                 packet::IWriter& writer,
+                 packet::IComposer& source_composer,
+                 packet::IComposer& repair_composer,
+                 packet::PacketFactory& packet_factory,
+                 core::BufferFactory<uint8_t>& buffer_factory,
+                 core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Check if writer is still working.
+    bool alive() const;
+
+    //! Set encoding window length and number of repair packets per window.
+    bool resize(size_t window_len, size_t n_repair);
+
+    //! Write packet.
+    //! @remarks
+    //!  - writes the given source packet to the output writer
+    //!  - adds it to encoding window
+    //!  - generates repair packets when it's time and writes them too
+    virtual void write(const packet::PacketPtr&);
+
+private:
+    enum { WindowMask = 0xff };
+
+    enum { Alignment = 8 };
+
+    void reset_window_();
+
+    void write_source_packet_(const packet::PacketPtr&);
+    void write_repair_packet_();
+    packet::PacketPtr make_repair_packet_(size_t n_symbols);
+    void encode_repair_packet_(packet::Packet& packet, size_t n_symbols);
+
+    void validate_fec_packet_(const packet::PacketPtr&);
+
+    size_t window_len_;
+    size_t n_repair_;
+
+    size_t payload_size_;
+
+    packet::IWriter& writer_;
+
+    packet::IComposer& source_composer_;
+    packet::IComposer& repair_composer_;
+
+    packet::PacketFactory& packet_factory_;
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
+    const Gf256& gf_;
+    gf256_kernel_func_t muladd_;
+
+    // last source packets, indexed by esi & WindowMask
+    core::Array<packet::PacketPtr> window_;
+    size_t n_window_packets_;
+
+    core::Array<uint8_t> coefs_;
+
+    uint32_t cur_esi_;
+    uint16_t cur_repair_key_;
+
+    // incremented by n_repair_ per source packet, a repair packet is generated
+    // every time it reaches window_len_
+    size_t repair_credit_;
+
+    bool valid_;
+    bool alive_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_WINDOW_WRITER_H_
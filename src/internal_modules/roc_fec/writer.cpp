@@ -35,7 +35,12 @@ Writer::Writer(const WriterConfig& config,
     , repair_composer_(repair_composer)
     , packet_factory_(packet_factory)
     , buffer_factory_(buffer_factory)
+    , source_block_(allocator)
     , repair_block_(allocator)
+    , pending_head_(0)
+    , pending_count_(0)
+    , encoder_pos_(0)
+    , stop_(0)
     , first_packet_(true)
     , cur_packet_(0)
     , fec_scheme_(fec_scheme)
@@ -46,9 +51,36 @@ Writer::Writer(const WriterConfig& config,
     if (!resize(config.n_source_packets, config.n_repair_packets)) {
         return;
     }
+
+    if (config.async_encoding) {
+        for (size_t n = 0; n < MaxPendingBlocks; n++) {
+            pending_blocks_[n].reset(new (pending_blocks_[n]) PendingBlock(allocator));
+        }
+
+        encoder_thread_.reset(new (allocator) EncoderThread(*this), allocator);
+        if (!encoder_thread_) {
+            roc_log(LogError, "fec writer: can't allocate encoder thread");
+            return;
+        }
+
+        if (!encoder_thread_->start()) {
+            roc_log(LogError, "fec writer: can't start encoder thread");
+            encoder_thread_.reset();
+            return;
+        }
+    }
+
     valid_ = true;
 }
 
+Writer::~Writer() {
+    if (encoder_thread_) {
+        stop_ = 1;
+        encoder_thread_->wake();
+        encoder_thread_->join();
+    }
+}
+
 bool Writer::valid() const {
     return valid_;
 }
@@ -91,6 +123,30 @@ bool Writer::resize(size_t sblen, size_t rblen) {
     return true;
 }
 
+WriterMetrics Writer::metrics() const {
+    return metrics_;
+}
+
+bool Writer::flush() {
+    roc_panic_if_not(valid());
+
+    if (!alive_ || !encoder_thread_) {
+        return true;
+    }
+
+    finish_pending_blocks_();
+
+    return pending_count_ == 0;
+}
+
+void Writer::drain() {
+    roc_panic_if_not(valid());
+
+    while (!flush()) {
+        core::sleep_for(core::ClockMonotonic, core::Millisecond);
+    }
+}
+
 void Writer::write(const packet::PacketPtr& pp) {
     roc_panic_if_not(valid());
     roc_panic_if_not(pp);
@@ -99,6 +155,13 @@ void Writer::write(const packet::PacketPtr& pp) {
         return;
     }
 
+    if (encoder_thread_) {
+        finish_pending_blocks_();
+        if (!alive_) {
+            return;
+        }
+    }
+
     validate_fec_packet_(pp);
 
     if (first_packet_) {
@@ -135,6 +198,11 @@ bool Writer::begin_block_(const packet::PacketPtr& pp) {
             (unsigned long)cur_sbn_, (unsigned long)cur_sblen_, (unsigned long)cur_rblen_,
             (unsigned long)cur_payload_size_);
 
+    if (encoder_thread_) {
+        // encoder is owned by encoder thread
+        return true;
+    }
+
     if (!encoder_.begin(cur_sblen_, cur_rblen_, cur_payload_size_)) {
         roc_log(LogError,
                 "fec writer: can't begin encoder block, shutting down:"
@@ -147,26 +215,206 @@ bool Writer::begin_block_(const packet::PacketPtr& pp) {
 }
 
 void Writer::end_block_() {
+    if (encoder_thread_) {
+        end_block_async_();
+        return;
+    }
+
     make_repair_packets_();
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
     encode_repair_packets_();
-    compose_repair_packets_();
-    write_repair_packets_();
+    report_encode_time_(cur_sbn_, core::timestamp(core::ClockMonotonic) - start_time);
+
+    compose_repair_packets_(repair_block_);
+    write_repair_packets_(repair_block_);
 
     encoder_.end();
 }
 
+void Writer::end_block_async_() {
+    // Source packets are already written, so if the encoder thread is so
+    // slow that the queue is full, we skip repair packets of this block
+    // instead of blocking the caller.
+    finish_pending_blocks_();
+
+    if (pending_count_ == MaxPendingBlocks) {
+        roc_log(LogDebug,
+                "fec writer: encoder queue is full, skipping repair packets:"
+                " sbn=%lu n_pending=%lu",
+                (unsigned long)cur_sbn_, (unsigned long)pending_count_);
+
+        for (size_t i = 0; i < cur_sblen_; i++) {
+            source_block_[i] = NULL;
+        }
+        metrics_.n_skipped_blocks++;
+        return;
+    }
+
+    make_repair_packets_();
+
+    PendingBlock& block =
+        *pending_blocks_[(pending_head_ + pending_count_) % MaxPendingBlocks];
+
+    if (!start_pending_block_(block)) {
+        return;
+    }
+
+    pending_count_++;
+
+    block.state = Pending_Encoding;
+    encoder_thread_->wake();
+}
+
 void Writer::next_block_() {
     cur_block_repair_sn_ += (packet::seqnum_t)cur_rblen_;
     cur_sbn_++;
     cur_packet_ = 0;
 }
 
+bool Writer::start_pending_block_(PendingBlock& block) {
+    if (block.source_block.size() != cur_sblen_) {
+        if (!block.source_block.resize(cur_sblen_)) {
+            roc_log(LogError,
+                    "fec writer: can't allocate pending block memory, shutting down:"
+                    " sblen=%lu",
+                    (unsigned long)cur_sblen_);
+            return (alive_ = false);
+        }
+    }
+
+    if (block.repair_block.size() != cur_rblen_) {
+        if (!block.repair_block.resize(cur_rblen_)) {
+            roc_log(LogError,
+                    "fec writer: can't allocate pending block memory, shutting down:"
+                    " rblen=%lu",
+                    (unsigned long)cur_rblen_);
+            return (alive_ = false);
+        }
+    }
+
+    for (size_t i = 0; i < cur_sblen_; i++) {
+        block.source_block[i] = source_block_[i];
+        source_block_[i] = NULL;
+    }
+
+    for (size_t i = 0; i < cur_rblen_; i++) {
+        block.repair_block[i] = repair_block_[i];
+        repair_block_[i] = NULL;
+    }
+
+    block.payload_size = cur_payload_size_;
+    block.sbn = cur_sbn_;
+    block.encode_time = 0;
+    block.failed = false;
+
+    return true;
+}
+
+// Called from encoder thread.
+void Writer::encode_pending_blocks_() {
+    // blocks are queued in order, so encode them in order until we reach
+    // a block which is not queued yet
+    for (;;) {
+        PendingBlock& block = *pending_blocks_[encoder_pos_];
+
+        if (block.state != Pending_Encoding) {
+            break;
+        }
+
+        encode_pending_block_(block);
+
+        block.state = Pending_Done;
+        encoder_pos_ = (encoder_pos_ + 1) % MaxPendingBlocks;
+    }
+}
+
+// Called from encoder thread.
+void Writer::encode_pending_block_(PendingBlock& block) {
+    const size_t sblen = block.source_block.size();
+    const size_t rblen = block.repair_block.size();
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    if (!encoder_.begin(sblen, rblen, block.payload_size)) {
+        block.failed = true;
+        return;
+    }
+
+    for (size_t i = 0; i < sblen; i++) {
+        encoder_.set(i, block.source_block[i]->fec()->payload);
+    }
+
+    for (size_t i = 0; i < rblen; i++) {
+        packet::PacketPtr rp = block.repair_block[i];
+        if (rp) {
+            encoder_.set(sblen + i, rp->fec()->payload);
+        }
+    }
+
+    encoder_.fill();
+    encoder_.end();
+
+    block.encode_time = core::timestamp(core::ClockMonotonic) - start_time;
+}
+
+void Writer::finish_pending_blocks_() {
+    while (pending_count_ != 0 && alive_) {
+        PendingBlock& block = *pending_blocks_[pending_head_];
+
+        if (block.state != Pending_Done) {
+            break;
+        }
+
+        finish_pending_block_(block);
+
+        pending_head_ = (pending_head_ + 1) % MaxPendingBlocks;
+        pending_count_--;
+    }
+}
+
+void Writer::finish_pending_block_(PendingBlock& block) {
+    if (block.failed) {
+        roc_log(LogError,
+                "fec writer: can't begin encoder block, shutting down:"
+                " sblen=%lu rblen=%lu",
+                (unsigned long)block.source_block.size(),
+                (unsigned long)block.repair_block.size());
+        alive_ = false;
+    } else {
+        report_encode_time_(block.sbn, block.encode_time);
+
+        compose_repair_packets_(block.repair_block);
+        write_repair_packets_(block.repair_block);
+    }
+
+    for (size_t i = 0; i < block.source_block.size(); i++) {
+        block.source_block[i] = NULL;
+    }
+
+    for (size_t i = 0; i < block.repair_block.size(); i++) {
+        block.repair_block[i] = NULL;
+    }
+
+    block.state = Pending_Idle;
+}
+
 bool Writer::apply_sizes_(size_t sblen, size_t rblen, size_t payload_size) {
     if (payload_size == 0) {
         roc_log(LogError, "fec writer: payload size can't be zero");
         return (alive_ = false);
     }
 
+    if (encoder_thread_ && source_block_.size() != sblen) {
+        if (!source_block_.resize(sblen)) {
+            roc_log(LogError,
+                    "fec writer: can't allocate source block memory, shutting down:"
+                    " cur_sbl=%lu new_sbl=%lu",
+                    (unsigned long)source_block_.size(), (unsigned long)sblen);
+            return (alive_ = false);
+        }
+    }
+
     if (repair_block_.size() != rblen) {
         if (!repair_block_.resize(rblen)) {
             roc_log(LogError,
@@ -185,7 +433,11 @@ bool Writer::apply_sizes_(size_t sblen, size_t rblen, size_t payload_size) {
 }
 
 void Writer::write_source_packet_(const packet::PacketPtr& pp) {
-    encoder_.set(cur_packet_, pp->fec()->payload);
+    if (encoder_thread_) {
+        source_block_[cur_packet_] = pp;
+    } else {
+        encoder_.set(cur_packet_, pp->fec()->payload);
+    }
 
     pp->add_flags(packet::Packet::FlagComposed);
     fill_packet_fec_fields_(pp, (packet::seqnum_t)cur_packet_);
@@ -253,9 +505,9 @@ void Writer::encode_repair_packets_() {
     encoder_.fill();
 }
 
-void Writer::compose_repair_packets_() {
-    for (size_t i = 0; i < cur_rblen_; i++) {
-        packet::PacketPtr rp = repair_block_[i];
+void Writer::compose_repair_packets_(core::Array<packet::PacketPtr>& block) {
+    for (size_t i = 0; i < block.size(); i++) {
+        packet::PacketPtr rp = block[i];
         if (!rp) {
             continue;
         }
@@ -268,12 +520,12 @@ void Writer::compose_repair_packets_() {
     }
 }
 
-void Writer::write_repair_packets_() {
-    for (size_t i = 0; i < cur_rblen_; i++) {
-        packet::PacketPtr rp = repair_block_[i];
+void Writer::write_repair_packets_(core::Array<packet::PacketPtr>& block) {
+    for (size_t i = 0; i < block.size(); i++) {
+        packet::PacketPtr rp = block[i];
         if (rp) {
-            writer_.write(repair_block_[i]);
-            repair_block_[i] = NULL;
+            writer_.write(rp);
+            block[i] = NULL;
         }
     }
 }
@@ -318,5 +570,39 @@ bool Writer::validate_source_packet_(const packet::PacketPtr& pp) {
     return true;
 }
 
+void Writer::report_encode_time_(packet::blknum_t sbn, core::nanoseconds_t encode_time) {
+    metrics_.n_encoded_blocks++;
+    metrics_.last_encode_time = encode_time;
+    if (metrics_.max_encode_time < encode_time) {
+        metrics_.max_encode_time = encode_time;
+    }
+
+    roc_log(LogTrace, "fec writer: encoded block: sbn=%lu encode_time=%.3fms",
+            (unsigned long)sbn, (double)encode_time / core::Millisecond);
+}
+
+Writer::EncoderThread::EncoderThread(Writer& writer)
+    : writer_(writer) {
+}
+
+Writer::EncoderThread::~EncoderThread() {
+}
+
+void Writer::EncoderThread::wake() {
+    wake_sem_.post();
+}
+
+void Writer::EncoderThread::run() {
+    for (;;) {
+        wake_sem_.wait();
+
+        writer_.encode_pending_blocks_();
+
+        if (writer_.stop_) {
+            break;
+        }
+    }
+}
+
 } // namespace fec
 } // namespace roc
@@ -13,10 +13,16 @@
 #define ROC_FEC_WRITER_H_
 
 #include "roc_core/array.h"
+#include "roc_core/atomic.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/semaphore.h"
 #include "roc_core/slice.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
 #include "roc_fec/iblock_encoder.h"
 #include "roc_packet/icomposer.h"
 #include "roc_packet/iwriter.h"
@@ -34,9 +40,44 @@ struct WriterConfig {
     //! Number of FEC packets in block.
     size_t n_repair_packets;
 
+    //! Encode repair packets in a separate thread.
+    //! @remarks
+    //!  Source packets are still written immediately. When a block is
+    //!  complete, it is queued to the encoder thread, and its repair packets
+    //!  are written during one of the following write() calls, after the
+    //!  encoder thread is done with them. Blocks are encoded and written in
+    //!  order; if the encoder thread is so slow that the queue is full,
+    //!  repair packets of the new block are skipped.
+    bool async_encoding;
+
     WriterConfig()
         : n_source_packets(20)
-        , n_repair_packets(10) {
+        , n_repair_packets(10)
+        , async_encoding(false) {
+    }
+};
+
+//! FEC writer metrics.
+struct WriterMetrics {
+    //! Number of blocks for which repair packets were generated.
+    size_t n_encoded_blocks;
+
+    //! Number of blocks for which repair packets were skipped.
+    //! Happens in async mode when the queue of blocks waiting for the
+    //! encoder thread is full when next block is complete.
+    size_t n_skipped_blocks;
+
+    //! Time spent generating repair packets for the last block.
+    core::nanoseconds_t last_encode_time;
+
+    //! Maximum time spent generating repair packets for a block.
+    core::nanoseconds_t max_encode_time;
+
+    WriterMetrics()
+        : n_encoded_blocks(0)
+        , n_skipped_blocks(0)
+        , last_encode_time(0)
+        , max_encode_time(0) {
     }
 };
 
@@ -64,6 +105,13 @@ public:
            core::BufferFactory<uint8_t>& buffer_factory,
            core::IAllocator& allocator);
 
+    //! Destroy.
+    //! @remarks
+    //!  In async mode, stops the encoder thread. Doesn't write anything to
+    //!  the output writer, which may be already closed, so repair packets of
+    //!  blocks that are still queued are lost. Use drain() to write them.
+    ~Writer();
+
     //! Check if object is successfully constructed.
     bool valid() const;
 
@@ -73,6 +121,26 @@ public:
     //! Set number of source packets per block.
     bool resize(size_t sblen, size_t rblen);
 
+    //! Get encoding metrics.
+    WriterMetrics metrics() const;
+
+    //! Write repair packets that are ready.
+    //! @remarks
+    //!  In async mode, writes repair packets of queued blocks which the
+    //!  encoder thread is done with. write() does the same before writing a
+    //!  source packet; this method allows to do it when there are no source
+    //!  packets.
+    //! @returns
+    //!  false if some blocks are still queued to the encoder thread.
+    bool flush();
+
+    //! Write repair packets of all queued blocks.
+    //! @remarks
+    //!  In async mode, blocks until the encoder thread is done with all
+    //!  queued blocks, and writes their repair packets. Should be called
+    //!  before shutdown while the output writer is still alive.
+    void drain();
+
     //! Write packet.
     //! @remarks
     //!  - writes the given source packet to the output writer
@@ -80,23 +148,72 @@ public:
     virtual void write(const packet::PacketPtr&);
 
 private:
+    class EncoderThread : public core::Thread {
+    public:
+        explicit EncoderThread(Writer& writer);
+        virtual ~EncoderThread();
+
+        void wake();
+
+    private:
+        virtual void run();
+
+        Writer& writer_;
+        core::Semaphore wake_sem_;
+    };
+
+    enum { MaxPendingBlocks = 4 };
+
+    enum PendingState { Pending_Idle, Pending_Encoding, Pending_Done };
+
+    // block queued to encoder thread
+    // owned by encoder thread while state is Pending_Encoding
+    struct PendingBlock {
+        core::Array<packet::PacketPtr> source_block;
+        core::Array<packet::PacketPtr> repair_block;
+        size_t payload_size;
+        packet::blknum_t sbn;
+        core::nanoseconds_t encode_time;
+        bool failed;
+        core::Atomic<int> state;
+
+        explicit PendingBlock(core::IAllocator& allocator)
+            : source_block(allocator)
+            , repair_block(allocator)
+            , payload_size(0)
+            , sbn(0)
+            , encode_time(0)
+            , failed(false)
+            , state(Pending_Idle) {
+        }
+    };
+
     bool begin_block_(const packet::PacketPtr& pp);
     void end_block_();
+    void end_block_async_();
     void next_block_();
 
+    bool start_pending_block_(PendingBlock& block);
+    void encode_pending_blocks_();
+    void encode_pending_block_(PendingBlock& block);
+    void finish_pending_blocks_();
+    void finish_pending_block_(PendingBlock& block);
+
     bool apply_sizes_(size_t sblen, size_t rblen, size_t payload_size);
 
     void write_source_packet_(const packet::PacketPtr&);
     void make_repair_packets_();
     packet::PacketPtr make_repair_packet_(packet::seqnum_t n);
     void encode_repair_packets_();
-    void compose_repair_packets_();
-    void write_repair_packets_();
+    void compose_repair_packets_(core::Array<packet::PacketPtr>& block);
+    void write_repair_packets_(core::Array<packet::PacketPtr>& block);
     void fill_packet_fec_fields_(const packet::PacketPtr& packet, packet::seqnum_t n);
 
     void validate_fec_packet_(const packet::PacketPtr&);
     bool validate_source_packet_(const packet::PacketPtr&);
 
+    void report_encode_time_(packet::blknum_t sbn, core::nanoseconds_t encode_time);
+
     size_t cur_sblen_;
     size_t next_sblen_;
 
@@ -114,8 +231,22 @@ private:
     packet::PacketFactory& packet_factory_;
     core::BufferFactory<uint8_t>& buffer_factory_;
 
+    core::Array<packet::PacketPtr> source_block_;
     core::Array<packet::PacketPtr> repair_block_;
 
+    // ring of blocks queued to encoder thread
+    // head and count are accessed only by writing thread,
+    // encoder position is accessed only by encoder thread
+    core::Optional<PendingBlock> pending_blocks_[MaxPendingBlocks];
+    size_t pending_head_;
+    size_t pending_count_;
+    size_t encoder_pos_;
+
+    core::ScopedPtr<EncoderThread> encoder_thread_;
+    core::Atomic<int> stop_;
+
+    WriterMetrics metrics_;
+
     bool first_packet_;
 
     packet::blknum_t cur_sbn_;
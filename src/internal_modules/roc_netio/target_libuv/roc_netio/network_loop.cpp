@@ -16,6 +16,13 @@
 namespace roc {
 namespace netio {
 
+namespace {
+
+// How often loop statistics are logged, milliseconds.
+const uint64_t StatsReportInterval = 10000;
+
+} // namespace
+
 NetworkLoop::Tasks::AddUdpReceiverPort::AddUdpReceiverPort(UdpReceiverConfig& config,
                                                            packet::IWriter& writer) {
     func_ = &NetworkLoop::task_add_udp_receiver_;
@@ -112,6 +119,9 @@ NetworkLoop::NetworkLoop(packet::PacketFactory& packet_factory,
     , loop_initialized_(false)
     , stop_sem_initialized_(false)
     , task_sem_initialized_(false)
+    , stats_timer_initialized_(false)
+    , num_pending_tasks_(0)
+    , start_time_(core::timestamp(core::ClockMonotonic))
     , resolver_(*this, loop_)
     , num_open_ports_(0) {
     if (int err = uv_loop_init(&loop_)) {
@@ -121,6 +131,13 @@ NetworkLoop::NetworkLoop(packet::PacketFactory& packet_factory,
     }
     loop_initialized_ = true;
 
+#if UV_VERSION_HEX >= 0x012700 // 1.39.0
+    if (int err = uv_loop_configure(&loop_, UV_METRICS_IDLE_TIME)) {
+        roc_log(LogDebug, "network loop: uv_loop_configure(): [%s] %s",
+                uv_err_name(err), uv_strerror(err));
+    }
+#endif
+
     if (int err = uv_async_init(&loop_, &stop_sem_, stop_sem_cb_)) {
         roc_log(LogError, "network loop: uv_async_init(): [%s] %s", uv_err_name(err),
                 uv_strerror(err));
@@ -137,6 +154,23 @@ NetworkLoop::NetworkLoop(packet::PacketFactory& packet_factory,
     task_sem_.data = this;
     task_sem_initialized_ = true;
 
+    if (int err = uv_timer_init(&loop_, &stats_timer_)) {
+        roc_log(LogError, "network loop: uv_timer_init(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return;
+    }
+    stats_timer_.data = this;
+    stats_timer_initialized_ = true;
+
+    if (int err = uv_timer_start(&stats_timer_, stats_timer_cb_, StatsReportInterval,
+                                 StatsReportInterval)) {
+        roc_log(LogError, "network loop: uv_timer_start(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return;
+    }
+    // timer alone should not keep the loop running
+    uv_unref((uv_handle_t*)&stats_timer_);
+
     started_ = Thread::start();
 }
 
@@ -171,6 +205,7 @@ NetworkLoop::~NetworkLoop() {
     roc_panic_if(closing_ports_.size());
     roc_panic_if(task_sem_initialized_);
     roc_panic_if(stop_sem_initialized_);
+    roc_panic_if(stats_timer_initialized_);
 }
 
 bool NetworkLoop::valid() const {
@@ -181,6 +216,25 @@ size_t NetworkLoop::num_ports() const {
     return (size_t)num_open_ports_;
 }
 
+void NetworkLoop::get_stats(NetworkLoopStats& stats) {
+    if (!valid()) {
+        roc_panic("network loop: can't use invalid loop");
+    }
+
+    stats.num_ports = (size_t)num_open_ports_;
+    stats.num_pending_tasks = (size_t)num_pending_tasks_;
+    stats.total_time = core::timestamp(core::ClockMonotonic) - start_time_;
+
+#if UV_VERSION_HEX >= 0x012700 // 1.39.0
+    // uv_metrics_idle_time() is protected by loop mutex
+    const core::nanoseconds_t idle_time =
+        (core::nanoseconds_t)uv_metrics_idle_time(&loop_);
+    stats.busy_time = stats.total_time > idle_time ? stats.total_time - idle_time : 0;
+#else
+    stats.busy_time = 0;
+#endif
+}
+
 void NetworkLoop::schedule(NetworkTask& task, INetworkTaskCompleter& completer) {
     if (!valid()) {
         roc_panic("network loop: can't use invalid loop");
@@ -193,6 +247,7 @@ void NetworkLoop::schedule(NetworkTask& task, INetworkTaskCompleter& completer)
     task.completer_ = &completer;
     task.state_ = NetworkTask::StatePending;
 
+    ++num_pending_tasks_;
     pending_tasks_.push_back(task);
 
     if (int err = uv_async_send(&task_sem_)) {
@@ -217,6 +272,7 @@ bool NetworkLoop::schedule_and_wait(NetworkTask& task) {
     task.completer_ = NULL;
     task.state_ = NetworkTask::StatePending;
 
+    ++num_pending_tasks_;
     pending_tasks_.push_back(task);
 
     if (int err = uv_async_send(&task_sem_)) {
@@ -301,6 +357,13 @@ void NetworkLoop::stop_sem_cb_(uv_async_t* handle) {
     self.process_pending_tasks_();
 }
 
+void NetworkLoop::stats_timer_cb_(uv_timer_t* handle) {
+    roc_panic_if_not(handle);
+
+    NetworkLoop& self = *(NetworkLoop*)handle->data;
+    self.report_stats_();
+}
+
 void NetworkLoop::process_pending_tasks_() {
     // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
     // try_pop_front_exclusive() may return NULL if the queue is not empty, but
@@ -308,6 +371,8 @@ void NetworkLoop::process_pending_tasks_() {
     // before processing all tasks, but schedule() always calls uv_async_send()
     // after push_back(), so we'll wake up soon and process the rest tasks.
     while (NetworkTask* task = pending_tasks_.try_pop_front_exclusive()) {
+        --num_pending_tasks_;
+
         (this->*(task->func_))(*task);
 
         if (task->state_ == NetworkTask::StateFinishing) {
@@ -371,6 +436,20 @@ void NetworkLoop::close_all_ports_() {
     update_num_ports_();
 }
 
+void NetworkLoop::report_stats_() {
+    NetworkLoopStats stats;
+    get_stats(stats);
+
+    roc_log(LogDebug,
+            "network loop: stats: ports=%lu pending_tasks=%lu busy_time=%.3fs"
+            " utilization=%.1f%%",
+            (unsigned long)stats.num_ports, (unsigned long)stats.num_pending_tasks,
+            (double)stats.busy_time / core::Second,
+            stats.total_time > 0
+                ? (double)stats.busy_time / (double)stats.total_time * 100.0
+                : 0.0);
+}
+
 void NetworkLoop::close_all_sems_() {
     if (task_sem_initialized_) {
         uv_close((uv_handle_t*)&task_sem_, NULL);
@@ -381,6 +460,11 @@ void NetworkLoop::close_all_sems_() {
         uv_close((uv_handle_t*)&stop_sem_, NULL);
         stop_sem_initialized_ = false;
     }
+
+    if (stats_timer_initialized_) {
+        uv_close((uv_handle_t*)&stats_timer_, NULL);
+        stats_timer_initialized_ = false;
+    }
 }
 
 void NetworkLoop::task_add_udp_receiver_(NetworkTask& base_task) {
@@ -24,6 +24,7 @@
 #include "roc_core/optional.h"
 #include "roc_core/semaphore.h"
 #include "roc_core/thread.h"
+#include "roc_core/time.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
 #include "roc_netio/iconn.h"
@@ -43,6 +44,30 @@
 namespace roc {
 namespace netio {
 
+//! Network event loop statistics.
+struct NetworkLoopStats {
+    //! Number of receiver and sender ports.
+    size_t num_ports;
+
+    //! Number of scheduled tasks not yet processed by loop thread.
+    size_t num_pending_tasks;
+
+    //! Time passed since the loop was started.
+    core::nanoseconds_t total_time;
+
+    //! Time during which the loop was not waiting for events.
+    //! Utilization of the loop thread is busy_time / total_time.
+    //! Always zero if libuv is too old to provide idle time metrics.
+    core::nanoseconds_t busy_time;
+
+    NetworkLoopStats()
+        : num_ports(0)
+        , num_pending_tasks(0)
+        , total_time(0)
+        , busy_time(0) {
+    }
+};
+
 //! Network event loop thread.
 //! @remarks
 //!  This class is a task-based facade for the whole roc_netio module.
@@ -200,6 +225,11 @@ public:
     //! Get number of receiver and sender ports.
     size_t num_ports() const;
 
+    //! Get loop statistics.
+    //! @remarks
+    //!  Can be called from any thread.
+    void get_stats(NetworkLoopStats& stats);
+
     //! Enqueue a task for asynchronous execution and return.
     //! The task should not be destroyed until the callback is called.
     //! The @p completer will be invoked on event loop thread after the
@@ -216,6 +246,7 @@ public:
 private:
     static void task_sem_cb_(uv_async_t* handle);
     static void stop_sem_cb_(uv_async_t* handle);
+    static void stats_timer_cb_(uv_timer_t* handle);
 
     virtual void handle_terminate_completed(IConn&, void*);
     virtual void handle_close_completed(BasicPort&, void*);
@@ -234,6 +265,8 @@ private:
 
     void update_num_ports_();
 
+    void report_stats_();
+
     void close_all_sems_();
     void close_all_ports_();
 
@@ -259,7 +292,13 @@ private:
     uv_async_t task_sem_;
     bool task_sem_initialized_;
 
+    uv_timer_t stats_timer_;
+    bool stats_timer_initialized_;
+
     core::MpscQueue<NetworkTask, core::NoOwnership> pending_tasks_;
+    core::Atomic<int> num_pending_tasks_;
+
+    core::nanoseconds_t start_time_;
 
     Resolver resolver_;
 
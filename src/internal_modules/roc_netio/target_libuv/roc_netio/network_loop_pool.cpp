@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_netio/network_loop_pool.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace netio {
+
+const char* network_loop_policy_to_str(NetworkLoopPolicy policy) {
+    switch (policy) {
+    case NetworkLoopPolicy_RoundRobin:
+        return "round_robin";
+    case NetworkLoopPolicy_LeastLoaded:
+        return "least_loaded";
+    }
+    return "<invalid>";
+}
+
+NetworkLoopPool::NetworkLoopPool(size_t num_loops,
+                                 NetworkLoopPolicy policy,
+                                 packet::PacketFactory& packet_factory,
+                                 core::BufferFactory<uint8_t>& buffer_factory,
+                                 core::IAllocator& allocator)
+    : num_loops_(0)
+    , policy_(policy)
+    , rr_counter_(0)
+    , valid_(false) {
+    roc_log(LogDebug, "network loop pool: initializing: num_loops=%lu policy=%s",
+            (unsigned long)num_loops, network_loop_policy_to_str(policy));
+
+    if (num_loops < 1 || num_loops > MaxLoops) {
+        roc_log(LogError,
+                "network loop pool: invalid number of loops: got=%lu expected=[1; %lu]",
+                (unsigned long)num_loops, (unsigned long)MaxLoops);
+        return;
+    }
+
+    for (; num_loops_ < num_loops; num_loops_++) {
+        core::ScopedPtr<NetworkLoop>& loop = loops_[num_loops_];
+
+        loop.reset(new (allocator) NetworkLoop(packet_factory, buffer_factory, allocator),
+                   allocator);
+
+        if (!loop || !loop->valid()) {
+            roc_log(LogError, "network loop pool: can't create network loop");
+            return;
+        }
+    }
+
+    valid_ = true;
+}
+
+bool NetworkLoopPool::valid() const {
+    return valid_;
+}
+
+size_t NetworkLoopPool::num_loops() const {
+    return num_loops_;
+}
+
+NetworkLoop& NetworkLoopPool::loop(size_t index) {
+    roc_panic_if_not(valid());
+    roc_panic_if_not(index < num_loops_);
+
+    return *loops_[index];
+}
+
+NetworkLoop& NetworkLoopPool::select_loop() {
+    roc_panic_if_not(valid());
+
+    size_t index = 0;
+
+    switch (policy_) {
+    case NetworkLoopPolicy_RoundRobin:
+        index = (size_t)(unsigned)(rr_counter_++) % num_loops_;
+        break;
+
+    case NetworkLoopPolicy_LeastLoaded:
+        index = select_least_loaded_();
+        break;
+    }
+
+    roc_log(LogTrace, "network loop pool: selected loop %lu", (unsigned long)index);
+
+    return *loops_[index];
+}
+
+void NetworkLoopPool::get_stats(size_t index, NetworkLoopStats& stats) {
+    loop(index).get_stats(stats);
+}
+
+size_t NetworkLoopPool::select_least_loaded_() {
+    size_t best_index = 0;
+    size_t best_ports = 0;
+    size_t best_tasks = 0;
+
+    for (size_t n = 0; n < num_loops_; n++) {
+        NetworkLoopStats stats;
+        loops_[n]->get_stats(stats);
+
+        if (n == 0 || stats.num_ports < best_ports
+            || (stats.num_ports == best_ports && stats.num_pending_tasks < best_tasks)) {
+            best_index = n;
+            best_ports = stats.num_ports;
+            best_tasks = stats.num_pending_tasks;
+        }
+    }
+
+    return best_index;
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_libuv/roc_netio/network_loop_pool.h
+//! @brief Pool of network event loops.
+
+#ifndef ROC_NETIO_NETWORK_LOOP_POOL_H_
+#define ROC_NETIO_NETWORK_LOOP_POOL_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_netio/network_loop.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+
+//! Policy of selecting network loop for a new port.
+enum NetworkLoopPolicy {
+    //! Select loops in turn.
+    NetworkLoopPolicy_RoundRobin,
+
+    //! Select loop with fewest ports, and then with fewest pending tasks.
+    NetworkLoopPolicy_LeastLoaded
+};
+
+//! Get string name of network loop policy.
+const char* network_loop_policy_to_str(NetworkLoopPolicy policy);
+
+//! Pool of network event loops.
+//! @remarks
+//!  Owns a fixed number of network loops, each running its own thread,
+//!  and selects a loop for every new port according to policy.
+class NetworkLoopPool : public core::NonCopyable<> {
+public:
+    //! Maximum number of loops in pool.
+    enum { MaxLoops = 16 };
+
+    //! Initialize.
+    //! @remarks
+    //!  Creates and starts @p num_loops loops.
+    NetworkLoopPool(size_t num_loops,
+                    NetworkLoopPolicy policy,
+                    packet::PacketFactory& packet_factory,
+                    core::BufferFactory<uint8_t>& buffer_factory,
+                    core::IAllocator& allocator);
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Get number of loops.
+    size_t num_loops() const;
+
+    //! Get loop by index.
+    NetworkLoop& loop(size_t index);
+
+    //! Select loop for a new port.
+    //! @remarks
+    //!  Thread-safe. Least-loaded policy looks at current number of ports,
+    //!  so concurrent callers may select the same loop before any of them
+    //!  adds a port.
+    NetworkLoop& select_loop();
+
+    //! Get statistics of loop by index.
+    void get_stats(size_t index, NetworkLoopStats& stats);
+
+private:
+    size_t select_least_loaded_();
+
+    core::ScopedPtr<NetworkLoop> loops_[MaxLoops];
+    size_t num_loops_;
+
+    const NetworkLoopPolicy policy_;
+    core::Atomic<int> rr_counter_;
+
+    bool valid_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_NETWORK_LOOP_POOL_H_
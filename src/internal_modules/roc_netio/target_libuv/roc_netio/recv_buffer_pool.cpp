@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_netio/recv_buffer_pool.h"
+#include "roc_core/align_ops.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace netio {
+
+RecvBufferPool::RecvBufferPool(core::BufferFactory<uint8_t>& buffer_factory,
+                               size_t num_slabs,
+                               core::IAllocator& allocator)
+    : buffer_factory_(buffer_factory)
+    , slabs_(allocator)
+    , cur_slab_(0)
+    , cur_offset_(0)
+    , n_hits_(0)
+    , n_misses_(0)
+    , valid_(false) {
+    if (num_slabs == 0) {
+        roc_log(LogError, "recv buffer pool: number of slabs should be positive");
+        return;
+    }
+
+    if (!slabs_.resize(num_slabs)) {
+        roc_log(LogError, "recv buffer pool: can't allocate ring of size %lu",
+                (unsigned long)num_slabs);
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool RecvBufferPool::valid() const {
+    return valid_;
+}
+
+core::Slice<uint8_t> RecvBufferPool::copy(const uint8_t* data, size_t size) {
+    roc_panic_if_not(valid());
+    roc_panic_if_not(data);
+
+    if (size > buffer_factory_.buffer_size()) {
+        roc_log(LogError, "recv buffer pool: payload too large: size=%lu max=%lu",
+                (unsigned long)size, (unsigned long)buffer_factory_.buffer_size());
+        return core::Slice<uint8_t>();
+    }
+
+    // keep payloads maximum aligned, as they were in separate buffers
+    size_t offset = core::AlignOps::align_max(cur_offset_);
+
+    if (!slabs_[cur_slab_] || offset + size > slabs_[cur_slab_]->size()) {
+        if (!next_slab_()) {
+            return core::Slice<uint8_t>();
+        }
+        offset = 0;
+    }
+
+    core::Buffer<uint8_t>& slab = *slabs_[cur_slab_];
+
+    memcpy(slab.data() + offset, data, size);
+    cur_offset_ = offset + size;
+
+    return core::Slice<uint8_t>(slab, offset, offset + size);
+}
+
+size_t RecvBufferPool::num_hits() const {
+    return n_hits_;
+}
+
+size_t RecvBufferPool::num_misses() const {
+    return n_misses_;
+}
+
+bool RecvBufferPool::next_slab_() {
+    if (slabs_[cur_slab_]) {
+        cur_slab_ = (cur_slab_ + 1) % slabs_.size();
+    }
+
+    cur_offset_ = 0;
+
+    core::SharedPtr<core::Buffer<uint8_t> >& slab = slabs_[cur_slab_];
+
+    // If we hold the only reference, all packets using the slab are gone,
+    // and nobody else can acquire a new reference to it.
+    if (slab && slab->getref() == 1) {
+        n_hits_++;
+        return true;
+    }
+
+    n_misses_++;
+
+    slab = buffer_factory_.new_buffer();
+    if (!slab) {
+        roc_log(LogError, "recv buffer pool: can't allocate buffer");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace netio
+} // namespace roc
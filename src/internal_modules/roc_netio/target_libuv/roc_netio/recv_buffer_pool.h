@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_libuv/roc_netio/recv_buffer_pool.h
+//! @brief Receive buffer pool.
+
+#ifndef ROC_NETIO_RECV_BUFFER_POOL_H_
+#define ROC_NETIO_RECV_BUFFER_POOL_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/slice.h"
+
+namespace roc {
+namespace netio {
+
+//! Receive buffer pool.
+//!
+//! Holds a ring of buffers ("slabs") allocated from buffer factory. Received
+//! payloads are copied into the current slab one after another, so that a
+//! packet holds only as much memory as its payload needs, and a single slab
+//! is shared by several small packets.
+//!
+//! When current slab is full, pool moves to the next slab in the ring. If
+//! all packets referring that slab were already released, the slab is reused
+//! in place (a hit). Otherwise the pool drops its reference to the slab,
+//! which returns to the factory when its last packet is released, and takes
+//! a new slab from the factory (a miss).
+//!
+//! Not thread-safe; should be used from the network thread owning the port.
+//! Slabs may be released from any thread.
+class RecvBufferPool : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Size of every slab is the buffer size of @p buffer_factory.
+    RecvBufferPool(core::BufferFactory<uint8_t>& buffer_factory,
+                   size_t num_slabs,
+                   core::IAllocator& allocator);
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Copy payload into pool.
+    //! @returns
+    //!  slice referring to the copy, or null slice if a new slab can't
+    //!  be allocated or payload is larger than slab.
+    core::Slice<uint8_t> copy(const uint8_t* data, size_t size);
+
+    //! Number of times a slab was reused without going to factory.
+    size_t num_hits() const;
+
+    //! Number of times a slab was taken from factory.
+    size_t num_misses() const;
+
+private:
+    bool next_slab_();
+
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
+    core::Array<core::SharedPtr<core::Buffer<uint8_t> > > slabs_;
+
+    size_t cur_slab_;
+    size_t cur_offset_;
+
+    size_t n_hits_;
+    size_t n_misses_;
+
+    bool valid_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_RECV_BUFFER_POOL_H_
@@ -29,6 +29,13 @@ UdpReceiverPort::UdpReceiverPort(const UdpReceiverConfig& config,
     , close_handler_arg_(NULL)
     , loop_(event_loop)
     , handle_initialized_(false)
+    , poll_handle_initialized_(false)
+    , poll_started_(false)
+    , fd_()
+    , batch_datagrams_(allocator)
+    , batch_packets_(allocator)
+    , recv_buf_(allocator)
+    , recv_pool_(buffer_factory, config.recv_pool_size, allocator)
     , multicast_group_joined_(false)
     , recv_started_(false)
     , closed_(false)
@@ -39,7 +46,7 @@ UdpReceiverPort::UdpReceiverPort(const UdpReceiverConfig& config,
 }
 
 UdpReceiverPort::~UdpReceiverPort() {
-    if (handle_initialized_) {
+    if (handle_initialized_ || poll_handle_initialized_) {
         roc_panic(
             "udp receiver: %s: receiver was not fully closed before calling destructor",
             descriptor());
@@ -51,6 +58,20 @@ const address::SocketAddr& UdpReceiverPort::bind_address() const {
 }
 
 bool UdpReceiverPort::open() {
+    if (!recv_pool_.valid()) {
+        roc_log(LogError, "udp receiver: %s: can't create receive buffer pool",
+                descriptor());
+        return false;
+    }
+
+    const size_t n_bufs = config_.batch_size > 1 ? config_.batch_size : 1;
+
+    if (!recv_buf_.resize(buffer_factory_.buffer_size() * n_bufs)) {
+        roc_log(LogError, "udp receiver: %s: can't allocate receive buffer",
+                descriptor());
+        return false;
+    }
+
     if (int err = uv_udp_init(&loop_, &handle_)) {
         roc_log(LogError, "udp receiver: %s: uv_udp_init(): [%s] %s", descriptor(),
                 uv_err_name(err), uv_strerror(err));
@@ -60,6 +81,15 @@ bool UdpReceiverPort::open() {
     handle_.data = this;
     handle_initialized_ = true;
 
+    if (config_.reuseport) {
+        if (config_.reuseport_exclusive && !check_exclusive_bind_()) {
+            return false;
+        }
+        if (!open_reuseport_socket_()) {
+            return false;
+        }
+    }
+
     unsigned flags = 0;
     if ((config_.reuseaddr || config_.bind_address.multicast())
         && config_.bind_address.port() > 0) {
@@ -103,13 +133,20 @@ bool UdpReceiverPort::open() {
         }
     }
 
-    if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
-        roc_log(LogError, "udp receiver: %s: uv_udp_recv_start(): [%s] %s", descriptor(),
-                uv_err_name(err), uv_strerror(err));
-        return false;
+    if (config_.batch_size > 1) {
+        if (!start_batch_recv_()) {
+            return false;
+        }
+    } else {
+        if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+            roc_log(LogError, "udp receiver: %s: uv_udp_recv_start(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+
+        recv_started_ = true;
     }
 
-    recv_started_ = true;
     update_descriptor();
 
     roc_log(LogDebug, "udp receiver: %s: opened port", descriptor());
@@ -117,6 +154,63 @@ bool UdpReceiverPort::open() {
     return true;
 }
 
+// Sockets with SO_REUSEPORT may be bound to an address that is already bound
+// by another socket with SO_REUSEPORT, even from another process. To ensure
+// that we own the address, we bind it once without SO_REUSEPORT and close
+// the socket. If port is zero, this also selects the port for all receivers.
+bool UdpReceiverPort::check_exclusive_bind_() {
+    SocketHandle sock = SocketInvalid;
+
+    if (!socket_create(config_.bind_address.family(), SocketType_Udp, sock)) {
+        roc_log(LogError, "udp receiver: %s: socket_create() failed", descriptor());
+        return false;
+    }
+
+    if (!socket_bind(sock, config_.bind_address)) {
+        roc_log(LogError,
+                "udp receiver: %s: address is already in use, can't share it:"
+                " address=%s",
+                descriptor(),
+                address::socket_addr_to_str(config_.bind_address).c_str());
+        socket_close(sock);
+        return false;
+    }
+
+    if (!socket_close(sock)) {
+        roc_log(LogError, "udp receiver: %s: socket_close() failed", descriptor());
+        return false;
+    }
+
+    return true;
+}
+
+// libuv doesn't support SO_REUSEPORT on all platforms, so we create socket
+// by ourselves, enable the option, and pass socket to libuv before binding.
+bool UdpReceiverPort::open_reuseport_socket_() {
+    SocketHandle sock = SocketInvalid;
+
+    if (!socket_create(config_.bind_address.family(), SocketType_Udp, sock)) {
+        roc_log(LogError, "udp receiver: %s: socket_create() failed", descriptor());
+        return false;
+    }
+
+    if (!socket_set_reuseport(sock)) {
+        roc_log(LogError, "udp receiver: %s: socket_set_reuseport() failed",
+                descriptor());
+        socket_close(sock);
+        return false;
+    }
+
+    if (int err = uv_udp_open(&handle_, sock)) {
+        roc_log(LogError, "udp receiver: %s: uv_udp_open(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        socket_close(sock);
+        return false;
+    }
+
+    return true;
+}
+
 AsyncOperationStatus UdpReceiverPort::async_close(ICloseHandler& handler,
                                                   void* handler_arg) {
     if (close_handler_) {
@@ -126,7 +220,7 @@ AsyncOperationStatus UdpReceiverPort::async_close(ICloseHandler& handler,
     close_handler_ = &handler;
     close_handler_arg_ = handler_arg;
 
-    if (!handle_initialized_) {
+    if (!handle_initialized_ && !poll_handle_initialized_) {
         return AsyncOp_Completed;
     }
 
@@ -144,11 +238,24 @@ AsyncOperationStatus UdpReceiverPort::async_close(ICloseHandler& handler,
         recv_started_ = false;
     }
 
+    if (poll_started_) {
+        if (int err = uv_poll_stop(&poll_handle_)) {
+            roc_log(LogError, "udp receiver: %s: uv_poll_stop(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+        }
+        poll_started_ = false;
+    }
+
     if (multicast_group_joined_) {
         leave_multicast_group_();
     }
 
-    if (!uv_is_closing((uv_handle_t*)&handle_)) {
+    // poll handle should be closed before socket
+    if (poll_handle_initialized_ && !uv_is_closing((uv_handle_t*)&poll_handle_)) {
+        uv_close((uv_handle_t*)&poll_handle_, close_cb_);
+    }
+
+    if (handle_initialized_ && !uv_is_closing((uv_handle_t*)&handle_)) {
         uv_close((uv_handle_t*)&handle_, close_cb_);
     }
 
@@ -160,9 +267,19 @@ void UdpReceiverPort::close_cb_(uv_handle_t* handle) {
 
     UdpReceiverPort& self = *(UdpReceiverPort*)handle->data;
 
-    self.handle_initialized_ = false;
+    if (handle == (uv_handle_t*)&self.handle_) {
+        self.handle_initialized_ = false;
+    } else {
+        self.poll_handle_initialized_ = false;
+    }
 
-    roc_log(LogDebug, "udp receiver: %s: closed port", self.descriptor());
+    if (self.handle_initialized_ || self.poll_handle_initialized_) {
+        return;
+    }
+
+    roc_log(LogDebug, "udp receiver: %s: closed port: pool_hits=%lu pool_misses=%lu",
+            self.descriptor(), (unsigned long)self.recv_pool_.num_hits(),
+            (unsigned long)self.recv_pool_.num_misses());
 
     roc_panic_if_not(self.close_handler_);
 
@@ -176,23 +293,13 @@ void UdpReceiverPort::alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf)
 
     UdpReceiverPort& self = *(UdpReceiverPort*)handle->data;
 
-    core::SharedPtr<core::Buffer<uint8_t> > bp = self.buffer_factory_.new_buffer();
-    if (!bp) {
-        roc_log(LogError, "udp receiver: %s: can't allocate buffer", self.descriptor());
-
-        buf->base = NULL;
-        buf->len = 0;
-
-        return;
-    }
-
-    if (size > bp->size()) {
-        size = bp->size();
+    // libuv calls recv_cb_() right after every alloc_cb_(), so the same
+    // receive buffer is reused for every datagram
+    if (size > self.recv_buf_.size()) {
+        size = self.recv_buf_.size();
     }
 
-    bp->incref(); // will be decremented in recv_cb_()
-
-    buf->base = (char*)bp->data();
+    buf->base = (char*)self.recv_buf_.data();
     buf->len = size;
 }
 
@@ -218,16 +325,6 @@ void UdpReceiverPort::recv_cb_(uv_udp_t* handle,
         }
     }
 
-    core::SharedPtr<core::Buffer<uint8_t> > bp =
-        core::Buffer<uint8_t>::container_of(buf->base);
-
-    // one reference for incref() called from alloc_cb_()
-    // one reference for the shared pointer above
-    roc_panic_if(bp->getref() != 2);
-
-    // decrement reference counter incremented in alloc_cb_()
-    bp->decref();
-
     if (nread < 0) {
         roc_log(
             LogError, "udp receiver: %s: network error: num=%u src=%s dst=%s nread=%ld",
@@ -271,25 +368,182 @@ void UdpReceiverPort::recv_cb_(uv_udp_t* handle,
             address::socket_addr_to_str(src_addr).c_str(),
             address::socket_addr_to_str(self.config_.bind_address).c_str(), (long)nread);
 
-    if ((size_t)nread > bp->size()) {
+    if ((size_t)nread > buf->len) {
         roc_panic("udp receiver: %s: unexpected buffer size: got %ld, max %ld",
-                  self.descriptor(), (long)nread, (long)bp->size());
+                  self.descriptor(), (long)nread, (long)buf->len);
     }
 
-    packet::PacketPtr pp = self.packet_factory_.new_packet();
+    packet::PacketPtr pp =
+        self.make_packet_((const uint8_t*)buf->base, (size_t)nread, src_addr);
     if (!pp) {
-        roc_log(LogError, "udp receiver: %s: can't allocate packet", self.descriptor());
         return;
     }
 
+    self.writer_.write(pp);
+}
+
+void UdpReceiverPort::poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+    roc_panic_if_not(handle->data);
+
+    UdpReceiverPort& self = *(UdpReceiverPort*)handle->data;
+
+    if (status < 0) {
+        roc_log(LogError, "udp receiver: %s: poll failed: [%s] %s", self.descriptor(),
+                uv_err_name(status), uv_strerror(status));
+        return;
+    }
+
+    if ((events & UV_READABLE) == 0) {
+        return;
+    }
+
+    self.recv_batch_();
+}
+
+// Socket is still owned by uv_udp_t handle, which is used for binding and
+// multicast setup, but reading is performed by us when poll handle reports
+// that socket is readable. Since uv_udp_recv_start() is never called, libuv
+// doesn't watch the socket by itself.
+bool UdpReceiverPort::start_batch_recv_() {
+    if (int err = uv_fileno((uv_handle_t*)&handle_, &fd_)) {
+        roc_log(LogError, "udp receiver: %s: uv_fileno(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    if (!batch_datagrams_.resize(config_.batch_size)
+        || !batch_packets_.resize(config_.batch_size)) {
+        roc_log(LogError, "udp receiver: %s: can't allocate batch of size %lu",
+                descriptor(), (unsigned long)config_.batch_size);
+        return false;
+    }
+
+    // every datagram of batch gets its own part of receive buffer
+    const size_t buf_size = buffer_factory_.buffer_size();
+
+    for (size_t n = 0; n < batch_datagrams_.size(); n++) {
+        batch_datagrams_[n].buf = recv_buf_.data() + n * buf_size;
+        batch_datagrams_[n].bufsz = buf_size;
+    }
+
+    poll_handle_.data = this;
+
+    if (int err = uv_poll_init_socket(&loop_, &poll_handle_, fd_)) {
+        roc_log(LogError, "udp receiver: %s: uv_poll_init_socket(): [%s] %s",
+                descriptor(), uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    poll_handle_initialized_ = true;
+
+    if (int err = uv_poll_start(&poll_handle_, UV_READABLE, poll_cb_)) {
+        roc_log(LogError, "udp receiver: %s: uv_poll_start(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    poll_started_ = true;
+
+    roc_log(LogDebug, "udp receiver: %s: enabled batched receive: batch_size=%lu",
+            descriptor(), (unsigned long)config_.batch_size);
+
+    return true;
+}
+
+void UdpReceiverPort::recv_batch_() {
+    const ssize_t n_read =
+        socket_try_recv_batch(fd_, batch_datagrams_.data(), batch_datagrams_.size());
+
+    if (n_read == IOErr_WouldBlock) {
+        return;
+    }
+
+    if (n_read < 0) {
+        roc_log(LogError, "udp receiver: %s: network error: num=%u dst=%s",
+                descriptor(), packet_counter_,
+                address::socket_addr_to_str(config_.bind_address).c_str());
+        return;
+    }
+
+    roc_log(LogTrace, "udp receiver: %s: received batch: n_datagrams=%ld", descriptor(),
+            (long)n_read);
+
+    size_t n_packets = 0;
+
+    for (size_t n = 0; n < (size_t)n_read; n++) {
+        const SocketDatagram& dgm = batch_datagrams_[n];
+
+        if (dgm.size == 0) {
+            roc_log(LogTrace, "udp receiver: %s: empty packet: num=%u src=%s dst=%s",
+                    descriptor(), packet_counter_,
+                    address::socket_addr_to_str(dgm.address).c_str(),
+                    address::socket_addr_to_str(config_.bind_address).c_str());
+            continue;
+        }
+
+        if (dgm.truncated) {
+            roc_log(LogDebug,
+                    "udp receiver: %s:"
+                    " ignoring partial read: num=%u src=%s dst=%s nread=%lu",
+                    descriptor(), packet_counter_,
+                    address::socket_addr_to_str(dgm.address).c_str(),
+                    address::socket_addr_to_str(config_.bind_address).c_str(),
+                    (unsigned long)dgm.size);
+            continue;
+        }
+
+        packet_counter_++;
+
+        roc_log(LogTrace,
+                "udp receiver: %s: received packet: num=%u src=%s dst=%s nread=%lu",
+                descriptor(), packet_counter_,
+                address::socket_addr_to_str(dgm.address).c_str(),
+                address::socket_addr_to_str(config_.bind_address).c_str(),
+                (unsigned long)dgm.size);
+
+        packet::PacketPtr pp =
+            make_packet_((const uint8_t*)dgm.buf, dgm.size, dgm.address);
+        if (pp) {
+            batch_packets_[n_packets++] = pp;
+        }
+    }
+
+    if (n_packets == 0) {
+        return;
+    }
+
+    // whole batch is passed to pipeline at once
+    writer_.write_batch(batch_packets_.data(), n_packets);
+
+    for (size_t n = 0; n < n_packets; n++) {
+        batch_packets_[n] = NULL;
+    }
+}
+
+packet::PacketPtr UdpReceiverPort::make_packet_(const uint8_t* data,
+                                                size_t size,
+                                                const address::SocketAddr& src_addr) {
+    core::Slice<uint8_t> buf = recv_pool_.copy(data, size);
+    if (!buf) {
+        roc_log(LogError, "udp receiver: %s: can't allocate buffer", descriptor());
+        return NULL;
+    }
+
+    packet::PacketPtr pp = packet_factory_.new_packet();
+    if (!pp) {
+        roc_log(LogError, "udp receiver: %s: can't allocate packet", descriptor());
+        return NULL;
+    }
+
     pp->add_flags(packet::Packet::FlagUDP);
 
     pp->udp()->src_addr = src_addr;
-    pp->udp()->dst_addr = self.config_.bind_address;
+    pp->udp()->dst_addr = config_.bind_address;
 
-    pp->set_data(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
+    pp->set_data(buf);
 
-    self.writer_.write(pp);
+    return pp;
 }
 
 bool UdpReceiverPort::join_multicast_group_() {
@@ -15,12 +15,15 @@
 #include <uv.h>
 
 #include "roc_address/socket_addr.h"
+#include "roc_core/array.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/list_node.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
+#include "roc_netio/recv_buffer_pool.h"
+#include "roc_netio/socket_ops.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_factory.h"
 
@@ -43,8 +46,39 @@ struct UdpReceiverConfig {
     //! binding to non-ephemeral port.
     bool reuseaddr;
 
+    //! If set, enable SO_REUSEPORT before binding socket.
+    //! Allows to bind several receivers to the same address, e.g. one per
+    //! network thread. On Linux, kernel distributes incoming flows between
+    //! them. All receivers sharing address should enable this option.
+    bool reuseport;
+
+    //! If set together with reuseport, check that the address is not used
+    //! by any other socket before binding, by binding it once without
+    //! SO_REUSEPORT. Should be set for the first of several receivers
+    //! sharing address, so that traffic is not silently shared with
+    //! another process that also uses SO_REUSEPORT.
+    bool reuseport_exclusive;
+
+    //! Maximum number of datagrams to read per wakeup.
+    //! If greater than one, receiver polls socket by itself and reads up to
+    //! this number of datagrams at once, using a single system call if the
+    //! platform supports it (recvmmsg). Otherwise, datagrams are read by
+    //! libuv one by one.
+    size_t batch_size;
+
+    //! Number of buffers in receive buffer pool.
+    //! Datagrams are read into a buffer owned by receiver and then copied into
+    //! a buffer from pool, which is shared by several packets if they are small.
+    //! Buffers are reused in place if all their packets were already released.
+    //! Should be positive.
+    size_t recv_pool_size;
+
     UdpReceiverConfig()
-        : reuseaddr(false) {
+        : reuseaddr(false)
+        , reuseport(false)
+        , reuseport_exclusive(false)
+        , batch_size(0)
+        , recv_pool_size(16) {
         multicast_interface[0] = '\0';
     }
 };
@@ -84,6 +118,16 @@ private:
                          const uv_buf_t* buf,
                          const sockaddr* addr,
                          unsigned flags);
+    static void poll_cb_(uv_poll_t* handle, int status, int events);
+
+    bool check_exclusive_bind_();
+    bool open_reuseport_socket_();
+
+    bool start_batch_recv_();
+    void recv_batch_();
+
+    packet::PacketPtr
+    make_packet_(const uint8_t* data, size_t size, const address::SocketAddr& src_addr);
 
     bool join_multicast_group_();
     void leave_multicast_group_();
@@ -99,6 +143,19 @@ private:
     uv_udp_t handle_;
     bool handle_initialized_;
 
+    uv_poll_t poll_handle_;
+    bool poll_handle_initialized_;
+    bool poll_started_;
+
+    uv_os_fd_t fd_;
+
+    core::Array<SocketDatagram> batch_datagrams_;
+    core::Array<packet::PacketPtr> batch_packets_;
+
+    // datagrams are read here before copying to pool
+    core::Array<uint8_t> recv_buf_;
+    RecvBufferPool recv_pool_;
+
     bool multicast_group_joined_;
     bool recv_started_;
     bool closed_;
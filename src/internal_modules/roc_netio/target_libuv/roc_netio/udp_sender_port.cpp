@@ -32,6 +32,9 @@ UdpSenderPort::UdpSenderPort(const UdpSenderConfig& config,
     , loop_(event_loop)
     , write_sem_initialized_(false)
     , handle_initialized_(false)
+    , batch_datagrams_(allocator)
+    , batch_packets_(allocator)
+    , gso_enabled_(config.gso_enabled)
     , pending_packets_(0)
     , sent_packets_(0)
     , sent_packets_blk_(0)
@@ -124,6 +127,18 @@ bool UdpSenderPort::open() {
                   uv_err_name(fd_err), uv_strerror(fd_err));
     }
 
+    if (config_.batch_size > 1) {
+        if (!batch_datagrams_.resize(config_.batch_size)
+            || !batch_packets_.resize(config_.batch_size)) {
+            roc_log(LogError, "udp sender: %s: can't allocate batch of size %lu",
+                    descriptor(), (unsigned long)config_.batch_size);
+            return false;
+        }
+
+        roc_log(LogDebug, "udp sender: %s: enabled batched send: batch_size=%lu gso=%d",
+                descriptor(), (unsigned long)config_.batch_size, (int)gso_enabled_);
+    }
+
     stopped_ = false;
     update_descriptor();
 
@@ -179,7 +194,7 @@ void UdpSenderPort::write(const packet::PacketPtr& pp) {
 void UdpSenderPort::write_(const packet::PacketPtr& pp) {
     const bool had_pending = (++pending_packets_ > 1);
 
-    if (!had_pending) {
+    if (!had_pending && config_.batch_size <= 1) {
         if (try_nonblocking_send_(pp)) {
             --pending_packets_;
             return;
@@ -222,39 +237,112 @@ void UdpSenderPort::write_sem_cb_(uv_async_t* handle) {
 
     UdpSenderPort& self = *(UdpSenderPort*)handle->data;
 
+    if (self.config_.batch_size > 1) {
+        self.send_batches_();
+    }
+
     // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
     // try_pop_front_exclusive() may return NULL if the queue is not empty, but
     // push_back() is currently in progress. In this case we can exit the loop
     // before processing all packets, but write() always calls uv_async_send()
     // after push_back(), so we'll wake up soon and process the rest packets.
     while (packet::PacketPtr pp = self.queue_.try_pop_front_exclusive()) {
-        packet::UDP& udp = *pp->udp();
+        self.send_async_(pp);
+    }
+}
 
-        const int packet_num = ++self.sent_packets_;
-        ++self.sent_packets_blk_;
+// Sends queued packets directly from network thread, in batches.
+// Stops when socket can't accept more packets without blocking; remaining
+// packets are then sent asynchronously via libuv.
+void UdpSenderPort::send_batches_() {
+    for (;;) {
+        // packets pending in libuv queue should be sent first to keep order
+        if (handle_.send_queue_count != 0) {
+            return;
+        }
 
-        roc_log(LogTrace, "udp sender: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
-                self.descriptor(), packet_num,
-                address::socket_addr_to_str(self.config_.bind_address).c_str(),
-                address::socket_addr_to_str(udp.dst_addr).c_str(),
-                (long)pp->data().size());
+        size_t n_packets = 0;
+
+        while (n_packets < batch_packets_.size()) {
+            packet::PacketPtr pp = queue_.try_pop_front_exclusive();
+            if (!pp) {
+                break;
+            }
+
+            SocketDatagram& dgm = batch_datagrams_[n_packets];
+
+            dgm.buf = pp->data().data();
+            dgm.size = pp->data().size();
+            dgm.address = pp->udp()->dst_addr;
+
+            batch_packets_[n_packets] = pp;
+            n_packets++;
+        }
+
+        if (n_packets == 0) {
+            return;
+        }
 
-        uv_buf_t buf;
-        buf.base = (char*)pp->data().data();
-        buf.len = pp->data().size();
+        ssize_t ret =
+            socket_try_send_batch(fd_, batch_datagrams_.data(), n_packets, gso_enabled_);
 
-        udp.request.data = &self;
+        if (ret == IOErr_Failure && gso_enabled_) {
+            roc_log(LogInfo, "udp sender: %s: batched send failed, disabling gso",
+                    descriptor());
 
-        if (int err = uv_udp_send(&udp.request, &self.handle_, &buf, 1,
-                                  udp.dst_addr.saddr(), send_cb_)) {
-            roc_log(LogError, "udp sender: %s: uv_udp_send(): [%s] %s", self.descriptor(),
-                    uv_err_name(err), uv_strerror(err));
-            continue;
+            gso_enabled_ = false;
+            ret = socket_try_send_batch(fd_, batch_datagrams_.data(), n_packets, false);
         }
 
-        // will be decremented in send_cb_()
-        pp->incref();
+        const size_t n_sent = ret > 0 ? (size_t)ret : 0;
+
+        roc_log(LogTrace, "udp sender: %s: sent batch: n_packets=%lu n_sent=%lu",
+                descriptor(), (unsigned long)n_packets, (unsigned long)n_sent);
+
+        for (size_t n = 0; n < n_packets; n++) {
+            if (n < n_sent) {
+                ++sent_packets_;
+                finish_packet_();
+            } else {
+                send_async_(batch_packets_[n]);
+            }
+            batch_packets_[n].reset();
+        }
+
+        if (n_sent < n_packets) {
+            return;
+        }
+    }
+}
+
+void UdpSenderPort::send_async_(const packet::PacketPtr& pp) {
+    packet::UDP& udp = *pp->udp();
+
+    const int packet_num = ++sent_packets_;
+    ++sent_packets_blk_;
+
+    roc_log(LogTrace, "udp sender: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
+            descriptor(), packet_num,
+            address::socket_addr_to_str(config_.bind_address).c_str(),
+            address::socket_addr_to_str(udp.dst_addr).c_str(), (long)pp->data().size());
+
+    uv_buf_t buf;
+    buf.base = (char*)pp->data().data();
+    buf.len = pp->data().size();
+
+    udp.request.data = this;
+
+    if (int err = uv_udp_send(&udp.request, &handle_, &buf, 1, udp.dst_addr.saddr(),
+                              send_cb_)) {
+        roc_log(LogError, "udp sender: %s: uv_udp_send(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        // send_cb_() won't be called
+        finish_packet_();
+        return;
     }
+
+    // will be decremented in send_cb_()
+    pp->incref();
 }
 
 void UdpSenderPort::send_cb_(uv_udp_send_t* req, int status) {
@@ -282,10 +370,14 @@ void UdpSenderPort::send_cb_(uv_udp_send_t* req, int status) {
                 (long)pp->data().size(), uv_err_name(status), uv_strerror(status));
     }
 
-    const int pending_packets = --self.pending_packets_;
+    self.finish_packet_();
+}
 
-    if (pending_packets == 0 && self.stopped_) {
-        self.start_closing_();
+void UdpSenderPort::finish_packet_() {
+    const int pending_packets = --pending_packets_;
+
+    if (pending_packets == 0 && stopped_) {
+        start_closing_();
     }
 }
 
@@ -324,7 +416,7 @@ bool UdpSenderPort::try_nonblocking_send_(const packet::PacketPtr& pp) {
 
     const packet::UDP& udp = *pp->udp();
     const bool success =
-        socket_try_send_to(fd_, pp->data().data(), pp->data().size(), udp.dst_addr);
+        socket_try_send_to(fd_, pp->data().data(), pp->data().size(), udp.dst_addr) > 0;
 
     if (success) {
         const int packet_num = ++sent_packets_;
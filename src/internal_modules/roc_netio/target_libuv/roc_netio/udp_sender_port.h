@@ -15,12 +15,14 @@
 #include <uv.h>
 
 #include "roc_address/socket_addr.h"
+#include "roc_core/array.h"
 #include "roc_core/atomic.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/rate_limiter.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
+#include "roc_netio/socket_ops.h"
 #include "roc_packet/iwriter.h"
 
 namespace roc {
@@ -42,15 +44,32 @@ struct UdpSenderConfig {
     //! regular asynchronous write.
     bool non_blocking_enabled;
 
+    //! Maximum number of datagrams to send at once.
+    //! If greater than one, written packets are not sent immediately, but
+    //! are queued and flushed by network thread in batches, using a single
+    //! system call if the platform supports it (sendmmsg). Packets written
+    //! before network thread wakes up, e.g. during one pipeline tick, are
+    //! flushed together. Disables non-blocking writes.
+    size_t batch_size;
+
+    //! If true, and batching is enabled, allow UDP GSO.
+    //! Consecutive packets of equal size sent to the same address are passed
+    //! to kernel as one message and are segmented by kernel or NIC, if the
+    //! platform supports it. Disabled automatically if sending fails.
+    bool gso_enabled;
+
     UdpSenderConfig()
         : reuseaddr(false)
-        , non_blocking_enabled(true) {
+        , non_blocking_enabled(true)
+        , batch_size(0)
+        , gso_enabled(false) {
     }
 
     //! Check two configs for equality.
     bool operator==(const UdpSenderConfig& other) const {
         return bind_address == other.bind_address
-            && non_blocking_enabled == other.non_blocking_enabled;
+            && non_blocking_enabled == other.non_blocking_enabled
+            && batch_size == other.batch_size && gso_enabled == other.gso_enabled;
     }
 };
 
@@ -90,6 +109,10 @@ private:
 
     void write_(const packet::PacketPtr&);
 
+    void send_batches_();
+    void send_async_(const packet::PacketPtr& pp);
+    void finish_packet_();
+
     bool fully_closed_() const;
     void start_closing_();
 
@@ -113,6 +136,10 @@ private:
 
     core::MpscQueue<packet::Packet> queue_;
 
+    core::Array<SocketDatagram> batch_datagrams_;
+    core::Array<packet::PacketPtr> batch_packets_;
+    bool gso_enabled_;
+
     core::Atomic<int> pending_packets_;
     core::Atomic<int> sent_packets_;
     core::Atomic<int> sent_packets_blk_;
@@ -10,6 +10,7 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <signal.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -343,6 +344,25 @@ bool socket_setup(SocketHandle sock, const SocketOptions& options) {
     return true;
 }
 
+#if defined(SO_REUSEPORT)
+
+bool socket_set_reuseport(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+    return set_int_option(sock, SOL_SOCKET, SO_REUSEPORT, "SO_REUSEPORT", 1);
+}
+
+#else // !defined(SO_REUSEPORT)
+
+bool socket_set_reuseport(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+    roc_log(LogError, "socket: SO_REUSEPORT is not supported on this platform");
+    return false;
+}
+
+#endif // defined(SO_REUSEPORT)
+
 bool socket_bind(SocketHandle sock, address::SocketAddr& local_address) {
     roc_panic_if(sock < 0);
     roc_panic_if(!local_address.has_host_port());
@@ -467,6 +487,133 @@ ssize_t socket_try_recv(SocketHandle sock, void* buf, size_t bufsz) {
     return ret;
 }
 
+#if defined(MSG_WAITFORONE)
+
+// This version is used if recvmmsg() is available (e.g. on Linux and BSD).
+ssize_t
+socket_try_recv_batch(SocketHandle sock, SocketDatagram* datagrams, size_t n_datagrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+
+    enum { MaxBatch = 64 };
+
+    if (n_datagrams > MaxBatch) {
+        n_datagrams = MaxBatch;
+    }
+
+    if (n_datagrams == 0) {
+        return 0;
+    }
+
+    mmsghdr msgs[MaxBatch];
+    iovec iovs[MaxBatch];
+
+    memset(msgs, 0, n_datagrams * sizeof(mmsghdr));
+
+    for (size_t n = 0; n < n_datagrams; n++) {
+        roc_panic_if(!datagrams[n].buf);
+
+        iovs[n].iov_base = datagrams[n].buf;
+        iovs[n].iov_len = datagrams[n].bufsz;
+
+        msgs[n].msg_hdr.msg_iov = &iovs[n];
+        msgs[n].msg_hdr.msg_iovlen = 1;
+        msgs[n].msg_hdr.msg_name = datagrams[n].address.saddr();
+        msgs[n].msg_hdr.msg_namelen = datagrams[n].address.max_slen();
+    }
+
+    int ret;
+    while ((ret = recvmmsg(sock, msgs, (unsigned)n_datagrams, MSG_DONTWAIT, NULL))
+           == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if (ret < 0 && is_ewouldblock(errno)) {
+        return IOErr_WouldBlock;
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "socket: recvmmsg(): %s", core::errno_to_str().c_str());
+        return IOErr_Failure;
+    }
+
+    if (ret == 0) {
+        return IOErr_WouldBlock;
+    }
+
+    for (size_t n = 0; n < (size_t)ret; n++) {
+        datagrams[n].size = msgs[n].msg_len;
+        datagrams[n].truncated = (msgs[n].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    }
+
+    return ret;
+}
+
+#else // !defined(MSG_WAITFORONE)
+
+// This version is used if recvmmsg() is not available.
+// It performs a recvmsg() call per datagram.
+ssize_t
+socket_try_recv_batch(SocketHandle sock, SocketDatagram* datagrams, size_t n_datagrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+
+    size_t n = 0;
+
+    for (; n < n_datagrams; n++) {
+        SocketDatagram& dgm = datagrams[n];
+
+        roc_panic_if(!dgm.buf);
+
+        iovec iov;
+        iov.iov_base = dgm.buf;
+        iov.iov_len = dgm.bufsz;
+
+        msghdr hdr;
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.msg_iov = &iov;
+        hdr.msg_iovlen = 1;
+        hdr.msg_name = dgm.address.saddr();
+        hdr.msg_namelen = dgm.address.max_slen();
+
+        ssize_t ret;
+        while ((ret = recvmsg(sock, &hdr, MSG_DONTWAIT)) == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0 && is_ewouldblock(errno)) {
+            break;
+        }
+
+        if (ret < 0) {
+            roc_log(LogError, "socket: recvmsg(): %s", core::errno_to_str().c_str());
+            if (n != 0) {
+                break;
+            }
+            return IOErr_Failure;
+        }
+
+        dgm.size = (size_t)ret;
+        dgm.truncated = (hdr.msg_flags & MSG_TRUNC) != 0;
+    }
+
+    if (n == 0 && n_datagrams != 0) {
+        return IOErr_WouldBlock;
+    }
+
+    return (ssize_t)n;
+}
+
+#endif // defined(MSG_WAITFORONE)
+
 #if defined(SO_NOSIGPIPE) || defined(MSG_NOSIGNAL)
 
 // This version is used if either SO_NOSIGPIPE or MSG_NOSIGNAL is available
@@ -653,6 +800,192 @@ ssize_t socket_try_send_to(SocketHandle sock,
     return ret;
 }
 
+#if defined(MSG_WAITFORONE)
+
+// This version is used if sendmmsg() is available (e.g. on Linux and BSD).
+ssize_t socket_try_send_batch(SocketHandle sock,
+                              const SocketDatagram* datagrams,
+                              size_t n_datagrams,
+                              bool gso) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+
+    enum {
+        MaxBatch = 64,
+        // limits of single GSO message
+        MaxSegments = 64,
+        MaxSegmentedBytes = 65000
+    };
+
+    if (n_datagrams > MaxBatch) {
+        n_datagrams = MaxBatch;
+    }
+
+    if (n_datagrams == 0) {
+        return 0;
+    }
+
+    mmsghdr msgs[MaxBatch];
+    iovec iovs[MaxBatch];
+
+    // number of datagrams in every message
+    size_t msg_datagrams[MaxBatch];
+
+#if defined(UDP_SEGMENT)
+    union {
+        char buf[CMSG_SPACE(sizeof(uint16_t))];
+        cmsghdr align;
+    } cmsgs[MaxBatch];
+#else
+    (void)gso;
+#endif
+
+    memset(msgs, 0, sizeof(msgs));
+
+    size_t n_msgs = 0;
+    size_t n_dgms = 0;
+
+    while (n_dgms < n_datagrams) {
+        const SocketDatagram& first = datagrams[n_dgms];
+
+        roc_panic_if(!first.buf);
+        roc_panic_if(!first.address.has_host_port());
+
+        size_t n_segs = 1;
+
+#if defined(UDP_SEGMENT)
+        if (gso && first.size != 0) {
+            size_t total_size = first.size;
+
+            while (n_dgms + n_segs < n_datagrams && n_segs < MaxSegments) {
+                const SocketDatagram& next = datagrams[n_dgms + n_segs];
+
+                if (next.size != first.size || !(next.address == first.address)
+                    || total_size + next.size > MaxSegmentedBytes) {
+                    break;
+                }
+
+                total_size += next.size;
+                n_segs++;
+            }
+        }
+#endif // defined(UDP_SEGMENT)
+
+        for (size_t n = 0; n < n_segs; n++) {
+            iovs[n_dgms + n].iov_base = datagrams[n_dgms + n].buf;
+            iovs[n_dgms + n].iov_len = datagrams[n_dgms + n].size;
+        }
+
+        msghdr& hdr = msgs[n_msgs].msg_hdr;
+
+        hdr.msg_iov = &iovs[n_dgms];
+        hdr.msg_iovlen = n_segs;
+        hdr.msg_name = const_cast<sockaddr*>(first.address.saddr());
+        hdr.msg_namelen = first.address.slen();
+
+#if defined(UDP_SEGMENT)
+        if (n_segs > 1) {
+            hdr.msg_control = cmsgs[n_msgs].buf;
+            hdr.msg_controllen = sizeof(cmsgs[n_msgs].buf);
+
+            const uint16_t seg_size = (uint16_t)first.size;
+
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+            cmsg->cmsg_level = IPPROTO_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(seg_size));
+            memcpy(CMSG_DATA(cmsg), &seg_size, sizeof(seg_size));
+        }
+#endif // defined(UDP_SEGMENT)
+
+        msg_datagrams[n_msgs] = n_segs;
+
+        n_msgs++;
+        n_dgms += n_segs;
+    }
+
+    int ret;
+    while ((ret = sendmmsg(sock, msgs, (unsigned)n_msgs, MSG_DONTWAIT)) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if (ret < 0 && is_ewouldblock(errno)) {
+        return IOErr_WouldBlock;
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "socket: sendmmsg(): %s", core::errno_to_str().c_str());
+        return IOErr_Failure;
+    }
+
+    if (ret == 0) {
+        return IOErr_WouldBlock;
+    }
+
+    size_t n_sent = 0;
+    for (size_t n = 0; n < (size_t)ret; n++) {
+        n_sent += msg_datagrams[n];
+    }
+
+    return (ssize_t)n_sent;
+}
+
+#else // !defined(MSG_WAITFORONE)
+
+// This version is used if sendmmsg() is not available.
+// It performs a sendto() call per datagram.
+ssize_t socket_try_send_batch(SocketHandle sock,
+                              const SocketDatagram* datagrams,
+                              size_t n_datagrams,
+                              bool) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+
+    size_t n = 0;
+
+    for (; n < n_datagrams; n++) {
+        const SocketDatagram& dgm = datagrams[n];
+
+        roc_panic_if(!dgm.buf);
+        roc_panic_if(!dgm.address.has_host_port());
+
+        ssize_t ret;
+        while ((ret = sendto(sock, dgm.buf, dgm.size, MSG_DONTWAIT, dgm.address.saddr(),
+                             dgm.address.slen()))
+               == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0 && is_ewouldblock(errno)) {
+            break;
+        }
+
+        if (ret < 0) {
+            roc_log(LogError, "socket: sendto(): %s", core::errno_to_str().c_str());
+            if (n != 0) {
+                break;
+            }
+            return IOErr_Failure;
+        }
+    }
+
+    if (n == 0 && n_datagrams != 0) {
+        return IOErr_WouldBlock;
+    }
+
+    return (ssize_t)n;
+}
+
+#endif // defined(MSG_WAITFORONE)
+
 bool socket_shutdown(SocketHandle sock) {
     roc_panic_if(sock < 0);
 
@@ -32,6 +32,31 @@ typedef int SocketHandle;
 //! Invalid socket handle.
 const SocketHandle SocketInvalid = -1;
 
+//! Datagram for batched socket I/O.
+struct SocketDatagram {
+    //! Buffer for datagram payload.
+    void* buf;
+
+    //! Buffer size.
+    size_t bufsz;
+
+    //! Number of bytes received or to be sent.
+    size_t size;
+
+    //! Remote address.
+    address::SocketAddr address;
+
+    //! Set if datagram didn't fit into buffer and was truncated.
+    bool truncated;
+
+    SocketDatagram()
+        : buf(NULL)
+        , bufsz(0)
+        , size(0)
+        , truncated(false) {
+    }
+};
+
 //! Create non-blocking socket.
 bool socket_create(address::AddrFamily family, SocketType type, SocketHandle& new_sock);
 
@@ -43,6 +68,13 @@ bool socket_accept(SocketHandle sock,
 //! Set socket options.
 bool socket_setup(SocketHandle sock, const SocketOptions& options);
 
+//! Enable SO_REUSEPORT option.
+//! Allows to bind multiple sockets to the same address and port.
+//! On Linux, kernel distributes incoming datagrams between such sockets
+//! by hash of source and destination address.
+//! @returns false if the option can't be enabled or is not supported.
+bool socket_set_reuseport(SocketHandle sock);
+
 //! Bind socket to local address.
 bool socket_bind(SocketHandle sock, address::SocketAddr& local_address);
 
@@ -65,6 +97,13 @@ bool socket_end_connect(SocketHandle sock);
 //! @returns number of bytes read (>= 0) or IOError (< 0).
 ssize_t socket_try_recv(SocketHandle sock, void* buf, size_t bufsz);
 
+//! Try to read multiple datagrams from socket without blocking.
+//! Fills @c size, @c address, and @c truncated fields of first N datagrams.
+//! Uses a single system call if the platform supports it.
+//! @returns number of datagrams read (> 0) or IOError (< 0).
+ssize_t
+socket_try_recv_batch(SocketHandle sock, SocketDatagram* datagrams, size_t n_datagrams);
+
 //! Try to write bytes to socket without blocking.
 //! @returns number of bytes written (>= 0) or IOError (< 0).
 ssize_t socket_try_send(SocketHandle sock, const void* buf, size_t bufsz);
@@ -76,6 +115,18 @@ ssize_t socket_try_send_to(SocketHandle sock,
                            size_t bufsz,
                            const address::SocketAddr& remote_address);
 
+//! Try to send multiple datagrams via socket without blocking.
+//! Sends @c size bytes from @c buf of each datagram to its @c address.
+//! Uses a single system call if the platform supports it (sendmmsg).
+//! If @p gso is true, consecutive datagrams of equal size sent to the same
+//! address are merged into one message and segmented by kernel (UDP GSO),
+//! if the platform supports it.
+//! @returns number of datagrams sent (> 0) or IOError (< 0).
+ssize_t socket_try_send_batch(SocketHandle sock,
+                              const SocketDatagram* datagrams,
+                              size_t n_datagrams,
+                              bool gso);
+
 //! Gracefully shutdown connection.
 bool socket_shutdown(SocketHandle sock);
 
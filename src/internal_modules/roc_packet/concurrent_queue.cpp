@@ -29,6 +29,31 @@ PacketPtr ConcurrentQueue::read() {
     return packet;
 }
 
+size_t ConcurrentQueue::read_batch(PacketPtr* packets, size_t max_packets) {
+    if (max_packets == 0) {
+        return 0;
+    }
+
+    core::Mutex::Lock lock(mutex_);
+
+    while (!list_.front()) {
+        cond_.wait();
+    }
+
+    size_t n_packets = 0;
+
+    while (n_packets < max_packets) {
+        Packet* packet = list_.front().get();
+        if (!packet) {
+            break;
+        }
+        packets[n_packets++] = packet;
+        list_.remove(*packet);
+    }
+
+    return n_packets;
+}
+
 void ConcurrentQueue::write(const PacketPtr& packet) {
     if (!packet) {
         roc_panic("concurrent queue: packet is null");
@@ -40,5 +65,24 @@ void ConcurrentQueue::write(const PacketPtr& packet) {
     cond_.broadcast();
 }
 
+void ConcurrentQueue::write_batch(const PacketPtr* packets, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        if (!packets[n]) {
+            roc_panic("concurrent queue: packet is null");
+        }
+    }
+
+    if (n_packets == 0) {
+        return;
+    }
+
+    core::Mutex::Lock lock(mutex_);
+
+    for (size_t n = 0; n < n_packets; n++) {
+        list_.push_back(*packets[n]);
+    }
+    cond_.broadcast();
+}
+
 } // namespace packet
 } // namespace roc
@@ -34,11 +34,23 @@ public:
     //!  packet from the queue.
     virtual PacketPtr read();
 
+    //! Read multiple packets.
+    //! @remarks
+    //!  Blocks until the queue becomes non-empty and returns up to
+    //!  @p max_packets packets from the beginning of the queue.
+    virtual size_t read_batch(PacketPtr* packets, size_t max_packets);
+
     //! Add packet to the queue.
     //! @remarks
     //!  Adds packet to the end of the queue.
     virtual void write(const PacketPtr& packet);
 
+    //! Add multiple packets to the queue.
+    //! @remarks
+    //!  Adds packets to the end of the queue under a single lock and
+    //!  wakes up readers once.
+    virtual void write_batch(const PacketPtr* packets, size_t n_packets);
+
 private:
     core::Mutex mutex_;
     core::Cond cond_;
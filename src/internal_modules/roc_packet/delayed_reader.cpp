@@ -39,9 +39,24 @@ PacketPtr DelayedReader::read() {
     return reader_.read();
 }
 
+size_t DelayedReader::read_batch(PacketPtr* packets, size_t max_packets) {
+    if (started_ && queue_.size() == 0) {
+        return reader_.read_batch(packets, max_packets);
+    }
+
+    return IReader::read_batch(packets, max_packets);
+}
+
 bool DelayedReader::fetch_packets_() {
-    while (PacketPtr pp = reader_.read()) {
-        queue_.write(pp);
+    PacketPtr packets[FetchBatchSize];
+
+    for (;;) {
+        const size_t n_packets = reader_.read_batch(packets, FetchBatchSize);
+        if (n_packets == 0) {
+            break;
+        }
+
+        queue_.write_batch(packets, n_packets);
     }
 
     const timestamp_t qs = queue_size_();
@@ -40,7 +40,15 @@ public:
     //! Read packet.
     virtual PacketPtr read();
 
+    //! Read multiple packets.
+    //! @remarks
+    //!  After the initial delay is accumulated and the delay queue is drained,
+    //!  batches are forwarded to the underlying reader.
+    virtual size_t read_batch(PacketPtr* packets, size_t max_packets);
+
 private:
+    enum { FetchBatchSize = 32 };
+
     bool fetch_packets_();
     PacketPtr read_queued_packet_();
 
@@ -28,7 +28,10 @@ enum FecScheme {
     FEC_ReedSolomon_M8,
 
     //! LDPC-Staircase.
-    FEC_LDPC_Staircase
+    FEC_LDPC_Staircase,
+
+    //! Sliding window Random Linear Codes over GF(2^8) (RFC 8681).
+    FEC_RLC
 };
 
 //! FECFRAME packet.
@@ -46,6 +49,9 @@ struct FEC {
     //!  Repair packets are numbered in range [k; k + n), where
     //!  k is a number of source packets per block (source_block_length)
     //!  n is a number of repair packets per block.
+    //!  For sliding window schemes (FEC_RLC), source packets are numbered
+    //!  sequentially through the whole stream, and repair packets hold the
+    //!  number of the first source packet in their encoding window.
     size_t encoding_symbol_id;
 
     //! Number of a source block in a packet stream.
@@ -54,12 +60,17 @@ struct FEC {
     //!  Source block is formed from the source packets.
     //!  Blocks are numbered sequentially starting from a random number.
     //!  Block number can wrap.
+    //!  For sliding window schemes (FEC_RLC), there are no blocks; repair
+    //!  packets hold repair key here, which is incremented for every repair
+    //!  packet, and source packets hold zero.
     blknum_t source_block_number;
 
     //! Number of source packets in the block to which this packet belongs to.
     //!
     //! @remarks
     //!  Different blocks can have different number of source packets.
+    //!  For sliding window schemes (FEC_RLC), repair packets hold number of
+    //!  source packets in their encoding window, and source packets hold zero.
     size_t source_block_length;
 
     //! Number of source packets and repair in the block to which this packet belongs to.
@@ -72,6 +72,34 @@ void Interleaver::flush() {
     next_2_put_ = next_2_send_ = 0;
 }
 
+bool Interleaver::resize(size_t block_sz) {
+    roc_panic_if_not(valid());
+    roc_panic_if(block_sz == 0);
+
+    if (block_sz == block_size_) {
+        return true;
+    }
+
+    // allocate memory first, so that resize below can't fail
+    if (!send_seq_.grow(block_sz) || !packets_.grow(block_sz)) {
+        return false;
+    }
+
+    flush();
+
+    if (!send_seq_.resize(block_sz) || !packets_.resize(block_sz)) {
+        roc_panic("interleaver: can't resize arrays");
+    }
+
+    roc_log(LogDebug, "interleaver: resizing block: cur_size=%u new_size=%u",
+            (unsigned)block_size_, (unsigned)block_sz);
+
+    block_size_ = block_sz;
+    reinit_seq_();
+
+    return true;
+}
+
 size_t Interleaver::block_size() const {
     return block_size_;
 }
@@ -42,6 +42,13 @@ public:
     //! Send all buffered packets to output writer.
     void flush();
 
+    //! Change block size.
+    //! @remarks
+    //!  Flushes buffered packets and starts a new sequence of given size.
+    //! @returns
+    //!  false if allocation failed; in this case block size is not changed.
+    bool resize(size_t block_size);
+
     //! Maximum delay between writing packet and moment we get it in output
     //! in terms of packets number.
     size_t block_size() const;
@@ -26,6 +26,15 @@ public:
     //! @returns
     //!  next available packet or NULL if there are no packets.
     virtual PacketPtr read() = 0;
+
+    //! Read multiple packets.
+    //! @returns
+    //!  number of packets stored into @p packets, not greater than @p max_packets.
+    //! @remarks
+    //!  Returns less than @p max_packets if read() would return NULL before
+    //!  @p max_packets packets are read. Default implementation calls read()
+    //!  in a loop; readers that can avoid per-packet overhead override it.
+    virtual size_t read_batch(PacketPtr* packets, size_t max_packets);
 };
 
 } // namespace packet
@@ -14,5 +14,11 @@ namespace packet {
 IWriter::~IWriter() {
 }
 
+void IWriter::write_batch(const PacketPtr* packets, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        write(packets[n]);
+    }
+}
+
 } // namespace packet
 } // namespace roc
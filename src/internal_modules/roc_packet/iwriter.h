@@ -24,6 +24,13 @@ public:
 
     //! Write packet.
     virtual void write(const PacketPtr&) = 0;
+
+    //! Write multiple packets.
+    //! @remarks
+    //!  Equivalent to calling write() for every packet in order. Default
+    //!  implementation does exactly that; writers that can avoid per-packet
+    //!  overhead override it.
+    virtual void write_batch(const PacketPtr* packets, size_t n_packets);
 };
 
 } // namespace packet
@@ -20,6 +20,21 @@ PacketPtr Queue::read() {
     return packet;
 }
 
+size_t Queue::read_batch(PacketPtr* packets, size_t max_packets) {
+    size_t n_packets = 0;
+
+    while (n_packets < max_packets) {
+        Packet* packet = list_.front().get();
+        if (!packet) {
+            break;
+        }
+        packets[n_packets++] = packet;
+        list_.remove(*packet);
+    }
+
+    return n_packets;
+}
+
 void Queue::write(const PacketPtr& packet) {
     if (!packet) {
         roc_panic("queue: null packet");
@@ -27,6 +42,15 @@ void Queue::write(const PacketPtr& packet) {
     list_.push_back(*packet);
 }
 
+void Queue::write_batch(const PacketPtr* packets, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        if (!packets[n]) {
+            roc_panic("queue: null packet");
+        }
+        list_.push_back(*packets[n]);
+    }
+}
+
 size_t Queue::size() const {
     return list_.size();
 }
@@ -29,11 +29,17 @@ public:
     //!  the first packet in the queue or null if there are no packets.
     virtual PacketPtr read();
 
+    //! Read multiple packets from the beginning of the queue.
+    virtual size_t read_batch(PacketPtr* packets, size_t max_packets);
+
     //! Add packet to the queue.
     //! @remarks
     //!  Adds packet to the end of the queue.
     virtual void write(const PacketPtr& packet);
 
+    //! Add multiple packets to the end of the queue.
+    virtual void write_batch(const PacketPtr* packets, size_t n_packets);
+
     //! Get number of packets in queue.
     size_t size() const;
 
@@ -34,6 +34,37 @@ bool Router::add_route(IWriter& writer, unsigned flags) {
 }
 
 void Router::write(const PacketPtr& packet) {
+    if (Route* route = find_route_(packet)) {
+        route->writer->write(packet);
+    }
+}
+
+void Router::write_batch(const PacketPtr* packets, size_t n_packets) {
+    size_t run_begin = 0;
+    Route* run_route = NULL;
+
+    for (size_t n = 0; n < n_packets; n++) {
+        Route* route = find_route_(packets[n]);
+
+        if (route != run_route) {
+            if (run_route) {
+                run_route->writer->write_batch(packets + run_begin, n - run_begin);
+            }
+            run_begin = n;
+            run_route = route;
+        }
+
+        if (!route) {
+            run_begin = n + 1;
+        }
+    }
+
+    if (run_route) {
+        run_route->writer->write_batch(packets + run_begin, n_packets - run_begin);
+    }
+}
+
+Router::Route* Router::find_route_(const PacketPtr& packet) {
     if (!packet) {
         roc_panic("router: unexpected null packet");
     }
@@ -63,11 +94,11 @@ void Router::write(const PacketPtr& packet) {
                     (unsigned long)r.source, (unsigned int)r.flags);
         }
 
-        r.writer->write(packet);
-        return;
+        return &r;
     }
 
     roc_log(LogDebug, "router: can't route packet, dropping");
+    return NULL;
 }
 
 } // namespace packet
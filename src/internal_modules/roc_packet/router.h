@@ -38,6 +38,12 @@ public:
     //!  Route @p packet to a writer or drop it if no routes found.
     virtual void write(const PacketPtr& packet);
 
+    //! Write multiple packets.
+    //! @remarks
+    //!  Routes every packet as write() does, but passes consecutive packets
+    //!  going to the same writer as a single batch.
+    virtual void write_batch(const PacketPtr* packets, size_t n_packets);
+
 private:
     struct Route {
         IWriter* writer;
@@ -46,6 +52,8 @@ private:
         bool has_source;
     };
 
+    Route* find_route_(const PacketPtr& packet);
+
     core::Array<Route, 2> routes_;
 };
 
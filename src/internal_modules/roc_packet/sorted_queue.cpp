@@ -15,10 +15,19 @@ namespace packet {
 
 SortedQueue::SortedQueue(size_t max_size)
     : max_size_(max_size) {
+    for (size_t n = 0; n < WindowSize; n++) {
+        ring_[n] = NULL;
+    }
 }
 
 PacketPtr SortedQueue::read() {
     if (PacketPtr packet = list_.back()) {
+        if (packet->rtp()) {
+            Packet*& slot = ring_[ring_index_(packet->rtp()->seqnum)];
+            if (slot == packet.get()) {
+                slot = NULL;
+            }
+        }
         list_.remove(*packet);
         return packet;
     }
@@ -43,6 +52,105 @@ void SortedQueue::write(const PacketPtr& packet) {
         latest_ = packet;
     }
 
+    if (!insert_indexed_(packet)) {
+        insert_sorted_(packet);
+    }
+}
+
+size_t SortedQueue::read_batch(PacketPtr* packets, size_t max_packets) {
+    size_t n_packets = 0;
+
+    while (n_packets < max_packets) {
+        if (!(packets[n_packets] = SortedQueue::read())) {
+            break;
+        }
+        n_packets++;
+    }
+
+    return n_packets;
+}
+
+void SortedQueue::write_batch(const PacketPtr* packets, size_t n_packets) {
+    for (size_t n = 0; n < n_packets; n++) {
+        SortedQueue::write(packets[n]);
+    }
+}
+
+size_t SortedQueue::ring_index_(seqnum_t seqnum) {
+    return seqnum % WindowSize;
+}
+
+// Returns false if packet can't be handled using the ring.
+bool SortedQueue::insert_indexed_(const PacketPtr& packet) {
+    if (!packet->rtp()) {
+        return false;
+    }
+
+    const seqnum_t seqnum = packet->rtp()->seqnum;
+
+    PacketPtr tail = list_.front();
+
+    if (!tail) {
+        list_.push_front(*packet);
+        ring_[ring_index_(seqnum)] = packet.get();
+        return true;
+    }
+
+    if (!tail->rtp()) {
+        return false;
+    }
+
+    const seqnum_t tail_seqnum = tail->rtp()->seqnum;
+
+    if (seqnum_lt(tail_seqnum, seqnum)) {
+        // newest packet; if its slot is occupied by a packet that is older than
+        // the window, that packet is left in the list without index
+        list_.push_front(*packet);
+        ring_[ring_index_(seqnum)] = packet.get();
+        return true;
+    }
+
+    const size_t distance = (size_t)seqnum_t(tail_seqnum - seqnum);
+
+    if (distance >= WindowSize) {
+        return false;
+    }
+
+    Packet*& slot = ring_[ring_index_(seqnum)];
+
+    if (slot && slot->rtp()->seqnum == seqnum) {
+        roc_log(LogDebug, "sorted queue: dropping duplicate packet");
+        return true;
+    }
+
+    // find closest newer packet, tail is the last candidate
+    Packet* next = NULL;
+
+    for (size_t n = 1; n <= distance; n++) {
+        const seqnum_t sn = seqnum_t(seqnum + n);
+        Packet* p = ring_[ring_index_(sn)];
+        if (p && p->rtp()->seqnum == sn) {
+            next = p;
+            break;
+        }
+    }
+
+    if (!next) {
+        return false;
+    }
+
+    if (PacketPtr prev = list_.nextof(*next)) {
+        list_.insert_before(*packet, *prev);
+    } else {
+        list_.push_back(*packet);
+    }
+
+    slot = packet.get();
+
+    return true;
+}
+
+void SortedQueue::insert_sorted_(const PacketPtr& packet) {
     PacketPtr pos = list_.front();
 
     for (; pos; pos = list_.nextof(*pos)) {
@@ -65,6 +173,14 @@ void SortedQueue::write(const PacketPtr& packet) {
     } else {
         list_.push_back(*packet);
     }
+
+    if (packet->rtp()) {
+        // don't replace newer packet
+        Packet*& slot = ring_[ring_index_(packet->rtp()->seqnum)];
+        if (!slot || seqnum_lt(slot->rtp()->seqnum, packet->rtp()->seqnum)) {
+            slot = packet.get();
+        }
+    }
 }
 
 size_t SortedQueue::size() const {
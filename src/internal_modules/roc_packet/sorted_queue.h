@@ -24,6 +24,13 @@ namespace packet {
 //! Sorted packet queue.
 //! @remarks
 //!  Packets order is determined by Packet::compare() method.
+//!
+//!  RTP packets within a window of WindowSize seqnums from the newest packet
+//!  are additionally indexed by seqnum in a ring. In-order packets are added
+//!  in O(1), duplicates are detected in O(1), and reordered packets are
+//!  positioned by scanning the ring instead of walking the list. Other
+//!  packets, like FEC repair packets without RTP header, and RTP packets
+//!  that are too late for the window, fall back to walking the list.
 class SortedQueue : public IWriter, public IReader, public core::NonCopyable<> {
 public:
     //! Construct empty queue.
@@ -38,6 +45,11 @@ public:
     //!  - otherwise, packet is inserted into the queue, keeping the queue sorted
     virtual void write(const PacketPtr& packet);
 
+    //! Add multiple packets to the queue.
+    //! @remarks
+    //!  Same as write() for every packet, without virtual dispatch per packet.
+    virtual void write_batch(const PacketPtr* packets, size_t n_packets);
+
     //! Read next packet.
     //! @returns
     //!  the first packet in the queue or null if there are no packets
@@ -45,6 +57,12 @@ public:
     //!  Removes returned packet from the queue.
     virtual PacketPtr read();
 
+    //! Read multiple packets from the beginning of the queue.
+    //! @remarks
+    //!  Same as read() until queue is empty or @p max_packets packets are read,
+    //!  without virtual dispatch per packet.
+    virtual size_t read_batch(PacketPtr* packets, size_t max_packets);
+
     //! Get number of packets in queue.
     size_t size() const;
 
@@ -69,10 +87,21 @@ public:
     //!  in the queue. Returned packet is not removed from the queue.
     PacketPtr latest() const;
 
+    //! Size of the seqnum window indexed by the ring.
+    enum { WindowSize = 1024 };
+
 private:
+    static size_t ring_index_(seqnum_t seqnum);
+
+    bool insert_indexed_(const PacketPtr& packet);
+    void insert_sorted_(const PacketPtr& packet);
+
     core::List<Packet> list_;
     PacketPtr latest_;
     const size_t max_size_;
+
+    // packets indexed by seqnum modulo WindowSize, owned by list_
+    Packet* ring_[WindowSize];
 };
 
 } // namespace packet
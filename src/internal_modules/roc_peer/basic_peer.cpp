@@ -24,5 +24,9 @@ Context& BasicPeer::context() {
     return context_;
 }
 
+netio::NetworkLoop& BasicPeer::select_network_loop() {
+    return context_.network_loops().select_loop();
+}
+
 } // namespace peer
 } // namespace roc
@@ -30,6 +30,13 @@ public:
     //! Peer's context.
     Context& context();
 
+protected:
+    //! Select network loop for a new port.
+    //! @remarks
+    //!  Selects loop from context's pool according to its policy.
+    //!  The port should be later removed from the same loop.
+    netio::NetworkLoop& select_network_loop();
+
 private:
     Context& context_;
 };
@@ -19,8 +19,13 @@ Context::Context(const ContextConfig& config, core::IAllocator& allocator)
     , byte_buffer_factory_(allocator_, config.max_packet_size, config.poisoning)
     , sample_buffer_factory_(
           allocator_, config.max_frame_size / sizeof(audio::sample_t), config.poisoning)
-    , network_loop_(packet_factory_, byte_buffer_factory_, allocator_)
-    , control_loop_(network_loop_, allocator_)
+    , receiver_port_sharding_(config.receiver_port_sharding)
+    , network_loops_(config.num_network_loops,
+                     config.network_loop_policy,
+                     packet_factory_,
+                     byte_buffer_factory_,
+                     allocator_)
+    , control_loop_(network_loops_, allocator_)
     , ref_counter_(0) {
     roc_log(LogDebug, "context: initializing");
 }
@@ -35,7 +40,7 @@ Context::~Context() {
 }
 
 bool Context::valid() {
-    return network_loop_.valid() && control_loop_.valid();
+    return network_loops_.valid() && control_loop_.valid();
 }
 
 void Context::incref() {
@@ -73,7 +78,27 @@ core::BufferFactory<audio::sample_t>& Context::sample_buffer_factory() {
 }
 
 netio::NetworkLoop& Context::network_loop() {
-    return network_loop_;
+    return network_loops_.loop(0);
+}
+
+size_t Context::num_network_loops() const {
+    return network_loops_.num_loops();
+}
+
+bool Context::receiver_port_sharding() const {
+    return receiver_port_sharding_;
+}
+
+netio::NetworkLoop& Context::network_loop(size_t index) {
+    return network_loops_.loop(index);
+}
+
+void Context::get_network_loop_stats(size_t index, netio::NetworkLoopStats& stats) {
+    network_loops_.get_stats(index, stats);
+}
+
+netio::NetworkLoopPool& Context::network_loops() {
+    return network_loops_;
 }
 
 ctl::ControlLoop& Context::control_loop() {
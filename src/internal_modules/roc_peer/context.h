@@ -18,6 +18,7 @@
 #include "roc_core/iallocator.h"
 #include "roc_ctl/control_loop.h"
 #include "roc_netio/network_loop.h"
+#include "roc_netio/network_loop_pool.h"
 #include "roc_packet/packet_factory.h"
 
 namespace roc {
@@ -34,16 +35,37 @@ struct ContextConfig {
     //! Enable memory poisoning.
     bool poisoning;
 
+    //! Number of network threads.
+    //! Should not exceed Context::MaxNetworkLoops.
+    size_t num_network_loops;
+
+    //! Shard receiver ports between network threads.
+    //! If set and there is more than one network thread, every unicast
+    //! receiver port is bound once in every network thread, using
+    //! SO_REUSEPORT, and kernel distributes incoming flows between threads.
+    //! Multicast and broadcast ports are never sharded, because such
+    //! datagrams are delivered to every socket.
+    bool receiver_port_sharding;
+
+    //! How to select network thread for sender and non-sharded receiver ports.
+    netio::NetworkLoopPolicy network_loop_policy;
+
     ContextConfig()
         : max_packet_size(2048)
         , max_frame_size(4096)
-        , poisoning(false) {
+        , poisoning(false)
+        , num_network_loops(1)
+        , receiver_port_sharding(false)
+        , network_loop_policy(netio::NetworkLoopPolicy_LeastLoaded) {
     }
 };
 
 //! Peer context.
 class Context : public core::NonCopyable<> {
 public:
+    //! Maximum number of network loops.
+    enum { MaxNetworkLoops = netio::NetworkLoopPool::MaxLoops };
+
     //! Initialize.
     explicit Context(const ContextConfig& config, core::IAllocator& allocator);
 
@@ -75,8 +97,30 @@ public:
     core::BufferFactory<audio::sample_t>& sample_buffer_factory();
 
     //! Get network event loop.
+    //! @remarks
+    //!  Returns first network loop of the pool, which is used for tasks
+    //!  not bound to a port, like address resolving.
     netio::NetworkLoop& network_loop();
 
+    //! Get number of network event loops.
+    size_t num_network_loops() const;
+
+    //! Check if receiver ports should be sharded between network loops.
+    bool receiver_port_sharding() const;
+
+    //! Get network event loop by index.
+    netio::NetworkLoop& network_loop(size_t index);
+
+    //! Get statistics of network event loop by index.
+    //! @remarks
+    //!  Reports number of ports, task queue depth, and thread utilization.
+    //!  Can be called from any thread. Every loop also logs its statistics
+    //!  periodically with debug level.
+    void get_network_loop_stats(size_t index, netio::NetworkLoopStats& stats);
+
+    //! Get pool of network event loops.
+    netio::NetworkLoopPool& network_loops();
+
     //! Get control event loop.
     ctl::ControlLoop& control_loop();
 
@@ -87,7 +131,9 @@ private:
     core::BufferFactory<uint8_t> byte_buffer_factory_;
     core::BufferFactory<audio::sample_t> sample_buffer_factory_;
 
-    netio::NetworkLoop network_loop_;
+    const bool receiver_port_sharding_;
+
+    netio::NetworkLoopPool network_loops_;
     ctl::ControlLoop control_loop_;
 
     core::Atomic<int> ref_counter_;
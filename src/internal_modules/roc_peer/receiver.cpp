@@ -50,14 +50,7 @@ Receiver::~Receiver() {
         }
 
         for (size_t p = 0; p < address::Iface_Max; p++) {
-            if (!slots_[s].ports[p].handle) {
-                continue;
-            }
-
-            netio::NetworkLoop::Tasks::RemovePort task(slots_[s].ports[p].handle);
-            if (!context().network_loop().schedule_and_wait(task)) {
-                roc_panic("sender peer: can't remove port");
-            }
+            remove_port_(slots_[s].ports[p]);
         }
     }
 }
@@ -232,9 +225,24 @@ bool Receiver::bind(size_t slot_index,
 
     slot->ports[iface].config.bind_address = resolve_task.get_address();
 
+    const bool sharded = use_port_shards_(slot->ports[iface]);
+
+    netio::NetworkLoop* loop = NULL;
+
+    if (sharded) {
+        // port will be bound in every network loop; first port ensures
+        // that nobody else is using the address
+        slot->ports[iface].config.reuseport = true;
+        slot->ports[iface].config.reuseport_exclusive = true;
+
+        loop = &context().network_loop();
+    } else {
+        loop = &select_network_loop();
+    }
+
     netio::NetworkLoop::Tasks::AddUdpReceiverPort port_task(slot->ports[iface].config,
                                                             *endpoint_task.get_writer());
-    if (!context().network_loop().schedule_and_wait(port_task)) {
+    if (!loop->schedule_and_wait(port_task)) {
         roc_log(LogError,
                 "receiver peer:"
                 " can't bind %s interface of slot %lu:"
@@ -250,8 +258,28 @@ bool Receiver::bind(size_t slot_index,
         return false;
     }
 
+    slot->ports[iface].loop = loop;
     slot->ports[iface].handle = port_task.get_handle();
 
+    if (sharded
+        && !add_port_shards_(slot->ports[iface], *endpoint_task.get_writer())) {
+        roc_log(LogError,
+                "receiver peer:"
+                " can't bind %s interface of slot %lu:"
+                " can't bind interface to local port in all network loops",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+
+        remove_port_(slot->ports[iface]);
+
+        pipeline::ReceiverLoop::Tasks::DeleteEndpoint delete_endpoint_task(slot->slot,
+                                                                           iface);
+        if (!pipeline_.schedule_and_wait(delete_endpoint_task)) {
+            roc_panic("receiver peer: can't remove newly created endpoint");
+        }
+
+        return false;
+    }
+
     if (uri.port() == 0) {
         // Report back the port number we've selected.
         uri.set_port(slot->ports[iface].config.bind_address.port());
@@ -262,6 +290,69 @@ bool Receiver::bind(size_t slot_index,
     return true;
 }
 
+// Sharding is opt-in. Multicast and broadcast datagrams are delivered to
+// every socket bound with SO_REUSEPORT, so sharding such ports would duplicate
+// packets. If SO_REUSEADDR is requested, the address is intentionally shared
+// with other sockets, and we can't ensure exclusive ownership.
+bool Receiver::use_port_shards_(const Port& port) {
+    if (!context().receiver_port_sharding() || context().num_network_loops() < 2) {
+        return false;
+    }
+
+    if (port.config.bind_address.multicast() || port.config.bind_address.broadcast()
+        || port.config.multicast_interface[0] || port.config.reuseaddr) {
+        roc_log(LogDebug,
+                "receiver peer: not sharding port between network loops:"
+                " multicast, broadcast, or shared address");
+        return false;
+    }
+
+    return true;
+}
+
+// Bind port to the same address in every network loop except first.
+// All shards write packets to the same endpoint, which writer is thread-safe.
+bool Receiver::add_port_shards_(Port& port, packet::IWriter& writer) {
+    for (size_t n = 1; n < context().num_network_loops(); n++) {
+        netio::UdpReceiverConfig config = port.config;
+        config.reuseport_exclusive = false;
+
+        netio::NetworkLoop::Tasks::AddUdpReceiverPort port_task(config, writer);
+        if (!context().network_loop(n).schedule_and_wait(port_task)) {
+            return false;
+        }
+
+        port.shards[n - 1] = port_task.get_handle();
+    }
+
+    return true;
+}
+
+void Receiver::remove_port_(Port& port) {
+    for (size_t n = 1; n < context().num_network_loops(); n++) {
+        if (!port.shards[n - 1]) {
+            continue;
+        }
+
+        netio::NetworkLoop::Tasks::RemovePort task(port.shards[n - 1]);
+        if (!context().network_loop(n).schedule_and_wait(task)) {
+            roc_panic("receiver peer: can't remove port");
+        }
+
+        port.shards[n - 1] = NULL;
+    }
+
+    if (port.handle) {
+        netio::NetworkLoop::Tasks::RemovePort task(port.handle);
+        if (!port.loop->schedule_and_wait(task)) {
+            roc_panic("receiver peer: can't remove port");
+        }
+
+        port.handle = NULL;
+        port.loop = NULL;
+    }
+}
+
 sndio::ISource& Receiver::source() {
     return pipeline_.source();
 }
@@ -55,8 +55,20 @@ private:
         netio::UdpReceiverConfig config;
         netio::NetworkLoop::PortHandle handle;
 
+        // loop selected for the port from context's pool,
+        // or first loop if the port is sharded
+        netio::NetworkLoop* loop;
+
+        // ports bound to the same address in other network loops,
+        // n-th shard belongs to loop n+1
+        netio::NetworkLoop::PortHandle shards[Context::MaxNetworkLoops - 1];
+
         Port()
-            : handle(NULL) {
+            : handle(NULL)
+            , loop(NULL) {
+            for (size_t n = 0; n < Context::MaxNetworkLoops - 1; n++) {
+                shards[n] = NULL;
+            }
         }
     };
 
@@ -74,6 +86,10 @@ private:
 
     Slot* get_slot_(size_t slot_index);
 
+    bool use_port_shards_(const Port& port);
+    bool add_port_shards_(Port& port, packet::IWriter& writer);
+    void remove_port_(Port& port);
+
     virtual void schedule_task_processing(pipeline::PipelineLoop&,
                                           core::nanoseconds_t delay);
     virtual void cancel_task_processing(pipeline::PipelineLoop&);
@@ -45,6 +45,14 @@ Sender::~Sender() {
 
     context().control_loop().wait(processing_task_);
 
+    if (valid()) {
+        // write packets buffered in pipeline while ports are still alive
+        pipeline::SenderLoop::Tasks::FlushSlots flush_task;
+        if (!pipeline_.schedule_and_wait(flush_task)) {
+            roc_panic("sender peer: can't flush pipeline");
+        }
+    }
+
     for (size_t s = 0; s < slots_.size(); s++) {
         if (!slots_[s].slot) {
             continue;
@@ -56,7 +64,7 @@ Sender::~Sender() {
             }
 
             netio::NetworkLoop::Tasks::RemovePort task(slots_[s].ports[p].handle);
-            if (!context().network_loop().schedule_and_wait(task)) {
+            if (!slots_[s].ports[p].loop->schedule_and_wait(task)) {
                 roc_panic("sender peer: can't remove port");
             }
         }
@@ -393,14 +401,17 @@ bool Sender::setup_outgoing_port_(Port& port,
             }
         }
 
+        netio::NetworkLoop& loop = select_network_loop();
+
         netio::NetworkLoop::Tasks::AddUdpSenderPort port_task(port.config);
 
-        if (!context().network_loop().schedule_and_wait(port_task)) {
+        if (!loop.schedule_and_wait(port_task)) {
             roc_log(LogError, "sender peer: can't bind %s interface to local port",
                     address::interface_to_str(iface));
             return false;
         }
 
+        port.loop = &loop;
         port.handle = port_task.get_handle();
         port.writer = port_task.get_writer();
 
@@ -63,9 +63,13 @@ private:
         netio::NetworkLoop::PortHandle handle;
         packet::IWriter* writer;
 
+        // loop selected for the port from context's pool
+        netio::NetworkLoop* loop;
+
         Port()
             : handle(NULL)
-            , writer(NULL) {
+            , writer(NULL)
+            , loop(NULL) {
         }
     };
 
@@ -22,6 +22,7 @@
 #include "roc_audio/watchdog.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/time.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/codec_config.h"
 #include "roc_fec/reader.h"
 #include "roc_fec/writer.h"
@@ -47,6 +48,9 @@ const core::nanoseconds_t DefaultLatency = 200 * core::Millisecond;
 //! Default internal frame length.
 const core::nanoseconds_t DefaultInternalFrameLength = 7 * core::Millisecond;
 
+//! Default capacity of receiver endpoint queue, in packets.
+const size_t DefaultEndpointQueueSize = 1024;
+
 //! Default minum latency relative to target latency.
 const int DefaultMinLatencyFactor = -1;
 
@@ -114,6 +118,9 @@ struct SenderConfig {
     //! FEC encoder parameters.
     fec::CodecConfig fec_encoder;
 
+    //! FEC block size tuner parameters.
+    fec::BlockTunerConfig fec_tuner;
+
     //! Input sample spec
     audio::SampleSpec input_sample_spec;
 
@@ -132,6 +139,13 @@ struct SenderConfig {
     //! Interleave packets.
     bool interleaving;
 
+    //! Adjust FEC block size according to loss and RTT reported by receivers.
+    //! @note
+    //!  Receivers don't send receiver reports yet, because receiver control
+    //!  endpoints can't send packets back to sender. Until then, enabling this
+    //!  has no effect, and it's not exposed in tools.
+    bool fec_tuning;
+
     //! Constrain receiver speed using a CPU timer according to the sample rate.
     bool timing;
 
@@ -153,6 +167,7 @@ struct SenderConfig {
         , payload_type(rtp::PayloadType_L16_Stereo)
         , resampling(false)
         , interleaving(false)
+        , fec_tuning(false)
         , timing(false)
         , poisoning(false)
         , profiling(false) {
@@ -232,6 +247,22 @@ struct ReceiverCommonConfig {
     //! Insert weird beeps instead of silence on packet loss.
     bool beeping;
 
+    //! Maximum number of packets queued in every endpoint between pipeline ticks.
+    //! When the queue is full, new packets from network are dropped.
+    size_t endpoint_queue_size;
+
+    //! Number of sessions prepared in advance by background thread.
+    //! When a new sender appears, a prepared session is used instead of
+    //! building it on pipeline thread, and removed sessions are destroyed
+    //! by the same thread. Zero disables the pool.
+    size_t session_pool_size;
+
+    //! Number of additional threads used to process sessions in parallel.
+    //! Every session frame is produced independently on one of the threads,
+    //! and then frames are mixed on pipeline thread. Zero disables parallel
+    //! processing.
+    size_t session_threads;
+
     ReceiverCommonConfig()
         : output_sample_spec(DefaultSampleRate, DefaultChannelMask)
         , internal_frame_length(DefaultInternalFrameLength)
@@ -239,7 +270,10 @@ struct ReceiverCommonConfig {
         , timing(false)
         , poisoning(false)
         , profiling(false)
-        , beeping(false) {
+        , beeping(false)
+        , endpoint_queue_size(DefaultEndpointQueueSize)
+        , session_pool_size(0)
+        , session_threads(0) {
     }
 };
 
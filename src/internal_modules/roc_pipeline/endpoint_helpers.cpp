@@ -32,7 +32,9 @@ bool validate_endpoint(address::Interface iface, address::Protocol proto) {
         return false;
     }
 
+    // sliding window codes are always built-in and are not provided by codec map
     if (proto_attrs->fec_scheme != packet::FEC_None
+        && proto_attrs->fec_scheme != packet::FEC_RLC
         && !fec::CodecMap::instance().is_supported(proto_attrs->fec_scheme)) {
         roc_log(LogError,
                 "bad endpoints configuration:"
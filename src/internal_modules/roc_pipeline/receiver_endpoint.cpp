@@ -17,6 +17,7 @@ namespace roc {
 namespace pipeline {
 
 ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
+                                   size_t queue_size,
                                    ReceiverState& receiver_state,
                                    ReceiverSessionGroup& session_group,
                                    const rtp::FormatMap& format_map,
@@ -25,13 +26,23 @@ ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
     , proto_(proto)
     , receiver_state_(receiver_state)
     , session_group_(session_group)
-    , parser_(NULL) {
+    , parser_(NULL)
+    , queue_(queue_size, allocator)
+    , n_dropped_(0)
+    , n_reported_dropped_(0) {
+    if (!queue_.valid()) {
+        roc_log(LogError, "receiver endpoint: can't allocate queue of size %lu",
+                (unsigned long)queue_size);
+        return;
+    }
+
     packet::IParser* parser = NULL;
 
     switch (proto) {
     case address::Proto_RTP:
     case address::Proto_RTP_LDPC_Source:
     case address::Proto_RTP_RS8M_Source:
+    case address::Proto_RTP_RLC_Source:
         rtp_parser_.reset(new (rtp_parser_) rtp::Parser(format_map, NULL));
         if (!rtp_parser_) {
             return;
@@ -83,6 +94,28 @@ ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
         }
         parser = fec_parser_.get();
         break;
+    case address::Proto_RTP_RLC_Source:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::RLC_Source_PayloadID, fec::Source, fec::Footer>(
+                    parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case address::Proto_RLC_Repair:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::RLC_Repair_PayloadID, fec::Repair, fec::Header>(
+                    parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
     default:
         break;
     }
@@ -121,22 +154,54 @@ packet::IWriter& ReceiverEndpoint::writer() {
 void ReceiverEndpoint::pull_packets() {
     roc_panic_if(!valid());
 
-    // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
-    // It may return NULL either if the queue is empty or if the packets in the
-    // queue were added in a very short time or are being added currently. It's
+    // Popping from ring is lock-free and wait-free. It may stop either if the
+    // queue is empty or if the next packet is being added currently. It's
     // acceptable to consider such packets late and to be pulled next time.
-    while (packet::PacketPtr packet = queue_.try_pop_front_exclusive()) {
-        if (!parser_->parse(*packet, packet->data())) {
-            roc_log(LogDebug, "receiver endpoint: can't parse packet");
-            continue;
+    packet::PacketPtr packets[PullBatchSize];
+
+    for (;;) {
+        const size_t n_packets = queue_.pop_front_batch_exclusive(packets, PullBatchSize);
+        if (n_packets == 0) {
+            break;
         }
 
-        session_group_.route_packet(packet);
+        receiver_state_.add_pending_packets(-(int)n_packets);
 
-        receiver_state_.add_pending_packets(-1);
+        // move parsed packets to the beginning of the array
+        size_t n_parsed = 0;
+
+        for (size_t n = 0; n < n_packets; n++) {
+            if (parser_->parse(*packets[n], packets[n]->data())) {
+                packets[n_parsed++] = packets[n];
+            } else {
+                roc_log(LogDebug, "receiver endpoint: can't parse packet");
+            }
+        }
+
+        session_group_.route_packets(packets, n_parsed);
+
+        for (size_t n = 0; n < n_packets; n++) {
+            packets[n] = NULL;
+        }
+
+        if (n_packets < PullBatchSize) {
+            break;
+        }
+    }
+
+    const long n_dropped = n_dropped_;
+
+    if (n_dropped != n_reported_dropped_) {
+        roc_log(LogDebug, "receiver endpoint: queue is full, dropped %ld packets",
+                n_dropped - n_reported_dropped_);
+        n_reported_dropped_ = n_dropped;
     }
 }
 
+size_t ReceiverEndpoint::num_dropped_packets() const {
+    return (size_t)(long)n_dropped_;
+}
+
 void ReceiverEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!valid());
 
@@ -146,7 +211,33 @@ void ReceiverEndpoint::write(const packet::PacketPtr& packet) {
 
     receiver_state_.add_pending_packets(+1);
 
-    queue_.push_back(*packet);
+    if (!queue_.push_back(*packet)) {
+        receiver_state_.add_pending_packets(-1);
+        ++n_dropped_;
+    }
+}
+
+void ReceiverEndpoint::write_batch(const packet::PacketPtr* packets, size_t n_packets) {
+    roc_panic_if(!valid());
+
+    if (n_packets == 0) {
+        return;
+    }
+
+    for (size_t n = 0; n < n_packets; n++) {
+        if (!packets[n]) {
+            roc_panic("receiver endpoint: packet is null");
+        }
+    }
+
+    receiver_state_.add_pending_packets(+(int)n_packets);
+
+    const size_t n_pushed = queue_.push_back_batch(packets, n_packets);
+
+    if (n_pushed != n_packets) {
+        receiver_state_.add_pending_packets(-(int)(n_packets - n_pushed));
+        n_dropped_ += (long)(n_packets - n_pushed);
+    }
 }
 
 } // namespace pipeline
@@ -15,7 +15,8 @@
 #include "roc_address/interface.h"
 #include "roc_address/protocol.h"
 #include "roc_core/iallocator.h"
-#include "roc_core/mpsc_queue.h"
+#include "roc_core/atomic.h"
+#include "roc_core/mpsc_ring.h"
 #include "roc_core/optional.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/scoped_ptr.h"
@@ -44,7 +45,11 @@ class ReceiverEndpoint
 
 public:
     //! Initialize.
+    //! @remarks
+    //!  @p queue_size defines maximum number of packets written to endpoint
+    //!  and not yet pulled by pipeline.
     ReceiverEndpoint(address::Protocol proto,
+                     size_t queue_size,
                      ReceiverState& receiver_state,
                      ReceiverSessionGroup& session_group,
                      const rtp::FormatMap& format_map,
@@ -61,13 +66,21 @@ public:
     //!  Packets passed to this writer will be pulled by endpoint pipeline.
     //!  This writer is thread-safe and lock-free.
     //!  The writer is passed to netio thread.
+    //!  If the queue is full, packets are dropped.
+    //!  Batches are added to the queue with a single atomic operation.
     packet::IWriter& writer();
 
     //! Pull packets writter to endpoint writer.
     void pull_packets();
 
+    //! Get number of packets dropped because the queue was full.
+    size_t num_dropped_packets() const;
+
 private:
+    enum { PullBatchSize = 64 };
+
     virtual void write(const packet::PacketPtr& packet);
+    virtual void write_batch(const packet::PacketPtr* packets, size_t n_packets);
 
     const address::Protocol proto_;
 
@@ -80,7 +93,10 @@ private:
     core::ScopedPtr<packet::IParser> fec_parser_;
     core::Optional<rtcp::Parser> rtcp_parser_;
 
-    core::MpscQueue<packet::Packet> queue_;
+    core::MpscRing<packet::Packet> queue_;
+
+    core::Atomic<long> n_dropped_;
+    long n_reported_dropped_;
 };
 
 } // namespace pipeline
@@ -26,12 +26,22 @@ ReceiverSession::ReceiverSession(
     core::IAllocator& allocator)
     : RefCounted(allocator)
     , src_address_(src_address)
+    , source_(0)
+    , has_source_(false)
+    , last_sr_ntp_(0)
+    , last_sr_time_(0)
     , audio_reader_(NULL) {
     const rtp::Format* format = format_map.format(session_config.payload_type);
     if (!format) {
         return;
     }
 
+    reception_stats_.reset(new (reception_stats_)
+                               rtcp::ReceptionStats(format->sample_spec.sample_rate()));
+    if (!reception_stats_) {
+        return;
+    }
+
     queue_router_.reset(new (queue_router_) packet::Router(allocator));
     if (!queue_router_) {
         return;
@@ -85,26 +95,38 @@ ReceiverSession::ReceiverSession(
             return;
         }
 
-        fec_decoder_.reset(
-            fec::CodecMap::instance().new_decoder(session_config.fec_decoder,
-                                                  byte_buffer_factory, allocator),
-            allocator);
-        if (!fec_decoder_) {
-            return;
-        }
-
         fec_parser_.reset(new (fec_parser_) rtp::Parser(format_map, NULL));
         if (!fec_parser_) {
             return;
         }
 
-        fec_reader_.reset(new (fec_reader_) fec::Reader(
-            session_config.fec_reader, session_config.fec_decoder.scheme, *fec_decoder_,
-            *preader, *repair_queue_, *fec_parser_, packet_factory, allocator));
-        if (!fec_reader_ || !fec_reader_->valid()) {
-            return;
+        if (session_config.fec_decoder.scheme == packet::FEC_RLC) {
+            // sliding window codes don't use block decoder
+            fec_window_reader_.reset(new (fec_window_reader_) fec::WindowReader(
+                *preader, *repair_queue_, *fec_parser_, packet_factory,
+                byte_buffer_factory, allocator));
+            if (!fec_window_reader_ || !fec_window_reader_->valid()) {
+                return;
+            }
+            preader = fec_window_reader_.get();
+        } else {
+            fec_decoder_.reset(
+                fec::CodecMap::instance().new_decoder(session_config.fec_decoder,
+                                                      byte_buffer_factory, allocator),
+                allocator);
+            if (!fec_decoder_) {
+                return;
+            }
+
+            fec_reader_.reset(new (fec_reader_) fec::Reader(
+                session_config.fec_reader, session_config.fec_decoder.scheme,
+                *fec_decoder_, *preader, *repair_queue_, *fec_parser_, packet_factory,
+                allocator));
+            if (!fec_reader_ || !fec_reader_->valid()) {
+                return;
+            }
+            preader = fec_reader_.get();
         }
-        preader = fec_reader_.get();
 
         fec_validator_.reset(new (fec_validator_) rtp::Validator(
             *preader, session_config.rtp_validator, format->sample_spec));
@@ -205,6 +227,24 @@ bool ReceiverSession::valid() const {
     return audio_reader_;
 }
 
+const address::SocketAddr& ReceiverSession::src_address() const {
+    return src_address_;
+}
+
+void ReceiverSession::set_src_address(const address::SocketAddr& src_address) {
+    roc_panic_if(HashmapNode::hashmap_node_data()->bucket);
+
+    src_address_ = src_address;
+}
+
+bool ReceiverSession::has_source() const {
+    return has_source_;
+}
+
+packet::source_t ReceiverSession::source() const {
+    return source_;
+}
+
 bool ReceiverSession::handle(const packet::PacketPtr& packet) {
     roc_panic_if(!valid());
 
@@ -217,10 +257,42 @@ bool ReceiverSession::handle(const packet::PacketPtr& packet) {
         return false;
     }
 
+    update_source_(*packet, core::timestamp(core::ClockMonotonic));
+
     queue_router_->write(packet);
     return true;
 }
 
+bool ReceiverSession::handle_batch(const packet::PacketPtr* packets, size_t n_packets) {
+    roc_panic_if(!valid());
+
+    if (n_packets == 0) {
+        return true;
+    }
+
+    packet::UDP* udp = packets[0]->udp();
+    if (!udp) {
+        return false;
+    }
+
+    if (udp->src_addr != src_address_) {
+        return false;
+    }
+
+    const core::nanoseconds_t now = core::timestamp(core::ClockMonotonic);
+
+    for (size_t n = 0; n < n_packets; n++) {
+        roc_panic_if_msg(!packets[n]->udp()
+                             || packets[n]->udp()->src_addr != src_address_,
+                         "receiver session: packets of batch have different sources");
+
+        update_source_(*packets[n], now);
+    }
+
+    queue_router_->write_batch(packets, n_packets);
+    return true;
+}
+
 bool ReceiverSession::advance(packet::timestamp_t timestamp) {
     roc_panic_if(!valid());
 
@@ -252,9 +324,26 @@ audio::IFrameReader& ReceiverSession::reader() {
     return *audio_reader_;
 }
 
+rtcp::ReceptionMetrics ReceiverSession::get_reception_metrics() {
+    roc_panic_if(!valid());
+
+    rtcp::ReceptionMetrics metrics;
+    metrics.ssrc = source_;
+
+    reception_stats_->build_metrics(metrics);
+
+    if (last_sr_ntp_ != 0) {
+        metrics.last_sr = last_sr_ntp_;
+        metrics.delay_last_sr = core::timestamp(core::ClockMonotonic) - last_sr_time_;
+    }
+
+    return metrics;
+}
+
 void ReceiverSession::add_sending_metrics(const rtcp::SendingMetrics& metrics) {
-    // TODO
-    (void)metrics;
+    // remember last report, so that sender can compute RTT from our report
+    last_sr_ntp_ = metrics.origin_ntp;
+    last_sr_time_ = core::timestamp(core::ClockMonotonic);
 }
 
 void ReceiverSession::add_link_metrics(const rtcp::LinkMetrics& metrics) {
@@ -262,5 +351,19 @@ void ReceiverSession::add_link_metrics(const rtcp::LinkMetrics& metrics) {
     (void)metrics;
 }
 
+void ReceiverSession::update_source_(const packet::Packet& packet,
+                                     core::nanoseconds_t now) {
+    if (!has_source_ && packet.rtp()) {
+        source_ = packet.rtp()->source;
+        has_source_ = true;
+    }
+
+    // repair packets have own numbering and are not reported
+    if (packet.rtp() && packet.rtp()->source == source_
+        && (packet.flags() & packet::Packet::FlagAudio)) {
+        reception_stats_->add_packet(*packet.rtp(), now);
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
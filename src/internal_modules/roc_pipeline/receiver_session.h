@@ -23,6 +23,8 @@
 #include "roc_audio/resampler_reader.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/buffer_factory.h"
+#include "roc_core/hashmap_node.h"
+#include "roc_core/hashsum.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list_node.h"
 #include "roc_core/optional.h"
@@ -30,6 +32,7 @@
 #include "roc_core/scoped_ptr.h"
 #include "roc_fec/iblock_decoder.h"
 #include "roc_fec/reader.h"
+#include "roc_fec/window_reader.h"
 #include "roc_packet/delayed_reader.h"
 #include "roc_packet/iparser.h"
 #include "roc_packet/ireader.h"
@@ -39,6 +42,7 @@
 #include "roc_packet/sorted_queue.h"
 #include "roc_pipeline/config.h"
 #include "roc_rtcp/metrics.h"
+#include "roc_rtcp/reception_stats.h"
 #include "roc_rtp/format_map.h"
 #include "roc_rtp/parser.h"
 #include "roc_rtp/populator.h"
@@ -54,7 +58,8 @@ namespace pipeline {
 //!    them into audio frames
 class ReceiverSession
     : public core::RefCounted<ReceiverSession, core::StandardAllocation>,
-      public core::ListNode {
+      public core::ListNode,
+      public core::HashmapNode {
     typedef core::RefCounted<ReceiverSession, core::StandardAllocation> RefCounted;
 
 public:
@@ -71,11 +76,36 @@ public:
     //! Check if the session pipeline was succefully constructed.
     bool valid() const;
 
+    //! Get address of the sender.
+    const address::SocketAddr& src_address() const;
+
+    //! Set address of the sender.
+    //! @remarks
+    //!  Used for sessions prepared in advance by ReceiverSessionPool.
+    //!  Should be called before session is added to session group.
+    void set_src_address(const address::SocketAddr& src_address);
+
+    //! Check if source id of the sender is known.
+    //! @remarks
+    //!  Source id becomes known when first RTP packet is handled.
+    bool has_source() const;
+
+    //! Get source id (SSRC) of the sender.
+    packet::source_t source() const;
+
     //! Try to route a packet to this session.
     //! @returns
     //!  true if the packet is dedicated for this session
     bool handle(const packet::PacketPtr& packet);
 
+    //! Try to route multiple packets to this session.
+    //! @remarks
+    //!  All packets should have the same source address.
+    //!  Packets are passed to session queues as a batch.
+    //! @returns
+    //!  true if the packets are dedicated for this session
+    bool handle_batch(const packet::PacketPtr* packets, size_t n_packets);
+
     //! Advance session timestamp.
     //! @returns
     //!  false if the session is ended
@@ -89,17 +119,48 @@ public:
     //! Get audio reader.
     audio::IFrameReader& reader();
 
+    //! Get metrics to be reported to sender.
+    //! @remarks
+    //!  Fraction of lost packets is computed since previous call.
+    rtcp::ReceptionMetrics get_reception_metrics();
+
     //! Handle metrics obtained from sender.
     void add_sending_metrics(const rtcp::SendingMetrics& metrics);
 
     //! Handle estimated link metrics.
     void add_link_metrics(const rtcp::LinkMetrics& metrics);
 
+    //! Get hash of sender address, for hashmap.
+    static core::hashsum_t key_hash(const address::SocketAddr& addr) {
+        return addr.hash();
+    }
+
+    //! Compare sender addresses, for hashmap.
+    static bool key_equal(const address::SocketAddr& addr1,
+                          const address::SocketAddr& addr2) {
+        return addr1 == addr2;
+    }
+
+    //! Get sender address, for hashmap.
+    const address::SocketAddr& key() const {
+        return src_address_;
+    }
+
 private:
-    const address::SocketAddr src_address_;
+    void update_source_(const packet::Packet& packet, core::nanoseconds_t now);
+
+    address::SocketAddr src_address_;
+
+    packet::source_t source_;
+    bool has_source_;
+
+    packet::ntp_timestamp_t last_sr_ntp_;
+    core::nanoseconds_t last_sr_time_;
 
     audio::IFrameReader* audio_reader_;
 
+    core::Optional<rtcp::ReceptionStats> reception_stats_;
+
     core::Optional<packet::Router> queue_router_;
 
     core::Optional<packet::SortedQueue> source_queue_;
@@ -115,6 +176,7 @@ private:
     core::Optional<rtp::Parser> fec_parser_;
     core::ScopedPtr<fec::IBlockDecoder> fec_decoder_;
     core::Optional<fec::Reader> fec_reader_;
+    core::Optional<fec::WindowReader> fec_window_reader_;
     core::Optional<rtp::Validator> fec_validator_;
 
     core::Optional<audio::Depacketizer> depacketizer_;
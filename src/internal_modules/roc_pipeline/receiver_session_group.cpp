@@ -17,6 +17,7 @@ ReceiverSessionGroup::ReceiverSessionGroup(
     const ReceiverConfig& receiver_config,
     ReceiverState& receiver_state,
     audio::Mixer& mixer,
+    ReceiverSessionPool& session_pool,
     const rtp::FormatMap& format_map,
     packet::PacketFactory& packet_factory,
     core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -28,8 +29,12 @@ ReceiverSessionGroup::ReceiverSessionGroup(
     , sample_buffer_factory_(sample_buffer_factory)
     , format_map_(format_map)
     , mixer_(mixer)
+    , session_pool_(session_pool)
     , receiver_state_(receiver_state)
-    , receiver_config_(receiver_config) {
+    , receiver_config_(receiver_config)
+    , session_map_(allocator)
+    , source_map_(allocator)
+    , source_list_(allocator) {
 }
 
 void ReceiverSessionGroup::route_packet(const packet::PacketPtr& packet) {
@@ -41,6 +46,32 @@ void ReceiverSessionGroup::route_packet(const packet::PacketPtr& packet) {
     route_transport_packet_(packet);
 }
 
+void ReceiverSessionGroup::route_packets(const packet::PacketPtr* packets,
+                                         size_t n_packets) {
+    size_t n = 0;
+
+    while (n < n_packets) {
+        const packet::PacketPtr& packet = packets[n];
+
+        if (packet->rtcp() || !packet->udp()) {
+            route_packet(packet);
+            n++;
+            continue;
+        }
+
+        // find run of packets from the same sender
+        size_t run_end = n + 1;
+
+        while (run_end < n_packets && !packets[run_end]->rtcp() && packets[run_end]->udp()
+               && packets[run_end]->udp()->src_addr == packet->udp()->src_addr) {
+            run_end++;
+        }
+
+        route_transport_batch_(packets + n, run_end - n);
+        n = run_end;
+    }
+}
+
 void ReceiverSessionGroup::advance_sessions(packet::timestamp_t timestamp) {
     core::SharedPtr<ReceiverSession> curr, next;
 
@@ -72,34 +103,52 @@ size_t ReceiverSessionGroup::num_sessions() const {
 }
 
 void ReceiverSessionGroup::on_update_source(packet::source_t ssrc, const char* cname) {
-    // TODO
-    (void)ssrc;
-    (void)cname;
+    core::SharedPtr<SourceEntry> entry = source_map_.find(ssrc);
+    if (!entry) {
+        return;
+    }
+
+    roc_log(LogDebug, "session group: updating source: ssrc=%lu cname=%s src_addr=%s",
+            (unsigned long)ssrc, cname,
+            address::socket_addr_to_str(entry->session().src_address()).c_str());
 }
 
 void ReceiverSessionGroup::on_remove_source(packet::source_t ssrc) {
-    // TODO
-    (void)ssrc;
+    core::SharedPtr<SourceEntry> entry = source_map_.find(ssrc);
+    if (!entry) {
+        return;
+    }
+
+    roc_log(LogDebug, "session group: source said goodbye: ssrc=%lu",
+            (unsigned long)ssrc);
+
+    remove_session_(entry->session());
 }
 
 size_t ReceiverSessionGroup::on_get_num_sources() {
-    // TODO
-    return 0;
+    return source_map_.size();
 }
 
 rtcp::ReceptionMetrics
 ReceiverSessionGroup::on_get_reception_metrics(size_t source_index) {
-    // TODO
-    (void)source_index;
-    return rtcp::ReceptionMetrics();
+    if (source_index >= source_list_.size()) {
+        roc_panic("session group: source index out of bounds: source_index=%lu",
+                  (unsigned long)source_index);
+    }
+
+    return source_list_[source_index]->session().get_reception_metrics();
 }
 
 void ReceiverSessionGroup::on_add_sending_metrics(const rtcp::SendingMetrics& metrics) {
-    core::SharedPtr<ReceiverSession> sess;
-
-    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
-        sess->add_sending_metrics(metrics);
+    core::SharedPtr<SourceEntry> entry = source_map_.find(metrics.origin_ssrc);
+    if (!entry) {
+        roc_log(LogDebug, "session group: ignoring sending metrics for unknown source:"
+                          " ssrc=%lu",
+                (unsigned long)metrics.origin_ssrc);
+        return;
     }
+
+    entry->session().add_sending_metrics(metrics);
 }
 
 void ReceiverSessionGroup::on_add_link_metrics(const rtcp::LinkMetrics& metrics) {
@@ -111,11 +160,12 @@ void ReceiverSessionGroup::on_add_link_metrics(const rtcp::LinkMetrics& metrics)
 }
 
 void ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& packet) {
-    core::SharedPtr<ReceiverSession> sess;
-
-    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
-        if (sess->handle(packet)) {
-            return;
+    if (packet->udp()) {
+        if (core::SharedPtr<ReceiverSession> sess =
+                session_map_.find(packet->udp()->src_addr)) {
+            if (sess->handle(packet)) {
+                return;
+            }
         }
     }
 
@@ -124,6 +174,34 @@ void ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& pack
     }
 }
 
+void ReceiverSessionGroup::route_transport_batch_(const packet::PacketPtr* packets,
+                                                  size_t n_packets) {
+    core::SharedPtr<ReceiverSession> sess =
+        session_map_.find(packets[0]->udp()->src_addr);
+
+    if (!sess) {
+        // first packet may create session
+        route_transport_packet_(packets[0]);
+
+        packets++;
+        n_packets--;
+
+        if (n_packets == 0) {
+            return;
+        }
+
+        sess = session_map_.find(packets[0]->udp()->src_addr);
+    }
+
+    if (sess && sess->handle_batch(packets, n_packets)) {
+        return;
+    }
+
+    for (size_t n = 0; n < n_packets; n++) {
+        route_transport_packet_(packets[n]);
+    }
+}
+
 void ReceiverSessionGroup::route_control_packet_(const packet::PacketPtr& packet) {
     if (!rtcp_composer_) {
         rtcp_composer_.reset(new (rtcp_composer_) rtcp::Composer());
@@ -173,9 +251,13 @@ void ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
             address::socket_addr_to_str(src_address).c_str(),
             address::socket_addr_to_str(dst_address).c_str());
 
-    core::SharedPtr<ReceiverSession> sess = new (allocator_) ReceiverSession(
-        sess_config, receiver_config_.common, src_address, format_map_, packet_factory_,
-        byte_buffer_factory_, sample_buffer_factory_, allocator_);
+    core::SharedPtr<ReceiverSession> sess = session_pool_.take(sess_config, src_address);
+
+    if (!sess) {
+        sess = new (allocator_) ReceiverSession(
+            sess_config, receiver_config_.common, src_address, format_map_,
+            packet_factory_, byte_buffer_factory_, sample_buffer_factory_, allocator_);
+    }
 
     if (!sess || !sess->valid()) {
         roc_log(LogError, "session group: can't create session, initialization failed");
@@ -188,8 +270,18 @@ void ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
         return;
     }
 
+    if (!session_map_.grow()) {
+        roc_log(LogError, "session group: can't create session, can't grow session map");
+        return;
+    }
+
+    if (!add_source_(*sess)) {
+        return;
+    }
+
     mixer_.add_input(sess->reader());
     sessions_.push_back(*sess);
+    session_map_.insert(*sess);
 
     receiver_state_.add_sessions(+1);
 }
@@ -197,10 +289,76 @@ void ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
 void ReceiverSessionGroup::remove_session_(ReceiverSession& sess) {
     roc_log(LogInfo, "session group: removing session");
 
+    // keep session alive until it's given back to pool
+    core::SharedPtr<ReceiverSession> sess_ptr(&sess);
+
+    remove_source_(sess);
+
     mixer_.remove_input(sess.reader());
+    session_map_.remove(sess);
     sessions_.remove(sess);
 
     receiver_state_.add_sessions(-1);
+
+    session_pool_.release(sess_ptr);
+}
+
+bool ReceiverSessionGroup::add_source_(ReceiverSession& sess) {
+    if (!sess.has_source()) {
+        return true;
+    }
+
+    if (source_map_.find(sess.source())) {
+        // Another sender uses the same source id; RTCP reports for this source
+        // id will go to the first session.
+        roc_log(LogDebug, "session group: source id is already used: ssrc=%lu",
+                (unsigned long)sess.source());
+        return true;
+    }
+
+    if (!source_map_.grow()) {
+        roc_log(LogError, "session group: can't create session, can't grow source map");
+        return false;
+    }
+
+    if (!source_list_.grow_exp(source_list_.size() + 1)) {
+        roc_log(LogError, "session group: can't create session, can't grow source list");
+        return false;
+    }
+
+    core::SharedPtr<SourceEntry> entry = new (allocator_) SourceEntry(allocator_, sess);
+    if (!entry) {
+        roc_log(LogError, "session group: can't create session, can't allocate source");
+        return false;
+    }
+
+    entry->set_index(source_list_.size());
+    source_list_.push_back(entry.get());
+
+    source_map_.insert(*entry);
+    return true;
+}
+
+void ReceiverSessionGroup::remove_source_(ReceiverSession& sess) {
+    if (!sess.has_source()) {
+        return;
+    }
+
+    core::SharedPtr<SourceEntry> entry = source_map_.find(sess.source());
+    if (!entry || &entry->session() != &sess) {
+        return;
+    }
+
+    // move last entry to the freed position
+    SourceEntry* last_entry = source_list_[source_list_.size() - 1];
+    source_list_[entry->index()] = last_entry;
+    last_entry->set_index(entry->index());
+
+    if (!source_list_.resize(source_list_.size() - 1)) {
+        roc_panic("session group: can't shrink source list");
+    }
+
+    source_map_.remove(*entry);
 }
 
 ReceiverSessionConfig
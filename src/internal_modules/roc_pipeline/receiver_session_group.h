@@ -13,10 +13,17 @@
 #define ROC_PIPELINE_RECEIVER_SESSION_GROUP_H_
 
 #include "roc_audio/mixer.h"
+#include "roc_core/allocation_policy.h"
+#include "roc_core/hashmap.h"
+#include "roc_core/hashmap_node.h"
+#include "roc_core/hashsum.h"
+#include "roc_core/array.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/ref_counted.h"
 #include "roc_pipeline/receiver_session.h"
+#include "roc_pipeline/receiver_session_pool.h"
 #include "roc_pipeline/receiver_state.h"
 #include "roc_rtcp/composer.h"
 #include "roc_rtcp/session.h"
@@ -28,12 +35,19 @@ namespace pipeline {
 //!
 //! Contains:
 //!  - a set of related receiver sessions
+//!
+//! Sessions are indexed by sender address, which is used to route transport
+//! packets, and by sender source id (SSRC), which is used to route RTCP
+//! reports. Indexed sources are also kept in a dense array, which is used
+//! to access sources by position when building RTCP reports. All lookups
+//! take constant time regardless of number of sessions.
 class ReceiverSessionGroup : public core::NonCopyable<>, private rtcp::IReceiverHooks {
 public:
     //! Initialize.
     ReceiverSessionGroup(const ReceiverConfig& receiver_config,
                          ReceiverState& receiver_state,
                          audio::Mixer& mixer,
+                         ReceiverSessionPool& session_pool,
                          const rtp::FormatMap& format_map,
                          packet::PacketFactory& packet_factory,
                          core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -43,6 +57,13 @@ public:
     //! Route packet to session.
     void route_packet(const packet::PacketPtr& packet);
 
+    //! Route multiple packets to sessions.
+    //! @remarks
+    //!  Equivalent to calling route_packet() for every packet in order, but
+    //!  consecutive packets from the same sender are passed to its session
+    //!  as a batch.
+    void route_packets(const packet::PacketPtr* packets, size_t n_packets);
+
     //! Advance session timestamp.
     void advance_sessions(packet::timestamp_t timestamp);
 
@@ -53,6 +74,46 @@ public:
     size_t num_sessions() const;
 
 private:
+    // Maps sender source id to session.
+    class SourceEntry : public core::RefCounted<SourceEntry, core::StandardAllocation>,
+                        public core::HashmapNode {
+    public:
+        SourceEntry(core::IAllocator& allocator, ReceiverSession& session)
+            : core::RefCounted<SourceEntry, core::StandardAllocation>(allocator)
+            , session_(session)
+            , index_(0) {
+        }
+
+        ReceiverSession& session() const {
+            return session_;
+        }
+
+        size_t index() const {
+            return index_;
+        }
+
+        void set_index(size_t index) {
+            index_ = index;
+        }
+
+        static core::hashsum_t key_hash(packet::source_t ssrc) {
+            return core::hashsum_int(ssrc);
+        }
+
+        static bool key_equal(packet::source_t ssrc1, packet::source_t ssrc2) {
+            return ssrc1 == ssrc2;
+        }
+
+        packet::source_t key() const {
+            return session_.source();
+        }
+
+    private:
+        ReceiverSession& session_;
+        // Position in source_list_.
+        size_t index_;
+    };
+
     // Implementation of rtcp::IReceiverHooks interface.
     // These methods are invoked by rtcp::Session.
     virtual void on_update_source(packet::source_t ssrc, const char* cname);
@@ -63,6 +124,7 @@ private:
     virtual void on_add_link_metrics(const rtcp::LinkMetrics& metrics);
 
     void route_transport_packet_(const packet::PacketPtr& packet);
+    void route_transport_batch_(const packet::PacketPtr* packets, size_t n_packets);
     void route_control_packet_(const packet::PacketPtr& packet);
 
     bool can_create_session_(const packet::PacketPtr& packet);
@@ -70,6 +132,9 @@ private:
     void create_session_(const packet::PacketPtr& packet);
     void remove_session_(ReceiverSession& sess);
 
+    bool add_source_(ReceiverSession& sess);
+    void remove_source_(ReceiverSession& sess);
+
     ReceiverSessionConfig make_session_config_(const packet::PacketPtr& packet) const;
 
     core::IAllocator& allocator_;
@@ -81,6 +146,7 @@ private:
     const rtp::FormatMap& format_map_;
 
     audio::Mixer& mixer_;
+    ReceiverSessionPool& session_pool_;
 
     ReceiverState& receiver_state_;
     const ReceiverConfig& receiver_config_;
@@ -89,6 +155,11 @@ private:
     core::Optional<rtcp::Session> rtcp_session_;
 
     core::List<ReceiverSession> sessions_;
+
+    core::Hashmap<ReceiverSession> session_map_;
+    core::Hashmap<SourceEntry> source_map_;
+    // Same entries as in source_map_, in arbitrary order.
+    core::Array<SourceEntry*> source_list_;
 };
 
 } // namespace pipeline
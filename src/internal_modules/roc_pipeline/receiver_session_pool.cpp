@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_session_pool.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/time.h"
+#include "roc_packet/fec_scheme_to_str.h"
+
+namespace roc {
+namespace pipeline {
+
+ReceiverSessionPool::ReceiverSessionPool(
+    size_t pool_size,
+    const ReceiverConfig& receiver_config,
+    const rtp::FormatMap& format_map,
+    packet::PacketFactory& packet_factory,
+    core::BufferFactory<uint8_t>& byte_buffer_factory,
+    core::BufferFactory<audio::sample_t>& sample_buffer_factory,
+    core::IAllocator& allocator)
+    : pool_size_(pool_size)
+    , receiver_config_(receiver_config)
+    , format_map_(format_map)
+    , packet_factory_(packet_factory)
+    , byte_buffer_factory_(byte_buffer_factory)
+    , sample_buffer_factory_(sample_buffer_factory)
+    , allocator_(allocator)
+    , wanted_key_(-1)
+    , ready_key_(-1)
+    , stop_(0)
+    , started_(false) {
+    if (pool_size_ == 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "session pool: initializing: pool_size=%lu",
+            (unsigned long)pool_size_);
+
+    if (receiver_config_.default_session.payload_type != 0) {
+        wanted_key_ = make_key_(receiver_config_.default_session);
+    }
+
+    started_ = Thread::start();
+    if (!started_) {
+        roc_log(LogError, "session pool: can't start thread");
+    }
+}
+
+ReceiverSessionPool::~ReceiverSessionPool() {
+    if (started_) {
+        stop_ = 1;
+        wake_sem_.post();
+        Thread::join();
+    }
+
+    core::Mutex::Lock lock(mutex_);
+
+    while (core::SharedPtr<ReceiverSession> sess = ready_.front()) {
+        ready_.remove(*sess);
+    }
+
+    while (core::SharedPtr<ReceiverSession> sess = retired_.front()) {
+        retired_.remove(*sess);
+    }
+}
+
+bool ReceiverSessionPool::valid() const {
+    return pool_size_ == 0 || started_;
+}
+
+void ReceiverSessionPool::prepare(packet::FecScheme fec_scheme) {
+    if (!started_) {
+        return;
+    }
+
+    ReceiverSessionConfig session_config = receiver_config_.default_session;
+    if (session_config.payload_type == 0) {
+        session_config.payload_type = guess_payload_type_();
+    }
+    session_config.fec_decoder.scheme = fec_scheme;
+
+    const int key = make_key_(session_config);
+
+    if (wanted_key_ != key) {
+        roc_log(LogDebug, "session pool: preparing sessions: pt=%u fec=%s",
+                session_config.payload_type, packet::fec_scheme_to_str(fec_scheme));
+
+        wanted_key_ = key;
+        wake_sem_.post();
+    }
+}
+
+core::SharedPtr<ReceiverSession>
+ReceiverSessionPool::take(const ReceiverSessionConfig& session_config,
+                          const address::SocketAddr& src_address) {
+    if (!started_) {
+        return NULL;
+    }
+
+    const int key = make_key_(session_config);
+
+    if (wanted_key_ != key) {
+        roc_log(LogDebug, "session pool: switching to new encoding: pt=%u fec=%s",
+                session_config.payload_type,
+                packet::fec_scheme_to_str(session_config.fec_decoder.scheme));
+
+        wanted_key_ = key;
+        wake_sem_.post();
+
+        return NULL;
+    }
+
+    // Don't wait for background thread if it's moving sessions right now.
+    if (!mutex_.try_lock()) {
+        return NULL;
+    }
+
+    core::SharedPtr<ReceiverSession> sess;
+
+    if (ready_key_ == key) {
+        if ((sess = ready_.front())) {
+            ready_.remove(*sess);
+        }
+    }
+
+    mutex_.unlock();
+
+    if (!sess) {
+        return NULL;
+    }
+
+    wake_sem_.post();
+
+    sess->set_src_address(src_address);
+
+    return sess;
+}
+
+void ReceiverSessionPool::release(const core::SharedPtr<ReceiverSession>& sess) {
+    roc_panic_if(!sess);
+
+    if (!started_) {
+        return;
+    }
+
+    // Don't wait for background thread; if it's busy, the caller destroys
+    // the session by itself.
+    if (!mutex_.try_lock()) {
+        return;
+    }
+
+    retired_.push_back(*sess);
+
+    mutex_.unlock();
+
+    wake_sem_.post();
+}
+
+size_t ReceiverSessionPool::num_ready() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return ready_.size();
+}
+
+size_t ReceiverSessionPool::num_retired() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return retired_.size();
+}
+
+void ReceiverSessionPool::run() {
+    roc_log(LogDebug, "session pool: starting thread");
+
+    while (!stop_) {
+        refill_();
+
+        if (!destroy_retired_()) {
+            // pipeline thread is about to drop its last reference
+            core::sleep_for(core::ClockMonotonic, core::Millisecond);
+            continue;
+        }
+
+        wake_sem_.wait();
+    }
+
+    roc_log(LogDebug, "session pool: finishing thread");
+}
+
+bool ReceiverSessionPool::destroy_retired_() {
+    core::List<ReceiverSession> retired;
+
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        while (core::SharedPtr<ReceiverSession> sess = retired_.front()) {
+            retired_.remove(*sess);
+            retired.push_back(*sess);
+        }
+    }
+
+    bool all_destroyed = true;
+
+    // sessions are destroyed here, outside of lock
+    while (core::SharedPtr<ReceiverSession> sess = retired.front()) {
+        retired.remove(*sess);
+
+        // pipeline thread may still hold a reference for a moment after
+        // release(); keep such session and retry later, so that it's not
+        // destroyed on pipeline thread when that reference is dropped
+        if (sess->getref() > 1) {
+            core::Mutex::Lock lock(mutex_);
+            retired_.push_back(*sess);
+            all_destroyed = false;
+        }
+    }
+
+    return all_destroyed;
+}
+
+int ReceiverSessionPool::make_key_(const ReceiverSessionConfig& config) {
+    return int(config.payload_type & 0xffff) | (int(config.fec_decoder.scheme) << 16);
+}
+
+unsigned int ReceiverSessionPool::guess_payload_type_() const {
+    // sender has no way to announce payload type in advance, so assume that
+    // it sends as many channels as we output
+    const rtp::PayloadType payload_types[] = {
+        rtp::PayloadType_L16_Stereo,
+        rtp::PayloadType_L16_Mono,
+    };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(payload_types); n++) {
+        const rtp::Format* format = format_map_.format(payload_types[n]);
+        if (format
+            && format->sample_spec.channel_mask()
+                == receiver_config_.common.output_sample_spec.channel_mask()) {
+            return payload_types[n];
+        }
+    }
+
+    return rtp::PayloadType_L16_Stereo;
+}
+
+void ReceiverSessionPool::refill_() {
+    const int key = wanted_key_;
+    if (key < 0) {
+        return;
+    }
+
+    core::List<ReceiverSession> stale;
+
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        if (ready_key_ != key) {
+            while (core::SharedPtr<ReceiverSession> sess = ready_.front()) {
+                ready_.remove(*sess);
+                stale.push_back(*sess);
+            }
+            ready_key_ = key;
+        }
+    }
+
+    // stale sessions are destroyed here, outside of lock
+    while (core::SharedPtr<ReceiverSession> sess = stale.front()) {
+        stale.remove(*sess);
+    }
+
+    ReceiverSessionConfig sess_config = receiver_config_.default_session;
+    sess_config.payload_type = (unsigned)(key & 0xffff);
+    sess_config.fec_decoder.scheme = (packet::FecScheme)(key >> 16);
+
+    while (!stop_ && wanted_key_ == key) {
+        {
+            core::Mutex::Lock lock(mutex_);
+
+            if (ready_.size() >= pool_size_) {
+                break;
+            }
+        }
+
+        core::SharedPtr<ReceiverSession> sess = new (allocator_) ReceiverSession(
+            sess_config, receiver_config_.common, address::SocketAddr(), format_map_,
+            packet_factory_, byte_buffer_factory_, sample_buffer_factory_, allocator_);
+
+        if (!sess || !sess->valid()) {
+            roc_log(LogError,
+                    "session pool: can't prepare session: pt=%u fec=%s",
+                    sess_config.payload_type,
+                    packet::fec_scheme_to_str(sess_config.fec_decoder.scheme));
+            // Don't retry until next wake up.
+            break;
+        }
+
+        core::Mutex::Lock lock(mutex_);
+
+        if (ready_key_ == key) {
+            ready_.push_back(*sess);
+        }
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_session_pool.h
+//! @brief Pool of prepared receiver sessions.
+
+#ifndef ROC_PIPELINE_RECEIVER_SESSION_POOL_H_
+#define ROC_PIPELINE_RECEIVER_SESSION_POOL_H_
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/list.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/thread.h"
+#include "roc_packet/fec.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/receiver_session.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Pool of prepared receiver sessions.
+//!
+//! Building a session allocates its pipeline elements and buffers and fills
+//! resampler tables, which is too slow for the pipeline thread. The pool runs
+//! a background thread which builds sessions in advance, so that pipeline
+//! thread can take a ready session in O(1) without allocations.
+//!
+//! All prepared sessions have the same payload type and FEC scheme. They are
+//! seeded when an endpoint is bound, see prepare(), and then follow the
+//! encoding of the latest requested session. If the first sender doesn't
+//! match the seeded encoding, its session is built on the pipeline thread.
+//!
+//! Removed sessions are given back to the pool, which destroys them on the
+//! background thread, so that pipeline thread doesn't deallocate them either.
+//!
+//! Known limitation: sessions are not reused. Pipeline elements of a session
+//! (depacketizer, FEC reader, resampler, latency monitor) keep per-stream state
+//! and can't be reset to initial state, so every prepared session is built
+//! from scratch and every removed session is destroyed.
+//!
+//! If pool size is zero, the thread is not started, take() always fails,
+//! and release() does nothing.
+class ReceiverSessionPool : public core::Thread, public core::NonCopyable<> {
+public:
+    //! Initialize and start preparing sessions.
+    ReceiverSessionPool(size_t pool_size,
+                        const ReceiverConfig& receiver_config,
+                        const rtp::FormatMap& format_map,
+                        packet::PacketFactory& packet_factory,
+                        core::BufferFactory<uint8_t>& byte_buffer_factory,
+                        core::BufferFactory<audio::sample_t>& sample_buffer_factory,
+                        core::IAllocator& allocator);
+
+    //! Stop background thread and destroy prepared sessions.
+    ~ReceiverSessionPool();
+
+    //! Check if the pool was successfully constructed.
+    bool valid() const;
+
+    //! Start preparing sessions for given FEC scheme.
+    //! @remarks
+    //!  Called when an endpoint is bound, before any packets arrive. Payload
+    //!  type is taken from default session config; if it's not set, it's
+    //!  guessed from output sample spec. Never blocks.
+    void prepare(packet::FecScheme fec_scheme);
+
+    //! Take prepared session.
+    //! @returns
+    //!  session bound to @p src_address, or NULL if there is no prepared
+    //!  session for payload type and FEC scheme from @p session_config.
+    //! @remarks
+    //!  Never blocks and never allocates. Wakes up background thread to
+    //!  prepare a replacement or sessions for new encoding.
+    core::SharedPtr<ReceiverSession> take(const ReceiverSessionConfig& session_config,
+                                          const address::SocketAddr& src_address);
+
+    //! Give back removed session.
+    //! @remarks
+    //!  Never blocks. If the pool is enabled, the session is destroyed later on
+    //!  background thread. Otherwise, or if background thread is holding the
+    //!  lock right now, the session is destroyed when the caller drops its
+    //!  last reference.
+    void release(const core::SharedPtr<ReceiverSession>& sess);
+
+    //! Get number of prepared sessions.
+    size_t num_ready() const;
+
+    //! Get number of released sessions not yet destroyed.
+    size_t num_retired() const;
+
+private:
+    virtual void run();
+
+    static int make_key_(const ReceiverSessionConfig& config);
+
+    unsigned int guess_payload_type_() const;
+
+    void refill_();
+    bool destroy_retired_();
+
+    const size_t pool_size_;
+
+    const ReceiverConfig& receiver_config_;
+    const rtp::FormatMap& format_map_;
+
+    packet::PacketFactory& packet_factory_;
+    core::BufferFactory<uint8_t>& byte_buffer_factory_;
+    core::BufferFactory<audio::sample_t>& sample_buffer_factory_;
+    core::IAllocator& allocator_;
+
+    // Key of sessions requested by pipeline, or -1 if unknown yet.
+    core::Atomic<int> wanted_key_;
+
+    // Protects ready_, ready_key_, and retired_.
+    core::Mutex mutex_;
+    core::List<ReceiverSession> ready_;
+    int ready_key_;
+    core::List<ReceiverSession> retired_;
+
+    core::Semaphore wake_sem_;
+    core::Atomic<int> stop_;
+
+    bool started_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SESSION_POOL_H_
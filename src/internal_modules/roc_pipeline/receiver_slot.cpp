@@ -7,6 +7,7 @@
  */
 
 #include "roc_pipeline/receiver_slot.h"
+#include "roc_address/protocol_map.h"
 #include "roc_core/log.h"
 #include "roc_pipeline/endpoint_helpers.h"
 
@@ -16,6 +17,7 @@ namespace pipeline {
 ReceiverSlot::ReceiverSlot(const ReceiverConfig& receiver_config,
                            ReceiverState& receiver_state,
                            audio::Mixer& mixer,
+                           ReceiverSessionPool& session_pool,
                            const rtp::FormatMap& format_map,
                            packet::PacketFactory& packet_factory,
                            core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -23,10 +25,13 @@ ReceiverSlot::ReceiverSlot(const ReceiverConfig& receiver_config,
                            core::IAllocator& allocator)
     : RefCounted(allocator)
     , format_map_(format_map)
+    , endpoint_queue_size_(receiver_config.common.endpoint_queue_size)
     , receiver_state_(receiver_state)
+    , session_pool_(session_pool)
     , session_group_(receiver_config,
                      receiver_state,
                      mixer,
+                     session_pool,
                      format_map,
                      packet_factory,
                      byte_buffer_factory,
@@ -121,7 +126,8 @@ ReceiverEndpoint* ReceiverSlot::create_source_endpoint_(address::Protocol proto)
     }
 
     source_endpoint_.reset(new (source_endpoint_) ReceiverEndpoint(
-        proto, receiver_state_, session_group_, format_map_, allocator()));
+        proto, endpoint_queue_size_, receiver_state_, session_group_, format_map_,
+        allocator()));
 
     if (!source_endpoint_ || !source_endpoint_->valid()) {
         roc_log(LogError, "receiver slot: can't create source endpoint");
@@ -129,6 +135,13 @@ ReceiverEndpoint* ReceiverSlot::create_source_endpoint_(address::Protocol proto)
         return NULL;
     }
 
+    // start preparing sessions before the first packet arrives
+    const address::ProtocolAttrs* proto_attrs =
+        address::ProtocolMap::instance().find_proto_by_id(proto);
+    if (proto_attrs) {
+        session_pool_.prepare(proto_attrs->fec_scheme);
+    }
+
     return source_endpoint_.get();
 }
 
@@ -149,7 +162,8 @@ ReceiverEndpoint* ReceiverSlot::create_repair_endpoint_(address::Protocol proto)
     }
 
     repair_endpoint_.reset(new (repair_endpoint_) ReceiverEndpoint(
-        proto, receiver_state_, session_group_, format_map_, allocator()));
+        proto, endpoint_queue_size_, receiver_state_, session_group_, format_map_,
+        allocator()));
 
     if (!repair_endpoint_ || !repair_endpoint_->valid()) {
         roc_log(LogError, "receiver slot: can't create repair endpoint");
@@ -171,7 +185,8 @@ ReceiverEndpoint* ReceiverSlot::create_control_endpoint_(address::Protocol proto
     }
 
     control_endpoint_.reset(new (control_endpoint_) ReceiverEndpoint(
-        proto, receiver_state_, session_group_, format_map_, allocator()));
+        proto, endpoint_queue_size_, receiver_state_, session_group_, format_map_,
+        allocator()));
 
     if (!control_endpoint_ || !control_endpoint_->valid()) {
         roc_log(LogError, "receiver slot: can't create control endpoint");
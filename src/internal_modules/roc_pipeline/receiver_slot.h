@@ -22,6 +22,7 @@
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session_group.h"
+#include "roc_pipeline/receiver_session_pool.h"
 #include "roc_pipeline/receiver_state.h"
 #include "roc_rtp/format_map.h"
 
@@ -42,6 +43,7 @@ public:
     ReceiverSlot(const ReceiverConfig& receiver_config,
                  ReceiverState& receiver_state,
                  audio::Mixer& mixer,
+                 ReceiverSessionPool& session_pool,
                  const rtp::FormatMap& format_map,
                  packet::PacketFactory& packet_factory,
                  core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -69,8 +71,10 @@ private:
     ReceiverEndpoint* create_control_endpoint_(address::Protocol proto);
 
     const rtp::FormatMap& format_map_;
+    const size_t endpoint_queue_size_;
 
     ReceiverState& receiver_state_;
+    ReceiverSessionPool& session_pool_;
     ReceiverSessionGroup session_group_;
 
     core::Optional<ReceiverEndpoint> source_endpoint_;
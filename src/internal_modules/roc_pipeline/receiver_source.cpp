@@ -29,13 +29,37 @@ ReceiverSource::ReceiverSource(
     , allocator_(allocator)
     , audio_reader_(NULL)
     , config_(config)
+    , session_pool_(config_.common.session_pool_size,
+                    config_,
+                    format_map,
+                    packet_factory,
+                    byte_buffer_factory,
+                    sample_buffer_factory,
+                    allocator)
     , timestamp_(0) {
-    mixer_.reset(new (mixer_) audio::Mixer(sample_buffer_factory,
-                                           config.common.internal_frame_length,
-                                           config.common.output_sample_spec));
+    if (!session_pool_.valid()) {
+        return;
+    }
+
+    if (config.common.session_threads != 0) {
+        worker_pool_.reset(new (worker_pool_) core::WorkerPool(
+            config.common.session_threads, allocator));
+        if (!worker_pool_ || !worker_pool_->valid()) {
+            return;
+        }
+        mixer_.reset(new (mixer_) audio::Mixer(
+            sample_buffer_factory, config.common.internal_frame_length,
+            config.common.output_sample_spec, *worker_pool_, allocator));
+    } else {
+        mixer_.reset(new (mixer_) audio::Mixer(sample_buffer_factory,
+                                               config.common.internal_frame_length,
+                                               config.common.output_sample_spec));
+    }
     if (!mixer_ || !mixer_->valid()) {
         return;
     }
+    // beeps are written into blank frames
+    mixer_->set_skip_blank(!config.common.beeping);
     audio::IFrameReader* areader = mixer_.get();
 
     if (config.common.poisoning) {
@@ -64,9 +88,9 @@ bool ReceiverSource::valid() const {
 }
 
 ReceiverSlot* ReceiverSource::create_slot() {
-    core::SharedPtr<ReceiverSlot> slot = new (allocator_)
-        ReceiverSlot(config_, state_, *mixer_, format_map_, packet_factory_,
-                     byte_buffer_factory_, sample_buffer_factory_, allocator_);
+    core::SharedPtr<ReceiverSlot> slot = new (allocator_) ReceiverSlot(
+        config_, state_, *mixer_, session_pool_, format_map_, packet_factory_,
+        byte_buffer_factory_, sample_buffer_factory_, allocator_);
     if (!slot) {
         return NULL;
     }
@@ -21,11 +21,13 @@
 #include "roc_core/mutex.h"
 #include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/worker_pool.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/receiver_endpoint.h"
+#include "roc_pipeline/receiver_session_pool.h"
 #include "roc_pipeline/receiver_slot.h"
 #include "roc_pipeline/receiver_state.h"
 #include "roc_rtp/format_map.h"
@@ -103,6 +105,7 @@ private:
     ReceiverState state_;
     core::List<ReceiverSlot> slots_;
 
+    core::Optional<core::WorkerPool> worker_pool_;
     core::Optional<audio::Mixer> mixer_;
     core::Optional<audio::PoisonReader> poisoner_;
     core::Optional<audio::ProfilingReader> profiler_;
@@ -111,6 +114,8 @@ private:
 
     ReceiverConfig config_;
 
+    ReceiverSessionPool session_pool_;
+
     packet::timestamp_t timestamp_;
 };
 
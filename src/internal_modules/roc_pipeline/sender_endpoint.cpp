@@ -25,6 +25,7 @@ SenderEndpoint::SenderEndpoint(address::Protocol proto, core::IAllocator& alloca
     case address::Proto_RTP:
     case address::Proto_RTP_LDPC_Source:
     case address::Proto_RTP_RS8M_Source:
+    case address::Proto_RTP_RLC_Source:
         rtp_composer_.reset(new (rtp_composer_) rtp::Composer(NULL));
         if (!rtp_composer_) {
             return;
@@ -78,6 +79,28 @@ SenderEndpoint::SenderEndpoint(address::Protocol proto, core::IAllocator& alloca
         }
         composer = fec_composer_.get();
         break;
+    case address::Proto_RTP_RLC_Source:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::RLC_Source_PayloadID, fec::Source, fec::Footer>(
+                    composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
+    case address::Proto_RLC_Repair:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::RLC_Repair_PayloadID, fec::Repair, fec::Header>(
+                    composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
     default:
         break;
     }
@@ -83,6 +83,10 @@ SenderLoop::Tasks::CheckSlotIsReady::CheckSlotIsReady(SlotHandle slot) {
     slot_ = (SenderSlot*)slot;
 }
 
+SenderLoop::Tasks::FlushSlots::FlushSlots() {
+    func_ = &SenderLoop::task_flush_slots_;
+}
+
 SenderLoop::SenderLoop(IPipelineTaskScheduler& scheduler,
                        const SenderConfig& config,
                        const rtp::FormatMap& format_map,
@@ -259,5 +263,10 @@ bool SenderLoop::task_check_slot_is_ready_(Task& task) {
     return task.slot_->is_ready();
 }
 
+bool SenderLoop::task_flush_slots_(Task&) {
+    sink_.flush();
+    return true;
+}
+
 } // namespace pipeline
 } // namespace roc
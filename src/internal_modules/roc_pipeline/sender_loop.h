@@ -116,6 +116,15 @@ public:
             //! Set task parameters.
             CheckSlotIsReady(SlotHandle slot);
         };
+
+        //! Write packets that are still buffered in all slots.
+        //! Should be executed before destination writers of endpoints are
+        //! closed, e.g. before removing network ports.
+        class FlushSlots : public Task {
+        public:
+            //! Set task parameters.
+            FlushSlots();
+        };
     };
 
     //! Initialize.
@@ -158,6 +167,7 @@ private:
     bool task_set_endpoint_destination_writer_(Task&);
     bool task_set_endpoint_destination_address_(Task&);
     bool task_check_slot_is_ready_(Task&);
+    bool task_flush_slots_(Task&);
 
     SenderSink sink_;
 
@@ -27,7 +27,8 @@ SenderSession::SenderSession(const SenderConfig& config,
     , byte_buffer_factory_(byte_buffer_factory)
     , sample_buffer_factory_(sample_buffer_factory)
     , audio_writer_(NULL)
-    , num_sources_(0) {
+    , num_sources_(0)
+    , last_report_seqnum_(0) {
 }
 
 bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
@@ -74,21 +75,48 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             pwriter = interleaver_.get();
         }
 
-        fec_encoder_.reset(fec::CodecMap::instance().new_encoder(
-                               config_.fec_encoder, byte_buffer_factory_, allocator_),
-                           allocator_);
-        if (!fec_encoder_) {
-            return false;
+        size_t max_block_length = 0;
+
+        if (config_.fec_encoder.scheme == packet::FEC_RLC) {
+            // sliding window codes don't use block encoder
+            fec_window_writer_.reset(new (fec_window_writer_) fec::WindowWriter(
+                config_.fec_writer, *pwriter, source_endpoint->composer(),
+                repair_endpoint->composer(), packet_factory_, byte_buffer_factory_,
+                allocator_));
+            if (!fec_window_writer_ || !fec_window_writer_->valid()) {
+                return false;
+            }
+            pwriter = fec_window_writer_.get();
+
+            max_block_length = fec::WindowWriter::MaxWindowLength;
+        } else {
+            fec_encoder_.reset(fec::CodecMap::instance().new_encoder(
+                                   config_.fec_encoder, byte_buffer_factory_, allocator_),
+                               allocator_);
+            if (!fec_encoder_) {
+                return false;
+            }
+
+            fec_writer_.reset(new (fec_writer_) fec::Writer(
+                config_.fec_writer, config_.fec_encoder.scheme, *fec_encoder_, *pwriter,
+                source_endpoint->composer(), repair_endpoint->composer(), packet_factory_,
+                byte_buffer_factory_, allocator_));
+            if (!fec_writer_ || !fec_writer_->valid()) {
+                return false;
+            }
+            pwriter = fec_writer_.get();
+
+            max_block_length = fec_encoder_->max_block_length();
         }
 
-        fec_writer_.reset(new (fec_writer_) fec::Writer(
-            config_.fec_writer, config_.fec_encoder.scheme, *fec_encoder_, *pwriter,
-            source_endpoint->composer(), repair_endpoint->composer(), packet_factory_,
-            byte_buffer_factory_, allocator_));
-        if (!fec_writer_ || !fec_writer_->valid()) {
-            return false;
+        if (config_.fec_tuning) {
+            fec_tuner_.reset(new (fec_tuner_) fec::BlockTuner(
+                config_.fec_tuner, config_.fec_writer, max_block_length,
+                config_.packet_length));
+            if (!fec_tuner_ || !fec_tuner_->valid()) {
+                return false;
+            }
         }
-        pwriter = fec_writer_.get();
     }
 
     payload_encoder_.reset(format->new_encoder(allocator_), allocator_);
@@ -194,6 +222,17 @@ void SenderSession::update() {
     }
 }
 
+void SenderSession::flush() {
+    // FEC writer writes to interleaver, so drain it first
+    if (fec_writer_) {
+        fec_writer_->drain();
+    }
+
+    if (interleaver_) {
+        interleaver_->flush();
+    }
+}
+
 size_t SenderSession::on_get_num_sources() {
     return num_sources_;
 }
@@ -224,13 +263,48 @@ SenderSession::on_get_sending_metrics(packet::ntp_timestamp_t report_time) {
 }
 
 void SenderSession::on_add_reception_metrics(const rtcp::ReceptionMetrics& metrics) {
-    // TODO
-    (void)metrics;
+    // reports without packets received since previous report carry no loss
+    // information, and feeding zero loss from them would shrink repair
+    if (metrics.ext_last_seqnum == 0 || metrics.ext_last_seqnum == last_report_seqnum_) {
+        return;
+    }
+    last_report_seqnum_ = metrics.ext_last_seqnum;
+
+    if (fec_tuner_) {
+        fec_tuner_->update_loss(metrics.fract_loss);
+        resize_fec_block_();
+    }
 }
 
 void SenderSession::on_add_link_metrics(const rtcp::LinkMetrics& metrics) {
-    // TODO
-    (void)metrics;
+    if (fec_tuner_) {
+        fec_tuner_->update_rtt(metrics.rtt);
+        resize_fec_block_();
+    }
+}
+
+void SenderSession::resize_fec_block_() {
+    bool ok = false;
+
+    if (fec_window_writer_) {
+        ok = fec_window_writer_->resize(fec_tuner_->n_source_packets(),
+                                        fec_tuner_->n_repair_packets());
+    } else {
+        ok = fec_writer_->resize(fec_tuner_->n_source_packets(),
+                                 fec_tuner_->n_repair_packets());
+    }
+
+    if (!ok) {
+        roc_log(LogDebug, "sender session: can't resize fec block");
+        return;
+    }
+
+    if (interleaver_) {
+        if (!interleaver_->resize(fec_tuner_->n_source_packets()
+                                  + fec_tuner_->n_repair_packets())) {
+            roc_log(LogDebug, "sender session: can't resize interleaver block");
+        }
+    }
 }
 
 } // namespace pipeline
@@ -24,7 +24,9 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/iblock_encoder.h"
+#include "roc_fec/window_writer.h"
 #include "roc_fec/writer.h"
 #include "roc_packet/interleaver.h"
 #include "roc_packet/packet_factory.h"
@@ -69,6 +71,13 @@ public:
     //! Update pipeline.
     void update();
 
+    //! Write packets that are still buffered in the pipeline.
+    //! @remarks
+    //!  Writes repair packets of FEC blocks queued to the encoder thread and
+    //!  packets held by interleaver. Should be called before destination
+    //!  writers of endpoints are closed.
+    void flush();
+
 private:
     // Implementation of rtcp::ISenderHooks interface.
     // These methods are invoked by rtcp::Session.
@@ -79,6 +88,8 @@ private:
     virtual void on_add_reception_metrics(const rtcp::ReceptionMetrics& metrics);
     virtual void on_add_link_metrics(const rtcp::LinkMetrics& metrics);
 
+    void resize_fec_block_();
+
     core::IAllocator& allocator_;
 
     const SenderConfig& config_;
@@ -95,6 +106,8 @@ private:
 
     core::ScopedPtr<fec::IBlockEncoder> fec_encoder_;
     core::Optional<fec::Writer> fec_writer_;
+    core::Optional<fec::WindowWriter> fec_window_writer_;
+    core::Optional<fec::BlockTuner> fec_tuner_;
 
     core::ScopedPtr<audio::IFrameEncoder> payload_encoder_;
     core::Optional<audio::Packetizer> packetizer_;
@@ -111,6 +124,8 @@ private:
     audio::IFrameWriter* audio_writer_;
 
     size_t num_sources_;
+
+    uint32_t last_report_seqnum_;
 };
 
 } // namespace pipeline
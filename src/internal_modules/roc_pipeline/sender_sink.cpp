@@ -96,6 +96,14 @@ void SenderSink::update() {
     invalidate_update_deadline_();
 }
 
+void SenderSink::flush() {
+    core::SharedPtr<SenderSlot> slot;
+
+    for (slot = slots_.front(); slot; slot = slots_.nextof(*slot)) {
+        slot->flush();
+    }
+}
+
 sndio::DeviceType SenderSink::type() const {
     return sndio::DeviceType_Sink;
 }
@@ -67,6 +67,11 @@ public:
     //! Update pipeline.
     void update();
 
+    //! Write packets that are still buffered in all slots.
+    //! @remarks
+    //!  Should be called before destination writers of endpoints are closed.
+    void flush();
+
     //! Get device type.
     virtual sndio::DeviceType type() const;
 
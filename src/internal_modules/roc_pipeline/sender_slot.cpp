@@ -112,6 +112,14 @@ void SenderSlot::update() {
     session_.update();
 }
 
+void SenderSlot::flush() {
+    if (!is_ready()) {
+        return;
+    }
+
+    session_.flush();
+}
+
 SenderEndpoint* SenderSlot::create_source_endpoint_(address::Protocol proto) {
     if (source_endpoint_) {
         roc_log(LogError, "sender slot: audio source endpoint is already set");
@@ -63,6 +63,11 @@ public:
     //! Update pipeline.
     void update();
 
+    //! Write packets that are still buffered in the pipeline.
+    //! @remarks
+    //!  Does nothing if slot is not ready.
+    void flush();
+
 private:
     SenderEndpoint* create_source_endpoint_(address::Protocol proto);
     SenderEndpoint* create_repair_endpoint_(address::Protocol proto);
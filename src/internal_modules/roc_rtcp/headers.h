@@ -290,13 +290,13 @@ private:
         //! @name Fraction lost since last SR/RR.
         // @{
         Losses_FractLost_shift = 24,
-        Losses_FractLost_mask = 0x0F,
+        Losses_FractLost_mask = 0xFF,
         // @}
 
         //! @name cumul. no. pkts lost (signed!).
         // @{
-        Losses_CumLoss_shift = 24,
-        Losses_CumLoss_mask = 0x0FFF
+        Losses_CumLoss_shift = 0,
+        Losses_CumLoss_mask = 0xFFFFFF
         // @}
     };
 
@@ -343,7 +343,7 @@ public:
     float fract_loss() const {
         const uint32_t tmp = core::ntoh32u(losses_);
         uint8_t losses8 = (tmp >> Losses_FractLost_shift) & Losses_FractLost_mask;
-        float res = float(losses8) / float(1 << Losses_FractLost_shift);
+        float res = float(losses8) / float(1 << 8);
 
         return res;
     }
@@ -371,9 +371,10 @@ public:
     //!
     //! May be negative in case of packet repeats.
     int32_t cumloss() const {
-        uint32_t res = core::ntoh32u(losses_) & Losses_CumLoss_mask;
+        uint32_t res =
+            (core::ntoh32u(losses_) >> Losses_CumLoss_shift) & Losses_CumLoss_mask;
         // If res is negative
-        if (res & (1 << (Losses_CumLoss_shift - 1))) {
+        if (res & ((Losses_CumLoss_mask + 1) >> 1)) {
             // Make whole leftest byte filled with 1.
             res |= ~(uint32_t)Losses_CumLoss_mask;
         }
@@ -386,14 +387,15 @@ public:
     void set_cumloss(int32_t l) {
         uint32_t losses = core::ntoh32u(losses_);
 
-        if (l > Losses_CumLoss_mask) {
-            l = Losses_CumLoss_mask;
-        } else if (l < -(int32_t)Losses_CumLoss_mask) {
-            l = -Losses_CumLoss_mask;
+        const int32_t max_loss = Losses_CumLoss_mask >> 1;
+
+        if (l > max_loss) {
+            l = max_loss;
+        } else if (l < -max_loss) {
+            l = -max_loss;
         }
-        set_bitfield<uint32_t>(losses, (uint32_t)l,
-                               sizeof(losses_) * 8 - Losses_CumLoss_shift,
-                               Losses_CumLoss_mask);
+        set_bitfield<uint32_t>(losses, (uint32_t)l & Losses_CumLoss_mask,
+                               Losses_CumLoss_shift, Losses_CumLoss_mask);
 
         losses_ = core::hton32u(losses);
     }
@@ -21,6 +21,9 @@ namespace rtcp {
 
 //! Metrics sent from sender to receiver.
 struct SendingMetrics {
+    //! Source id of the sender.
+    packet::source_t origin_ssrc;
+
     //! NTP time when these metrics were generated.
     packet::ntp_timestamp_t origin_ntp;
 
@@ -28,7 +31,8 @@ struct SendingMetrics {
     packet::timestamp_t origin_rtp;
 
     SendingMetrics()
-        : origin_ntp(0)
+        : origin_ssrc(0)
+        , origin_ntp(0)
         , origin_rtp(0) {
     }
 };
@@ -38,12 +42,37 @@ struct ReceptionMetrics {
     //! To which source there metrics apply.
     packet::source_t ssrc;
 
-    //! Fraction of lost packets.
+    //! Fraction of packets lost since previous report.
     float fract_loss;
 
+    //! Cumulative number of packets lost.
+    //! May be negative in case of packet repeats.
+    int32_t cum_loss;
+
+    //! Extended highest sequence number received.
+    //! Zero if no packets were received yet.
+    uint32_t ext_last_seqnum;
+
+    //! Interarrival jitter, in RTP timestamp units.
+    uint32_t jitter;
+
+    //! NTP timestamp of last sender report received from source.
+    //! Zero if no reports were received yet.
+    //! @remarks
+    //!  Only middle 32 bits are transmitted.
+    packet::ntp_timestamp_t last_sr;
+
+    //! Delay between receiving last sender report and sending this report.
+    core::nanoseconds_t delay_last_sr;
+
     ReceptionMetrics()
         : ssrc(0)
-        , fract_loss(0) {
+        , fract_loss(0)
+        , cum_loss(0)
+        , ext_last_seqnum(0)
+        , jitter(0)
+        , last_sr(0)
+        , delay_last_sr(0) {
     }
 };
 
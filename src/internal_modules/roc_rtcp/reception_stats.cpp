@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtcp/reception_stats.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+// Constants from RFC 3550 A.1.
+enum { SeqMod = 1 << 16, MaxDropout = 3000, MaxMisorder = 100 };
+
+// Cumulative loss is a 24-bit signed field in report block.
+const int64_t MaxCumLoss = 0x7FFFFF;
+
+} // namespace
+
+ReceptionStats::ReceptionStats(size_t sample_rate)
+    : sample_rate_(sample_rate)
+    , has_packets_(false)
+    , max_seqnum_(0)
+    , cycles_(0)
+    , base_seqnum_(0)
+    , bad_seqnum_(0)
+    , n_received_(0)
+    , n_expected_prior_(0)
+    , n_received_prior_(0)
+    , last_transit_(0)
+    , jitter_(0) {
+    roc_panic_if_msg(sample_rate == 0, "reception stats: invalid sample rate");
+}
+
+bool ReceptionStats::has_packets() const {
+    return has_packets_;
+}
+
+void ReceptionStats::add_packet(const packet::RTP& rtp, core::nanoseconds_t recv_time) {
+    if (!has_packets_) {
+        init_seq_(rtp.seqnum);
+        has_packets_ = true;
+    } else if (!update_seq_(rtp.seqnum)) {
+        return;
+    }
+
+    update_jitter_(rtp, recv_time);
+}
+
+void ReceptionStats::build_metrics(ReceptionMetrics& metrics) {
+    if (!has_packets_) {
+        return;
+    }
+
+    const uint32_t ext_max_seqnum = ext_max_seqnum_();
+    const uint32_t n_expected = ext_max_seqnum - base_seqnum_ + 1;
+
+    int64_t cum_loss = int64_t(n_expected) - int64_t(n_received_);
+    if (cum_loss > MaxCumLoss) {
+        cum_loss = MaxCumLoss;
+    } else if (cum_loss < -MaxCumLoss) {
+        cum_loss = -MaxCumLoss;
+    }
+
+    const uint32_t n_expected_interval = n_expected - n_expected_prior_;
+    const uint32_t n_received_interval = n_received_ - n_received_prior_;
+
+    n_expected_prior_ = n_expected;
+    n_received_prior_ = n_received_;
+
+    const int64_t n_lost_interval =
+        int64_t(n_expected_interval) - int64_t(n_received_interval);
+
+    metrics.fract_loss = 0;
+    if (n_expected_interval != 0 && n_lost_interval > 0) {
+        metrics.fract_loss = float(double(n_lost_interval) / double(n_expected_interval));
+    }
+
+    metrics.cum_loss = (int32_t)cum_loss;
+    metrics.ext_last_seqnum = ext_max_seqnum;
+    metrics.jitter = (uint32_t)jitter_;
+}
+
+void ReceptionStats::init_seq_(packet::seqnum_t seqnum) {
+    base_seqnum_ = seqnum;
+    max_seqnum_ = seqnum;
+    bad_seqnum_ = SeqMod + 1;
+    cycles_ = 0;
+    n_received_ = 1;
+    n_expected_prior_ = 0;
+    n_received_prior_ = 0;
+}
+
+bool ReceptionStats::update_seq_(packet::seqnum_t seqnum) {
+    const packet::seqnum_t delta = packet::seqnum_t(seqnum - max_seqnum_);
+
+    if (delta < MaxDropout) {
+        // in order, with permissible gap
+        if (seqnum < max_seqnum_) {
+            // sequence number wrapped
+            cycles_ += SeqMod;
+        }
+        max_seqnum_ = seqnum;
+    } else if (delta <= SeqMod - MaxMisorder) {
+        // very large jump; if two sequential packets arrive after it, assume
+        // that the sender restarted and resync
+        if (seqnum == bad_seqnum_) {
+            init_seq_(seqnum);
+            return true;
+        }
+        bad_seqnum_ = (uint32_t(seqnum) + 1) & (SeqMod - 1);
+        return false;
+    } else {
+        // duplicate or reordered packet
+    }
+
+    n_received_++;
+    return true;
+}
+
+void ReceptionStats::update_jitter_(const packet::RTP& rtp,
+                                    core::nanoseconds_t recv_time) {
+    // arrival time in RTP timestamp units; only differences are meaningful,
+    // so wrapping is fine
+    const uint32_t arrival = (uint32_t)(
+        (uint64_t)(recv_time / core::Microsecond) * sample_rate_ / 1000000);
+
+    const int64_t transit = int64_t(uint32_t(arrival - rtp.timestamp));
+
+    if (n_received_ > 1) {
+        int32_t d = int32_t(uint32_t(transit - last_transit_));
+        if (d < 0) {
+            d = -d;
+        }
+        jitter_ += (double(d) - jitter_) / 16.;
+    }
+
+    last_transit_ = transit;
+}
+
+uint32_t ReceptionStats::ext_max_seqnum_() const {
+    return cycles_ + max_seqnum_;
+}
+
+} // namespace rtcp
+} // namespace roc
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/reception_stats.h
+//! @brief Reception statistics.
+
+#ifndef ROC_RTCP_RECEPTION_STATS_H_
+#define ROC_RTCP_RECEPTION_STATS_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_packet/rtp.h"
+#include "roc_rtcp/metrics.h"
+
+namespace roc {
+namespace rtcp {
+
+//! Reception statistics of one RTP source.
+//!
+//! Counts received and lost packets and estimates interarrival jitter, as
+//! described in RFC 3550 A.3 and A.8. Used by receiver to fill reception
+//! report blocks.
+class ReceptionStats : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p sample_rate defines RTP clock rate of the source.
+    explicit ReceptionStats(size_t sample_rate);
+
+    //! Check if at least one packet was received.
+    bool has_packets() const;
+
+    //! Handle received packet.
+    //! @remarks
+    //!  @p recv_time is local time when the packet was received.
+    void add_packet(const packet::RTP& rtp, core::nanoseconds_t recv_time);
+
+    //! Fill reception metrics.
+    //! @remarks
+    //!  Fills all fields except ssrc. Fraction of lost packets is computed
+    //!  since previous call, so every call starts new reporting interval.
+    void build_metrics(ReceptionMetrics& metrics);
+
+private:
+    void init_seq_(packet::seqnum_t seqnum);
+    bool update_seq_(packet::seqnum_t seqnum);
+    void update_jitter_(const packet::RTP& rtp, core::nanoseconds_t recv_time);
+
+    uint32_t ext_max_seqnum_() const;
+
+    const size_t sample_rate_;
+
+    bool has_packets_;
+
+    packet::seqnum_t max_seqnum_;
+    uint32_t cycles_;
+    uint32_t base_seqnum_;
+    uint32_t bad_seqnum_;
+
+    uint32_t n_received_;
+    uint32_t n_expected_prior_;
+    uint32_t n_received_prior_;
+
+    int64_t last_transit_;
+    double jitter_;
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_RECEPTION_STATS_H_
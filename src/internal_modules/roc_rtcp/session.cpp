@@ -186,6 +186,7 @@ void Session::parse_goodbye_(const ByeTraverser& bye) {
 
 void Session::parse_sender_report_(const header::SenderReportPacket& sr) {
     SendingMetrics metrics;
+    metrics.origin_ssrc = sr.ssrc();
     metrics.origin_ntp = sr.ntp_timestamp();
     metrics.origin_rtp = sr.rtp_timestamp();
 
@@ -208,10 +209,35 @@ void Session::parse_reception_block_(const header::ReceptionReportBlock& blk) {
     ReceptionMetrics metrics;
     metrics.ssrc = blk.ssrc();
     metrics.fract_loss = blk.fract_loss();
+    metrics.cum_loss = blk.cumloss();
+    metrics.ext_last_seqnum = blk.last_seqnum();
+    metrics.jitter = blk.jitter();
+    metrics.last_sr = packet::ntp_timestamp_t(blk.last_sr()) << 16;
+    metrics.delay_last_sr =
+        packet::ntp_2_nanoseconds(packet::ntp_timestamp_t(blk.delay_last_sr()) << 16);
 
     if (send_hooks_) {
         send_hooks_->on_add_reception_metrics(metrics);
     }
+
+    // RFC 3550 6.4.1: RTT is the time since we sent the SR referenced by the
+    // block minus the time the receiver held it; both are in middle 32 bits
+    // of NTP timestamp
+    if (blk.last_sr() != 0) {
+        const uint32_t now = uint32_t(packet::ntp_timestamp() >> 16);
+        const uint32_t rtt = now - blk.last_sr() - blk.delay_last_sr();
+
+        // negative RTT means that the clock or the report is broken
+        if (int32_t(rtt) > 0) {
+            LinkMetrics link_metrics;
+            link_metrics.rtt =
+                packet::ntp_2_nanoseconds(packet::ntp_timestamp_t(rtt) << 16);
+
+            if (send_hooks_) {
+                send_hooks_->on_add_link_metrics(link_metrics);
+            }
+        }
+    }
 }
 
 packet::PacketPtr Session::generate_packet_() {
@@ -353,6 +379,16 @@ Session::build_reception_block_(const ReceptionMetrics& metrics) {
     header::ReceptionReportBlock blk;
 
     blk.set_ssrc(metrics.ssrc);
+    blk.set_fract_loss(ssize_t(metrics.fract_loss * 256), 256);
+    blk.set_cumloss(metrics.cum_loss);
+    blk.set_last_seqnum(metrics.ext_last_seqnum);
+    blk.set_jitter(metrics.jitter);
+
+    if (metrics.last_sr != 0) {
+        blk.set_last_sr(uint32_t(metrics.last_sr >> 16));
+        blk.set_delay_last_sr(
+            uint32_t(packet::nanoseconds_2_ntp(metrics.delay_last_sr) >> 16));
+    }
 
     return blk;
 }
@@ -26,14 +26,28 @@ packet::PacketPtr Populator::read() {
         return NULL;
     }
 
-    if (!packet->rtp()) {
-        roc_panic("rtp populator: unexpected non-rtp packet");
+    populate_(*packet);
+
+    return packet;
+}
+
+size_t Populator::read_batch(packet::PacketPtr* packets, size_t max_packets) {
+    const size_t n_packets = reader_.read_batch(packets, max_packets);
+
+    for (size_t n = 0; n < n_packets; n++) {
+        populate_(*packets[n]);
     }
 
-    packet->rtp()->duration = (packet::timestamp_t)decoder_.decoded_sample_count(
-        packet->rtp()->payload.data(), packet->rtp()->payload.size());
+    return n_packets;
+}
 
-    return packet;
+void Populator::populate_(packet::Packet& packet) {
+    if (!packet.rtp()) {
+        roc_panic("rtp populator: unexpected non-rtp packet");
+    }
+
+    packet.rtp()->duration = (packet::timestamp_t)decoder_.decoded_sample_count(
+        packet.rtp()->payload.data(), packet.rtp()->payload.size());
 }
 
 } // namespace rtp
@@ -31,7 +31,12 @@ public:
     //! Read next packet.
     virtual packet::PacketPtr read();
 
+    //! Read multiple packets.
+    virtual size_t read_batch(packet::PacketPtr* packets, size_t max_packets);
+
 private:
+    void populate_(packet::Packet& packet);
+
     packet::IReader& reader_;
     audio::IFrameDecoder& decoder_;
     const audio::SampleSpec sample_spec_;
@@ -53,7 +53,14 @@ public:
     //!  is valid, return it. Otherwise, returns NULL.
     virtual packet::PacketPtr read();
 
+    //! Read multiple packets.
+    //! @remarks
+    //!  Reads a batch from the underlying reader and drops invalid packets
+    //!  from it, hence may return less packets than are available.
+    virtual size_t read_batch(packet::PacketPtr* packets, size_t max_packets);
+
 private:
+    bool validate_(const packet::PacketPtr& next_packet);
     bool check_(const packet::RTP& prev, const packet::RTP& next) const;
 
     packet::IReader& reader_;
@@ -96,6 +96,7 @@ typedef enum roc_interface {
      *  - \ref ROC_PROTO_RTP
      *  - \ref ROC_PROTO_RTP_RS8M_SOURCE
      *  - \ref ROC_PROTO_RTP_LDPC_SOURCE
+     *  - \ref ROC_PROTO_RTP_RLC_SOURCE
      */
     ROC_INTERFACE_AUDIO_SOURCE = 11,
 
@@ -108,6 +109,7 @@ typedef enum roc_interface {
      * Allowed protocols:
      *  - \ref ROC_PROTO_RS8M_REPAIR
      *  - \ref ROC_PROTO_LDPC_REPAIR
+     *  - \ref ROC_PROTO_RLC_REPAIR
      */
     ROC_INTERFACE_AUDIO_REPAIR = 12,
 
@@ -213,6 +215,35 @@ typedef enum roc_protocol {
      */
     ROC_PROTO_LDPC_REPAIR = 33,
 
+    /** RTP source packet (RFC 3550) + FECFRAME RLC footer (RFC 8681).
+     *
+     * Interfaces:
+     *  - \ref ROC_INTERFACE_AUDIO_SOURCE
+     *
+     * Transports:
+     *  - UDP
+     *
+     * Audio encodings:
+     *  - similar to \ref ROC_PROTO_RTP
+     *
+     * FEC encodings:
+     *  - \ref ROC_FEC_ENCODING_RLC
+     */
+    ROC_PROTO_RTP_RLC_SOURCE = 34,
+
+    /** FEC repair packet + FECFRAME RLC header (RFC 8681).
+     *
+     * Interfaces:
+     *  - \ref ROC_INTERFACE_AUDIO_REPAIR
+     *
+     * Transports:
+     *  - UDP
+     *
+     * FEC encodings:
+     *  - \ref ROC_FEC_ENCODING_RLC
+     */
+    ROC_PROTO_RLC_REPAIR = 35,
+
     /** RTCP over UDP (RFC 3550).
      *
      * Interfaces:
@@ -248,7 +279,17 @@ typedef enum roc_fec_encoding {
      * Compatible with \ref ROC_PROTO_RTP_LDPC_SOURCE and \ref ROC_PROTO_LDPC_REPAIR
      * protocols for source and repair endpoints.
      */
-    ROC_FEC_ENCODING_LDPC_STAIRCASE = 2
+    ROC_FEC_ENCODING_LDPC_STAIRCASE = 2,
+
+    /** Sliding window Random Linear Codes over GF(2^8) (RFC 8681).
+     * Good for low latency. Lost packets can be restored as soon as a few
+     * following repair packets arrive, instead of waiting for the whole block.
+     * Block size parameters define encoding window length and ratio of repair
+     * packets to source packets.
+     * Compatible with \ref ROC_PROTO_RTP_RLC_SOURCE and \ref ROC_PROTO_RLC_REPAIR
+     * protocols for source and repair endpoints.
+     */
+    ROC_FEC_ENCODING_RLC = 3
 } roc_fec_encoding;
 
 /** Packet encoding. */
@@ -340,6 +381,23 @@ typedef enum roc_clock_source {
     ROC_CLOCK_INTERNAL = 1
 } roc_clock_source;
 
+/** Policy of distributing ports between network threads.
+ * Used when context has more than one network thread. Applies to sender
+ * ports and to receiver ports that are not sharded between threads.
+ */
+typedef enum roc_network_thread_policy {
+    /** Default policy.
+     * Current default is \c ROC_NETWORK_THREAD_POLICY_LEAST_LOADED.
+     */
+    ROC_NETWORK_THREAD_POLICY_DEFAULT = 0,
+
+    /** Assign new ports to network threads in turn. */
+    ROC_NETWORK_THREAD_POLICY_ROUND_ROBIN = 1,
+
+    /** Assign new port to network thread with fewest ports. */
+    ROC_NETWORK_THREAD_POLICY_LEAST_LOADED = 2
+} roc_network_thread_policy;
+
 /** Context configuration.
  *
  * It is safe to memset() this struct with zeros to get a default config. It is also
@@ -361,6 +419,29 @@ typedef struct roc_context_config {
      * If zero, default value is used.
      */
     unsigned int max_frame_size;
+
+    /** Number of network threads.
+     * Sender and receiver ports are distributed between threads according
+     * to \c network_thread_policy. If \c receiver_port_sharding is enabled,
+     * receiver ports are instead bound in every thread.
+     * If zero, default value is used (one thread).
+     */
+    unsigned int network_threads;
+
+    /** Policy of distributing ports between network threads.
+     * If zero, default value is used.
+     */
+    roc_network_thread_policy network_thread_policy;
+
+    /** Enable sharding of receiver ports between network threads.
+     * If non-zero and there is more than one network thread, every unicast
+     * receiver port is bound in every thread with \c SO_REUSEPORT, and
+     * incoming traffic is distributed between threads by the OS (currently
+     * only on Linux). Binding fails if the address is already in use by
+     * another socket. Multicast and broadcast addresses, and ports with
+     * \c SO_REUSEADDR enabled, are never sharded.
+     */
+    unsigned int receiver_port_sharding;
 } roc_context_config;
 
 /** Sender configuration.
@@ -546,6 +627,22 @@ typedef struct roc_receiver_config {
      * \see broken_playback_timeout.
      */
     unsigned long long breakage_detection_window;
+
+    /** Number of sessions prepared in advance.
+     * If non-zero, the receiver runs a background thread which builds sessions for
+     * the expected encoding in advance, and destroys removed sessions, so that the
+     * pipeline thread doesn't do it when a sender appears or disappears.
+     * If zero, sessions are built and destroyed on the pipeline thread.
+     */
+    unsigned int session_pool_size;
+
+    /** Number of additional threads for processing sessions.
+     * If non-zero, when there are several sessions, their audio is decoded and
+     * resampled in parallel on these threads, and then mixed on the pipeline
+     * thread. If zero, all sessions are processed on the pipeline thread.
+     * Should not exceed 32.
+     */
+    unsigned int session_threads;
 } roc_receiver_config;
 
 #ifdef __cplusplus
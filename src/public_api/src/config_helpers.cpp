@@ -11,6 +11,7 @@
 #include "roc_audio/resampler_profile.h"
 #include "roc_core/attributes.h"
 #include "roc_core/log.h"
+#include "roc_core/worker_pool.h"
 
 namespace roc {
 namespace api {
@@ -24,6 +25,32 @@ bool context_config_from_user(peer::ContextConfig& out, const roc_context_config
         out.max_frame_size = in.max_frame_size;
     }
 
+    if (in.network_threads != 0) {
+        if (in.network_threads > peer::Context::MaxNetworkLoops) {
+            roc_log(LogError,
+                    "bad configuration: invalid network_threads:"
+                    " expected value in range [1; %u]",
+                    (unsigned)peer::Context::MaxNetworkLoops);
+            return false;
+        }
+        out.num_network_loops = in.network_threads;
+    }
+
+    out.receiver_port_sharding = in.receiver_port_sharding;
+
+    switch (in.network_thread_policy) {
+    case ROC_NETWORK_THREAD_POLICY_DEFAULT:
+    case ROC_NETWORK_THREAD_POLICY_LEAST_LOADED:
+        out.network_loop_policy = netio::NetworkLoopPolicy_LeastLoaded;
+        break;
+    case ROC_NETWORK_THREAD_POLICY_ROUND_ROBIN:
+        out.network_loop_policy = netio::NetworkLoopPolicy_RoundRobin;
+        break;
+    default:
+        roc_log(LogError, "bad configuration: invalid network_thread_policy");
+        return false;
+    }
+
     return true;
 }
 
@@ -115,6 +142,9 @@ bool sender_config_from_user(pipeline::SenderConfig& out, const roc_sender_confi
     case ROC_FEC_ENCODING_LDPC_STAIRCASE:
         out.fec_encoder.scheme = packet::FEC_LDPC_Staircase;
         break;
+    case ROC_FEC_ENCODING_RLC:
+        out.fec_encoder.scheme = packet::FEC_RLC;
+        break;
     default:
         roc_log(LogError, "bad configuration: invalid fec_scheme");
         return false;
@@ -234,6 +264,15 @@ bool receiver_config_from_user(pipeline::ReceiverConfig& out,
             (core::nanoseconds_t)in.breakage_detection_window;
     }
 
+    out.common.session_pool_size = in.session_pool_size;
+
+    if (in.session_threads > core::WorkerPool::MaxThreads) {
+        roc_log(LogError, "bad configuration: invalid session_threads: max=%lu",
+                (unsigned long)core::WorkerPool::MaxThreads);
+        return false;
+    }
+    out.common.session_threads = in.session_threads;
+
     return true;
 }
 
@@ -287,6 +326,14 @@ bool proto_from_user(address::Protocol& out, const roc_protocol& in) {
         out = address::Proto_LDPC_Repair;
         return true;
 
+    case ROC_PROTO_RTP_RLC_SOURCE:
+        out = address::Proto_RTP_RLC_Source;
+        return true;
+
+    case ROC_PROTO_RLC_REPAIR:
+        out = address::Proto_RLC_Repair;
+        return true;
+
     case ROC_PROTO_RTCP:
         out = address::Proto_RTCP;
         return true;
@@ -325,6 +372,14 @@ bool proto_to_user(roc_protocol& out, address::Protocol in) {
         out = ROC_PROTO_LDPC_REPAIR;
         return true;
 
+    case address::Proto_RTP_RLC_Source:
+        out = ROC_PROTO_RTP_RLC_SOURCE;
+        return true;
+
+    case address::Proto_RLC_Repair:
+        out = ROC_PROTO_RLC_REPAIR;
+        return true;
+
     case address::Proto_RTCP:
         out = ROC_PROTO_RTCP;
         return true;
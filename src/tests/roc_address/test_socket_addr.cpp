@@ -124,6 +124,10 @@ TEST(socket_addr, eq_ipv4) {
     CHECK(!(addr1 != addr2));
     CHECK(addr1 != addr3);
     CHECK(addr1 != addr4);
+
+    UNSIGNED_LONGS_EQUAL(addr1.hash(), addr2.hash());
+    CHECK(addr1.hash() != addr3.hash());
+    CHECK(addr1.hash() != addr4.hash());
 }
 
 TEST(socket_addr, eq_ipv6) {
@@ -150,6 +154,10 @@ TEST(socket_addr, eq_ipv6) {
     CHECK(!(addr1 != addr2));
     CHECK(addr1 != addr3);
     CHECK(addr1 != addr4);
+
+    UNSIGNED_LONGS_EQUAL(addr1.hash(), addr2.hash());
+    CHECK(addr1.hash() != addr3.hash());
+    CHECK(addr1.hash() != addr4.hash());
 }
 
 TEST(socket_addr, multicast_ipv4) {
@@ -220,6 +228,37 @@ TEST(socket_addr, multicast_ipv6) {
     }
 }
 
+TEST(socket_addr, broadcast) {
+    {
+        SocketAddr addr;
+        CHECK(addr.set_host_port(Family_IPv4, "255.255.255.255", 123));
+        CHECK(addr.has_host_port());
+        CHECK(addr.broadcast());
+        CHECK(!addr.multicast());
+    }
+
+    {
+        SocketAddr addr;
+        CHECK(addr.set_host_port(Family_IPv4, "255.255.255.254", 123));
+        CHECK(addr.has_host_port());
+        CHECK(!addr.broadcast());
+    }
+
+    {
+        SocketAddr addr;
+        CHECK(addr.set_host_port(Family_IPv4, "0.0.0.0", 123));
+        CHECK(addr.has_host_port());
+        CHECK(!addr.broadcast());
+    }
+
+    {
+        SocketAddr addr;
+        CHECK(addr.set_host_port(Family_IPv6, "ff02::1", 123));
+        CHECK(addr.has_host_port());
+        CHECK(!addr.broadcast());
+    }
+}
+
 TEST(socket_addr, clear) {
     SocketAddr addr;
     CHECK(addr.set_host_port(Family_IPv4, "239.255.255.255", 123));
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/mixer.h"
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum {
+    SampleRate = 48000,
+    ChannelMask = 0x3,
+    NumCh = 2,
+    FrameSz = 10 * SampleRate / 1000 * NumCh,
+    MaxInputs = 64,
+    BatchSize = 100
+};
+
+const core::nanoseconds_t FrameDuration = 10 * core::Millisecond;
+
+core::HeapAllocator allocator;
+core::BufferFactory<sample_t> buffer_factory(allocator, FrameSz, true);
+
+class ConstReader : public IFrameReader {
+public:
+    ConstReader()
+        : value_(0.01f) {
+    }
+
+    virtual bool read(Frame& frame) {
+        for (size_t n = 0; n < frame.num_samples(); n++) {
+            frame.samples()[n] = value_;
+        }
+        frame.set_flags(Frame::FlagNonblank);
+        return true;
+    }
+
+private:
+    const sample_t value_;
+};
+
+void BM_MixerKernel(benchmark::State& state) {
+    const MixerKernel kernel = (MixerKernel)state.range(0);
+
+    mixer_kernel_func_t func = mixer_kernel_func(kernel);
+    if (!func) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+
+    sample_t in[FrameSz];
+    sample_t out[FrameSz];
+
+    for (size_t n = 0; n < FrameSz; n++) {
+        in[n] = 0.001f;
+        out[n] = 0;
+    }
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        for (int n = 0; n < BatchSize; n++) {
+            func(out, in, FrameSz);
+            benchmark::DoNotOptimize(out);
+        }
+    }
+
+    state.counters["samples_per_sec"] = benchmark::Counter(
+        double(state.iterations()) * FrameSz, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_MixerKernel)
+    ->Arg(MixerKernel_Scalar)
+    ->Arg(MixerKernel_SSE2)
+    ->Arg(MixerKernel_AVX2)
+    ->Arg(MixerKernel_NEON)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_MixerRead(benchmark::State& state) {
+    const size_t num_inputs = (size_t)state.range(0);
+
+    ConstReader readers[MaxInputs];
+
+    Mixer mixer(buffer_factory, FrameDuration, SampleSpec(SampleRate, ChannelMask));
+    roc_panic_if(!mixer.valid());
+
+    for (size_t n = 0; n < num_inputs; n++) {
+        mixer.add_input(readers[n]);
+    }
+
+    sample_t samples[FrameSz];
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        for (int n = 0; n < BatchSize; n++) {
+            Frame frame(samples, FrameSz);
+            mixer.read(frame);
+            benchmark::DoNotOptimize(samples);
+        }
+    }
+
+    state.counters["samples_per_sec"] = benchmark::Counter(
+        double(state.iterations()) * FrameSz * num_inputs, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_MixerRead)
+    ->RangeMultiplier(2)
+    ->Range(1, MaxInputs)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/pcm_mapper.h"
+#include "roc_audio/pcm_mapper_func.h"
+#include "roc_core/macro_helpers.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum { NumSamples = 4096, MaxBytes = NumSamples * 8, BatchSize = 100 };
+
+struct Pair {
+    const char* name;
+    PcmEncoding in_encoding;
+    PcmEndian in_endian;
+    PcmEncoding out_encoding;
+    PcmEndian out_endian;
+    pcm_mapper_func_t scalar_func;
+};
+
+#define PAIR(name, in_enc, in_end, out_enc, out_end)                                    \
+    {                                                                                  \
+        name, PcmEncoding_##in_enc, PcmEndian_##in_end, PcmEncoding_##out_enc,         \
+            PcmEndian_##out_end,                                                       \
+            &pcm_mapper<PcmEncoding_##in_enc, PcmEncoding_##out_enc,                   \
+                        PcmEndian_##in_end, PcmEndian_##out_end>::map                  \
+    }
+
+// Float32 is native-endian; LE CPU is assumed for scalar baseline.
+const Pair pairs[] = {
+    // L16 RTP payloads
+    PAIR("s16be->f32", SInt16, Big, Float32, Little),
+    PAIR("f32->s16be", Float32, Little, SInt16, Big),
+    // sound cards
+    PAIR("s16le->f32", SInt16, Little, Float32, Little),
+    PAIR("f32->s16le", Float32, Little, SInt16, Little),
+    PAIR("s24le->f32", SInt24, Little, Float32, Little),
+    PAIR("f32->s24le", Float32, Little, SInt24, Little),
+    PAIR("s32le->f32", SInt32, Little, Float32, Little),
+    PAIR("f32->s32le", Float32, Little, SInt32, Little),
+    // bit-granular packed formats
+    PAIR("s18be->f32", SInt18, Big, Float32, Little),
+    PAIR("f32->s20be", Float32, Little, SInt20, Big),
+};
+
+#undef PAIR
+
+uint8_t input[MaxBytes];
+uint8_t output[MaxBytes];
+
+void fill_input(const Pair& pair) {
+    if (pair.in_encoding == PcmEncoding_Float32) {
+        for (size_t n = 0; n < NumSamples; n++) {
+            const float f = (float)(n % 2001) / 1000.0f - 1.0f;
+            memcpy(input + n * sizeof(float), &f, sizeof(float));
+        }
+    } else {
+        for (size_t n = 0; n < MaxBytes; n++) {
+            input[n] = (uint8_t)(n * 7919);
+        }
+    }
+}
+
+void set_counters(benchmark::State& state, const Pair& pair) {
+    state.SetLabel(pair.name);
+    state.counters["samples_per_sec"] = benchmark::Counter(
+        double(state.iterations()) * NumSamples, benchmark::Counter::kIsRate);
+}
+
+void BM_PcmMapper(benchmark::State& state) {
+    const Pair& pair = pairs[state.range(0)];
+
+    PcmFormat in_fmt;
+    in_fmt.encoding = pair.in_encoding;
+    in_fmt.endian = pair.in_endian;
+
+    PcmFormat out_fmt;
+    out_fmt.encoding = pair.out_encoding;
+    out_fmt.endian = pair.out_endian;
+
+    PcmMapper mapper(in_fmt, out_fmt);
+
+    fill_input(pair);
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        for (int n = 0; n < BatchSize; n++) {
+            size_t in_off = 0, out_off = 0;
+            mapper.map(input, sizeof(input), in_off, output, sizeof(output), out_off,
+                       NumSamples);
+            benchmark::DoNotOptimize(output);
+        }
+    }
+
+    set_counters(state, pair);
+}
+
+BENCHMARK(BM_PcmMapper)
+    ->DenseRange(0, (int)ROC_ARRAY_SIZE(pairs) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_PcmMapperScalar(benchmark::State& state) {
+    const Pair& pair = pairs[state.range(0)];
+
+    fill_input(pair);
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        for (int n = 0; n < BatchSize; n++) {
+            size_t in_off = 0, out_off = 0;
+            pair.scalar_func(input, in_off, output, out_off, NumSamples);
+            benchmark::DoNotOptimize(output);
+        }
+    }
+
+    set_counters(state, pair);
+}
+
+BENCHMARK(BM_PcmMapperScalar)
+    ->DenseRange(0, (int)ROC_ARRAY_SIZE(pairs) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/iframe_writer.h"
+#include "roc_audio/resampler_map.h"
+#include "roc_audio/resampler_reader.h"
+#include "roc_audio/resampler_writer.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum {
+    // Enough for 10ms at 96kHz with 8 channels.
+    MaxFrameSize = 8192,
+    NumFrames = 100
+};
+
+enum Method { Method_Reader, Method_Writer };
+
+const core::nanoseconds_t FrameDuration = 10 * core::Millisecond;
+
+const ResamplerProfile profiles[] = {
+    ResamplerProfile_Low,
+    ResamplerProfile_Medium,
+    ResamplerProfile_High,
+};
+
+const size_t channel_counts[] = { 1, 2, 6, 8 };
+
+const size_t rate_pairs[][2] = {
+    { 44100, 48000 }, { 48000, 44100 }, { 48000, 48000 },
+    { 16000, 48000 }, { 96000, 48000 },
+};
+
+// Small deviation like those produced by latency monitor.
+const float Scaling = 1.0005f;
+
+core::HeapAllocator allocator;
+core::BufferFactory<sample_t> buffer_factory(allocator, MaxFrameSize, true);
+
+class NoiseReader : public IFrameReader {
+public:
+    NoiseReader()
+        : pos_(0) {
+        for (size_t n = 0; n < MaxFrameSize; n++) {
+            samples_[n] = (sample_t)((n * 7919) % 1000) / 1000.0f - 0.5f;
+        }
+    }
+
+    virtual bool read(Frame& frame) {
+        for (size_t n = 0; n < frame.num_samples(); n++) {
+            frame.samples()[n] = samples_[pos_];
+            pos_ = (pos_ + 1) % MaxFrameSize;
+        }
+        frame.set_flags(Frame::FlagNonblank);
+        return true;
+    }
+
+private:
+    sample_t samples_[MaxFrameSize];
+    size_t pos_;
+};
+
+class CountingWriter : public IFrameWriter {
+public:
+    CountingWriter()
+        : num_samples_(0) {
+    }
+
+    virtual void write(Frame& frame) {
+        benchmark::DoNotOptimize(frame.samples());
+        num_samples_ += frame.num_samples();
+    }
+
+    size_t num_samples() const {
+        return num_samples_;
+    }
+
+private:
+    size_t num_samples_;
+};
+
+void set_args(benchmark::internal::Benchmark* b) {
+    std::vector<std::string> names;
+    names.push_back("backend");
+    names.push_back("profile");
+    names.push_back("channels");
+    names.push_back("in_rate");
+    names.push_back("out_rate");
+    names.push_back("set_scaling");
+    b->ArgNames(names);
+
+    for (size_t n_back = 0; n_back < ResamplerMap::instance().num_backends(); n_back++) {
+        for (size_t n_prof = 0; n_prof < ROC_ARRAY_SIZE(profiles); n_prof++) {
+            for (size_t n_ch = 0; n_ch < ROC_ARRAY_SIZE(channel_counts); n_ch++) {
+                for (size_t n_rate = 0; n_rate < ROC_ARRAY_SIZE(rate_pairs); n_rate++) {
+                    // Without and with set_scaling() call before every frame.
+                    for (int n_scale = 0; n_scale < 2; n_scale++) {
+                        std::vector<int64_t> args;
+                        args.push_back(
+                            (int64_t)ResamplerMap::instance().nth_backend(n_back));
+                        args.push_back((int64_t)profiles[n_prof]);
+                        args.push_back((int64_t)channel_counts[n_ch]);
+                        args.push_back((int64_t)rate_pairs[n_rate][0]);
+                        args.push_back((int64_t)rate_pairs[n_rate][1]);
+                        args.push_back((int64_t)n_scale);
+                        b->Args(args);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void run_bench(benchmark::State& state, Method method) {
+    const ResamplerBackend backend = (ResamplerBackend)state.range(0);
+    const ResamplerProfile profile = (ResamplerProfile)state.range(1);
+    const size_t num_channels = (size_t)state.range(2);
+    const packet::channel_mask_t chans =
+        (packet::channel_mask_t)((1u << num_channels) - 1);
+    const size_t in_rate = (size_t)state.range(3);
+    const size_t out_rate = (size_t)state.range(4);
+    const bool scale_every_frame = state.range(5) != 0;
+
+    const SampleSpec in_spec(in_rate, chans);
+    const SampleSpec out_spec(out_rate, chans);
+
+    core::ScopedPtr<IResampler> resampler(
+        ResamplerMap::instance().new_resampler(backend, allocator, buffer_factory,
+                                               profile, FrameDuration, in_spec),
+        allocator);
+    if (!resampler || !resampler->valid()) {
+        state.SkipWithError("can't create resampler");
+        return;
+    }
+
+    state.SetLabel(resampler_backend_to_str(backend));
+
+    NoiseReader reader;
+    CountingWriter writer;
+
+    core::ScopedPtr<ResamplerReader> resampler_reader;
+    core::ScopedPtr<ResamplerWriter> resampler_writer;
+
+    if (method == Method_Reader) {
+        resampler_reader.reset(new (allocator) ResamplerReader(reader, *resampler,
+                                                               in_spec, out_spec),
+                               allocator);
+        roc_panic_if(!resampler_reader || !resampler_reader->valid());
+        roc_panic_if(!resampler_reader->set_scaling(Scaling));
+    } else {
+        resampler_writer.reset(new (allocator) ResamplerWriter(
+                                   writer, *resampler, buffer_factory, FrameDuration,
+                                   in_spec, out_spec),
+                               allocator);
+        roc_panic_if(!resampler_writer || !resampler_writer->valid());
+        roc_panic_if(!resampler_writer->set_scaling(Scaling));
+    }
+
+    const size_t in_frame_size = in_spec.ns_2_samples_overall(FrameDuration);
+    const size_t out_frame_size = out_spec.ns_2_samples_overall(FrameDuration);
+
+    sample_t samples[MaxFrameSize];
+
+    size_t num_out_samples = 0;
+    size_t frame_num = 0;
+
+    while (state.KeepRunningBatch(NumFrames)) {
+        for (int n = 0; n < NumFrames; n++) {
+            if (scale_every_frame) {
+                // Alternate scaling to emulate latency monitor adjustments.
+                const float scaling = (frame_num++ % 2) ? Scaling : 1 / Scaling;
+                if (resampler_reader) {
+                    resampler_reader->set_scaling(scaling);
+                } else {
+                    resampler_writer->set_scaling(scaling);
+                }
+            }
+
+            if (resampler_reader) {
+                Frame frame(samples, out_frame_size);
+                resampler_reader->read(frame);
+                benchmark::DoNotOptimize(samples);
+                num_out_samples += out_frame_size;
+            } else {
+                Frame frame(samples, in_frame_size);
+                reader.read(frame);
+                resampler_writer->write(frame);
+            }
+        }
+    }
+
+    if (resampler_writer) {
+        num_out_samples = writer.num_samples();
+    }
+
+    // Count output samples per channel, so that results for different
+    // number of channels can be compared with output rate.
+    state.counters["samples_per_sec"] = benchmark::Counter(
+        double(num_out_samples / num_channels), benchmark::Counter::kIsRate);
+}
+
+void BM_ResamplerReader(benchmark::State& state) {
+    run_bench(state, Method_Reader);
+}
+
+BENCHMARK(BM_ResamplerReader)->Apply(set_args)->Unit(benchmark::kMicrosecond);
+
+void BM_ResamplerWriter(benchmark::State& state) {
+    run_bench(state, Method_Writer);
+}
+
+BENCHMARK(BM_ResamplerWriter)->Apply(set_args)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -19,6 +19,9 @@ enum { MaxSamples = 100 };
 
 const double Epsilon = 0.000001;
 
+// -3dB
+const sample_t F = 0.70710678f;
+
 void check(sample_t* input,
            sample_t* output,
            size_t n_samples,
@@ -32,7 +35,7 @@ void check(sample_t* input,
     ChannelMapper mapper(in_chans, out_chans);
     mapper.map(in_frame, out_frame);
 
-    for (size_t n = 0; n < n_samples; n++) {
+    for (size_t n = 0; n < n_samples * packet::num_channels(out_chans); n++) {
         DOUBLES_EQUAL(output[n], actual_output[n], Epsilon);
     }
 }
@@ -74,12 +77,13 @@ TEST(channel_mapper, mask_subset) {
         0.5f, //
     };
 
+    // mono is duplicated to both channels
     sample_t output[NumSamples * 2] = {
-        0.0f, 0.1f, //
-        0.0f, 0.2f, //
-        0.0f, 0.3f, //
-        0.0f, 0.4f, //
-        0.0f, 0.5f, //
+        0.1f, 0.1f, //
+        0.2f, 0.2f, //
+        0.3f, 0.3f, //
+        0.4f, 0.4f, //
+        0.5f, 0.5f, //
     };
 
     check(input, output, NumSamples, InChans, OutChans);
@@ -96,12 +100,14 @@ TEST(channel_mapper, mask_superset) {
         -0.5f, 0.5f, 0.8f, //
     };
 
+    // center is folded into left and right with -3dB, and the result
+    // is scaled to avoid clipping
     sample_t output[NumSamples * 2] = {
-        -0.1f, 0.1f, //
-        -0.2f, 0.2f, //
-        -0.3f, 0.3f, //
-        -0.4f, 0.4f, //
-        -0.5f, 0.5f, //
+        (-0.1f + 0.8f * F) / (1 + F), (0.1f + 0.8f * F) / (1 + F), //
+        (-0.2f + 0.8f * F) / (1 + F), (0.2f + 0.8f * F) / (1 + F), //
+        (-0.3f + 0.8f * F) / (1 + F), (0.3f + 0.8f * F) / (1 + F), //
+        (-0.4f + 0.8f * F) / (1 + F), (0.4f + 0.8f * F) / (1 + F), //
+        (-0.5f + 0.8f * F) / (1 + F), (0.5f + 0.8f * F) / (1 + F), //
     };
 
     check(input, output, NumSamples, InChans, OutChans);
@@ -110,7 +116,7 @@ TEST(channel_mapper, mask_superset) {
 TEST(channel_mapper, mask_overlap) {
     enum { NumSamples = 5, InChans = 0x5, OutChans = 0x3 };
 
-    sample_t input[NumSamples * 3] = {
+    sample_t input[NumSamples * 2] = {
         -0.1f, 0.8f, //
         -0.2f, 0.8f, //
         -0.3f, 0.8f, //
@@ -118,12 +124,147 @@ TEST(channel_mapper, mask_overlap) {
         -0.5f, 0.8f, //
     };
 
+    // center is folded into left and right with -3dB, and left is scaled
+    // to avoid clipping, while right gets only center and is not scaled
+    sample_t output[NumSamples * 2] = {
+        (-0.1f + 0.8f * F) / (1 + F), 0.8f * F, //
+        (-0.2f + 0.8f * F) / (1 + F), 0.8f * F, //
+        (-0.3f + 0.8f * F) / (1 + F), 0.8f * F, //
+        (-0.4f + 0.8f * F) / (1 + F), 0.8f * F, //
+        (-0.5f + 0.8f * F) / (1 + F), 0.8f * F, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, mono_to_stereo) {
+    enum { NumSamples = 3, InChans = 0x1, OutChans = 0x3 };
+
+    sample_t input[NumSamples] = { 0.1f, -0.2f, 0.3f };
+
+    sample_t output[NumSamples * 2] = {
+        0.1f,  0.1f,  //
+        -0.2f, -0.2f, //
+        0.3f,  0.3f,  //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, stereo_to_mono) {
+    enum { NumSamples = 3, InChans = 0x3, OutChans = 0x1 };
+
+    sample_t input[NumSamples * 2] = {
+        0.1f,  0.3f, //
+        -0.2f, 0.2f, //
+        0.5f,  0.5f, //
+    };
+
+    sample_t output[NumSamples] = { 0.2f, 0.0f, 0.5f };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, stereo_to_surround) {
+    enum { NumSamples = 2, InChans = 0x3, OutChans = 0x3F };
+
+    sample_t input[NumSamples * 2] = {
+        0.1f, 0.2f, //
+        0.3f, 0.4f, //
+    };
+
+    // center is mixed from front with -3dB and scaled to avoid clipping,
+    // backs are derived from front with -3dB, LFE is not derived
+    // FL FR FC LFE BL BR
+    sample_t output[NumSamples * 6] = {
+        0.1f, 0.2f, (0.1f + 0.2f) / 2, 0.0f, 0.1f * F, 0.2f * F, //
+        0.3f, 0.4f, (0.3f + 0.4f) / 2, 0.0f, 0.3f * F, 0.4f * F, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, mono_to_surround) {
+    enum { NumSamples = 2, InChans = 0x1, OutChans = 0x3F };
+
+    sample_t input[NumSamples] = { 0.1f, -0.2f };
+
+    // FL FR FC LFE BL BR
+    sample_t output[NumSamples * 6] = {
+        0.1f,  0.1f,  0.1f,  0.0f, 0.1f * F,  0.1f * F,  //
+        -0.2f, -0.2f, -0.2f, 0.0f, -0.2f * F, -0.2f * F, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, surround51_to_surround71) {
+    enum { NumSamples = 1, InChans = 0x3F, OutChans = 0xFF };
+
+    // FL FR FC LFE BL BR
+    sample_t input[NumSamples * 6] = {
+        0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, //
+    };
+
+    // sides are copied from backs
+    // FL FR FC LFE BL BR SL SR
+    sample_t output[NumSamples * 8] = {
+        0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.5f, 0.6f, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, surround_to_stereo) {
+    enum { NumSamples = 2, InChans = 0x3F, OutChans = 0x3 };
+
+    // FL FR FC LFE BL BR
+    sample_t input[NumSamples * 6] = {
+        0.1f, 0.2f, 0.3f, 0.9f, 0.4f, 0.5f, //
+        0.5f, 0.4f, 0.3f, 0.9f, 0.2f, 0.1f, //
+    };
+
+    // LFE is dropped, center and back are folded with -3dB,
+    // and the result is scaled to avoid clipping
     sample_t output[NumSamples * 2] = {
-        -0.1f, 0.0f, //
-        -0.2f, 0.0f, //
-        -0.3f, 0.0f, //
-        -0.4f, 0.0f, //
-        -0.5f, 0.0f, //
+        (0.1f + 0.3f * F + 0.4f * F) / (1 + 2 * F),
+        (0.2f + 0.3f * F + 0.5f * F) / (1 + 2 * F), //
+        (0.5f + 0.3f * F + 0.2f * F) / (1 + 2 * F),
+        (0.4f + 0.3f * F + 0.1f * F) / (1 + 2 * F), //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, surround71_to_surround51) {
+    enum { NumSamples = 1, InChans = 0xFF, OutChans = 0x3F };
+
+    // FL FR FC LFE BL BR SL SR
+    sample_t input[NumSamples * 8] = {
+        0.1f, 0.2f, 0.3f, 0.4f, 0.2f, 0.1f, 0.4f, 0.3f, //
+    };
+
+    // sides are mixed into backs, and only backs are scaled to avoid clipping
+    sample_t output[NumSamples * 6] = {
+        0.1f, 0.2f, 0.3f, 0.4f, (0.2f + 0.4f) / 2, (0.1f + 0.3f) / 2, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, no_position) {
+    // layout without specialized kernel, high bits have no position
+    enum { NumSamples = 2, InChans = 0x30003, OutChans = 0x10007 };
+
+    sample_t input[NumSamples * 4] = {
+        0.1f, 0.2f, 0.3f, 0.4f, //
+        0.5f, 0.6f, 0.7f, 0.8f, //
+    };
+
+    // center is mixed from front
+    sample_t output[NumSamples * 4] = {
+        0.1f, 0.2f, (0.1f + 0.2f) / 2, 0.3f, //
+        0.5f, 0.6f, (0.5f + 0.6f) / 2, 0.7f, //
     };
 
     check(input, output, NumSamples, InChans, OutChans);
@@ -13,14 +13,22 @@
 #include "roc_audio/mixer.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/worker_pool.h"
 
 namespace roc {
 namespace audio {
 
 namespace {
 
-enum { BufSz = 100, SampleRate = 44100, ChannelMask = 0x1, MaxBufSz = 500 };
+enum {
+    BufSz = 100,
+    SampleRate = 44100,
+    ChannelMask = 0x1,
+    MaxBufSz = 500,
+    NumThreads = 3
+};
 
 const audio::SampleSpec SampleSpecs = audio::SampleSpec(SampleRate, ChannelMask);
 
@@ -69,8 +77,8 @@ TEST(mixer, one_reader) {
 
     mixer.add_input(reader);
 
-    reader.add(BufSz, 0.11f);
-    expect_output(mixer, BufSz, 0.11f);
+    reader.add(BufSz, 0.11f, Frame::FlagNonblank);
+    expect_output(mixer, BufSz, 0.11f, Frame::FlagNonblank);
 
     CHECK(reader.num_unread() == 0);
 }
@@ -83,8 +91,8 @@ TEST(mixer, one_reader_large) {
 
     mixer.add_input(reader);
 
-    reader.add(MaxBufSz * 2, 0.11f);
-    expect_output(mixer, MaxBufSz * 2, 0.11f);
+    reader.add(MaxBufSz * 2, 0.11f, Frame::FlagNonblank);
+    expect_output(mixer, MaxBufSz * 2, 0.11f, Frame::FlagNonblank);
 
     CHECK(reader.num_unread() == 0);
 }
@@ -99,10 +107,10 @@ TEST(mixer, two_readers) {
     mixer.add_input(reader1);
     mixer.add_input(reader2);
 
-    reader1.add(BufSz, 0.11f);
-    reader2.add(BufSz, 0.22f);
+    reader1.add(BufSz, 0.11f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.22f, Frame::FlagNonblank);
 
-    expect_output(mixer, BufSz, 0.33f);
+    expect_output(mixer, BufSz, 0.33f, Frame::FlagNonblank);
 
     CHECK(reader1.num_unread() == 0);
     CHECK(reader2.num_unread() == 0);
@@ -118,20 +126,20 @@ TEST(mixer, remove_reader) {
     mixer.add_input(reader1);
     mixer.add_input(reader2);
 
-    reader1.add(BufSz, 0.11f);
-    reader2.add(BufSz, 0.22f);
-    expect_output(mixer, BufSz, 0.33f);
+    reader1.add(BufSz, 0.11f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.22f, Frame::FlagNonblank);
+    expect_output(mixer, BufSz, 0.33f, Frame::FlagNonblank);
 
     mixer.remove_input(reader2);
 
-    reader1.add(BufSz, 0.44f);
-    reader2.add(BufSz, 0.55f);
-    expect_output(mixer, BufSz, 0.44f);
+    reader1.add(BufSz, 0.44f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.55f, Frame::FlagNonblank);
+    expect_output(mixer, BufSz, 0.44f, Frame::FlagNonblank);
 
     mixer.remove_input(reader1);
 
-    reader1.add(BufSz, 0.77f);
-    reader2.add(BufSz, 0.88f);
+    reader1.add(BufSz, 0.77f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.88f, Frame::FlagNonblank);
     expect_output(mixer, BufSz, 0.0f);
 
     CHECK(reader1.num_unread() == BufSz);
@@ -148,20 +156,20 @@ TEST(mixer, clamp) {
     mixer.add_input(reader1);
     mixer.add_input(reader2);
 
-    reader1.add(BufSz, 0.900f);
-    reader2.add(BufSz, 0.101f);
+    reader1.add(BufSz, 0.900f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.101f, Frame::FlagNonblank);
 
-    expect_output(mixer, BufSz, 1.0f);
+    expect_output(mixer, BufSz, 1.0f, Frame::FlagNonblank);
 
-    reader1.add(BufSz, 0.2f);
-    reader2.add(BufSz, 1.1f);
+    reader1.add(BufSz, 0.2f, Frame::FlagNonblank);
+    reader2.add(BufSz, 1.1f, Frame::FlagNonblank);
 
-    expect_output(mixer, BufSz, 1.0f);
+    expect_output(mixer, BufSz, 1.0f, Frame::FlagNonblank);
 
-    reader1.add(BufSz, -0.2f);
-    reader2.add(BufSz, -0.81f);
+    reader1.add(BufSz, -0.2f, Frame::FlagNonblank);
+    reader2.add(BufSz, -0.81f, Frame::FlagNonblank);
 
-    expect_output(mixer, BufSz, -1.0f);
+    expect_output(mixer, BufSz, -1.0f, Frame::FlagNonblank);
 
     CHECK(reader1.num_unread() == 0);
     CHECK(reader2.num_unread() == 0);
@@ -179,22 +187,245 @@ TEST(mixer, flags) {
     mixer.add_input(reader1);
     mixer.add_input(reader2);
 
-    reader1.add(BigBatch, 0.1f, 0);
+    reader1.add(BigBatch, 0.0f, 0);
     reader1.add(BigBatch, 0.1f, Frame::FlagNonblank);
-    reader1.add(BigBatch, 0.1f, 0);
+    reader1.add(BigBatch, 0.0f, 0);
 
-    reader2.add(BigBatch, 0.1f, Frame::FlagIncomplete);
-    reader2.add(BigBatch / 2, 0.1f, 0);
-    reader2.add(BigBatch / 2, 0.1f, Frame::FlagDrops);
-    reader2.add(BigBatch, 0.1f, 0);
+    reader2.add(BigBatch, 0.0f, Frame::FlagIncomplete);
+    reader2.add(BigBatch / 2, 0.1f, Frame::FlagNonblank);
+    reader2.add(BigBatch / 2, 0.1f, Frame::FlagNonblank | Frame::FlagDrops);
+    reader2.add(BigBatch, 0.0f, 0);
 
-    expect_output(mixer, BigBatch, 0.2f, Frame::FlagIncomplete);
+    expect_output(mixer, BigBatch, 0.0f, Frame::FlagIncomplete);
     expect_output(mixer, BigBatch, 0.2f, Frame::FlagNonblank | Frame::FlagDrops);
-    expect_output(mixer, BigBatch, 0.2f, 0);
+    expect_output(mixer, BigBatch, 0.0f, 0);
 
     CHECK(reader1.num_unread() == 0);
     CHECK(reader2.num_unread() == 0);
 }
 
+TEST(mixer, skip_blank) {
+    test::MockReader reader1;
+    test::MockReader reader2;
+    test::MockReader reader3;
+
+    Mixer mixer(buffer_factory, MaxBufDuration, SampleSpecs);
+    CHECK(mixer.valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+    mixer.add_input(reader3);
+
+    // blank frames are expected to be zero, if they're not,
+    // this shows that they're not added
+    reader1.add(BufSz, 0.11f, 0);
+    reader2.add(BufSz, 0.22f, Frame::FlagNonblank);
+    reader3.add(BufSz, 0.33f, 0);
+
+    expect_output(mixer, BufSz, 0.22f, Frame::FlagNonblank);
+    UNSIGNED_LONGS_EQUAL(1, mixer.num_active_inputs());
+
+    reader1.add(BufSz, 0.11f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.22f, 0);
+    reader3.add(BufSz, 0.33f, Frame::FlagNonblank);
+
+    expect_output(mixer, BufSz, 0.44f, Frame::FlagNonblank);
+    UNSIGNED_LONGS_EQUAL(2, mixer.num_active_inputs());
+
+    reader1.add(BufSz, 0.11f, 0);
+    reader2.add(BufSz, 0.22f, 0);
+    reader3.add(BufSz, 0.33f, Frame::FlagIncomplete);
+
+    expect_output(mixer, BufSz, 0.0f, Frame::FlagIncomplete);
+    UNSIGNED_LONGS_EQUAL(0, mixer.num_active_inputs());
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
+TEST(mixer, skip_blank_disabled) {
+    core::WorkerPool worker_pool(NumThreads, allocator);
+    CHECK(worker_pool.valid());
+
+    test::MockReader seq_readers[2];
+    test::MockReader par_readers[2];
+
+    Mixer seq_mixer(buffer_factory, MaxBufDuration, SampleSpecs);
+    CHECK(seq_mixer.valid());
+
+    Mixer par_mixer(buffer_factory, MaxBufDuration, SampleSpecs, worker_pool,
+                    allocator);
+    CHECK(par_mixer.valid());
+
+    Mixer* mixers[] = { &seq_mixer, &par_mixer };
+    test::MockReader* readers[] = { seq_readers, par_readers };
+
+    for (size_t m = 0; m < ROC_ARRAY_SIZE(mixers); m++) {
+        // e.g. blank frames contain beeps
+        mixers[m]->set_skip_blank(false);
+
+        mixers[m]->add_input(readers[m][0]);
+        mixers[m]->add_input(readers[m][1]);
+
+        readers[m][0].add(BufSz, 0.11f, 0);
+        readers[m][1].add(BufSz, 0.22f, Frame::FlagNonblank);
+
+        expect_output(*mixers[m], BufSz, 0.33f, Frame::FlagNonblank);
+        UNSIGNED_LONGS_EQUAL(2, mixers[m]->num_active_inputs());
+
+        readers[m][0].add(BufSz, 0.11f, 0);
+        readers[m][1].add(BufSz, 0.22f, 0);
+
+        expect_output(*mixers[m], BufSz, 0.33f, 0);
+        UNSIGNED_LONGS_EQUAL(2, mixers[m]->num_active_inputs());
+
+        CHECK(readers[m][0].num_unread() == 0);
+        CHECK(readers[m][1].num_unread() == 0);
+    }
+}
+
+TEST(mixer, num_active_inputs) {
+    test::MockReader reader1;
+    test::MockReader reader2;
+
+    Mixer mixer(buffer_factory, MaxBufDuration, SampleSpecs);
+    CHECK(mixer.valid());
+
+    UNSIGNED_LONGS_EQUAL(0, mixer.num_active_inputs());
+
+    mixer.add_input(reader1);
+
+    reader1.add(BufSz, 0.11f, Frame::FlagNonblank);
+    expect_output(mixer, BufSz, 0.11f, Frame::FlagNonblank);
+    UNSIGNED_LONGS_EQUAL(1, mixer.num_active_inputs());
+
+    reader1.add(BufSz, 0.0f, 0);
+    expect_output(mixer, BufSz, 0.0f, 0);
+    UNSIGNED_LONGS_EQUAL(0, mixer.num_active_inputs());
+
+    mixer.add_input(reader2);
+
+    reader1.add(BufSz, 0.11f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.22f, Frame::FlagNonblank);
+    expect_output(mixer, BufSz, 0.33f, Frame::FlagNonblank);
+    UNSIGNED_LONGS_EQUAL(2, mixer.num_active_inputs());
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+}
+
+TEST(mixer, parallel_many_readers) {
+    enum { NumReaders = 10, BigBatch = MaxBufSz * 3 };
+
+    core::WorkerPool worker_pool(NumThreads, allocator);
+    CHECK(worker_pool.valid());
+
+    test::MockReader readers[NumReaders];
+
+    Mixer mixer(buffer_factory, MaxBufDuration, SampleSpecs, worker_pool, allocator);
+    CHECK(mixer.valid());
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        mixer.add_input(readers[n]);
+    }
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        readers[n].add(BigBatch, 0.01f * float(n + 1), Frame::FlagNonblank);
+    }
+
+    expect_output(mixer, BigBatch, 0.55f, Frame::FlagNonblank);
+    UNSIGNED_LONGS_EQUAL(NumReaders, mixer.num_active_inputs());
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        CHECK(readers[n].num_unread() == 0);
+    }
+}
+
+TEST(mixer, parallel_same_as_sequential) {
+    enum { NumReaders = 7, NumFrames = 20 };
+
+    core::WorkerPool worker_pool(NumThreads, allocator);
+    CHECK(worker_pool.valid());
+
+    test::MockReader seq_readers[NumReaders];
+    test::MockReader par_readers[NumReaders];
+
+    Mixer seq_mixer(buffer_factory, MaxBufDuration, SampleSpecs);
+    CHECK(seq_mixer.valid());
+
+    Mixer par_mixer(buffer_factory, MaxBufDuration, SampleSpecs, worker_pool,
+                    allocator);
+    CHECK(par_mixer.valid());
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        seq_mixer.add_input(seq_readers[n]);
+        par_mixer.add_input(par_readers[n]);
+    }
+
+    for (size_t nf = 0; nf < NumFrames; nf++) {
+        for (size_t n = 0; n < NumReaders; n++) {
+            const sample_t value = 0.0123f * float(n + 1) * float(nf % 3) - 0.03f;
+            const unsigned flags = (n + nf) % 4 == 0 ? 0 : Frame::FlagNonblank;
+
+            seq_readers[n].add(BufSz, value, flags);
+            par_readers[n].add(BufSz, value, flags);
+        }
+
+        core::Slice<sample_t> seq_buf = new_buffer(BufSz);
+        core::Slice<sample_t> par_buf = new_buffer(BufSz);
+
+        Frame seq_frame(seq_buf.data(), seq_buf.size());
+        Frame par_frame(par_buf.data(), par_buf.size());
+
+        CHECK(seq_mixer.read(seq_frame));
+        CHECK(par_mixer.read(par_frame));
+
+        // inputs are mixed in the same order, so results are bit-exact
+        CHECK(memcmp(seq_buf.data(), par_buf.data(), BufSz * sizeof(sample_t)) == 0);
+
+        UNSIGNED_LONGS_EQUAL(seq_frame.flags(), par_frame.flags());
+        UNSIGNED_LONGS_EQUAL(seq_mixer.num_active_inputs(),
+                             par_mixer.num_active_inputs());
+    }
+}
+
+TEST(mixer, parallel_remove_reader) {
+    core::WorkerPool worker_pool(NumThreads, allocator);
+    CHECK(worker_pool.valid());
+
+    test::MockReader reader1;
+    test::MockReader reader2;
+    test::MockReader reader3;
+
+    Mixer mixer(buffer_factory, MaxBufDuration, SampleSpecs, worker_pool, allocator);
+    CHECK(mixer.valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+    mixer.add_input(reader3);
+
+    reader1.add(BufSz, 0.11f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.22f, Frame::FlagNonblank);
+    reader3.add(BufSz, 0.33f, Frame::FlagNonblank);
+    expect_output(mixer, BufSz, 0.66f, Frame::FlagNonblank);
+
+    mixer.remove_input(reader2);
+
+    reader1.add(BufSz, 0.11f, Frame::FlagNonblank);
+    reader2.add(BufSz, 0.22f, Frame::FlagNonblank);
+    reader3.add(BufSz, 0.33f, Frame::FlagIncomplete);
+    expect_output(mixer, BufSz, 0.11f, Frame::FlagNonblank | Frame::FlagIncomplete);
+
+    mixer.remove_input(reader1);
+    mixer.remove_input(reader3);
+
+    expect_output(mixer, BufSz, 0.0f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == BufSz);
+    CHECK(reader3.num_unread() == 0);
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { MaxSz = 301 };
+
+const double Epsilon = 0.00001;
+
+sample_t make_sample(size_t n, size_t k) {
+    return sample_t(int((n * 7 + k * 13) % 41) - 20) / 16;
+}
+
+void check_kernel(MixerKernel kernel, size_t size) {
+    mixer_kernel_func_t func = mixer_kernel_func(kernel);
+    CHECK(func);
+
+    sample_t in[MaxSz + 1];
+    sample_t out[MaxSz + 1];
+    sample_t expected[MaxSz + 1];
+
+    for (size_t n = 0; n < MaxSz + 1; n++) {
+        in[n] = make_sample(n, 1);
+        out[n] = make_sample(n, 2);
+
+        if (n < size) {
+            sample_t s = in[n] + out[n];
+            if (s > SampleMax) {
+                s = SampleMax;
+            }
+            if (s < SampleMin) {
+                s = SampleMin;
+            }
+            expected[n] = s;
+        } else {
+            expected[n] = out[n];
+        }
+    }
+
+    // Use unaligned pointers.
+    func(out + 1, in + 1, size - 1);
+    func(out, in, 1);
+
+    for (size_t n = 0; n < MaxSz + 1; n++) {
+        DOUBLES_EQUAL((double)expected[n], (double)out[n], Epsilon);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(mixer_kernel) {};
+
+TEST(mixer_kernel, scalar_supported) {
+    CHECK(mixer_kernel_func(MixerKernel_Scalar));
+}
+
+TEST(mixer_kernel, select) {
+    const MixerKernel kernel = mixer_kernel_select();
+
+    CHECK(mixer_kernel_func(kernel));
+    CHECK(kernel != MixerKernel_Max);
+}
+
+TEST(mixer_kernel, add_and_clamp) {
+    for (int k = 0; k < MixerKernel_Max; k++) {
+        if (!mixer_kernel_func((MixerKernel)k)) {
+            continue;
+        }
+        for (size_t size = 1; size <= MaxSz; size++) {
+            check_kernel((MixerKernel)k, size);
+        }
+    }
+}
+
+TEST(mixer_kernel, to_str) {
+    for (int k = 0; k < MixerKernel_Max; k++) {
+        CHECK(strcmp(mixer_kernel_to_str((MixerKernel)k), "<invalid>") != 0);
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -11,6 +11,8 @@
 #include <stdio.h>
 
 #include "roc_audio/pcm_mapper.h"
+#include "roc_audio/pcm_mapper_func.h"
+#include "roc_core/fast_random.h"
 #include "roc_core/log.h"
 #include "roc_core/macro_helpers.h"
 #include "roc_core/print_buffer.h"
@@ -100,6 +102,77 @@ void compare(const double* expected, const double* actual, size_t n_items) {
     }
 }
 
+// Check that mapper selected by PcmMapper, which may be vectorized, produces
+// exactly the same output as scalar mapper, for any length and byte offset
+template <PcmEncoding InEnc, PcmEncoding OutEnc, PcmEndian InEnd, PcmEndian OutEnd>
+void check_same_as_scalar() {
+    enum { MaxSamples = 300, MaxOffset = 3, MaxBytes = (MaxSamples + MaxOffset) * 8 };
+
+    PcmFormat in_fmt;
+    in_fmt.encoding = InEnc;
+    in_fmt.endian = InEnd;
+
+    PcmFormat out_fmt;
+    out_fmt.encoding = OutEnc;
+    out_fmt.endian = OutEnd;
+
+    PcmMapper mapper(in_fmt, out_fmt);
+
+    uint8_t input[MaxBytes];
+
+    if (InEnc == PcmEncoding_Float32) {
+        // floats in range [-1.5; 1.5], including exact bounds
+        for (size_t n = 0; n < MaxBytes / sizeof(float); n++) {
+            float f = 0;
+            switch (n % 4) {
+            case 0:
+                f = (float)core::fast_random(0, 30000) / 10000.0f - 1.5f;
+                break;
+            case 1:
+                f = (float)core::fast_random(0, 20000) / 10000.0f - 1.0f;
+                break;
+            case 2:
+                f = (n % 8 == 2) ? 1.0f : -1.0f;
+                break;
+            case 3:
+                f = (float)core::fast_random(0, 200) / 100000.0f - 0.001f;
+                break;
+            }
+            memcpy(input + n * sizeof(float), &f, sizeof(float));
+        }
+    } else {
+        for (size_t n = 0; n < MaxBytes; n++) {
+            input[n] = (uint8_t)core::fast_random(0, 255);
+        }
+    }
+
+    for (size_t n_samples = 1; n_samples <= MaxSamples; n_samples++) {
+        for (size_t off = 0; off <= MaxOffset; off++) {
+            uint8_t expected_output[MaxBytes] = {};
+            uint8_t actual_output[MaxBytes] = {};
+
+            size_t expected_in_off = mapper.input_bit_count(off);
+            size_t expected_out_off = mapper.output_bit_count(off);
+
+            pcm_mapper<InEnc, OutEnc, InEnd, OutEnd>::map(
+                input, expected_in_off, expected_output, expected_out_off, n_samples);
+
+            size_t actual_in_off = mapper.input_bit_count(off);
+            size_t actual_out_off = mapper.output_bit_count(off);
+
+            UNSIGNED_LONGS_EQUAL(n_samples,
+                                 mapper.map(input, sizeof(input), actual_in_off,
+                                            actual_output, sizeof(actual_output),
+                                            actual_out_off, n_samples));
+
+            UNSIGNED_LONGS_EQUAL(expected_in_off, actual_in_off);
+            UNSIGNED_LONGS_EQUAL(expected_out_off, actual_out_off);
+
+            compare(expected_output, actual_output, MaxBytes);
+        }
+    }
+}
+
 } // namespace
 
 TEST_GROUP(pcm_mapper) {};
@@ -1047,5 +1120,34 @@ TEST(pcm_mapper, le_to_be) {
     compare(expected_output, actual_output, NumOutputBytes);
 }
 
+TEST(pcm_mapper, vectorized_same_as_scalar) {
+    check_same_as_scalar<PcmEncoding_SInt16, PcmEncoding_Float32, PcmEndian_Big,
+                         PcmEndian_Little>();
+    check_same_as_scalar<PcmEncoding_SInt16, PcmEncoding_Float32, PcmEndian_Little,
+                         PcmEndian_Little>();
+    check_same_as_scalar<PcmEncoding_Float32, PcmEncoding_SInt16, PcmEndian_Little,
+                         PcmEndian_Big>();
+    check_same_as_scalar<PcmEncoding_Float32, PcmEncoding_SInt16, PcmEndian_Little,
+                         PcmEndian_Little>();
+
+    check_same_as_scalar<PcmEncoding_SInt24, PcmEncoding_Float32, PcmEndian_Big,
+                         PcmEndian_Little>();
+    check_same_as_scalar<PcmEncoding_SInt24, PcmEncoding_Float32, PcmEndian_Little,
+                         PcmEndian_Little>();
+    check_same_as_scalar<PcmEncoding_Float32, PcmEncoding_SInt24, PcmEndian_Little,
+                         PcmEndian_Big>();
+    check_same_as_scalar<PcmEncoding_Float32, PcmEncoding_SInt24, PcmEndian_Little,
+                         PcmEndian_Little>();
+
+    check_same_as_scalar<PcmEncoding_SInt32, PcmEncoding_Float32, PcmEndian_Big,
+                         PcmEndian_Little>();
+    check_same_as_scalar<PcmEncoding_SInt32, PcmEncoding_Float32, PcmEndian_Little,
+                         PcmEndian_Little>();
+    check_same_as_scalar<PcmEncoding_Float32, PcmEncoding_SInt32, PcmEndian_Little,
+                         PcmEndian_Big>();
+    check_same_as_scalar<PcmEncoding_Float32, PcmEncoding_SInt32, PcmEndian_Little,
+                         PcmEndian_Little>();
+}
+
 } // namespace audio
 } // namespace roc
@@ -411,5 +411,99 @@ TEST(resampler, upscale_downscale_stereo) {
     }
 }
 
+TEST(resampler, builtin_multichannel_matches_mono) {
+    enum {
+        SampleRate = 44100,
+        NumCh = 6,
+        ChMask = 0x3F,
+        NumPad = 2 * OutFrameSize,
+        NumSamples = 20 * OutFrameSize
+    };
+    const audio::SampleSpec MonoSpecs = SampleSpec(SampleRate, 0x1);
+    const audio::SampleSpec MultiSpecs = SampleSpec(SampleRate, ChMask);
+
+    const float Scaling = 0.97f;
+
+    sample_t input_ch[NumCh][NumSamples];
+    sample_t input[NumSamples * NumCh];
+
+    for (size_t ch = 0; ch < NumCh; ch++) {
+        generate_sine(input_ch[ch], NumSamples, NumPad + ch * 10);
+        for (size_t n = 0; n < NumSamples; n++) {
+            input[n * NumCh + ch] = input_ch[ch][n];
+        }
+    }
+
+    sample_t output[NumSamples * NumCh] = {};
+    resample(ResamplerBackend_Builtin, Reader, input, output, NumSamples * NumCh,
+             MultiSpecs, Scaling);
+
+    for (size_t ch = 0; ch < NumCh; ch++) {
+        sample_t output_ch[NumSamples] = {};
+        resample(ResamplerBackend_Builtin, Reader, input_ch[ch], output_ch, NumSamples,
+                 MonoSpecs, Scaling);
+
+        for (size_t n = 0; n < NumSamples; n++) {
+            DOUBLES_EQUAL((double)output_ch[n], (double)output[n * NumCh + ch], 1e-6);
+        }
+    }
+}
+
+TEST(resampler, reader_flags) {
+    enum { SampleRate = 44100, ChMask = 0x1, NumFrames = 100 };
+    const audio::SampleSpec SampleSpecs = SampleSpec(SampleRate, ChMask);
+
+    for (size_t n_back = 0; n_back < ResamplerMap::instance().num_backends(); n_back++) {
+        ResamplerBackend backend = ResamplerMap::instance().nth_backend(n_back);
+
+        core::ScopedPtr<IResampler> resampler(
+            ResamplerMap::instance().new_resampler(
+                backend, allocator, buffer_factory, ResamplerProfile_High,
+                SampleSpecs.samples_overall_2_ns(InFrameSize), SampleSpecs),
+            allocator);
+        CHECK(resampler);
+        CHECK(resampler->valid());
+
+        test::MockReader input_reader;
+        input_reader.add(InFrameSize * NumFrames / 2, 0.5f, Frame::FlagNonblank);
+        input_reader.add(InFrameSize, 0.0f, Frame::FlagDrops);
+        input_reader.pad_zeros();
+
+        ResamplerReader rr(input_reader, *resampler, SampleSpecs, SampleSpecs);
+        CHECK(rr.valid());
+        CHECK(rr.set_scaling(0.99f));
+
+        bool seen_nonblank = false, seen_drops = false, seen_blank = false;
+
+        for (size_t n = 0; n < NumFrames; n++) {
+            sample_t samples[OutFrameSize];
+            Frame frame(samples, OutFrameSize);
+            CHECK(rr.read(frame));
+
+            if (frame.flags() & Frame::FlagNonblank) {
+                // non-blank frames can't follow blank ones
+                CHECK(!seen_blank);
+                seen_nonblank = true;
+            } else {
+                CHECK(seen_nonblank);
+                seen_blank = true;
+
+                for (size_t i = 0; i < OutFrameSize; i++) {
+                    DOUBLES_EQUAL(0.0, (double)samples[i], 0.0001);
+                }
+            }
+
+            if (frame.flags() & Frame::FlagDrops) {
+                CHECK(!seen_drops);
+                seen_drops = true;
+            }
+        }
+
+        CHECK(seen_nonblank);
+        CHECK(seen_drops);
+        CHECK(seen_blank);
+    }
+}
+
 } // namespace audio
 } // namespace roc
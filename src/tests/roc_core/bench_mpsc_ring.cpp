@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/atomic.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/mpsc_queue.h"
+#include "roc_core/mpsc_ring.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+namespace {
+
+// Compares MpscQueue and MpscRing in the way receiver endpoint uses them:
+// several network threads push packets, and pipeline thread drains queue.
+
+enum { NumPushes = 200000, RingCapacity = 1024, PopBatchSize = 64 };
+
+struct Object : MpscQueueNode {};
+
+HeapAllocator allocator;
+
+template <class Queue> class PushThread : public Thread {
+public:
+    PushThread()
+        : queue_(NULL)
+        , objs_(NULL)
+        , n_dropped_(0) {
+    }
+
+    void init(Queue& queue, Object* objs) {
+        queue_ = &queue;
+        objs_ = objs;
+    }
+
+    long num_dropped() const {
+        return n_dropped_;
+    }
+
+private:
+    virtual void run() {
+        for (int n = 0; n < NumPushes; n++) {
+            if (!push(*queue_, objs_[n])) {
+                n_dropped_++;
+            }
+        }
+    }
+
+    static bool push(MpscQueue<Object, NoOwnership>& queue, Object& obj) {
+        queue.push_back(obj);
+        return true;
+    }
+
+    static bool push(MpscRing<Object, NoOwnership>& ring, Object& obj) {
+        return ring.push_back(obj);
+    }
+
+    Queue* queue_;
+    Object* objs_;
+    Atomic<long> n_dropped_;
+};
+
+// Queue consumer drains objects one by one, as endpoint did before.
+size_t drain(MpscQueue<Object, NoOwnership>& queue) {
+    size_t n_popped = 0;
+    while (queue.try_pop_front_exclusive()) {
+        n_popped++;
+    }
+    return n_popped;
+}
+
+// Ring consumer drains objects in batches.
+size_t drain(MpscRing<Object, NoOwnership>& ring) {
+    Object* batch[PopBatchSize];
+    size_t n_popped = 0;
+    for (;;) {
+        const size_t n_batch = ring.pop_front_batch_exclusive(batch, PopBatchSize);
+        n_popped += n_batch;
+        if (n_batch < PopBatchSize) {
+            break;
+        }
+    }
+    return n_popped;
+}
+
+template <class Queue>
+void run_bench(benchmark::State& state, Queue& queue, Object* objs) {
+    const int num_push_threads = (int)state.range(0);
+
+    size_t n_popped = 0;
+    long n_dropped = 0;
+
+    while (state.KeepRunning()) {
+        PushThread<Queue>* threads = new PushThread<Queue>[size_t(num_push_threads)];
+
+        for (int n = 0; n < num_push_threads; n++) {
+            threads[n].init(queue, objs + n * NumPushes);
+            threads[n].start();
+        }
+
+        size_t n_expected = size_t(num_push_threads) * NumPushes;
+        size_t n_iter_popped = 0;
+
+        for (;;) {
+            n_iter_popped += drain(queue);
+
+            long n_iter_dropped = 0;
+            for (int n = 0; n < num_push_threads; n++) {
+                n_iter_dropped += threads[n].num_dropped();
+            }
+
+            if (n_iter_popped + (size_t)n_iter_dropped >= n_expected) {
+                break;
+            }
+        }
+
+        for (int n = 0; n < num_push_threads; n++) {
+            threads[n].join();
+            n_dropped += threads[n].num_dropped();
+        }
+
+        n_popped += n_iter_popped;
+
+        delete[] threads;
+    }
+
+    state.SetItemsProcessed(int64_t(n_popped));
+    state.counters["dropped"] = double(n_dropped);
+}
+
+void BM_MpscQueue_Drain(benchmark::State& state) {
+    MpscQueue<Object, NoOwnership> queue;
+    Object* objs = new Object[NumPushes * state.range(0)];
+
+    run_bench(state, queue, objs);
+
+    delete[] objs;
+}
+
+BENCHMARK(BM_MpscQueue_Drain)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+void BM_MpscRing_Drain(benchmark::State& state) {
+    MpscRing<Object, NoOwnership> ring(RingCapacity, allocator);
+    Object* objs = new Object[NumPushes * state.range(0)];
+
+    run_bench(state, ring, objs);
+
+    delete[] objs;
+}
+
+BENCHMARK(BM_MpscRing_Drain)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace core
+} // namespace roc
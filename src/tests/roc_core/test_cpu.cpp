@@ -8,6 +8,7 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_core/cpu_features.h"
 #include "roc_core/cpu_traits.h"
 
 namespace roc {
@@ -38,5 +39,27 @@ TEST(cpu, bitness) {
 #endif
 }
 
+TEST(cpu, features) {
+    const unsigned features = cpu_features();
+
+#if ROC_CPU_HAS_X86_DISPATCH && defined(__SSE2__)
+    CHECK(features & CpuFeature_SSE2);
+#endif
+
+#if ROC_CPU_HAS_X86_DISPATCH && defined(__AVX2__)
+    CHECK(features & CpuFeature_AVX2);
+#endif
+
+#if ROC_CPU_HAS_NEON
+    CHECK(features & CpuFeature_NEON);
+#endif
+
+#if ROC_CPU_FAMILY != ROC_CPU_X86
+    CHECK((features & (CpuFeature_SSE2 | CpuFeature_SSSE3 | CpuFeature_AVX2)) == 0);
+#endif
+
+    (void)features;
+}
+
 } // namespace core
 } // namespace roc
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/atomic_ops.h"
+#include "roc_core/log.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { MaxMessages = 2000 };
+
+struct Capture {
+    int n_msgs;
+    int msgs[MaxMessages];
+    uint64_t tids[MaxMessages];
+
+    unsigned long n_rate_dropped;
+    int n_reports;
+};
+
+void capture_handler(const LogMessage& msg, void** args) {
+    Capture& capture = *(Capture*)args[0];
+
+    unsigned long n_ring_dropped = 0, n_rate_dropped = 0;
+    if (sscanf(msg.text,
+               "log flusher: dropped messages: ring_full=%lu rate_limited=%lu",
+               &n_ring_dropped, &n_rate_dropped)
+        == 2) {
+        capture.n_rate_dropped += n_rate_dropped;
+        capture.n_reports++;
+        return;
+    }
+
+    CHECK(capture.n_msgs < MaxMessages);
+
+    capture.msgs[capture.n_msgs] = atoi(msg.text);
+    capture.tids[capture.n_msgs] = msg.tid;
+    capture.n_msgs++;
+}
+
+class LogThread : public Thread {
+public:
+    LogThread()
+        : n_msgs_(0)
+        , n_running_(NULL) {
+    }
+
+    void init(int n_msgs, int* n_running) {
+        n_msgs_ = n_msgs;
+        n_running_ = n_running;
+    }
+
+private:
+    virtual void run() {
+        for (int n = 0; n < n_msgs_; n++) {
+            roc_log(LogInfo, "%d", n);
+        }
+
+        if (n_running_) {
+            // stay alive until all threads have written, so that
+            // every thread has distinct tid
+            AtomicOps::fetch_sub_seq_cst(*n_running_, 1);
+            while (AtomicOps::load_seq_cst(*n_running_) != 0) {
+                sleep_for(ClockMonotonic, Millisecond);
+            }
+        }
+    }
+
+    int n_msgs_;
+    int* n_running_;
+};
+
+} // namespace
+
+TEST_GROUP(log_flusher) {
+    Capture capture;
+    LogLevel saved_level;
+
+    void setup() {
+        memset(&capture, 0, sizeof(capture));
+
+        saved_level = Logger::instance().get_level();
+        Logger::instance().set_level(LogInfo);
+
+        void* args[] = { &capture };
+        Logger::instance().set_handler(capture_handler, args, ROC_ARRAY_SIZE(args));
+
+        // wait until per-thread rate limit is reset after previous test
+        sleep_for(ClockMonotonic, 100 * Millisecond);
+    }
+
+    void teardown() {
+        Logger::instance().set_async(false);
+        Logger::instance().set_handler(NULL, NULL, 0);
+        Logger::instance().set_level(saved_level);
+    }
+};
+
+TEST(log_flusher, order) {
+    enum { NumMessages = 100 };
+
+    CHECK(Logger::instance().set_async(true));
+
+    for (int n = 0; n < NumMessages; n++) {
+        roc_log(LogInfo, "%d", n);
+    }
+
+    // flushes pending messages
+    CHECK(Logger::instance().set_async(false));
+
+    LONGS_EQUAL(NumMessages, capture.n_msgs);
+    LONGS_EQUAL(0, capture.n_reports);
+
+    for (int n = 0; n < NumMessages; n++) {
+        LONGS_EQUAL(n, capture.msgs[n]);
+        CHECK(capture.tids[n] == Thread::get_tid());
+    }
+}
+
+TEST(log_flusher, restart) {
+    for (int n = 0; n < 3; n++) {
+        CHECK(Logger::instance().set_async(true));
+        roc_log(LogInfo, "%d", n);
+        CHECK(Logger::instance().set_async(false));
+
+        // synchronous mode
+        roc_log(LogInfo, "%d", n + 100);
+    }
+
+    LONGS_EQUAL(6, capture.n_msgs);
+
+    for (int n = 0; n < 3; n++) {
+        LONGS_EQUAL(n, capture.msgs[n * 2]);
+        LONGS_EQUAL(n + 100, capture.msgs[n * 2 + 1]);
+    }
+}
+
+TEST(log_flusher, rate_limit) {
+    enum { NumMessages = 1000 };
+
+    CHECK(Logger::instance().set_async(true));
+
+    for (int n = 0; n < NumMessages; n++) {
+        roc_log(LogInfo, "%d", n);
+    }
+
+    CHECK(Logger::instance().set_async(false));
+
+    // noisy thread is limited, and every dropped message is reported
+    CHECK(capture.n_msgs < NumMessages);
+    CHECK(capture.n_reports > 0);
+    LONGS_EQUAL(NumMessages, capture.n_msgs + (int)capture.n_rate_dropped);
+
+    for (int n = 1; n < capture.n_msgs; n++) {
+        CHECK(capture.msgs[n - 1] < capture.msgs[n]);
+    }
+}
+
+TEST(log_flusher, stop_concurrent_writers) {
+    enum { NumThreads = 4, NumMessages = 100 };
+
+    CHECK(Logger::instance().set_async(true));
+
+    LogThread threads[NumThreads];
+
+    for (int n = 0; n < NumThreads; n++) {
+        threads[n].init(NumMessages, NULL);
+        CHECK(threads[n].start());
+    }
+
+    // every message is either flushed during stop, or written synchronously
+    CHECK(Logger::instance().set_async(false));
+
+    for (int n = 0; n < NumThreads; n++) {
+        threads[n].join();
+    }
+
+    LONGS_EQUAL(NumThreads * NumMessages, capture.n_msgs);
+}
+
+TEST(log_flusher, thread_slots_expire) {
+    // number of rate limiting slots in flusher
+    enum { NumThreads = 64, NumMessages = 1000 };
+
+    CHECK(Logger::instance().set_async(true));
+
+    {
+        int n_running = NumThreads;
+        LogThread threads[NumThreads];
+
+        for (int n = 0; n < NumThreads; n++) {
+            threads[n].init(1, &n_running);
+            CHECK(threads[n].start());
+        }
+
+        for (int n = 0; n < NumThreads; n++) {
+            threads[n].join();
+        }
+    }
+
+    // wait until slots of exited threads expire
+    sleep_for(ClockMonotonic, 1100 * Millisecond);
+
+    LogThread noisy_thread;
+    noisy_thread.init(NumMessages, NULL);
+    CHECK(noisy_thread.start());
+    noisy_thread.join();
+
+    CHECK(Logger::instance().set_async(false));
+
+    // new thread takes slot of exited thread and is rate limited
+    CHECK(capture.n_rate_dropped > 0);
+    LONGS_EQUAL(NumThreads + NumMessages, capture.n_msgs + (int)capture.n_rate_dropped);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/log_ring.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+HeapAllocator allocator;
+
+bool write_msg(LogRing& ring, LogMessage& msg, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    const bool ret = ring.write(msg, format, args);
+    va_end(args);
+    return ret;
+}
+
+class WriteThread : public Thread {
+public:
+    WriteThread()
+        : ring_(NULL)
+        , id_(0)
+        , n_msgs_(0) {
+    }
+
+    void init(LogRing& ring, int id, int n_msgs) {
+        ring_ = &ring;
+        id_ = id;
+        n_msgs_ = n_msgs;
+    }
+
+private:
+    virtual void run() {
+        LogMessage msg;
+        msg.level = LogDebug;
+        msg.line = id_;
+
+        for (int n = 0; n < n_msgs_; n++) {
+            while (!write_msg(*ring_, msg, "%d", n)) {
+                // ring is full, wait for consumer
+            }
+        }
+    }
+
+    LogRing* ring_;
+    int id_;
+    int n_msgs_;
+};
+
+} // namespace
+
+TEST_GROUP(log_ring) {};
+
+TEST(log_ring, capacity) {
+    {
+        LogRing ring(1, allocator);
+        CHECK(ring.valid());
+        UNSIGNED_LONGS_EQUAL(2, ring.capacity());
+    }
+    {
+        LogRing ring(8, allocator);
+        CHECK(ring.valid());
+        UNSIGNED_LONGS_EQUAL(8, ring.capacity());
+    }
+    {
+        LogRing ring(9, allocator);
+        CHECK(ring.valid());
+        UNSIGNED_LONGS_EQUAL(16, ring.capacity());
+    }
+}
+
+TEST(log_ring, write_read) {
+    LogRing ring(4, allocator);
+    CHECK(ring.valid());
+
+    LogMessage msg;
+    char text[LogRing::MaxTextSize];
+
+    CHECK(!ring.read(msg, text, sizeof(text)));
+
+    LogMessage in_msg;
+    in_msg.level = LogInfo;
+    in_msg.module = "module";
+    in_msg.file = "file";
+    in_msg.line = 123;
+    in_msg.time = 456;
+    in_msg.pid = 11;
+    in_msg.tid = 22;
+    in_msg.text = "ignored";
+    in_msg.location_mode = LocationEnabled;
+    in_msg.colors_mode = ColorsEnabled;
+
+    CHECK(write_msg(ring, in_msg, "hello %s %d", "world", 42));
+
+    CHECK(ring.read(msg, text, sizeof(text)));
+
+    LONGS_EQUAL(LogInfo, msg.level);
+    STRCMP_EQUAL("module", msg.module);
+    STRCMP_EQUAL("file", msg.file);
+    LONGS_EQUAL(123, msg.line);
+    LONGS_EQUAL(456, msg.time);
+    LONGS_EQUAL(11, msg.pid);
+    LONGS_EQUAL(22, msg.tid);
+    LONGS_EQUAL(LocationEnabled, msg.location_mode);
+    LONGS_EQUAL(ColorsEnabled, msg.colors_mode);
+
+    POINTERS_EQUAL(text, msg.text);
+    STRCMP_EQUAL("hello world 42", msg.text);
+
+    CHECK(!ring.read(msg, text, sizeof(text)));
+}
+
+TEST(log_ring, long_text) {
+    LogRing ring(4, allocator);
+    CHECK(ring.valid());
+
+    char long_text[LogRing::MaxTextSize * 2];
+    memset(long_text, 'x', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+
+    LogMessage msg;
+    CHECK(write_msg(ring, msg, "%s", long_text));
+
+    {
+        char text[LogRing::MaxTextSize];
+        CHECK(ring.read(msg, text, sizeof(text)));
+        UNSIGNED_LONGS_EQUAL(LogRing::MaxTextSize - 1, strlen(msg.text));
+    }
+
+    CHECK(write_msg(ring, msg, "%s", long_text));
+
+    {
+        char text[10];
+        CHECK(ring.read(msg, text, sizeof(text)));
+        STRCMP_EQUAL("xxxxxxxxx", msg.text);
+    }
+}
+
+TEST(log_ring, full) {
+    LogRing ring(4, allocator);
+    CHECK(ring.valid());
+
+    LogMessage msg;
+    char text[LogRing::MaxTextSize];
+
+    for (int n = 0; n < 4; n++) {
+        CHECK(write_msg(ring, msg, "%d", n));
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, ring.num_dropped());
+
+    CHECK(!write_msg(ring, msg, "%d", 4));
+    CHECK(!write_msg(ring, msg, "%d", 5));
+
+    UNSIGNED_LONGS_EQUAL(2, ring.num_dropped());
+
+    CHECK(ring.read(msg, text, sizeof(text)));
+    STRCMP_EQUAL("0", msg.text);
+
+    CHECK(write_msg(ring, msg, "%d", 6));
+
+    CHECK(ring.read(msg, text, sizeof(text)));
+    STRCMP_EQUAL("1", msg.text);
+    CHECK(ring.read(msg, text, sizeof(text)));
+    STRCMP_EQUAL("2", msg.text);
+    CHECK(ring.read(msg, text, sizeof(text)));
+    STRCMP_EQUAL("3", msg.text);
+    CHECK(ring.read(msg, text, sizeof(text)));
+    STRCMP_EQUAL("6", msg.text);
+
+    CHECK(!ring.read(msg, text, sizeof(text)));
+
+    UNSIGNED_LONGS_EQUAL(2, ring.num_dropped());
+}
+
+TEST(log_ring, concurrent_writers) {
+    enum { NumThreads = 8, NumMessages = 5000 };
+
+    LogRing ring(64, allocator);
+    CHECK(ring.valid());
+
+    WriteThread threads[NumThreads];
+
+    for (int n = 0; n < NumThreads; n++) {
+        threads[n].init(ring, n, NumMessages);
+    }
+
+    for (int n = 0; n < NumThreads; n++) {
+        CHECK(threads[n].start());
+    }
+
+    int next_msg[NumThreads] = {};
+
+    for (int n_msgs = 0; n_msgs < NumThreads * NumMessages;) {
+        LogMessage msg;
+        char text[LogRing::MaxTextSize];
+
+        if (!ring.read(msg, text, sizeof(text))) {
+            continue;
+        }
+
+        CHECK(msg.line >= 0 && msg.line < NumThreads);
+
+        // messages from every thread are read in order
+        LONGS_EQUAL(next_msg[msg.line], atoi(msg.text));
+        next_msg[msg.line]++;
+
+        n_msgs++;
+    }
+
+    for (int n = 0; n < NumThreads; n++) {
+        threads[n].join();
+    }
+
+    for (int n = 0; n < NumThreads; n++) {
+        LONGS_EQUAL(NumMessages, next_msg[n]);
+    }
+}
+
+} // namespace core
+} // namespace roc
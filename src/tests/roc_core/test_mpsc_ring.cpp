@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/mpsc_ring.h"
+#include "roc_core/ref_counted.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+struct NoAllocation {
+    template <class T> void destroy(T&) {
+    }
+};
+
+struct Object : RefCounted<Object, NoAllocation> {};
+
+HeapAllocator allocator;
+
+class PushThread : public Thread {
+public:
+    enum { MaxBatch = 16 };
+
+    PushThread()
+        : ring_(NULL)
+        , objs_(NULL)
+        , n_objs_(0)
+        , batch_size_(0) {
+    }
+
+    // if batch_size is zero, push objects one by one
+    void init(MpscRing<Object, NoOwnership>& ring,
+              Object* objs,
+              size_t n_objs,
+              size_t batch_size) {
+        roc_panic_if(batch_size > MaxBatch);
+
+        ring_ = &ring;
+        objs_ = objs;
+        n_objs_ = n_objs;
+        batch_size_ = batch_size;
+    }
+
+private:
+    virtual void run() {
+        if (batch_size_ == 0) {
+            for (size_t n = 0; n < n_objs_; n++) {
+                while (!ring_->push_back(objs_[n])) {
+                    // ring is full, wait for consumer
+                }
+            }
+        } else {
+            Object* batch[MaxBatch] = {};
+
+            for (size_t n = 0; n < n_objs_;) {
+                size_t n_batch = 0;
+                while (n_batch < batch_size_ && n + n_batch < n_objs_) {
+                    batch[n_batch] = &objs_[n + n_batch];
+                    n_batch++;
+                }
+
+                // if ring is full, remaining objects are pushed next time
+                n += ring_->push_back_batch(batch, n_batch);
+            }
+        }
+    }
+
+    MpscRing<Object, NoOwnership>* ring_;
+    Object* objs_;
+    size_t n_objs_;
+    size_t batch_size_;
+};
+
+void check_concurrent_producers(size_t batch_size) {
+    enum { NumThreads = 4, NumObjs = 10000, Capacity = 64, BatchSize = 16 };
+
+    MpscRing<Object, NoOwnership> ring(Capacity, allocator);
+    CHECK(ring.valid());
+
+    Object* objs = new Object[NumThreads * NumObjs];
+    PushThread threads[NumThreads];
+
+    for (int n = 0; n < NumThreads; n++) {
+        threads[n].init(ring, objs + n * NumObjs, NumObjs, batch_size);
+        CHECK(threads[n].start());
+    }
+
+    // objects from every producer are popped in order they were pushed
+    size_t next_obj[NumThreads] = {};
+    size_t n_popped = 0;
+
+    while (n_popped < NumThreads * NumObjs) {
+        Object* batch[BatchSize] = {};
+        const size_t n_batch = ring.pop_front_batch_exclusive(batch, BatchSize);
+
+        for (size_t n = 0; n < n_batch; n++) {
+            const size_t index = size_t(batch[n] - objs);
+            const size_t thread = index / NumObjs;
+
+            CHECK(thread < NumThreads);
+            UNSIGNED_LONGS_EQUAL(thread * NumObjs + next_obj[thread], index);
+
+            next_obj[thread]++;
+        }
+
+        n_popped += n_batch;
+    }
+
+    for (int n = 0; n < NumThreads; n++) {
+        threads[n].join();
+        UNSIGNED_LONGS_EQUAL(NumObjs, next_obj[n]);
+    }
+
+    POINTERS_EQUAL(NULL, ring.try_pop_front_exclusive());
+
+    delete[] objs;
+}
+
+} // namespace
+
+TEST_GROUP(mpsc_ring) {};
+
+TEST(mpsc_ring, capacity) {
+    {
+        MpscRing<Object, NoOwnership> ring(1, allocator);
+        CHECK(ring.valid());
+        UNSIGNED_LONGS_EQUAL(2, ring.capacity());
+    }
+    {
+        MpscRing<Object, NoOwnership> ring(8, allocator);
+        CHECK(ring.valid());
+        UNSIGNED_LONGS_EQUAL(8, ring.capacity());
+    }
+    {
+        MpscRing<Object, NoOwnership> ring(9, allocator);
+        CHECK(ring.valid());
+        UNSIGNED_LONGS_EQUAL(16, ring.capacity());
+    }
+}
+
+TEST(mpsc_ring, empty) {
+    MpscRing<Object, NoOwnership> ring(4, allocator);
+    CHECK(ring.valid());
+
+    POINTERS_EQUAL(NULL, ring.try_pop_front_exclusive());
+
+    Object* objs[4] = {};
+    UNSIGNED_LONGS_EQUAL(0, ring.pop_front_batch_exclusive(objs, 4));
+}
+
+TEST(mpsc_ring, push_pop) {
+    MpscRing<Object, NoOwnership> ring(4, allocator);
+    CHECK(ring.valid());
+
+    Object obj;
+
+    // wrap around the ring several times
+    for (int i = 0; i < 10; i++) {
+        CHECK(ring.push_back(obj));
+
+        POINTERS_EQUAL(&obj, ring.try_pop_front_exclusive());
+        POINTERS_EQUAL(NULL, ring.try_pop_front_exclusive());
+    }
+}
+
+TEST(mpsc_ring, push_pop_many) {
+    enum { NumObjs = 8 };
+
+    MpscRing<Object, NoOwnership> ring(NumObjs, allocator);
+    CHECK(ring.valid());
+
+    Object objs[NumObjs];
+
+    for (int i = 0; i < 3; i++) {
+        for (int n = 0; n < NumObjs; n++) {
+            CHECK(ring.push_back(objs[n]));
+        }
+
+        for (int n = 0; n < NumObjs; n++) {
+            POINTERS_EQUAL(&objs[n], ring.try_pop_front_exclusive());
+        }
+
+        POINTERS_EQUAL(NULL, ring.try_pop_front_exclusive());
+    }
+}
+
+TEST(mpsc_ring, full) {
+    enum { NumObjs = 4 };
+
+    MpscRing<Object, NoOwnership> ring(NumObjs, allocator);
+    CHECK(ring.valid());
+
+    Object objs[NumObjs];
+    Object extra;
+
+    for (int n = 0; n < NumObjs; n++) {
+        CHECK(ring.push_back(objs[n]));
+    }
+
+    CHECK(!ring.push_back(extra));
+    CHECK(!ring.push_back(extra));
+
+    // one free cell after pop
+    POINTERS_EQUAL(&objs[0], ring.try_pop_front_exclusive());
+
+    CHECK(ring.push_back(extra));
+    CHECK(!ring.push_back(extra));
+
+    for (int n = 1; n < NumObjs; n++) {
+        POINTERS_EQUAL(&objs[n], ring.try_pop_front_exclusive());
+    }
+    POINTERS_EQUAL(&extra, ring.try_pop_front_exclusive());
+    POINTERS_EQUAL(NULL, ring.try_pop_front_exclusive());
+}
+
+TEST(mpsc_ring, pop_batch) {
+    enum { NumObjs = 8, BatchSize = 3 };
+
+    MpscRing<Object, NoOwnership> ring(NumObjs, allocator);
+    CHECK(ring.valid());
+
+    Object objs[NumObjs];
+
+    for (int n = 0; n < NumObjs; n++) {
+        CHECK(ring.push_back(objs[n]));
+    }
+
+    Object* batch[BatchSize] = {};
+    size_t n_popped = 0;
+
+    for (;;) {
+        const size_t n_batch = ring.pop_front_batch_exclusive(batch, BatchSize);
+        if (n_batch == 0) {
+            break;
+        }
+
+        CHECK(n_batch <= BatchSize);
+
+        for (size_t n = 0; n < n_batch; n++) {
+            POINTERS_EQUAL(&objs[n_popped + n], batch[n]);
+        }
+
+        n_popped += n_batch;
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumObjs, n_popped);
+    POINTERS_EQUAL(NULL, ring.try_pop_front_exclusive());
+}
+
+TEST(mpsc_ring, ownership) {
+    Object obj1;
+    Object obj2;
+    Object obj3;
+
+    UNSIGNED_LONGS_EQUAL(0, obj1.getref());
+    UNSIGNED_LONGS_EQUAL(0, obj2.getref());
+    UNSIGNED_LONGS_EQUAL(0, obj3.getref());
+
+    {
+        MpscRing<Object> ring(2, allocator);
+        CHECK(ring.valid());
+
+        CHECK(ring.push_back(obj1));
+        UNSIGNED_LONGS_EQUAL(1, obj1.getref());
+
+        CHECK(ring.push_back(obj3));
+        UNSIGNED_LONGS_EQUAL(1, obj3.getref());
+
+        // failed push doesn't acquire ownership
+        CHECK(!ring.push_back(obj2));
+        UNSIGNED_LONGS_EQUAL(0, obj2.getref());
+
+        {
+            SharedPtr<Object> ptr = ring.try_pop_front_exclusive();
+            CHECK(ptr);
+            UNSIGNED_LONGS_EQUAL(1, obj1.getref());
+        }
+
+        UNSIGNED_LONGS_EQUAL(0, obj1.getref());
+
+        CHECK(ring.push_back(obj2));
+        UNSIGNED_LONGS_EQUAL(1, obj2.getref());
+    }
+
+    // ring releases remaining objects
+    UNSIGNED_LONGS_EQUAL(0, obj1.getref());
+    UNSIGNED_LONGS_EQUAL(0, obj2.getref());
+    UNSIGNED_LONGS_EQUAL(0, obj3.getref());
+}
+
+TEST(mpsc_ring, push_batch) {
+    enum { NumObjs = 8, BatchSize = 3 };
+
+    MpscRing<Object, NoOwnership> ring(NumObjs, allocator);
+    CHECK(ring.valid());
+
+    Object objs[NumObjs + BatchSize];
+    Object* batch[BatchSize] = {};
+
+    size_t n_pushed = 0;
+
+    for (;;) {
+        for (size_t n = 0; n < BatchSize; n++) {
+            batch[n] = &objs[n_pushed + n];
+        }
+
+        const size_t n_batch = ring.push_back_batch(batch, BatchSize);
+        n_pushed += n_batch;
+
+        if (n_batch < BatchSize) {
+            break;
+        }
+    }
+
+    // last batch is added partially
+    UNSIGNED_LONGS_EQUAL(NumObjs, n_pushed);
+    UNSIGNED_LONGS_EQUAL(0, ring.push_back_batch(batch, BatchSize));
+
+    // two free cells after pop
+    POINTERS_EQUAL(&objs[0], ring.try_pop_front_exclusive());
+    POINTERS_EQUAL(&objs[1], ring.try_pop_front_exclusive());
+
+    batch[0] = &objs[NumObjs];
+    batch[1] = &objs[NumObjs + 1];
+    batch[2] = &objs[NumObjs + 2];
+
+    UNSIGNED_LONGS_EQUAL(2, ring.push_back_batch(batch, BatchSize));
+
+    for (size_t n = 2; n < NumObjs + 2; n++) {
+        POINTERS_EQUAL(&objs[n], ring.try_pop_front_exclusive());
+    }
+    POINTERS_EQUAL(NULL, ring.try_pop_front_exclusive());
+}
+
+TEST(mpsc_ring, push_batch_ownership) {
+    Object objs[3];
+
+    {
+        MpscRing<Object> ring(2, allocator);
+        CHECK(ring.valid());
+
+        SharedPtr<Object> batch[3] = { &objs[0], &objs[1], &objs[2] };
+
+        // objects that didn't fit are not acquired
+        UNSIGNED_LONGS_EQUAL(2, ring.push_back_batch(batch, 3));
+
+        UNSIGNED_LONGS_EQUAL(2, objs[0].getref());
+        UNSIGNED_LONGS_EQUAL(2, objs[1].getref());
+        UNSIGNED_LONGS_EQUAL(1, objs[2].getref());
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, objs[0].getref());
+    UNSIGNED_LONGS_EQUAL(0, objs[1].getref());
+    UNSIGNED_LONGS_EQUAL(0, objs[2].getref());
+}
+
+TEST(mpsc_ring, concurrent_producers) {
+    check_concurrent_producers(0);
+}
+
+TEST(mpsc_ring, concurrent_batch_producers) {
+    // batch size is not a divider of capacity, so batches wrap around
+    check_concurrent_producers(5);
+}
+
+} // namespace core
+} // namespace roc
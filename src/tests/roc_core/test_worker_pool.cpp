@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/thread.h"
+#include "roc_core/worker_pool.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { NumThreads = 4, MaxItems = 1000 };
+
+HeapAllocator allocator;
+
+class TestJob : public IWorkerJob {
+public:
+    TestJob() {
+        reset();
+    }
+
+    void reset() {
+        for (size_t n = 0; n < MaxItems; n++) {
+            counts_[n] = 0;
+            tids_[n] = 0;
+        }
+    }
+
+    virtual void run_item(size_t index) {
+        CHECK(index < MaxItems);
+
+        counts_[index]++;
+        tids_[index] = Thread::get_tid();
+    }
+
+    long count(size_t index) const {
+        return counts_[index];
+    }
+
+    uint64_t tid(size_t index) const {
+        return tids_[index];
+    }
+
+private:
+    // items are not processed concurrently, and run() returns after
+    // all items are done, so no atomics needed
+    long counts_[MaxItems];
+    uint64_t tids_[MaxItems];
+};
+
+} // namespace
+
+TEST_GROUP(worker_pool) {};
+
+TEST(worker_pool, invalid_size) {
+    {
+        WorkerPool pool(0, allocator);
+        CHECK(!pool.valid());
+    }
+    {
+        WorkerPool pool(WorkerPool::MaxThreads + 1, allocator);
+        CHECK(!pool.valid());
+    }
+}
+
+TEST(worker_pool, init) {
+    WorkerPool pool(NumThreads, allocator);
+    CHECK(pool.valid());
+
+    UNSIGNED_LONGS_EQUAL(NumThreads, pool.num_threads());
+}
+
+TEST(worker_pool, run_all_items) {
+    WorkerPool pool(NumThreads, allocator);
+    CHECK(pool.valid());
+
+    TestJob job;
+
+    const size_t sizes[] = { 0, 1, 2, NumThreads, NumThreads + 1, MaxItems };
+
+    for (size_t ns = 0; ns < ROC_ARRAY_SIZE(sizes); ns++) {
+        job.reset();
+
+        pool.run(job, sizes[ns]);
+
+        // every item is processed exactly once, and run() doesn't return
+        // until all items are done
+        for (size_t n = 0; n < MaxItems; n++) {
+            LONGS_EQUAL(n < sizes[ns] ? 1 : 0, job.count(n));
+        }
+    }
+}
+
+TEST(worker_pool, single_item_on_caller) {
+    WorkerPool pool(NumThreads, allocator);
+    CHECK(pool.valid());
+
+    TestJob job;
+
+    pool.run(job, 1);
+
+    LONGS_EQUAL(1, job.count(0));
+    CHECK(job.tid(0) == Thread::get_tid());
+}
+
+TEST(worker_pool, many_runs) {
+    enum { NumRuns = 1000, NumItems = 10 };
+
+    WorkerPool pool(NumThreads, allocator);
+    CHECK(pool.valid());
+
+    TestJob job;
+
+    for (size_t nr = 0; nr < NumRuns; nr++) {
+        pool.run(job, NumItems);
+    }
+
+    for (size_t n = 0; n < MaxItems; n++) {
+        LONGS_EQUAL(n < NumItems ? NumRuns : 0, job.count(n));
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/time.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_fec/reader.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_packet/router.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// This benchmark compares FEC schemes, block sizes, payload sizes, and loss rates.
+//
+// BM_FecEncode and BM_FecDecode run IBlockEncoder and IBlockDecoder directly,
+// one block per iteration. BM_FecWriterReader runs one block per iteration
+// through fec::Writer, a lossy link, and fec::Reader, including packet
+// allocation, composing, and parsing.
+//
+// Common args are: FEC scheme, source packets per block, repair packets per
+// block, payload size. Decoding benchmarks also take loss rate, in percents.
+// Losses are random and independent for every packet.
+//
+// Reported counters:
+//  - bytes_per_second: source payload bytes processed per second
+//  - repaired_per_sec: restored source packets per second
+//  - max_block_us: worst time spent on one block, in microseconds
+//
+// Schemes not supported in current build are skipped.
+
+enum { MaxPayloadSize = 1500, NumLossPatterns = 32 };
+
+const unsigned SourceID = 555;
+const unsigned PayloadType = rtp::PayloadType_L16_Stereo;
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxPayloadSize + 100, false);
+packet::PacketFactory packet_factory(allocator, false);
+
+rtp::FormatMap format_map;
+rtp::Parser rtp_parser(format_map, NULL);
+rtp::Composer rtp_composer(NULL);
+
+Composer<RS8M_PayloadID, Source, Footer> rs8m_source_composer(&rtp_composer);
+Composer<RS8M_PayloadID, Repair, Header> rs8m_repair_composer(NULL);
+Composer<LDPC_Source_PayloadID, Source, Footer> ldpc_source_composer(&rtp_composer);
+Composer<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_composer(NULL);
+
+packet::IComposer& source_composer(packet::FecScheme scheme) {
+    switch (scheme) {
+    case packet::FEC_ReedSolomon_M8:
+        return rs8m_source_composer;
+    case packet::FEC_LDPC_Staircase:
+        return ldpc_source_composer;
+    default:
+        roc_panic("bad scheme");
+    }
+}
+
+packet::IComposer& repair_composer(packet::FecScheme scheme) {
+    switch (scheme) {
+    case packet::FEC_ReedSolomon_M8:
+        return rs8m_repair_composer;
+    case packet::FEC_LDPC_Staircase:
+        return ldpc_repair_composer;
+    default:
+        roc_panic("bad scheme");
+    }
+}
+
+class Block {
+public:
+    Block(size_t n_packets, size_t payload_size)
+        : buffers_(allocator) {
+        roc_panic_if(!buffers_.resize(n_packets));
+
+        for (size_t i = 0; i < n_packets; i++) {
+            buffers_[i] = buffer_factory.new_buffer();
+            buffers_[i].reslice(0, payload_size);
+
+            for (size_t j = 0; j < payload_size; j++) {
+                buffers_[i].data()[j] = (uint8_t)core::fast_random(0, 0xff);
+            }
+        }
+    }
+
+    const core::Slice<uint8_t>& operator[](size_t i) const {
+        return buffers_[i];
+    }
+
+private:
+    core::Array<core::Slice<uint8_t> > buffers_;
+};
+
+// Precomputed random losses, so that random generator doesn't affect timing.
+class LossPatterns {
+public:
+    LossPatterns(size_t n_packets, size_t loss_percents)
+        : lost_(allocator)
+        , n_packets_(n_packets) {
+        roc_panic_if(!lost_.resize(n_packets * NumLossPatterns));
+
+        for (size_t i = 0; i < lost_.size(); i++) {
+            lost_[i] = core::fast_random(0, 99) < loss_percents;
+        }
+    }
+
+    bool is_lost(size_t pattern, size_t packet) const {
+        return lost_[(pattern % NumLossPatterns) * n_packets_ + packet];
+    }
+
+private:
+    core::Array<bool> lost_;
+    size_t n_packets_;
+};
+
+class LatencyMeter {
+public:
+    LatencyMeter()
+        : start_(0)
+        , max_(0) {
+    }
+
+    void begin() {
+        start_ = core::timestamp(core::ClockMonotonic);
+    }
+
+    void end() {
+        const core::nanoseconds_t elapsed =
+            core::timestamp(core::ClockMonotonic) - start_;
+        if (max_ < elapsed) {
+            max_ = elapsed;
+        }
+    }
+
+    double max_us() const {
+        return double(max_) / core::Microsecond;
+    }
+
+private:
+    core::nanoseconds_t start_;
+    core::nanoseconds_t max_;
+};
+
+// Drops packets according to loss pattern.
+class LossyWriter : public packet::IWriter {
+public:
+    LossyWriter(packet::IWriter& writer, const LossPatterns& losses, size_t n_packets)
+        : writer_(writer)
+        , losses_(losses)
+        , n_packets_(n_packets)
+        , pattern_(0)
+        , packet_(0) {
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        if (!losses_.is_lost(pattern_, packet_)) {
+            writer_.write(pp);
+        }
+        if (++packet_ == n_packets_) {
+            packet_ = 0;
+            pattern_++;
+        }
+    }
+
+private:
+    packet::IWriter& writer_;
+    const LossPatterns& losses_;
+    const size_t n_packets_;
+    size_t pattern_;
+    size_t packet_;
+};
+
+bool make_codec_config(benchmark::State& state, CodecConfig& config) {
+    config.scheme = (packet::FecScheme)state.range(0);
+
+    if (!CodecMap::instance().is_supported(config.scheme)) {
+        state.SkipWithError("scheme not supported");
+        return false;
+    }
+
+    return true;
+}
+
+void set_counters(benchmark::State& state,
+                  size_t n_source,
+                  size_t payload_size,
+                  size_t n_repaired,
+                  const LatencyMeter& meter) {
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n_source)
+                            * int64_t(payload_size));
+
+    state.counters["repaired_per_sec"] =
+        benchmark::Counter(double(n_repaired), benchmark::Counter::kIsRate);
+
+    state.counters["max_block_us"] = meter.max_us();
+}
+
+// scheme, source packets, repair packets, payload size
+const int64_t encode_arg_rows[][4] = {
+    { packet::FEC_ReedSolomon_M8, 20, 10, 200 },
+    { packet::FEC_ReedSolomon_M8, 20, 10, 1200 },
+    { packet::FEC_ReedSolomon_M8, 100, 50, 1200 },
+    { packet::FEC_ReedSolomon_M8, 200, 50, 1200 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 200 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 1200 },
+    { packet::FEC_LDPC_Staircase, 100, 50, 1200 },
+    { packet::FEC_LDPC_Staircase, 200, 50, 1200 },
+    { packet::FEC_LDPC_Staircase, 1000, 500, 1200 },
+};
+
+// scheme, source packets, repair packets, payload size, loss rate
+const int64_t decode_arg_rows[][5] = {
+    { packet::FEC_ReedSolomon_M8, 20, 10, 200, 5 },
+    { packet::FEC_ReedSolomon_M8, 20, 10, 1200, 5 },
+    { packet::FEC_ReedSolomon_M8, 20, 10, 1200, 20 },
+    { packet::FEC_ReedSolomon_M8, 100, 50, 1200, 5 },
+    { packet::FEC_ReedSolomon_M8, 100, 50, 1200, 20 },
+    { packet::FEC_ReedSolomon_M8, 200, 50, 1200, 5 },
+    { packet::FEC_ReedSolomon_M8, 200, 50, 200, 20 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 200, 5 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 1200, 5 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 1200, 20 },
+    { packet::FEC_LDPC_Staircase, 100, 50, 1200, 5 },
+    { packet::FEC_LDPC_Staircase, 100, 50, 1200, 20 },
+    { packet::FEC_LDPC_Staircase, 200, 50, 1200, 5 },
+    { packet::FEC_LDPC_Staircase, 200, 50, 200, 20 },
+    { packet::FEC_LDPC_Staircase, 1000, 500, 1200, 20 },
+};
+
+// scheme, source packets, repair packets, payload size, loss rate
+const int64_t writer_reader_arg_rows[][5] = {
+    { packet::FEC_ReedSolomon_M8, 20, 10, 200, 5 },
+    { packet::FEC_ReedSolomon_M8, 20, 10, 1200, 0 },
+    { packet::FEC_ReedSolomon_M8, 20, 10, 1200, 5 },
+    { packet::FEC_ReedSolomon_M8, 20, 10, 1200, 20 },
+    { packet::FEC_ReedSolomon_M8, 100, 50, 1200, 5 },
+    { packet::FEC_ReedSolomon_M8, 100, 50, 1200, 20 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 200, 5 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 1200, 0 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 1200, 5 },
+    { packet::FEC_LDPC_Staircase, 20, 10, 1200, 20 },
+    { packet::FEC_LDPC_Staircase, 100, 50, 1200, 5 },
+    { packet::FEC_LDPC_Staircase, 100, 50, 1200, 20 },
+};
+
+void add_arg_rows(benchmark::internal::Benchmark* b,
+                  const int64_t* rows,
+                  size_t n_rows,
+                  size_t n_cols) {
+    for (size_t n = 0; n < n_rows; n++) {
+        std::vector<int64_t> args(rows + n * n_cols, rows + (n + 1) * n_cols);
+        b->Args(args);
+    }
+}
+
+void encode_args(benchmark::internal::Benchmark* b) {
+    add_arg_rows(b, encode_arg_rows[0], ROC_ARRAY_SIZE(encode_arg_rows),
+                 ROC_ARRAY_SIZE(encode_arg_rows[0]));
+}
+
+void decode_args(benchmark::internal::Benchmark* b) {
+    add_arg_rows(b, decode_arg_rows[0], ROC_ARRAY_SIZE(decode_arg_rows),
+                 ROC_ARRAY_SIZE(decode_arg_rows[0]));
+}
+
+void writer_reader_args(benchmark::internal::Benchmark* b) {
+    add_arg_rows(b, writer_reader_arg_rows[0], ROC_ARRAY_SIZE(writer_reader_arg_rows),
+                 ROC_ARRAY_SIZE(writer_reader_arg_rows[0]));
+}
+
+// Args: scheme, source packets, repair packets, payload size.
+void BM_FecEncode(benchmark::State& state) {
+    CodecConfig codec_config;
+    if (!make_codec_config(state, codec_config)) {
+        return;
+    }
+
+    const size_t n_source = (size_t)state.range(1);
+    const size_t n_repair = (size_t)state.range(2);
+    const size_t payload_size = (size_t)state.range(3);
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(codec_config, buffer_factory, allocator),
+        allocator);
+    roc_panic_if(!encoder);
+
+    Block block(n_source + n_repair, payload_size);
+    LatencyMeter meter;
+
+    while (state.KeepRunning()) {
+        meter.begin();
+
+        encoder->begin(n_source, n_repair, payload_size);
+        for (size_t i = 0; i < n_source + n_repair; i++) {
+            encoder->set(i, block[i]);
+        }
+        encoder->fill();
+        encoder->end();
+
+        meter.end();
+    }
+
+    set_counters(state, n_source, payload_size, 0, meter);
+}
+
+BENCHMARK(BM_FecEncode)->Apply(encode_args)->Unit(benchmark::kMicrosecond);
+
+// Args: scheme, source packets, repair packets, payload size, loss rate.
+void BM_FecDecode(benchmark::State& state) {
+    CodecConfig codec_config;
+    if (!make_codec_config(state, codec_config)) {
+        return;
+    }
+
+    const size_t n_source = (size_t)state.range(1);
+    const size_t n_repair = (size_t)state.range(2);
+    const size_t payload_size = (size_t)state.range(3);
+    const size_t loss_rate = (size_t)state.range(4);
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(codec_config, buffer_factory, allocator),
+        allocator);
+    roc_panic_if(!encoder);
+
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_decoder(codec_config, buffer_factory, allocator),
+        allocator);
+    roc_panic_if(!decoder);
+
+    Block block(n_source + n_repair, payload_size);
+
+    encoder->begin(n_source, n_repair, payload_size);
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        encoder->set(i, block[i]);
+    }
+    encoder->fill();
+    encoder->end();
+
+    LossPatterns losses(n_source + n_repair, loss_rate);
+    LatencyMeter meter;
+
+    size_t n_iter = 0;
+    size_t n_repaired = 0;
+
+    while (state.KeepRunning()) {
+        meter.begin();
+
+        decoder->begin(n_source, n_repair, payload_size);
+        for (size_t i = 0; i < n_source + n_repair; i++) {
+            if (!losses.is_lost(n_iter, i)) {
+                decoder->set(i, block[i]);
+            }
+        }
+        for (size_t i = 0; i < n_source; i++) {
+            if (losses.is_lost(n_iter, i) && decoder->repair(i)) {
+                n_repaired++;
+            }
+        }
+        decoder->end();
+
+        meter.end();
+
+        n_iter++;
+    }
+
+    set_counters(state, n_source, payload_size, n_repaired, meter);
+}
+
+BENCHMARK(BM_FecDecode)->Apply(decode_args)->Unit(benchmark::kMicrosecond);
+
+// Args: scheme, source packets, repair packets, payload size, loss rate.
+void BM_FecWriterReader(benchmark::State& state) {
+    CodecConfig codec_config;
+    if (!make_codec_config(state, codec_config)) {
+        return;
+    }
+
+    WriterConfig writer_config;
+    writer_config.n_source_packets = (size_t)state.range(1);
+    writer_config.n_repair_packets = (size_t)state.range(2);
+
+    const size_t n_source = writer_config.n_source_packets;
+    const size_t n_repair = writer_config.n_repair_packets;
+    const size_t payload_size = (size_t)state.range(3);
+    const size_t loss_rate = (size_t)state.range(4);
+
+    roc_panic_if(payload_size <= sizeof(rtp::Header));
+    const size_t rtp_payload_size = payload_size - sizeof(rtp::Header);
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(codec_config, buffer_factory, allocator),
+        allocator);
+    roc_panic_if(!encoder);
+
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_decoder(codec_config, buffer_factory, allocator),
+        allocator);
+    roc_panic_if(!decoder);
+
+    packet::Queue source_queue;
+    packet::Queue repair_queue;
+
+    packet::Router router(allocator);
+    roc_panic_if(!router.add_route(source_queue, packet::Packet::FlagAudio));
+    roc_panic_if(!router.add_route(repair_queue, packet::Packet::FlagRepair));
+
+    LossPatterns losses(n_source + n_repair, loss_rate);
+    LossyWriter lossy_writer(router, losses, n_source + n_repair);
+
+    Writer writer(writer_config, codec_config.scheme, *encoder, lossy_writer,
+                  source_composer(codec_config.scheme),
+                  repair_composer(codec_config.scheme), packet_factory, buffer_factory,
+                  allocator);
+    roc_panic_if(!writer.valid());
+
+    ReaderConfig reader_config;
+    Reader reader(reader_config, codec_config.scheme, *decoder, source_queue,
+                  repair_queue, rtp_parser, packet_factory, allocator);
+    roc_panic_if(!reader.valid());
+
+    LatencyMeter meter;
+
+    packet::seqnum_t sn = 0;
+    size_t n_repaired = 0;
+
+    while (state.KeepRunning()) {
+        meter.begin();
+
+        for (size_t i = 0; i < n_source; i++) {
+            packet::PacketPtr pp = packet_factory.new_packet();
+            roc_panic_if(!pp);
+
+            core::Slice<uint8_t> bp = buffer_factory.new_buffer();
+            roc_panic_if(!bp);
+
+            roc_panic_if(!source_composer(codec_config.scheme)
+                              .prepare(*pp, bp, rtp_payload_size));
+            pp->set_data(bp);
+
+            pp->add_flags(packet::Packet::FlagAudio);
+
+            pp->rtp()->source = SourceID;
+            pp->rtp()->payload_type = PayloadType;
+            pp->rtp()->seqnum = sn;
+            pp->rtp()->timestamp = packet::timestamp_t(sn) * 10;
+            sn++;
+
+            writer.write(pp);
+        }
+
+        while (packet::PacketPtr pp = reader.read()) {
+            if (pp->flags() & packet::Packet::FlagRestored) {
+                n_repaired++;
+            }
+        }
+
+        meter.end();
+    }
+
+    set_counters(state, n_source, payload_size, n_repaired, meter);
+}
+
+BENCHMARK(BM_FecWriterReader)->Apply(writer_reader_args)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/gf256_kernel.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+enum { PayloadSize = 1024, NumSourcePackets = 100 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, PayloadSize, true);
+
+class Block {
+public:
+    Block(size_t n_source, size_t n_repair)
+        : buffers_(allocator) {
+        roc_panic_if(!buffers_.resize(n_source + n_repair));
+
+        for (size_t i = 0; i < n_source + n_repair; i++) {
+            buffers_[i] = buffer_factory.new_buffer();
+            buffers_[i].reslice(0, PayloadSize);
+
+            for (size_t j = 0; j < PayloadSize; j++) {
+                buffers_[i].data()[j] = (uint8_t)core::fast_random(0, 0xff);
+            }
+        }
+    }
+
+    const core::Slice<uint8_t>& operator[](size_t i) const {
+        return buffers_[i];
+    }
+
+private:
+    core::Array<core::Slice<uint8_t> > buffers_;
+};
+
+CodecConfig make_config(CodecBackend backend) {
+    CodecConfig config;
+    config.scheme = packet::FEC_ReedSolomon_M8;
+    config.backend = backend;
+    return config;
+}
+
+void BM_Gf256Kernel(benchmark::State& state) {
+    const Gf256Kernel kernel = (Gf256Kernel)state.range(0);
+
+    gf256_kernel_func_t func = gf256_kernel_func(kernel);
+    if (!func) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+
+    uint8_t src[PayloadSize];
+    uint8_t dst[PayloadSize];
+
+    for (size_t n = 0; n < PayloadSize; n++) {
+        src[n] = (uint8_t)n;
+        dst[n] = 0;
+    }
+
+    const uint8_t* table = Gf256::instance().split_table(0x8e);
+
+    while (state.KeepRunning()) {
+        func(dst, src, table, PayloadSize);
+        benchmark::DoNotOptimize(dst);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * PayloadSize);
+}
+
+BENCHMARK(BM_Gf256Kernel)
+    ->Arg(Gf256Kernel_Scalar)
+    ->Arg(Gf256Kernel_SSSE3)
+    ->Arg(Gf256Kernel_AVX2)
+    ->Arg(Gf256Kernel_NEON);
+
+// Args: backend, repair packets per 100 source packets.
+void BM_Rs8mEncode(benchmark::State& state) {
+    const CodecBackend backend = (CodecBackend)state.range(0);
+    const size_t n_repair = (size_t)state.range(1);
+
+    if (!CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8, backend)) {
+        state.SkipWithError("backend not supported");
+        return;
+    }
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(make_config(backend), buffer_factory,
+                                         allocator),
+        allocator);
+    roc_panic_if(!encoder);
+
+    Block block(NumSourcePackets, n_repair);
+
+    while (state.KeepRunning()) {
+        encoder->begin(NumSourcePackets, n_repair, PayloadSize);
+        for (size_t i = 0; i < NumSourcePackets + n_repair; i++) {
+            encoder->set(i, block[i]);
+        }
+        encoder->fill();
+        encoder->end();
+    }
+
+    // source bytes consumed
+    state.SetBytesProcessed(int64_t(state.iterations()) * NumSourcePackets
+                            * PayloadSize);
+}
+
+BENCHMARK(BM_Rs8mEncode)
+    ->ArgPair(CodecBackend_OpenFEC, 10)
+    ->ArgPair(CodecBackend_OpenFEC, 50)
+    ->ArgPair(CodecBackend_OpenFEC, 100)
+    ->ArgPair(CodecBackend_OpenFEC, 150)
+    ->ArgPair(CodecBackend_Builtin, 10)
+    ->ArgPair(CodecBackend_Builtin, 50)
+    ->ArgPair(CodecBackend_Builtin, 100)
+    ->ArgPair(CodecBackend_Builtin, 150)
+    ->Unit(benchmark::kMicrosecond);
+
+// Args: backend, repair packets per 100 source packets.
+// Source packets are lost as much as repair packets can recover.
+void BM_Rs8mDecode(benchmark::State& state) {
+    const CodecBackend backend = (CodecBackend)state.range(0);
+    const size_t n_repair = (size_t)state.range(1);
+
+    if (!CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8, backend)) {
+        state.SkipWithError("backend not supported");
+        return;
+    }
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(make_config(backend), buffer_factory,
+                                         allocator),
+        allocator);
+    roc_panic_if(!encoder);
+
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_decoder(make_config(backend), buffer_factory,
+                                         allocator),
+        allocator);
+    roc_panic_if(!decoder);
+
+    Block block(NumSourcePackets, n_repair);
+
+    encoder->begin(NumSourcePackets, n_repair, PayloadSize);
+    for (size_t i = 0; i < NumSourcePackets + n_repair; i++) {
+        encoder->set(i, block[i]);
+    }
+    encoder->fill();
+    encoder->end();
+
+    const size_t n_lost = std::min(n_repair, (size_t)NumSourcePackets);
+
+    while (state.KeepRunning()) {
+        decoder->begin(NumSourcePackets, n_repair, PayloadSize);
+        for (size_t i = n_lost; i < NumSourcePackets + n_repair; i++) {
+            decoder->set(i, block[i]);
+        }
+        for (size_t i = 0; i < n_lost; i++) {
+            benchmark::DoNotOptimize(decoder->repair(i));
+        }
+        decoder->end();
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * NumSourcePackets
+                            * PayloadSize);
+    state.counters["repaired_per_sec"] = benchmark::Counter(
+        double(state.iterations()) * n_lost, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_Rs8mDecode)
+    ->ArgPair(CodecBackend_OpenFEC, 10)
+    ->ArgPair(CodecBackend_OpenFEC, 50)
+    ->ArgPair(CodecBackend_OpenFEC, 100)
+    ->ArgPair(CodecBackend_OpenFEC, 150)
+    ->ArgPair(CodecBackend_Builtin, 10)
+    ->ArgPair(CodecBackend_Builtin, 50)
+    ->ArgPair(CodecBackend_Builtin, 100)
+    ->ArgPair(CodecBackend_Builtin, 150)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
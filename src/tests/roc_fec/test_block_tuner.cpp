@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_fec/block_tuner.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t MaxBlockLength = 255;
+
+const core::nanoseconds_t PacketLength = 5 * core::Millisecond;
+
+} // namespace
+
+TEST_GROUP(block_tuner) {
+    BlockTunerConfig tuner_config;
+    WriterConfig writer_config;
+
+    void setup() {
+        tuner_config.min_block_duration = 20 * core::Millisecond;
+        tuner_config.max_block_duration = 200 * core::Millisecond;
+        tuner_config.min_repair_ratio = 0.1f;
+        tuner_config.max_repair_ratio = 1.0f;
+        tuner_config.loss_margin = 2.0f;
+        tuner_config.loss_decay = 0.5f;
+
+        writer_config.n_source_packets = 20;
+        writer_config.n_repair_packets = 10;
+    }
+};
+
+TEST(block_tuner, initial) {
+    BlockTuner tuner(tuner_config, writer_config, MaxBlockLength, PacketLength);
+    CHECK(tuner.valid());
+
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(10, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, no_loss) {
+    BlockTuner tuner(tuner_config, writer_config, MaxBlockLength, PacketLength);
+    CHECK(tuner.valid());
+
+    tuner.update_loss(0);
+
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(2, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, loss) {
+    BlockTuner tuner(tuner_config, writer_config, MaxBlockLength, PacketLength);
+    CHECK(tuner.valid());
+
+    tuner.update_loss(0.2f);
+
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(8, tuner.n_repair_packets());
+
+    tuner.update_loss(0.9f);
+
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, loss_decay) {
+    BlockTuner tuner(tuner_config, writer_config, MaxBlockLength, PacketLength);
+    CHECK(tuner.valid());
+
+    tuner.update_loss(0.4f);
+    UNSIGNED_LONGS_EQUAL(16, tuner.n_repair_packets());
+
+    // loss goes down slowly
+    tuner.update_loss(0);
+    UNSIGNED_LONGS_EQUAL(8, tuner.n_repair_packets());
+
+    tuner.update_loss(0);
+    UNSIGNED_LONGS_EQUAL(4, tuner.n_repair_packets());
+
+    for (size_t n = 0; n < 10; n++) {
+        tuner.update_loss(0);
+    }
+    UNSIGNED_LONGS_EQUAL(2, tuner.n_repair_packets());
+
+    // loss goes up immediately
+    tuner.update_loss(0.4f);
+    UNSIGNED_LONGS_EQUAL(16, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, rtt) {
+    BlockTuner tuner(tuner_config, writer_config, MaxBlockLength, PacketLength);
+    CHECK(tuner.valid());
+
+    // block duration is half of rtt
+    tuner.update_rtt(100 * core::Millisecond);
+    UNSIGNED_LONGS_EQUAL(10, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(5, tuner.n_repair_packets());
+
+    // min block duration
+    tuner.update_rtt(10 * core::Millisecond);
+    UNSIGNED_LONGS_EQUAL(4, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(2, tuner.n_repair_packets());
+
+    // max block duration
+    tuner.update_rtt(core::Second);
+    UNSIGNED_LONGS_EQUAL(40, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_repair_packets());
+
+    // unknown rtt is ignored
+    tuner.update_rtt(0);
+    UNSIGNED_LONGS_EQUAL(40, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, loss_and_rtt) {
+    BlockTuner tuner(tuner_config, writer_config, MaxBlockLength, PacketLength);
+    CHECK(tuner.valid());
+
+    tuner.update_rtt(100 * core::Millisecond);
+    tuner.update_loss(0.1f);
+
+    UNSIGNED_LONGS_EQUAL(10, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(2, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, max_block_length) {
+    BlockTuner tuner(tuner_config, writer_config, 30, PacketLength);
+    CHECK(tuner.valid());
+
+    // 40 source packets don't fit, block is shrunk keeping repair ratio
+    tuner.update_rtt(core::Second);
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(10, tuner.n_repair_packets());
+
+    tuner.update_loss(0.9f);
+    UNSIGNED_LONGS_EQUAL(15, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(15, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, invalid_config) {
+    {
+        BlockTuner tuner(tuner_config, writer_config, MaxBlockLength, 0);
+        CHECK(!tuner.valid());
+    }
+    {
+        BlockTuner tuner(tuner_config, writer_config, 20, PacketLength);
+        CHECK(!tuner.valid());
+    }
+    {
+        BlockTunerConfig config = tuner_config;
+        config.min_block_duration = config.max_block_duration + 1;
+
+        BlockTuner tuner(config, writer_config, MaxBlockLength, PacketLength);
+        CHECK(!tuner.valid());
+    }
+    {
+        BlockTunerConfig config = tuner_config;
+        config.min_repair_ratio = config.max_repair_ratio + 1;
+
+        BlockTuner tuner(config, writer_config, MaxBlockLength, PacketLength);
+        CHECK(!tuner.valid());
+    }
+    {
+        BlockTunerConfig config = tuner_config;
+        config.loss_decay = 0;
+
+        BlockTuner tuner(config, writer_config, MaxBlockLength, PacketLength);
+        CHECK(!tuner.valid());
+    }
+}
+
+} // namespace fec
+} // namespace roc
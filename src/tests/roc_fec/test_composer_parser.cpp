@@ -14,6 +14,7 @@
 #include "roc_fec/parser.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_rtp/composer.h"
+#include "roc_rtp/headers.h"
 #include "roc_rtp/parser.h"
 
 namespace roc {
@@ -81,6 +82,33 @@ const uint8_t Ref_rs8m_repair[] = {
     0x09, 0x0a
 };
 
+const size_t Test_rlc_esi = 0x11223344;
+const size_t Test_rlc_key = 0x5566;
+const size_t Test_rlc_nss = 0x777;
+
+const uint8_t Ref_rtp_rlc_source[] = {
+    /* RTP header */
+    0x80, 0x0B, 0x55, 0x66, //
+    0x77, 0x88, 0x99, 0xaa, //
+    0x11, 0x22, 0x33, 0x44, //
+    /* Payload */
+    0x01, 0x02, 0x03, 0x04, //
+    0x05, 0x06, 0x07, 0x08, //
+    0x09, 0x0a,
+    /* RLC source footer */
+    0x11, 0x22, 0x33, 0x44
+};
+
+const uint8_t Ref_rlc_repair[] = {
+    /* RLC repair header */
+    0x55, 0x66, 0xf7, 0x77, //
+    0x11, 0x22, 0x33, 0x44, //
+    /* Payload */
+    0x01, 0x02, 0x03, 0x04, //
+    0x05, 0x06, 0x07, 0x08, //
+    0x09, 0x0a
+};
+
 struct PacketTest {
     packet::IComposer* composer;
     packet::IParser* parser;
@@ -233,7 +261,57 @@ void test_all(const PacketTest& test) {
 
 } // namespace
 
-TEST_GROUP(composer_parser) {};
+TEST_GROUP(composer_parser) {
+    void check_rlc(packet::IComposer& composer,
+                   packet::IParser& parser,
+                   bool is_rtp,
+                   const uint8_t* reference,
+                   size_t reference_size,
+                   size_t sbn,
+                   size_t sbl) {
+        core::Slice<uint8_t> buffer = buffer_factory.new_buffer();
+        CHECK(buffer);
+
+        packet::PacketPtr packet1 = packet_factory.new_packet();
+        CHECK(packet1);
+
+        CHECK(composer.prepare(*packet1, buffer, Test_payload_size));
+        packet1->set_data(buffer);
+
+        fill_packet(*packet1, is_rtp);
+
+        packet1->fec()->encoding_symbol_id = Test_rlc_esi;
+        packet1->fec()->source_block_number = Test_rlc_key;
+        packet1->fec()->source_block_length = Test_rlc_nss;
+        packet1->fec()->block_length = 0;
+
+        CHECK(composer.compose(*packet1));
+
+        UNSIGNED_LONGS_EQUAL(reference_size, packet1->data().size());
+        for (size_t i = 0; i < reference_size; i++) {
+            UNSIGNED_LONGS_EQUAL(reference[i], packet1->data().data()[i]);
+        }
+
+        packet::PacketPtr packet2 = packet_factory.new_packet();
+        CHECK(packet2);
+
+        CHECK(parser.parse(*packet2, packet1->data()));
+
+        CHECK(packet2->fec());
+        UNSIGNED_LONGS_EQUAL(packet::FEC_RLC, packet2->fec()->fec_scheme);
+        UNSIGNED_LONGS_EQUAL(Test_rlc_esi, packet2->fec()->encoding_symbol_id);
+        UNSIGNED_LONGS_EQUAL(sbn, packet2->fec()->source_block_number);
+        UNSIGNED_LONGS_EQUAL(sbl, packet2->fec()->source_block_length);
+        UNSIGNED_LONGS_EQUAL(0, packet2->fec()->block_length);
+        UNSIGNED_LONGS_EQUAL(Test_payload_size + (is_rtp ? sizeof(rtp::Header) : 0),
+                             packet2->fec()->payload.size());
+
+        if (is_rtp) {
+            CHECK(packet2->rtp());
+            UNSIGNED_LONGS_EQUAL(Test_rtp_seqnum, packet2->rtp()->seqnum);
+        }
+    }
+};
 
 TEST(composer_parser, rtp_ldpc_source) {
     rtp::Composer rtp_composer(NULL);
@@ -307,5 +385,26 @@ TEST(composer_parser, rs8m_repair) {
     test_all(test);
 }
 
+TEST(composer_parser, rtp_rlc_source) {
+    rtp::Composer rtp_composer(NULL);
+    Composer<RLC_Source_PayloadID, Source, Footer> rlc_composer(&rtp_composer);
+
+    rtp::FormatMap rtp_format_map;
+    rtp::Parser rtp_parser(rtp_format_map, NULL);
+    Parser<RLC_Source_PayloadID, Source, Footer> rlc_parser(&rtp_parser);
+
+    // there are no blocks, so key and nss are not sent with source packets
+    check_rlc(rlc_composer, rlc_parser, true, Ref_rtp_rlc_source,
+              sizeof(Ref_rtp_rlc_source), 0, 0);
+}
+
+TEST(composer_parser, rlc_repair) {
+    Composer<RLC_Repair_PayloadID, Repair, Header> rlc_composer(NULL);
+    Parser<RLC_Repair_PayloadID, Repair, Header> rlc_parser(NULL);
+
+    check_rlc(rlc_composer, rlc_parser, false, Ref_rlc_repair, sizeof(Ref_rlc_repair),
+              Test_rlc_key, Test_rlc_nss);
+}
+
 } // namespace fec
 } // namespace roc
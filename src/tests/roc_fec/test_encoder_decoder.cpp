@@ -13,6 +13,7 @@
 #include "roc_core/fast_random.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_fec/codec_map.h"
 
@@ -40,6 +41,18 @@ public:
         CHECK(decoder_);
     }
 
+    Codec(const CodecConfig& encoder_config, const CodecConfig& decoder_config)
+        : encoder_(CodecMap::instance().new_encoder(
+                       encoder_config, buffer_factory, allocator),
+                   allocator)
+        , decoder_(CodecMap::instance().new_decoder(
+                       decoder_config, buffer_factory, allocator),
+                   allocator)
+        , buffers_(allocator) {
+        CHECK(encoder_);
+        CHECK(decoder_);
+    }
+
     void encode(size_t n_source, size_t n_repair, size_t p_size) {
         CHECK(buffers_.resize(n_source + n_repair));
 
@@ -221,6 +234,82 @@ TEST(encoder_decoder, full_repair_payload_sizes) {
     }
 }
 
+TEST(encoder_decoder, all_backends_max_loss) {
+    enum { NumSourcePackets = 30, NumRepairPackets = 15, PayloadSize = 251 };
+
+    const CodecBackend backends[] = { CodecBackend_OpenFEC, CodecBackend_Builtin };
+
+    for (size_t n_back = 0; n_back < ROC_ARRAY_SIZE(backends); n_back++) {
+        if (!CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8,
+                                               backends[n_back])) {
+            continue;
+        }
+
+        CodecConfig config;
+        config.scheme = packet::FEC_ReedSolomon_M8;
+        config.backend = backends[n_back];
+
+        Codec code(config);
+        code.encode(NumSourcePackets, NumRepairPackets, PayloadSize);
+
+        CHECK(code.decoder().begin(NumSourcePackets, NumRepairPackets, PayloadSize));
+
+        // lose every other source packet, up to the number of repair packets
+        size_t n_lost = 0;
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (i < NumSourcePackets && i % 2 == 0 && n_lost < NumRepairPackets) {
+                n_lost++;
+                continue;
+            }
+            code.decoder().set(i, code.get_buffer(i));
+        }
+        CHECK(code.decode(NumSourcePackets, PayloadSize));
+
+        code.decoder().end();
+    }
+}
+
+TEST(encoder_decoder, backends_compatible) {
+    enum { NumSourcePackets = 20, NumRepairPackets = 10, PayloadSize = 251 };
+
+    const CodecBackend backends[] = { CodecBackend_OpenFEC, CodecBackend_Builtin };
+
+    for (size_t n_enc = 0; n_enc < ROC_ARRAY_SIZE(backends); n_enc++) {
+        for (size_t n_dec = 0; n_dec < ROC_ARRAY_SIZE(backends); n_dec++) {
+            if (!CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8,
+                                                   backends[n_enc])
+                || !CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8,
+                                                      backends[n_dec])) {
+                continue;
+            }
+
+            CodecConfig encoder_config;
+            encoder_config.scheme = packet::FEC_ReedSolomon_M8;
+            encoder_config.backend = backends[n_enc];
+
+            CodecConfig decoder_config;
+            decoder_config.scheme = packet::FEC_ReedSolomon_M8;
+            decoder_config.backend = backends[n_dec];
+
+            Codec code(encoder_config, decoder_config);
+            code.encode(NumSourcePackets, NumRepairPackets, PayloadSize);
+
+            CHECK(
+                code.decoder().begin(NumSourcePackets, NumRepairPackets, PayloadSize));
+
+            for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+                if (i < NumRepairPackets) {
+                    continue;
+                }
+                code.decoder().set(i, code.get_buffer(i));
+            }
+            CHECK(code.decode(NumSourcePackets, PayloadSize));
+
+            code.decoder().end();
+        }
+    }
+}
+
 TEST(encoder_decoder, max_source_block) {
     for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); ++n_scheme) {
         CodecConfig config;
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/gf256_kernel.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxSz = 301 };
+
+uint8_t make_byte(size_t n, size_t k) {
+    return (uint8_t)((n * 7 + k * 13) & 0xff);
+}
+
+void check_kernel(Gf256Kernel kernel, uint8_t c, size_t size) {
+    gf256_kernel_func_t func = gf256_kernel_func(kernel);
+    CHECK(func);
+
+    const Gf256& gf = Gf256::instance();
+
+    uint8_t src[MaxSz + 1];
+    uint8_t dst[MaxSz + 1];
+    uint8_t expected[MaxSz + 1];
+
+    for (size_t n = 0; n < MaxSz + 1; n++) {
+        src[n] = make_byte(n, 1);
+        dst[n] = make_byte(n, 2);
+
+        if (n < size) {
+            expected[n] = dst[n] ^ gf.mul(c, src[n]);
+        } else {
+            expected[n] = dst[n];
+        }
+    }
+
+    // Use unaligned pointers.
+    func(dst + 1, src + 1, gf.split_table(c), size - 1);
+    func(dst, src, gf.split_table(c), 1);
+
+    for (size_t n = 0; n < MaxSz + 1; n++) {
+        UNSIGNED_LONGS_EQUAL(expected[n], dst[n]);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(gf256_kernel) {};
+
+TEST(gf256_kernel, field) {
+    const Gf256& gf = Gf256::instance();
+
+    // x^8 = x^4 + x^3 + x^2 + 1
+    UNSIGNED_LONGS_EQUAL(0x1d, gf.exp(8));
+
+    for (size_t a = 1; a < Gf256::Size; a++) {
+        UNSIGNED_LONGS_EQUAL(0, gf.mul((uint8_t)a, 0));
+        UNSIGNED_LONGS_EQUAL(a, gf.mul((uint8_t)a, 1));
+        UNSIGNED_LONGS_EQUAL(1, gf.mul((uint8_t)a, gf.div(1, (uint8_t)a)));
+
+        for (size_t b = 1; b < Gf256::Size; b += 7) {
+            UNSIGNED_LONGS_EQUAL(a, gf.div(gf.mul((uint8_t)a, (uint8_t)b), (uint8_t)b));
+        }
+    }
+}
+
+TEST(gf256_kernel, scalar_supported) {
+    CHECK(gf256_kernel_func(Gf256Kernel_Scalar));
+}
+
+TEST(gf256_kernel, select) {
+    const Gf256Kernel kernel = gf256_kernel_select();
+
+    CHECK(gf256_kernel_func(kernel));
+    CHECK(kernel != Gf256Kernel_Max);
+}
+
+TEST(gf256_kernel, muladd) {
+    const uint8_t consts[] = { 0, 1, 2, 0x1d, 0x80, 0xff };
+
+    for (int k = 0; k < Gf256Kernel_Max; k++) {
+        if (!gf256_kernel_func((Gf256Kernel)k)) {
+            continue;
+        }
+        for (size_t n_c = 0; n_c < sizeof(consts); n_c++) {
+            for (size_t size = 1; size <= MaxSz; size++) {
+                check_kernel((Gf256Kernel)k, consts[n_c], size);
+            }
+        }
+    }
+}
+
+TEST(gf256_kernel, to_str) {
+    for (int k = 0; k < Gf256Kernel_Max; k++) {
+        CHECK(strcmp(gf256_kernel_to_str((Gf256Kernel)k), "<invalid>") != 0);
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_fec/rlc_coefficients.h"
+#include "roc_fec/tinymt32.h"
+
+namespace roc {
+namespace fec {
+
+TEST_GROUP(tinymt32) {};
+
+TEST(tinymt32, rfc8682_test_vector) {
+    // first outputs for seed 1, from RFC 8682 section 2.2
+    const uint32_t expected[] = {
+        2545341989u, 981918433u, 3715302833u, 2387538352u, 3591001365u,
+    };
+
+    TinyMT32 prng(1);
+
+    for (size_t n = 0; n < sizeof(expected) / sizeof(expected[0]); n++) {
+        UNSIGNED_LONGS_EQUAL(expected[n], prng.generate_uint32());
+    }
+}
+
+TEST(tinymt32, same_seed) {
+    TinyMT32 prng1(12345);
+    TinyMT32 prng2(12345);
+
+    for (size_t n = 0; n < 100; n++) {
+        UNSIGNED_LONGS_EQUAL(prng1.generate_uint32(), prng2.generate_uint32());
+    }
+}
+
+TEST(tinymt32, rlc_coefficients) {
+    enum { NumCoefs = 255, NumKeys = 100 };
+
+    for (size_t key = 0; key < NumKeys; key++) {
+        uint8_t coefs[NumCoefs];
+        rlc_coefficients((uint16_t)key, coefs, NumCoefs);
+
+        TinyMT32 prng((uint32_t)key);
+
+        for (size_t n = 0; n < NumCoefs; n++) {
+            // dense code, coefficients are never zero
+            CHECK(coefs[n] != 0);
+
+            uint8_t expected;
+            do {
+                expected = (uint8_t)(prng.generate_uint32() & 0xff);
+            } while (expected == 0);
+
+            UNSIGNED_LONGS_EQUAL(expected, coefs[n]);
+        }
+
+        // prefix doesn't depend on number of coefficients
+        uint8_t short_coefs[10];
+        rlc_coefficients((uint16_t)key, short_coefs, 10);
+
+        for (size_t n = 0; n < 10; n++) {
+            UNSIGNED_LONGS_EQUAL(coefs[n], short_coefs[n]);
+        }
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,573 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/packet_dispatcher.h"
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_fec/window_reader.h"
+#include "roc_fec/window_writer.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t WindowLength = 10;
+const size_t NumRepairPackets = 5;
+
+const unsigned SourceID = 555;
+const unsigned PayloadType = rtp::PayloadType_L16_Stereo;
+
+const size_t FECPayloadSize = 193;
+
+const size_t MaxBuffSize = 500;
+
+const size_t MaxPackets = 1000;
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBuffSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+rtp::FormatMap format_map;
+rtp::Parser rtp_parser(format_map, NULL);
+
+Parser<RLC_Source_PayloadID, Source, Footer> source_parser(&rtp_parser);
+Parser<RLC_Repair_PayloadID, Repair, Header> repair_parser(NULL);
+
+rtp::Composer rtp_composer(NULL);
+Composer<RLC_Source_PayloadID, Source, Footer> source_composer(&rtp_composer);
+Composer<RLC_Repair_PayloadID, Repair, Header> repair_composer(NULL);
+
+// Drops selected source packets (by seqnum) and repair packets (by index)
+// before passing them to dispatcher.
+class PacketLoser : public packet::IWriter {
+public:
+    PacketLoser(packet::IWriter& writer)
+        : writer_(writer)
+        , n_repair_(0) {
+        for (size_t i = 0; i < MaxPackets; i++) {
+            lost_source_[i] = false;
+            lost_repair_[i] = false;
+        }
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        if (pp->flags() & packet::Packet::FlagRepair) {
+            CHECK(n_repair_ < MaxPackets);
+            if (lost_repair_[n_repair_++]) {
+                return;
+            }
+        } else {
+            CHECK(pp->rtp()->seqnum < MaxPackets);
+            if (lost_source_[pp->rtp()->seqnum]) {
+                return;
+            }
+        }
+        writer_.write(pp);
+    }
+
+    void lose_source(size_t sn) {
+        lost_source_[sn] = true;
+    }
+
+    void lose_repair(size_t n) {
+        lost_repair_[n] = true;
+    }
+
+    size_t n_repair() const {
+        return n_repair_;
+    }
+
+private:
+    packet::IWriter& writer_;
+
+    bool lost_source_[MaxPackets];
+    bool lost_repair_[MaxPackets];
+
+    size_t n_repair_;
+};
+
+} // namespace
+
+TEST_GROUP(window_writer_reader) {
+    WriterConfig writer_config;
+
+    void setup() {
+        writer_config.n_source_packets = WindowLength;
+        writer_config.n_repair_packets = NumRepairPackets;
+    }
+
+    packet::PacketPtr make_packet(size_t sn, size_t fec_payload_size = FECPayloadSize) {
+        CHECK(fec_payload_size > sizeof(rtp::Header));
+        const size_t rtp_payload_size = fec_payload_size - sizeof(rtp::Header);
+
+        packet::PacketPtr pp = packet_factory.new_packet();
+        CHECK(pp);
+
+        core::Slice<uint8_t> bp = buffer_factory.new_buffer();
+        CHECK(bp);
+
+        CHECK(source_composer.prepare(*pp, bp, rtp_payload_size));
+
+        pp->set_data(bp);
+
+        UNSIGNED_LONGS_EQUAL(rtp_payload_size, pp->rtp()->payload.size());
+        UNSIGNED_LONGS_EQUAL(fec_payload_size, pp->fec()->payload.size());
+
+        pp->add_flags(packet::Packet::FlagAudio);
+
+        pp->rtp()->source = SourceID;
+        pp->rtp()->payload_type = PayloadType;
+        pp->rtp()->seqnum = packet::seqnum_t(sn);
+        pp->rtp()->timestamp = packet::timestamp_t(sn * 10);
+
+        for (size_t i = 0; i < rtp_payload_size; i++) {
+            pp->rtp()->payload.data()[i] = uint8_t(sn + i);
+        }
+
+        return pp;
+    }
+
+    void check_packet(packet::PacketPtr pp, size_t sn, bool restored,
+                      size_t fec_payload_size = FECPayloadSize) {
+        const size_t rtp_payload_size = fec_payload_size - sizeof(rtp::Header);
+
+        CHECK(pp);
+
+        CHECK(pp->flags() & packet::Packet::FlagRTP);
+        CHECK(pp->flags() & packet::Packet::FlagAudio);
+
+        CHECK(pp->rtp());
+        CHECK(pp->rtp()->header);
+        CHECK(pp->rtp()->payload);
+
+        UNSIGNED_LONGS_EQUAL(SourceID, pp->rtp()->source);
+        UNSIGNED_LONGS_EQUAL(sn, pp->rtp()->seqnum);
+        UNSIGNED_LONGS_EQUAL(packet::timestamp_t(sn * 10), pp->rtp()->timestamp);
+        UNSIGNED_LONGS_EQUAL(PayloadType, pp->rtp()->payload_type);
+        UNSIGNED_LONGS_EQUAL(rtp_payload_size, pp->rtp()->payload.size());
+
+        for (size_t i = 0; i < rtp_payload_size; i++) {
+            UNSIGNED_LONGS_EQUAL(uint8_t(sn + i), pp->rtp()->payload.data()[i]);
+        }
+
+        if (restored) {
+            CHECK((pp->flags() & packet::Packet::FlagRestored) != 0);
+            CHECK(!pp->fec());
+        } else {
+            CHECK((pp->flags() & packet::Packet::FlagRestored) == 0);
+            CHECK(pp->fec());
+        }
+    }
+};
+
+TEST(window_writer_reader, no_losses) {
+    enum { NumPackets = 40 };
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+
+    WindowWriter writer(writer_config, dispatcher, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        writer.write(make_packet(sn));
+    }
+    dispatcher.push_stocks();
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, dispatcher.source_size());
+    UNSIGNED_LONGS_EQUAL(NumPackets * NumRepairPackets / WindowLength,
+                         dispatcher.repair_size());
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        check_packet(reader.read(), sn, false);
+    }
+
+    CHECK(!reader.read());
+
+    CHECK(writer.alive());
+    CHECK(reader.alive());
+}
+
+TEST(window_writer_reader, repair_packets_layout) {
+    enum { NumPackets = 40 };
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+
+    WindowWriter writer(writer_config, dispatcher, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+
+    packet::PacketPtr first = make_packet(0);
+    writer.write(first);
+
+    const uint32_t first_esi = (uint32_t)first->fec()->encoding_symbol_id;
+
+    for (size_t sn = 1; sn < NumPackets; sn++) {
+        writer.write(make_packet(sn));
+    }
+    dispatcher.push_stocks();
+
+    const size_t n_repair = dispatcher.repair_size();
+
+    for (size_t n = 0; n < n_repair; n++) {
+        packet::PacketPtr rp = dispatcher.repair_reader().read();
+        CHECK(rp);
+        CHECK(rp->fec());
+
+        // repair packet is generated after every two source packets and
+        // covers last WindowLength packets
+        const size_t end = (n + 1) * WindowLength / NumRepairPackets;
+        const size_t begin = end > WindowLength ? end - WindowLength : 0;
+
+        UNSIGNED_LONGS_EQUAL(packet::FEC_RLC, rp->fec()->fec_scheme);
+        UNSIGNED_LONGS_EQUAL(uint32_t(first_esi + begin),
+                             rp->fec()->encoding_symbol_id);
+        UNSIGNED_LONGS_EQUAL(end - begin, rp->fec()->source_block_length);
+        UNSIGNED_LONGS_EQUAL(FECPayloadSize, rp->fec()->payload.size());
+    }
+}
+
+TEST(window_writer_reader, one_loss) {
+    enum { NumPackets = 40, LostPacket = 11 };
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+    PacketLoser loser(dispatcher);
+
+    WindowWriter writer(writer_config, loser, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    loser.lose_source(LostPacket);
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        writer.write(make_packet(sn));
+    }
+    dispatcher.push_stocks();
+
+    UNSIGNED_LONGS_EQUAL(NumPackets - 1, dispatcher.source_size());
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        check_packet(reader.read(), sn, sn == LostPacket);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(window_writer_reader, multiple_losses) {
+    enum { NumPackets = 60 };
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+    PacketLoser loser(dispatcher);
+
+    WindowWriter writer(writer_config, loser, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    loser.lose_source(3);
+    loser.lose_source(7);
+    loser.lose_source(8);
+    loser.lose_source(15);
+    loser.lose_source(31);
+    loser.lose_source(40);
+    loser.lose_source(41);
+
+    loser.lose_repair(4);
+    loser.lose_repair(15);
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        writer.write(make_packet(sn));
+    }
+    dispatcher.push_stocks();
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        check_packet(reader.read(), sn,
+                     sn == 3 || sn == 7 || sn == 8 || sn == 15 || sn == 31 || sn == 40
+                         || sn == 41);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(window_writer_reader, burst_loss) {
+    enum {
+        NumPackets = 80,
+        BurstWindowLength = 30,
+        BurstRepairPackets = 15,
+        FirstLost = 20,
+        NumLost = 6
+    };
+
+    writer_config.n_source_packets = BurstWindowLength;
+    writer_config.n_repair_packets = BurstRepairPackets;
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+    PacketLoser loser(dispatcher);
+
+    WindowWriter writer(writer_config, loser, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    for (size_t sn = FirstLost; sn < FirstLost + NumLost; sn++) {
+        loser.lose_source(sn);
+    }
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        writer.write(make_packet(sn));
+    }
+    dispatcher.push_stocks();
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        check_packet(reader.read(), sn, sn >= FirstLost && sn < FirstLost + NumLost);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(window_writer_reader, too_many_losses) {
+    enum { NumPackets = 30 };
+
+    // one repair packet per window
+    writer_config.n_repair_packets = 1;
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+    PacketLoser loser(dispatcher);
+
+    WindowWriter writer(writer_config, loser, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    // restorable
+    loser.lose_source(5);
+
+    // not restorable, only one repair packet covers both
+    loser.lose_source(12);
+    loser.lose_source(13);
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        writer.write(make_packet(sn));
+    }
+    dispatcher.push_stocks();
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        if (sn == 12 || sn == 13) {
+            continue;
+        }
+        check_packet(reader.read(), sn, sn == 5);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(window_writer_reader, restore_before_window_end) {
+    enum { NumPackets = 40, LostPacket = 15 };
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+    PacketLoser loser(dispatcher);
+
+    WindowWriter writer(writer_config, loser, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    loser.lose_source(LostPacket);
+
+    size_t next_sn = 0;
+
+    // deliver every packet as soon as it's written, and read everything
+    // that is available; lost packet is restored by the first repair packet
+    // that follows it, before next source packet arrives
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        writer.write(make_packet(sn));
+        dispatcher.push_stocks();
+
+        for (;;) {
+            packet::PacketPtr pp = reader.read();
+            if (!pp) {
+                break;
+            }
+            check_packet(pp, next_sn, next_sn == LostPacket);
+            next_sn++;
+        }
+
+        if (sn == LostPacket) {
+            UNSIGNED_LONGS_EQUAL(LostPacket + 1, next_sn);
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, next_sn);
+}
+
+TEST(window_writer_reader, repair_before_source) {
+    enum { NumPackets = 40 };
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+    PacketLoser loser(dispatcher);
+
+    WindowWriter writer(writer_config, loser, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    loser.lose_source(4);
+    loser.lose_source(22);
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        writer.write(make_packet(sn));
+    }
+
+    dispatcher.push_repair_stock(dispatcher.repair_size());
+    CHECK(!reader.read());
+
+    dispatcher.push_source_stock(NumPackets - 2);
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        check_packet(reader.read(), sn, sn == 4 || sn == 22);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(window_writer_reader, payload_size_change) {
+    enum { NumPackets = 40, SizeChangePacket = 20 };
+
+    const size_t PayloadSize2 = FECPayloadSize + 50;
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+    PacketLoser loser(dispatcher);
+
+    WindowWriter writer(writer_config, loser, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    loser.lose_source(SizeChangePacket - 2);
+    loser.lose_source(SizeChangePacket + 1);
+    loser.lose_source(SizeChangePacket + 7);
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        writer.write(
+            make_packet(sn, sn < SizeChangePacket ? FECPayloadSize : PayloadSize2));
+    }
+    dispatcher.push_stocks();
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        check_packet(reader.read(), sn,
+                     sn == SizeChangePacket - 2 || sn == SizeChangePacket + 1
+                         || sn == SizeChangePacket + 7,
+                     sn < SizeChangePacket ? FECPayloadSize : PayloadSize2);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(window_writer_reader, resize) {
+    enum { NumPackets = 80, ResizePacket = 30 };
+
+    test::PacketDispatcher dispatcher(source_parser, repair_parser, packet_factory,
+                                      MaxPackets, 0);
+    PacketLoser loser(dispatcher);
+
+    WindowWriter writer(writer_config, loser, source_composer, repair_composer,
+                        packet_factory, buffer_factory, allocator);
+
+    WindowReader reader(dispatcher.source_reader(), dispatcher.repair_reader(),
+                        rtp_parser, packet_factory, buffer_factory, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    loser.lose_source(10);
+    loser.lose_source(ResizePacket + 2);
+    loser.lose_source(ResizePacket + 25);
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        if (sn == ResizePacket) {
+            CHECK(writer.resize(WindowLength * 3, NumRepairPackets));
+        }
+        writer.write(make_packet(sn));
+    }
+    dispatcher.push_stocks();
+
+    // 5 repair packets per 10 source packets, then per 30 source packets
+    UNSIGNED_LONGS_EQUAL(ResizePacket * NumRepairPackets / WindowLength
+                             + (NumPackets - ResizePacket) * NumRepairPackets
+                                 / (WindowLength * 3),
+                         loser.n_repair());
+
+    for (size_t sn = 0; sn < NumPackets; sn++) {
+        check_packet(reader.read(), sn,
+                     sn == 10 || sn == ResizePacket + 2 || sn == ResizePacket + 25);
+    }
+
+    CHECK(!reader.read());
+
+    CHECK(!writer.resize(0, 1));
+    CHECK(!writer.resize(WindowWriter::MaxWindowLength + 1, 1));
+}
+
+} // namespace fec
+} // namespace roc
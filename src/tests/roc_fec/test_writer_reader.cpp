@@ -14,6 +14,8 @@
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/time.h"
 #include "roc_fec/codec_map.h"
 #include "roc_fec/composer.h"
 #include "roc_fec/headers.h"
@@ -61,6 +63,97 @@ Composer<RS8M_PayloadID, Repair, Header> rs8m_repair_composer(NULL);
 Composer<LDPC_Source_PayloadID, Source, Footer> ldpc_source_composer(&rtp_composer);
 Composer<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_composer(NULL);
 
+class CountingDecoder : public IBlockDecoder {
+public:
+    CountingDecoder(IBlockDecoder& decoder)
+        : decoder_(decoder)
+        , n_begin_(0)
+        , n_repair_(0) {
+    }
+
+    virtual size_t max_block_length() const {
+        return decoder_.max_block_length();
+    }
+
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size) {
+        n_begin_++;
+        return decoder_.begin(sblen, rblen, payload_size);
+    }
+
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer) {
+        decoder_.set(index, buffer);
+    }
+
+    virtual core::Slice<uint8_t> repair(size_t index) {
+        n_repair_++;
+        return decoder_.repair(index);
+    }
+
+    virtual void end() {
+        decoder_.end();
+    }
+
+    size_t n_begin() const {
+        return n_begin_;
+    }
+
+    size_t n_repair() const {
+        return n_repair_;
+    }
+
+private:
+    IBlockDecoder& decoder_;
+
+    size_t n_begin_;
+    size_t n_repair_;
+};
+
+class GatedEncoder : public IBlockEncoder {
+public:
+    GatedEncoder(IBlockEncoder& encoder)
+        : encoder_(encoder) {
+    }
+
+    virtual size_t alignment() const {
+        return encoder_.alignment();
+    }
+
+    virtual size_t max_block_length() const {
+        return encoder_.max_block_length();
+    }
+
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size) {
+        return encoder_.begin(sblen, rblen, payload_size);
+    }
+
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer) {
+        encoder_.set(index, buffer);
+    }
+
+    virtual void fill() {
+        gate_.wait();
+        encoder_.fill();
+    }
+
+    virtual void end() {
+        encoder_.end();
+    }
+
+    void open() {
+        gate_.post();
+    }
+
+private:
+    IBlockEncoder& encoder_;
+    core::Semaphore gate_;
+};
+
+void wait_flushed(Writer& writer) {
+    while (!writer.flush()) {
+        core::sleep_for(core::ClockMonotonic, core::Millisecond);
+    }
+}
+
 } // namespace
 
 TEST_GROUP(writer_reader) {
@@ -849,15 +942,16 @@ TEST(writer_reader, repair_packets_before_source_packets) {
             packet::PacketPtr p = reader.read();
             CHECK(p);
 
-            // All packets should be restored.
+            // Only first packet should be restored, because reader repairs
+            // packets only when they're requested.
             check_audio_packet(p, rd_sn);
-            check_restored(p, true);
+            check_restored(p, i == 0);
 
             rd_sn++;
 
             if (i == 0) {
                 // Deliver source packets from second block.
-                // These packets should be dropped.
+                // These packets should be used instead of repairing.
                 dispatcher.push_stocks();
             }
         }
@@ -1053,6 +1147,238 @@ TEST(writer_reader, multiple_repair_attempts) {
     }
 }
 
+TEST(writer_reader, repair_only_requested_packets) {
+    // 1. Lose one packet and delay another one in the same block.
+    // 2. Read until the lost packet, it should be repaired.
+    // 3. Deliver the delayed packet before it's requested, it should be used
+    //    as is, without repairing, and the decoder block should be reused.
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_encoder(codec_config, buffer_factory, allocator),
+            allocator);
+
+        core::ScopedPtr<IBlockDecoder> decoder(
+            CodecMap::instance().new_decoder(codec_config, buffer_factory, allocator),
+            allocator);
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        CountingDecoder counting_decoder(*decoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        Writer writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                      source_composer(), repair_composer(), packet_factory,
+                      buffer_factory, allocator);
+
+        Reader reader(reader_config, codec_config.scheme, counting_decoder,
+                      dispatcher.source_reader(), dispatcher.repair_reader(), rtp_parser,
+                      packet_factory, allocator);
+
+        CHECK(writer.valid());
+        CHECK(reader.valid());
+
+        fill_all_packets(0);
+
+        dispatcher.lose(5);
+        dispatcher.delay(15);
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            writer.write(source_packets[i]);
+        }
+
+        dispatcher.push_stocks();
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            if (i == 15) {
+                dispatcher.push_delayed(15);
+            }
+
+            packet::PacketPtr p = reader.read();
+            CHECK(p);
+            check_audio_packet(p, i);
+            check_restored(p, i == 5);
+        }
+
+        UNSIGNED_LONGS_EQUAL(1, counting_decoder.n_begin());
+        UNSIGNED_LONGS_EQUAL(1, counting_decoder.n_repair());
+
+        LONGS_EQUAL(0, dispatcher.source_size());
+    }
+}
+
+TEST(writer_reader, async_encoding) {
+    enum { NumBlocks = 5 };
+
+    writer_config.async_encoding = true;
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_encoder(codec_config, buffer_factory, allocator),
+            allocator);
+
+        core::ScopedPtr<IBlockDecoder> decoder(
+            CodecMap::instance().new_decoder(codec_config, buffer_factory, allocator),
+            allocator);
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        Writer writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                      source_composer(), repair_composer(), packet_factory,
+                      buffer_factory, allocator);
+
+        Reader reader(reader_config, codec_config.scheme, *decoder,
+                      dispatcher.source_reader(), dispatcher.repair_reader(), rtp_parser,
+                      packet_factory, allocator);
+
+        CHECK(writer.valid());
+        CHECK(reader.valid());
+
+        dispatcher.lose(11);
+
+        for (size_t block_num = 0; block_num < NumBlocks; ++block_num) {
+            fill_all_packets(NumSourcePackets * block_num);
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                writer.write(source_packets[i]);
+            }
+
+            // source packets are written immediately
+            LONGS_EQUAL(NumSourcePackets - 1, dispatcher.source_size());
+
+            // repair packets are written when encoder thread is done
+            wait_flushed(writer);
+            LONGS_EQUAL(NumRepairPackets, dispatcher.repair_size());
+
+            dispatcher.push_stocks();
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                packet::PacketPtr p = reader.read();
+                CHECK(p);
+                check_audio_packet(p, NumSourcePackets * block_num + i);
+                check_restored(p, i == 11);
+            }
+        }
+
+        LONGS_EQUAL(NumBlocks, writer.metrics().n_encoded_blocks);
+        LONGS_EQUAL(0, writer.metrics().n_skipped_blocks);
+        CHECK(writer.metrics().max_encode_time >= writer.metrics().last_encode_time);
+    }
+}
+
+TEST(writer_reader, async_encoding_busy_encoder) {
+    // While encoder thread is busy with first block, next blocks are complete.
+    // Source packets should be written without waiting, and blocks should be
+    // queued to the encoder thread until the queue is full; repair packets
+    // of blocks that don't fit into the queue should be skipped.
+    enum { NumQueuedBlocks = 4, NumBlocks = NumQueuedBlocks + 1 };
+
+    writer_config.async_encoding = true;
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_encoder(codec_config, buffer_factory, allocator),
+            allocator);
+
+        CHECK(encoder);
+
+        GatedEncoder gated_encoder(*encoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        Writer writer(writer_config, codec_config.scheme, gated_encoder, dispatcher,
+                      source_composer(), repair_composer(), packet_factory,
+                      buffer_factory, allocator);
+
+        CHECK(writer.valid());
+
+        for (size_t block_num = 0; block_num < NumBlocks; ++block_num) {
+            fill_all_packets(NumSourcePackets * block_num);
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                writer.write(source_packets[i]);
+            }
+        }
+
+        LONGS_EQUAL(NumSourcePackets * NumBlocks, dispatcher.source_size());
+        LONGS_EQUAL(0, dispatcher.repair_size());
+
+        CHECK(!writer.flush());
+
+        for (size_t block_num = 0; block_num < NumQueuedBlocks; ++block_num) {
+            gated_encoder.open();
+        }
+        wait_flushed(writer);
+
+        LONGS_EQUAL(NumSourcePackets * NumBlocks, dispatcher.source_size());
+        LONGS_EQUAL(NumRepairPackets * NumQueuedBlocks, dispatcher.repair_size());
+
+        LONGS_EQUAL(NumQueuedBlocks, writer.metrics().n_encoded_blocks);
+        LONGS_EQUAL(1, writer.metrics().n_skipped_blocks);
+    }
+}
+
+TEST(writer_reader, async_encoding_drain) {
+    // Repair packets of queued blocks are written by drain(), without
+    // writing new source packets.
+    enum { NumBlocks = 3 };
+
+    writer_config.async_encoding = true;
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_encoder(codec_config, buffer_factory, allocator),
+            allocator);
+
+        CHECK(encoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        Writer writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                      source_composer(), repair_composer(), packet_factory,
+                      buffer_factory, allocator);
+
+        CHECK(writer.valid());
+
+        for (size_t block_num = 0; block_num < NumBlocks; ++block_num) {
+            fill_all_packets(NumSourcePackets * block_num);
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                writer.write(source_packets[i]);
+            }
+        }
+
+        writer.drain();
+        CHECK(writer.flush());
+
+        LONGS_EQUAL(NumSourcePackets * NumBlocks, dispatcher.source_size());
+        LONGS_EQUAL(NumRepairPackets * NumBlocks, dispatcher.repair_size());
+
+        LONGS_EQUAL(NumBlocks, writer.metrics().n_encoded_blocks);
+        LONGS_EQUAL(0, writer.metrics().n_skipped_blocks);
+    }
+}
+
 TEST(writer_reader, drop_outdated_block) {
     for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
         codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
@@ -2963,8 +3289,9 @@ TEST(writer_reader, reader_invalid_fec_scheme_source_packet) {
             packet::PacketPtr p = writer_queue.read();
             CHECK(p);
             CHECK((p->flags() & packet::Packet::FlagRepair) == 0);
-            p->fec()->fec_scheme = CodecMap::instance().nth_scheme(
-                (n_scheme + 1) % CodecMap::instance().num_schemes());
+            p->fec()->fec_scheme = codec_config.scheme == packet::FEC_ReedSolomon_M8
+                ? packet::FEC_LDPC_Staircase
+                : packet::FEC_ReedSolomon_M8;
             source_queue.write(p);
             UNSIGNED_LONGS_EQUAL(1, source_queue.size());
         }
@@ -3043,8 +3370,9 @@ TEST(writer_reader, reader_invalid_fec_scheme_repair_packet) {
             packet::PacketPtr p = writer_queue.read();
             CHECK(p);
             CHECK((p->flags() & packet::Packet::FlagRepair) != 0);
-            p->fec()->fec_scheme = CodecMap::instance().nth_scheme(
-                (n_scheme + 1) % CodecMap::instance().num_schemes());
+            p->fec()->fec_scheme = codec_config.scheme == packet::FEC_ReedSolomon_M8
+                ? packet::FEC_LDPC_Staircase
+                : packet::FEC_ReedSolomon_M8;
             repair_queue.write(p);
             UNSIGNED_LONGS_EQUAL(1, repair_queue.size());
         }
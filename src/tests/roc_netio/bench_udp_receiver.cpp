@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/time.h"
+#include "roc_netio/network_loop.h"
+#include "roc_netio/socket_ops.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+namespace {
+
+enum {
+    // Typical size of audio or repair packet.
+    PacketSize = 300,
+    // Number of simulated senders, each with its own source port.
+    NumSenders = 64,
+    // Packets sent by every sender per iteration.
+    BurstSize = 8,
+    MaxLoops = 4
+};
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, 2048, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+uint8_t payload[PacketSize];
+
+// Counts packets and drops them; called concurrently from all network threads.
+class CountingWriter : public packet::IWriter {
+public:
+    CountingWriter()
+        : count_(0) {
+    }
+
+    virtual void write(const packet::PacketPtr&) {
+        ++count_;
+    }
+
+    long count() const {
+        return count_;
+    }
+
+private:
+    core::Atomic<long> count_;
+};
+
+// Every iteration, each sender socket sends a burst of packets to the shared
+// address. Receivers are never paced, so packets that did not fit into socket
+// buffers while network threads were busy are reported as lost.
+void BM_UdpReceiverPortSharded(benchmark::State& state) {
+    const size_t n_loops = (size_t)state.range(0);
+    const size_t batch_size = (size_t)state.range(1);
+
+    CountingWriter writer;
+
+    UdpReceiverConfig config;
+    roc_panic_if(
+        !config.bind_address.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+    config.reuseport = true;
+    config.batch_size = batch_size;
+
+    core::ScopedPtr<NetworkLoop> loops[MaxLoops];
+    NetworkLoop::PortHandle ports[MaxLoops] = {};
+
+    for (size_t n = 0; n < n_loops; n++) {
+        loops[n].reset(new (allocator)
+                           NetworkLoop(packet_factory, buffer_factory, allocator),
+                       allocator);
+        roc_panic_if(!loops[n] || !loops[n]->valid());
+
+        // first port selects port number, others bind to the same one
+        NetworkLoop::Tasks::AddUdpReceiverPort task(config, writer);
+        roc_panic_if(!loops[n]->schedule_and_wait(task));
+        ports[n] = task.get_handle();
+    }
+
+    SocketHandle senders[NumSenders];
+    for (size_t n = 0; n < NumSenders; n++) {
+        address::SocketAddr addr;
+        roc_panic_if(!addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+        roc_panic_if(!socket_create(address::Family_IPv4, SocketType_Udp, senders[n]));
+        roc_panic_if(!socket_bind(senders[n], addr));
+    }
+
+    SocketDatagram datagrams[BurstSize];
+    for (size_t n = 0; n < BurstSize; n++) {
+        datagrams[n].buf = payload;
+        datagrams[n].size = sizeof(payload);
+        datagrams[n].address = config.bind_address;
+    }
+
+    long n_sent = 0;
+
+    while (state.KeepRunningBatch(NumSenders * BurstSize)) {
+        for (size_t n = 0; n < NumSenders; n++) {
+            const ssize_t ret =
+                socket_try_send_batch(senders[n], datagrams, BurstSize, false);
+            if (ret > 0) {
+                n_sent += (long)ret;
+            }
+        }
+    }
+
+    // let network threads drain socket buffers
+    core::sleep_for(core::ClockMonotonic, core::Millisecond * 100);
+
+    const long n_received = writer.count();
+
+    for (size_t n = 0; n < NumSenders; n++) {
+        socket_close(senders[n]);
+    }
+
+    for (size_t n = 0; n < n_loops; n++) {
+        NetworkLoop::Tasks::RemovePort task(ports[n]);
+        roc_panic_if(!loops[n]->schedule_and_wait(task));
+    }
+
+    state.counters["sent_per_sec"] =
+        benchmark::Counter(double(n_sent), benchmark::Counter::kIsRate);
+    state.counters["received_per_sec"] =
+        benchmark::Counter(double(n_received), benchmark::Counter::kIsRate);
+    state.counters["loss"] =
+        n_sent != 0 ? double(n_sent - n_received) / double(n_sent) : 0.;
+}
+
+void udp_receiver_port_args(benchmark::internal::Benchmark* b) {
+    std::vector<std::string> names;
+    names.push_back("loops");
+    names.push_back("batch");
+    b->ArgNames(names);
+
+    const int64_t loops[] = { 1, 2, 4 };
+    const int64_t batches[] = { 0, 32 };
+
+    for (size_t n_loop = 0; n_loop < ROC_ARRAY_SIZE(loops); n_loop++) {
+        for (size_t n_batch = 0; n_batch < ROC_ARRAY_SIZE(batches); n_batch++) {
+            b->ArgPair(loops[n_loop], batches[n_batch]);
+        }
+    }
+}
+
+BENCHMARK(BM_UdpReceiverPortSharded)
+    ->Apply(udp_receiver_port_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace netio
+} // namespace roc
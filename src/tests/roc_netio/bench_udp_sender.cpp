@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_netio/network_loop.h"
+#include "roc_netio/socket_ops.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+namespace {
+
+enum {
+    // Typical size of audio or repair packet.
+    PacketSize = 300,
+    // Packets written during one pipeline tick.
+    TickPackets = 32,
+    // Ticks per iteration of port benchmark.
+    NumTicks = 100,
+    MaxDestinations = 4
+};
+
+enum Mode { Mode_NonBlocking, Mode_Async, Mode_Batch, Mode_BatchGso };
+
+const char* mode_names[] = { "nonblocking", "async", "batch", "batch+gso" };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, PacketSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+// Sockets that are never read; kernel drops packets when their buffers are full.
+struct Sinks {
+    SocketHandle socks[MaxDestinations];
+    address::SocketAddr addrs[MaxDestinations];
+
+    Sinks() {
+        for (size_t n = 0; n < MaxDestinations; n++) {
+            roc_panic_if(!addrs[n].set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+            roc_panic_if(!socket_create(address::Family_IPv4, SocketType_Udp, socks[n]));
+            roc_panic_if(!socket_bind(socks[n], addrs[n]));
+        }
+    }
+
+    ~Sinks() {
+        for (size_t n = 0; n < MaxDestinations; n++) {
+            socket_close(socks[n]);
+        }
+    }
+};
+
+uint8_t payload[PacketSize];
+
+void set_counters(benchmark::State& state, size_t n_sent, size_t n_dropped) {
+    state.counters["packets_per_sec"] =
+        benchmark::Counter(double(n_sent), benchmark::Counter::kIsRate);
+    state.counters["dropped"] = double(n_dropped);
+}
+
+// One sendto() per packet.
+void BM_SocketSendTo(benchmark::State& state) {
+    const size_t n_dests = (size_t)state.range(0);
+
+    Sinks sinks;
+
+    address::SocketAddr bind_addr;
+    roc_panic_if(!bind_addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+
+    SocketHandle sock = SocketInvalid;
+    roc_panic_if(!socket_create(address::Family_IPv4, SocketType_Udp, sock));
+    roc_panic_if(!socket_bind(sock, bind_addr));
+
+    size_t n_sent = 0, n_dropped = 0;
+
+    while (state.KeepRunningBatch(TickPackets)) {
+        for (size_t n = 0; n < TickPackets; n++) {
+            if (socket_try_send_to(sock, payload, sizeof(payload),
+                                   sinks.addrs[n % n_dests])
+                > 0) {
+                n_sent++;
+            } else {
+                n_dropped++;
+            }
+        }
+    }
+
+    socket_close(sock);
+
+    set_counters(state, n_sent, n_dropped);
+}
+
+BENCHMARK(BM_SocketSendTo)
+    ->ArgName("dests")
+    ->Arg(1)
+    ->Arg(3)
+    ->MeasureProcessCPUTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// One sendmmsg() per tick, optionally with GSO.
+void BM_SocketSendBatch(benchmark::State& state) {
+    const size_t n_dests = (size_t)state.range(0);
+    const bool gso = state.range(1) != 0;
+
+    Sinks sinks;
+
+    address::SocketAddr bind_addr;
+    roc_panic_if(!bind_addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+
+    SocketHandle sock = SocketInvalid;
+    roc_panic_if(!socket_create(address::Family_IPv4, SocketType_Udp, sock));
+    roc_panic_if(!socket_bind(sock, bind_addr));
+
+    // packets for the same destination go in a row, like audio and repair
+    // packets of one block
+    SocketDatagram datagrams[TickPackets];
+    for (size_t n = 0; n < TickPackets; n++) {
+        datagrams[n].buf = payload;
+        datagrams[n].size = sizeof(payload);
+        datagrams[n].address = sinks.addrs[n * n_dests / TickPackets];
+    }
+
+    size_t n_sent = 0, n_dropped = 0;
+
+    while (state.KeepRunningBatch(TickPackets)) {
+        const ssize_t ret = socket_try_send_batch(sock, datagrams, TickPackets, gso);
+        if (ret > 0) {
+            n_sent += (size_t)ret;
+            n_dropped += TickPackets - (size_t)ret;
+        } else {
+            n_dropped += TickPackets;
+        }
+    }
+
+    socket_close(sock);
+
+    set_counters(state, n_sent, n_dropped);
+}
+
+void socket_send_batch_args(benchmark::internal::Benchmark* b) {
+    std::vector<std::string> names;
+    names.push_back("dests");
+    names.push_back("gso");
+    b->ArgNames(names);
+
+    const int64_t dests[] = { 1, 3 };
+
+    for (size_t n_dest = 0; n_dest < ROC_ARRAY_SIZE(dests); n_dest++) {
+        for (int64_t gso = 0; gso < 2; gso++) {
+            b->ArgPair(dests[n_dest], gso);
+        }
+    }
+}
+
+BENCHMARK(BM_SocketSendBatch)
+    ->Apply(socket_send_batch_args)
+    ->MeasureProcessCPUTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Every iteration adds sender port, writes NumTicks ticks of packets, and
+// removes port, which waits until all packets are sent. CPU time of both
+// pipeline (benchmark) and network threads is measured.
+void BM_UdpSenderPort(benchmark::State& state) {
+    const Mode mode = (Mode)state.range(0);
+    const size_t n_dests = (size_t)state.range(1);
+
+    Sinks sinks;
+
+    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    roc_panic_if(!net_loop.valid());
+
+    std::vector<packet::PacketPtr> packets;
+
+    for (size_t n = 0; n < NumTicks * TickPackets; n++) {
+        packet::PacketPtr pp = packet_factory.new_packet();
+        roc_panic_if(!pp);
+
+        core::Slice<uint8_t> buf = buffer_factory.new_buffer();
+        roc_panic_if(!buf);
+        buf.reslice(0, PacketSize);
+
+        pp->add_flags(packet::Packet::FlagUDP);
+        pp->udp()->dst_addr = sinks.addrs[(n % TickPackets) * n_dests / TickPackets];
+        pp->set_data(buf);
+
+        packets.push_back(pp);
+    }
+
+    UdpSenderConfig config;
+    roc_panic_if(
+        !config.bind_address.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+
+    config.non_blocking_enabled = (mode == Mode_NonBlocking);
+    config.batch_size = (mode == Mode_Batch || mode == Mode_BatchGso) ? TickPackets : 0;
+    config.gso_enabled = (mode == Mode_BatchGso);
+
+    while (state.KeepRunning()) {
+        NetworkLoop::Tasks::AddUdpSenderPort add_task(config);
+        roc_panic_if(!net_loop.schedule_and_wait(add_task));
+
+        packet::IWriter& writer = *add_task.get_writer();
+
+        for (size_t n = 0; n < packets.size(); n++) {
+            writer.write(packets[n]);
+        }
+
+        NetworkLoop::Tasks::RemovePort remove_task(add_task.get_handle());
+        roc_panic_if(!net_loop.schedule_and_wait(remove_task));
+    }
+
+    state.SetLabel(mode_names[mode]);
+    state.counters["packets_per_sec"] = benchmark::Counter(
+        double(state.iterations()) * packets.size(), benchmark::Counter::kIsRate);
+}
+
+void udp_sender_port_args(benchmark::internal::Benchmark* b) {
+    std::vector<std::string> names;
+    names.push_back("mode");
+    names.push_back("dests");
+    b->ArgNames(names);
+
+    const int64_t modes[] = { Mode_NonBlocking, Mode_Async, Mode_Batch, Mode_BatchGso };
+    const int64_t dests[] = { 1, 3 };
+
+    for (size_t n_mode = 0; n_mode < ROC_ARRAY_SIZE(modes); n_mode++) {
+        for (size_t n_dest = 0; n_dest < ROC_ARRAY_SIZE(dests); n_dest++) {
+            b->ArgPair(modes[n_mode], dests[n_dest]);
+        }
+    }
+}
+
+BENCHMARK(BM_UdpSenderPort)
+    ->Apply(udp_sender_port_args)
+    ->MeasureProcessCPUTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_netio/network_loop_pool.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum { MaxBufSize = 500, NumLoops = 3 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+NetworkLoop::PortHandle add_udp_sender(NetworkLoop& net_loop) {
+    UdpSenderConfig config;
+    CHECK(config.bind_address.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+
+    NetworkLoop::Tasks::AddUdpSenderPort task(config);
+    CHECK(net_loop.schedule_and_wait(task));
+    return task.get_handle();
+}
+
+void remove_port(NetworkLoop& net_loop, NetworkLoop::PortHandle handle) {
+    NetworkLoop::Tasks::RemovePort task(handle);
+    CHECK(net_loop.schedule_and_wait(task));
+}
+
+size_t loop_index(NetworkLoopPool& pool, NetworkLoop& loop) {
+    for (size_t n = 0; n < pool.num_loops(); n++) {
+        if (&pool.loop(n) == &loop) {
+            return n;
+        }
+    }
+    FAIL("loop not found in pool");
+    return 0;
+}
+
+} // namespace
+
+TEST_GROUP(loop_pool) {};
+
+TEST(loop_pool, init) {
+    NetworkLoopPool pool(NumLoops, NetworkLoopPolicy_RoundRobin, packet_factory,
+                         buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    UNSIGNED_LONGS_EQUAL(NumLoops, pool.num_loops());
+
+    for (size_t n = 0; n < NumLoops; n++) {
+        CHECK(pool.loop(n).valid());
+        UNSIGNED_LONGS_EQUAL(0, pool.loop(n).num_ports());
+    }
+}
+
+TEST(loop_pool, invalid_size) {
+    {
+        NetworkLoopPool pool(0, NetworkLoopPolicy_RoundRobin, packet_factory,
+                             buffer_factory, allocator);
+        CHECK(!pool.valid());
+    }
+    {
+        NetworkLoopPool pool(NetworkLoopPool::MaxLoops + 1, NetworkLoopPolicy_RoundRobin,
+                             packet_factory, buffer_factory, allocator);
+        CHECK(!pool.valid());
+    }
+}
+
+TEST(loop_pool, round_robin) {
+    NetworkLoopPool pool(NumLoops, NetworkLoopPolicy_RoundRobin, packet_factory,
+                         buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    for (size_t n = 0; n < NumLoops * 3; n++) {
+        UNSIGNED_LONGS_EQUAL(n % NumLoops, loop_index(pool, pool.select_loop()));
+    }
+}
+
+TEST(loop_pool, least_loaded) {
+    NetworkLoopPool pool(NumLoops, NetworkLoopPolicy_LeastLoaded, packet_factory,
+                         buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    NetworkLoop::PortHandle handles[NumLoops * 2] = {};
+    NetworkLoop* loops[NumLoops * 2] = {};
+
+    // every new port goes to loop with fewest ports
+    for (size_t n = 0; n < NumLoops * 2; n++) {
+        loops[n] = &pool.select_loop();
+        UNSIGNED_LONGS_EQUAL(n % NumLoops, loop_index(pool, *loops[n]));
+
+        handles[n] = add_udp_sender(*loops[n]);
+        CHECK(handles[n]);
+    }
+
+    for (size_t n = 0; n < NumLoops; n++) {
+        UNSIGNED_LONGS_EQUAL(2, pool.loop(n).num_ports());
+    }
+
+    // after removing port from second loop, it becomes least loaded
+    remove_port(*loops[1], handles[1]);
+    handles[1] = NULL;
+
+    UNSIGNED_LONGS_EQUAL(1, loop_index(pool, pool.select_loop()));
+    UNSIGNED_LONGS_EQUAL(1, loop_index(pool, pool.select_loop()));
+
+    for (size_t n = 0; n < NumLoops * 2; n++) {
+        if (handles[n]) {
+            remove_port(*loops[n], handles[n]);
+        }
+    }
+}
+
+TEST(loop_pool, stats) {
+    NetworkLoopPool pool(NumLoops, NetworkLoopPolicy_RoundRobin, packet_factory,
+                         buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    NetworkLoop::PortHandle handle = add_udp_sender(pool.loop(1));
+    CHECK(handle);
+
+    for (size_t n = 0; n < NumLoops; n++) {
+        NetworkLoopStats stats;
+        pool.get_stats(n, stats);
+
+        UNSIGNED_LONGS_EQUAL(n == 1 ? 1 : 0, stats.num_ports);
+        UNSIGNED_LONGS_EQUAL(0, stats.num_pending_tasks);
+
+        CHECK(stats.total_time > 0);
+        CHECK(stats.busy_time >= 0);
+        CHECK(stats.busy_time <= stats.total_time);
+    }
+
+    remove_port(pool.loop(1), handle);
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/align_ops.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_netio/recv_buffer_pool.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum { BufSize = 1024, SmallSize = 100, NumSlabs = 3 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, BufSize, true);
+
+uint8_t payload[BufSize];
+
+void init_payload() {
+    for (size_t n = 0; n < BufSize; n++) {
+        payload[n] = uint8_t(n * 13 + 7);
+    }
+}
+
+void check_slice(const core::Slice<uint8_t>& slice, size_t size) {
+    CHECK(slice);
+    UNSIGNED_LONGS_EQUAL(size, slice.size());
+    CHECK(memcmp(slice.data(), payload, size) == 0);
+}
+
+} // namespace
+
+TEST_GROUP(recv_buffer_pool) {
+    void setup() {
+        init_payload();
+    }
+};
+
+TEST(recv_buffer_pool, invalid) {
+    RecvBufferPool pool(buffer_factory, 0, allocator);
+    CHECK(!pool.valid());
+}
+
+TEST(recv_buffer_pool, pack_small) {
+    RecvBufferPool pool(buffer_factory, NumSlabs, allocator);
+    CHECK(pool.valid());
+
+    const size_t stride = core::AlignOps::align_max(SmallSize);
+    const size_t per_slab = BufSize / stride;
+
+    core::Slice<uint8_t> first = pool.copy(payload, SmallSize);
+    check_slice(first, SmallSize);
+
+    // small payloads share one slab
+    for (size_t n = 1; n < per_slab; n++) {
+        core::Slice<uint8_t> slice = pool.copy(payload, SmallSize);
+        check_slice(slice, SmallSize);
+
+        POINTERS_EQUAL(first.data() + n * stride, slice.data());
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, pool.num_hits());
+    UNSIGNED_LONGS_EQUAL(1, pool.num_misses());
+
+    // next payload doesn't fit and goes to a new slab
+    core::Slice<uint8_t> slice = pool.copy(payload, SmallSize);
+    check_slice(slice, SmallSize);
+
+    CHECK(slice.data() < first.data() || slice.data() >= first.data() + BufSize);
+
+    UNSIGNED_LONGS_EQUAL(0, pool.num_hits());
+    UNSIGNED_LONGS_EQUAL(2, pool.num_misses());
+}
+
+TEST(recv_buffer_pool, reuse_released) {
+    RecvBufferPool pool(buffer_factory, NumSlabs, allocator);
+    CHECK(pool.valid());
+
+    uint8_t* slab_data[NumSlabs] = {};
+
+    // fill every slab with one large payload and release it
+    for (size_t n = 0; n < NumSlabs; n++) {
+        core::Slice<uint8_t> slice = pool.copy(payload, BufSize);
+        check_slice(slice, BufSize);
+
+        slab_data[n] = slice.data();
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, pool.num_hits());
+    UNSIGNED_LONGS_EQUAL(NumSlabs, pool.num_misses());
+
+    // slabs are reused in ring order
+    for (size_t n = 0; n < NumSlabs * 2; n++) {
+        core::Slice<uint8_t> slice = pool.copy(payload, BufSize);
+        check_slice(slice, BufSize);
+
+        POINTERS_EQUAL(slab_data[n % NumSlabs], slice.data());
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumSlabs * 2, pool.num_hits());
+    UNSIGNED_LONGS_EQUAL(NumSlabs, pool.num_misses());
+}
+
+TEST(recv_buffer_pool, replace_used) {
+    RecvBufferPool pool(buffer_factory, NumSlabs, allocator);
+    CHECK(pool.valid());
+
+    core::Slice<uint8_t> held[NumSlabs];
+
+    for (size_t n = 0; n < NumSlabs; n++) {
+        held[n] = pool.copy(payload, BufSize);
+        check_slice(held[n], BufSize);
+    }
+
+    // all slabs are still used by packets, so new ones are allocated
+    for (size_t n = 0; n < NumSlabs; n++) {
+        core::Slice<uint8_t> slice = pool.copy(payload, BufSize);
+        check_slice(slice, BufSize);
+
+        CHECK(slice.data() != held[n].data());
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, pool.num_hits());
+    UNSIGNED_LONGS_EQUAL(NumSlabs * 2, pool.num_misses());
+
+    // data of replaced slabs is not touched
+    for (size_t n = 0; n < NumSlabs; n++) {
+        check_slice(held[n], BufSize);
+    }
+}
+
+TEST(recv_buffer_pool, too_large) {
+    RecvBufferPool pool(buffer_factory, NumSlabs, allocator);
+    CHECK(pool.valid());
+
+    uint8_t large[BufSize + 1] = {};
+
+    core::Slice<uint8_t> slice = pool.copy(large, sizeof(large));
+    CHECK(!slice);
+
+    UNSIGNED_LONGS_EQUAL(0, pool.num_hits());
+    UNSIGNED_LONGS_EQUAL(0, pool.num_misses());
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_netio/socket_ops.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum { SmallSize = 50, LargeSize = 200, BufSize = 100 };
+
+void fill_buffer(uint8_t* buf, size_t bufsz, uint8_t value) {
+    for (size_t n = 0; n < bufsz; n++) {
+        buf[n] = uint8_t(value + n);
+    }
+}
+
+void check_buffer(const uint8_t* buf, size_t bufsz, uint8_t value) {
+    for (size_t n = 0; n < bufsz; n++) {
+        UNSIGNED_LONGS_EQUAL(uint8_t(value + n), buf[n]);
+    }
+}
+
+SocketHandle new_udp_socket(address::SocketAddr& addr) {
+    CHECK(addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+
+    SocketHandle sock = SocketInvalid;
+    CHECK(socket_create(addr.family(), SocketType_Udp, sock));
+    CHECK(socket_bind(sock, addr));
+
+    return sock;
+}
+
+void send_datagram(SocketHandle sock,
+                   const address::SocketAddr& dst_addr,
+                   size_t size,
+                   uint8_t value) {
+    uint8_t buf[LargeSize];
+    CHECK(size <= sizeof(buf));
+    fill_buffer(buf, size, value);
+
+    LONGS_EQUAL((long)size, (long)socket_try_send_to(sock, buf, size, dst_addr));
+}
+
+} // namespace
+
+TEST_GROUP(socket_ops) {};
+
+TEST(socket_ops, recv_batch_empty) {
+    address::SocketAddr rx_addr;
+    SocketHandle rx_sock = new_udp_socket(rx_addr);
+
+    uint8_t buf[BufSize];
+
+    SocketDatagram dgm;
+    dgm.buf = buf;
+    dgm.bufsz = sizeof(buf);
+
+    LONGS_EQUAL(IOErr_WouldBlock, socket_try_recv_batch(rx_sock, &dgm, 1));
+
+    CHECK(socket_close(rx_sock));
+}
+
+TEST(socket_ops, recv_batch_truncated) {
+    address::SocketAddr tx_addr;
+    SocketHandle tx_sock = new_udp_socket(tx_addr);
+
+    address::SocketAddr rx_addr;
+    SocketHandle rx_sock = new_udp_socket(rx_addr);
+
+    // datagrams larger than receive buffer are truncated,
+    // but don't affect subsequent datagrams
+    const size_t sizes[] = { SmallSize, LargeSize, BufSize, LargeSize, SmallSize };
+    enum { NumDatagrams = ROC_ARRAY_SIZE(sizes) };
+
+    for (size_t n = 0; n < NumDatagrams; n++) {
+        send_datagram(tx_sock, rx_addr, sizes[n], uint8_t(n));
+    }
+
+    uint8_t bufs[NumDatagrams][BufSize];
+    SocketDatagram dgms[NumDatagrams];
+
+    for (size_t n = 0; n < NumDatagrams; n++) {
+        dgms[n].buf = bufs[n];
+        dgms[n].bufsz = sizeof(bufs[n]);
+    }
+
+    // loopback delivers datagrams immediately, but they may be returned in
+    // several batches
+    size_t n_recv = 0;
+    while (n_recv < NumDatagrams) {
+        const ssize_t ret =
+            socket_try_recv_batch(rx_sock, dgms + n_recv, NumDatagrams - n_recv);
+        CHECK(ret > 0);
+        n_recv += (size_t)ret;
+    }
+
+    for (size_t n = 0; n < NumDatagrams; n++) {
+        if (sizes[n] > BufSize) {
+            CHECK(dgms[n].truncated);
+            UNSIGNED_LONGS_EQUAL(BufSize, dgms[n].size);
+        } else {
+            CHECK(!dgms[n].truncated);
+            UNSIGNED_LONGS_EQUAL(sizes[n], dgms[n].size);
+        }
+
+        check_buffer(bufs[n], dgms[n].size, uint8_t(n));
+        CHECK(dgms[n].address == tx_addr);
+    }
+
+    LONGS_EQUAL(IOErr_WouldBlock, socket_try_recv_batch(rx_sock, dgms, NumDatagrams));
+
+    CHECK(socket_close(tx_sock));
+    CHECK(socket_close(rx_sock));
+}
+
+} // namespace netio
+} // namespace roc
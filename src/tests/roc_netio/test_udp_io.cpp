@@ -9,6 +9,7 @@
 #include <CppUTest/TestHarness.h>
 
 #include "roc_address/socket_addr.h"
+#include "roc_core/atomic.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_netio/network_loop.h"
@@ -102,6 +103,39 @@ void check_packet(const packet::PacketPtr& pp,
     CHECK(memcmp(pp->data().data(), expected.data(), expected.size()) == 0);
 }
 
+// Counts how packets are passed to writer.
+class CountingWriter : public packet::IWriter {
+public:
+    explicit CountingWriter(packet::IWriter& writer)
+        : writer_(writer)
+        , n_writes_(0)
+        , n_batches_(0) {
+    }
+
+    int num_writes() const {
+        return n_writes_;
+    }
+
+    int num_batches() const {
+        return n_batches_;
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        n_writes_++;
+        writer_.write(pp);
+    }
+
+    virtual void write_batch(const packet::PacketPtr* packets, size_t n_packets) {
+        n_batches_++;
+        writer_.write_batch(packets, n_packets);
+    }
+
+private:
+    packet::IWriter& writer_;
+    core::Atomic<int> n_writes_;
+    core::Atomic<int> n_batches_;
+};
+
 } // namespace
 
 TEST_GROUP(udp_io) {};
@@ -185,6 +219,207 @@ TEST(udp_io, one_sender_one_receiver_separate_loops) {
     }
 }
 
+TEST(udp_io, one_sender_one_receiver_batched) {
+    enum { BatchSize = 4 };
+
+    packet::ConcurrentQueue rx_queue;
+
+    UdpSenderConfig tx_config = make_sender_config();
+    UdpReceiverConfig rx_config = make_receiver_config();
+
+    rx_config.batch_size = BatchSize;
+
+    NetworkLoop tx_loop(packet_factory, buffer_factory, allocator);
+    CHECK(tx_loop.valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    NetworkLoop rx_loop(packet_factory, buffer_factory, allocator);
+    CHECK(rx_loop.valid());
+    CHECK(add_udp_receiver(rx_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer->write(new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config, rx_config, p);
+        }
+    }
+}
+
+TEST(udp_io, one_sender_one_receiver_batched_write) {
+    enum { BatchSize = 4 };
+
+    packet::ConcurrentQueue rx_queue;
+    CountingWriter rx_writer(rx_queue);
+
+    UdpSenderConfig tx_config = make_sender_config();
+    UdpReceiverConfig rx_config = make_receiver_config();
+
+    rx_config.batch_size = BatchSize;
+
+    NetworkLoop tx_loop(packet_factory, buffer_factory, allocator);
+    CHECK(tx_loop.valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    NetworkLoop rx_loop(packet_factory, buffer_factory, allocator);
+    CHECK(rx_loop.valid());
+    CHECK(add_udp_receiver(rx_loop, rx_config, rx_writer));
+
+    for (int p = 0; p < NumPackets; p++) {
+        tx_writer->write(new_packet(tx_config, rx_config, p));
+    }
+    for (int p = 0; p < NumPackets; p++) {
+        check_packet(rx_queue.read(), tx_config, rx_config, p);
+    }
+
+    // datagrams read by one system call are passed to writer at once
+    LONGS_EQUAL(0, rx_writer.num_writes());
+    CHECK(rx_writer.num_batches() > 0);
+    CHECK(rx_writer.num_batches() <= NumPackets);
+}
+
+TEST(udp_io, one_sender_one_receiver_batched_send) {
+    enum { BatchSize = 4 };
+
+    for (int gso = 0; gso <= 1; gso++) {
+        packet::ConcurrentQueue rx_queue;
+
+        UdpSenderConfig tx_config = make_sender_config();
+        UdpReceiverConfig rx_config = make_receiver_config();
+
+        tx_config.batch_size = BatchSize;
+        tx_config.gso_enabled = gso;
+
+        NetworkLoop tx_loop(packet_factory, buffer_factory, allocator);
+        CHECK(tx_loop.valid());
+
+        packet::IWriter* tx_writer = NULL;
+        CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+        CHECK(tx_writer);
+
+        NetworkLoop rx_loop(packet_factory, buffer_factory, allocator);
+        CHECK(rx_loop.valid());
+        CHECK(add_udp_receiver(rx_loop, rx_config, rx_queue));
+
+        for (int i = 0; i < NumIterations; i++) {
+            for (int p = 0; p < NumPackets; p++) {
+                tx_writer->write(new_packet(tx_config, rx_config, p));
+            }
+            for (int p = 0; p < NumPackets; p++) {
+                check_packet(rx_queue.read(), tx_config, rx_config, p);
+            }
+        }
+    }
+}
+
+TEST(udp_io, one_sender_many_receivers_batched_send) {
+    enum { BatchSize = 8 };
+
+    packet::ConcurrentQueue rx_queue1;
+    packet::ConcurrentQueue rx_queue2;
+
+    UdpSenderConfig tx_config = make_sender_config();
+
+    tx_config.batch_size = BatchSize;
+    tx_config.gso_enabled = true;
+
+    UdpReceiverConfig rx_config1 = make_receiver_config();
+    UdpReceiverConfig rx_config2 = make_receiver_config();
+
+    rx_config2.batch_size = BatchSize;
+
+    NetworkLoop tx_loop(packet_factory, buffer_factory, allocator);
+    CHECK(tx_loop.valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    NetworkLoop rx_loop(packet_factory, buffer_factory, allocator);
+    CHECK(rx_loop.valid());
+    CHECK(add_udp_receiver(rx_loop, rx_config1, rx_queue1));
+    CHECK(add_udp_receiver(rx_loop, rx_config2, rx_queue2));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer->write(new_packet(tx_config, rx_config1, p * 10));
+            tx_writer->write(new_packet(tx_config, rx_config1, p * 10 + 1));
+            tx_writer->write(new_packet(tx_config, rx_config2, p * 20));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue1.read(), tx_config, rx_config1, p * 10);
+            check_packet(rx_queue1.read(), tx_config, rx_config1, p * 10 + 1);
+            check_packet(rx_queue2.read(), tx_config, rx_config2, p * 20);
+        }
+    }
+}
+
+TEST(udp_io, many_senders_reuseport_receivers) {
+    enum { NumSenders = 8, NumReceivers = 3 };
+
+    packet::ConcurrentQueue rx_queue;
+
+    UdpReceiverConfig rx_config = make_receiver_config();
+    rx_config.reuseport = true;
+
+    NetworkLoop tx_loop(packet_factory, buffer_factory, allocator);
+    CHECK(tx_loop.valid());
+
+    UdpSenderConfig tx_configs[NumSenders];
+    packet::IWriter* tx_writers[NumSenders] = {};
+
+    for (int s = 0; s < NumSenders; s++) {
+        tx_configs[s] = make_sender_config();
+        CHECK(add_udp_sender(tx_loop, tx_configs[s], &tx_writers[s]));
+        CHECK(tx_writers[s]);
+    }
+
+    NetworkLoop rx_loop1(packet_factory, buffer_factory, allocator);
+    NetworkLoop rx_loop2(packet_factory, buffer_factory, allocator);
+    NetworkLoop rx_loop3(packet_factory, buffer_factory, allocator);
+
+    NetworkLoop* rx_loops[NumReceivers] = { &rx_loop1, &rx_loop2, &rx_loop3 };
+
+    for (int r = 0; r < NumReceivers; r++) {
+        CHECK(rx_loops[r]->valid());
+        // first receiver selects port, others bind to the same port
+        CHECK(add_udp_receiver(*rx_loops[r], rx_config, rx_queue));
+    }
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int s = 0; s < NumSenders; s++) {
+            tx_writers[s]->write(new_packet(tx_configs[s], rx_config, s));
+        }
+
+        // order between senders is not preserved
+        bool received[NumSenders] = {};
+
+        for (int n = 0; n < NumSenders; n++) {
+            packet::PacketPtr pp = rx_queue.read();
+            CHECK(pp);
+
+            int s = 0;
+            for (; s < NumSenders; s++) {
+                if (pp->udp()->src_addr == tx_configs[s].bind_address) {
+                    break;
+                }
+            }
+            CHECK(s < NumSenders);
+            CHECK(!received[s]);
+            received[s] = true;
+
+            check_packet(pp, tx_configs[s], rx_config, s);
+        }
+    }
+}
+
 TEST(udp_io, one_sender_many_receivers) {
     packet::ConcurrentQueue rx_queue1;
     packet::ConcurrentQueue rx_queue2;
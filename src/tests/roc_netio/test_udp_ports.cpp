@@ -165,6 +165,79 @@ TEST(udp_ports, add_addrinuse) {
     UNSIGNED_LONGS_EQUAL(0, net_loop2.num_ports());
 }
 
+TEST(udp_ports, add_reuseport) {
+    packet::ConcurrentQueue queue;
+
+    NetworkLoop net_loop1(packet_factory, buffer_factory, allocator);
+    CHECK(net_loop1.valid());
+
+    NetworkLoop net_loop2(packet_factory, buffer_factory, allocator);
+    CHECK(net_loop2.valid());
+
+    UdpReceiverConfig rx_config1 = make_receiver_config("127.0.0.1", 0);
+    rx_config1.reuseport = true;
+
+    NetworkLoop::PortHandle rx_handle1 = add_udp_receiver(net_loop1, rx_config1, queue);
+    CHECK(rx_handle1);
+    CHECK(rx_config1.bind_address.port() != 0);
+
+    UdpReceiverConfig rx_config2 = rx_config1;
+
+    NetworkLoop::PortHandle rx_handle2 = add_udp_receiver(net_loop2, rx_config2, queue);
+    CHECK(rx_handle2);
+    CHECK(rx_config2.bind_address == rx_config1.bind_address);
+
+    UdpReceiverConfig rx_config3 = rx_config1;
+    rx_config3.reuseport = false;
+
+    CHECK(!add_udp_receiver(net_loop2, rx_config3, queue));
+
+    UNSIGNED_LONGS_EQUAL(1, net_loop1.num_ports());
+    UNSIGNED_LONGS_EQUAL(1, net_loop2.num_ports());
+
+    remove_port(net_loop1, rx_handle1);
+    remove_port(net_loop2, rx_handle2);
+}
+
+TEST(udp_ports, add_reuseport_exclusive) {
+    packet::ConcurrentQueue queue;
+
+    NetworkLoop net_loop1(packet_factory, buffer_factory, allocator);
+    CHECK(net_loop1.valid());
+
+    NetworkLoop net_loop2(packet_factory, buffer_factory, allocator);
+    CHECK(net_loop2.valid());
+
+    // first receiver selects port and checks that nobody else uses it
+    UdpReceiverConfig rx_config1 = make_receiver_config("127.0.0.1", 0);
+    rx_config1.reuseport = true;
+    rx_config1.reuseport_exclusive = true;
+
+    NetworkLoop::PortHandle rx_handle1 = add_udp_receiver(net_loop1, rx_config1, queue);
+    CHECK(rx_handle1);
+    CHECK(rx_config1.bind_address.port() != 0);
+
+    // other receivers may share address with it
+    UdpReceiverConfig rx_config2 = rx_config1;
+    rx_config2.reuseport_exclusive = false;
+
+    NetworkLoop::PortHandle rx_handle2 = add_udp_receiver(net_loop2, rx_config2, queue);
+    CHECK(rx_handle2);
+    CHECK(rx_config2.bind_address == rx_config1.bind_address);
+
+    // but exclusive receiver can't be added to already used address,
+    // even if all of them use SO_REUSEPORT
+    UdpReceiverConfig rx_config3 = rx_config1;
+
+    CHECK(!add_udp_receiver(net_loop2, rx_config3, queue));
+
+    UNSIGNED_LONGS_EQUAL(1, net_loop1.num_ports());
+    UNSIGNED_LONGS_EQUAL(1, net_loop2.num_ports());
+
+    remove_port(net_loop1, rx_handle1);
+    remove_port(net_loop2, rx_handle2);
+}
+
 TEST(udp_ports, add_broadcast_sender) {
     packet::ConcurrentQueue queue;
 
@@ -43,5 +43,29 @@ TEST(concurrent_queue, write_read) {
     CHECK(queue.read() == p2);
 }
 
+TEST(concurrent_queue, write_read_batch) {
+    enum { NumPackets = 5 };
+
+    ConcurrentQueue queue;
+
+    PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet();
+    }
+
+    queue.write_batch(packets, NumPackets);
+
+    PacketPtr batch[NumPackets];
+
+    UNSIGNED_LONGS_EQUAL(3, queue.read_batch(batch, 3));
+    CHECK(batch[0] == packets[0]);
+    CHECK(batch[1] == packets[1]);
+    CHECK(batch[2] == packets[2]);
+
+    UNSIGNED_LONGS_EQUAL(2, queue.read_batch(batch, NumPackets));
+    CHECK(batch[0] == packets[3]);
+    CHECK(batch[1] == packets[4]);
+}
+
 } // namespace packet
 } // namespace roc
@@ -101,6 +101,39 @@ TEST(delayed_reader, instant) {
     CHECK(!dr.read());
 }
 
+TEST(delayed_reader, read_batch) {
+    Queue queue;
+    DelayedReader dr(queue, NumSamples * (NumPackets - 1) * NsPerSample, SampleSpecs);
+
+    PacketPtr packets[NumPackets];
+    PacketPtr batch[NumPackets];
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        UNSIGNED_LONGS_EQUAL(0, dr.read_batch(batch, NumPackets));
+        packets[n] = new_packet(n);
+        queue.write(packets[n]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, dr.read_batch(batch, NumPackets));
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        CHECK(batch[n] == packets[n]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, dr.read_batch(batch, NumPackets));
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(NumPackets + n);
+        queue.write(packets[n]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, dr.read_batch(batch, NumPackets));
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        CHECK(batch[n] == packets[n]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, dr.read_batch(batch, NumPackets));
+}
+
 TEST(delayed_reader, trim) {
     Queue queue;
     DelayedReader dr(queue, NumSamples * (NumPackets - 1) * NsPerSample, SampleSpecs);
@@ -10,6 +10,7 @@
 
 #include "roc_core/array.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_packet/interleaver.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/queue.h"
@@ -112,5 +113,51 @@ TEST(interleaver, flush) {
     }
 }
 
+TEST(interleaver, resize) {
+    Queue queue;
+    Interleaver intrlvr(queue, allocator, 10);
+
+    CHECK(intrlvr.valid());
+
+    const size_t block_sizes[] = { 20, 30, 4, 17 };
+
+    seqnum_t sn = 0;
+
+    for (size_t nb = 0; nb < ROC_ARRAY_SIZE(block_sizes); nb++) {
+        // half of block is buffered and is flushed by resize
+        for (size_t n = 0; n < intrlvr.block_size() / 2; n++) {
+            intrlvr.write(new_packet(sn++));
+        }
+
+        CHECK(intrlvr.resize(block_sizes[nb]));
+        UNSIGNED_LONGS_EQUAL(block_sizes[nb], intrlvr.block_size());
+
+        UNSIGNED_LONGS_EQUAL(sn, queue.size());
+
+        // full blocks of new size are passed through
+        for (size_t n = 0; n < intrlvr.block_size() * 3; n++) {
+            intrlvr.write(new_packet(sn++));
+        }
+
+        UNSIGNED_LONGS_EQUAL(sn, queue.size());
+    }
+
+    core::Array<bool> packets_ctr(allocator);
+    CHECK(packets_ctr.resize(sn));
+
+    for (size_t i = 0; i < sn; i++) {
+        packets_ctr[i] = false;
+    }
+
+    for (size_t i = 0; i < sn; i++) {
+        PacketPtr p = queue.read();
+        CHECK(p);
+        CHECK(!packets_ctr[p->rtp()->seqnum]);
+        packets_ctr[p->rtp()->seqnum] = true;
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
 } // namespace packet
 } // namespace roc
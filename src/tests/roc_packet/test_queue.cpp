@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { NumPackets = 5 };
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+PacketPtr new_packet() {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+    return packet;
+}
+
+// Uses default batch implementations of IReader and IWriter.
+class ForwardingQueue : public IReader, public IWriter {
+public:
+    virtual PacketPtr read() {
+        return queue_.read();
+    }
+
+    virtual void write(const PacketPtr& packet) {
+        queue_.write(packet);
+    }
+
+private:
+    Queue queue_;
+};
+
+} // namespace
+
+TEST_GROUP(queue) {};
+
+TEST(queue, write_read) {
+    Queue queue;
+
+    PacketPtr p1 = new_packet();
+    PacketPtr p2 = new_packet();
+
+    queue.write(p1);
+    queue.write(p2);
+
+    UNSIGNED_LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+    CHECK(!queue.read());
+
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+}
+
+TEST(queue, write_read_batch) {
+    Queue queue;
+
+    PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet();
+    }
+
+    queue.write_batch(packets, NumPackets);
+    UNSIGNED_LONGS_EQUAL(NumPackets, queue.size());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        LONGS_EQUAL(2, packets[n]->getref());
+    }
+
+    PacketPtr batch[NumPackets];
+
+    UNSIGNED_LONGS_EQUAL(3, queue.read_batch(batch, 3));
+    UNSIGNED_LONGS_EQUAL(2, queue.read_batch(batch + 3, NumPackets));
+    UNSIGNED_LONGS_EQUAL(0, queue.read_batch(batch, NumPackets));
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        CHECK(batch[n] == packets[n]);
+        LONGS_EQUAL(2, packets[n]->getref());
+    }
+}
+
+TEST(queue, default_batch) {
+    ForwardingQueue queue;
+
+    PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet();
+    }
+
+    queue.write_batch(packets, NumPackets);
+
+    PacketPtr batch[NumPackets + 1];
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, queue.read_batch(batch, NumPackets + 1));
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        CHECK(batch[n] == packets[n]);
+    }
+    CHECK(!batch[NumPackets]);
+
+    UNSIGNED_LONGS_EQUAL(0, queue.read_batch(batch, NumPackets));
+}
+
+} // namespace packet
+} // namespace roc
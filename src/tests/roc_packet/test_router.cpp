@@ -156,5 +156,39 @@ TEST(router, different_routes_different_sources) {
     UNSIGNED_LONGS_EQUAL(1, queue_f.size());
 }
 
+TEST(router, write_batch) {
+    enum { NumPackets = 7 };
+
+    Router router(allocator);
+
+    Queue queue_a;
+    CHECK(router.add_route(queue_a, Packet::FlagAudio));
+
+    Queue queue_f;
+    CHECK(router.add_route(queue_f, Packet::FlagFEC));
+
+    PacketPtr packets[NumPackets] = {
+        new_packet(11, Packet::FlagAudio), new_packet(11, Packet::FlagAudio),
+        new_packet(11, Packet::FlagFEC),   new_packet(22, Packet::FlagAudio),
+        new_packet(11, Packet::FlagAudio), new_packet(11, Packet::FlagFEC),
+        new_packet(11, Packet::FlagFEC),
+    };
+
+    router.write_batch(packets, NumPackets);
+
+    // packet from unknown source is dropped
+    LONGS_EQUAL(1, packets[3]->getref());
+
+    CHECK(queue_a.read() == packets[0]);
+    CHECK(queue_a.read() == packets[1]);
+    CHECK(queue_a.read() == packets[4]);
+    CHECK(!queue_a.read());
+
+    CHECK(queue_f.read() == packets[2]);
+    CHECK(queue_f.read() == packets[5]);
+    CHECK(queue_f.read() == packets[6]);
+    CHECK(!queue_f.read());
+}
+
 } // namespace packet
 } // namespace roc
@@ -393,5 +393,75 @@ TEST(sorted_queue, latest) {
     CHECK(queue.latest() == p4);
 }
 
+TEST(sorted_queue, reordered_within_window) {
+    enum { NumPackets = 500, Step = 7 };
+
+    SortedQueue queue(0);
+
+    PacketPtr packets[NumPackets];
+
+    const seqnum_t first_sn = 65000; // wraps around
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(seqnum_t(first_sn + n));
+    }
+
+    // Step and NumPackets are coprime, so every packet is written once
+    for (size_t n = 0; n < NumPackets; n++) {
+        queue.write(packets[(n * Step) % NumPackets]);
+    }
+
+    // duplicates
+    for (size_t n = 0; n < NumPackets; n += 3) {
+        queue.write(new_packet(seqnum_t(first_sn + n)));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    CHECK(queue.head() == packets[0]);
+    CHECK(queue.tail() == packets[NumPackets - 1]);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read() == packets[n]);
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(sorted_queue, reordered_outside_window) {
+    SortedQueue queue(0);
+
+    PacketPtr p1 = new_packet(100);
+    PacketPtr p2 = new_packet(101);
+    PacketPtr p3 = new_packet(100 + SortedQueue::WindowSize);
+    PacketPtr p4 = new_packet(100 + SortedQueue::WindowSize * 2);
+    PacketPtr p5 = new_packet(102);
+
+    queue.write(p1);
+    queue.write(p4);
+    queue.write(p3);
+    queue.write(p2);
+    queue.write(p5);
+
+    // duplicates
+    queue.write(new_packet(100));
+    queue.write(new_packet(102));
+    queue.write(new_packet(100 + SortedQueue::WindowSize));
+
+    LONGS_EQUAL(5, queue.size());
+
+    CHECK(queue.head() == p1);
+    CHECK(queue.tail() == p4);
+    CHECK(queue.latest() == p4);
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+    CHECK(queue.read() == p5);
+    CHECK(queue.read() == p3);
+    CHECK(queue.read() == p4);
+
+    CHECK(!queue.read());
+}
+
 } // namespace packet
 } // namespace roc
@@ -50,5 +50,71 @@ TEST(context, reference_counting) {
     CHECK(!context.is_used());
 }
 
+TEST(context, network_loops) {
+    ContextConfig context_config;
+    context_config.num_network_loops = 3;
+
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    UNSIGNED_LONGS_EQUAL(3, context.num_network_loops());
+    UNSIGNED_LONGS_EQUAL(3, context.network_loops().num_loops());
+
+    CHECK(&context.network_loop() == &context.network_loop(0));
+    CHECK(&context.network_loop(0) != &context.network_loop(1));
+    CHECK(&context.network_loop(1) != &context.network_loop(2));
+}
+
+TEST(context, network_loop_stats) {
+    ContextConfig context_config;
+    context_config.num_network_loops = 2;
+
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    {
+        pipeline::SenderConfig sender_config;
+        Sender sender(context, sender_config);
+
+        address::EndpointUri uri(allocator);
+        CHECK(address::parse_endpoint_uri("rtp://127.0.0.1:123",
+                                          address::EndpointUri::Subset_Full, uri));
+
+        CHECK(sender.connect(0, address::Iface_AudioSource, uri));
+
+        size_t total_ports = 0;
+
+        for (size_t n = 0; n < context.num_network_loops(); n++) {
+            netio::NetworkLoopStats stats;
+            context.get_network_loop_stats(n, stats);
+
+            total_ports += stats.num_ports;
+
+            UNSIGNED_LONGS_EQUAL(0, stats.num_pending_tasks);
+            CHECK(stats.total_time > 0);
+            CHECK(stats.busy_time <= stats.total_time);
+        }
+
+        UNSIGNED_LONGS_EQUAL(1, total_ports);
+    }
+}
+
+TEST(context, invalid_network_loops) {
+    {
+        ContextConfig context_config;
+        context_config.num_network_loops = 0;
+
+        Context context(context_config, allocator);
+        CHECK(!context.valid());
+    }
+    {
+        ContextConfig context_config;
+        context_config.num_network_loops = Context::MaxNetworkLoops + 1;
+
+        Context context(context_config, allocator);
+        CHECK(!context.valid());
+    }
+}
+
 } // namespace peer
 } // namespace roc
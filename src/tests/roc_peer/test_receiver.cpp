@@ -97,6 +97,108 @@ TEST(receiver, bind_slots) {
     UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 0);
 }
 
+TEST(receiver, bind_no_sharding) {
+    enum { NumLoops = 3 };
+
+    context_config.num_network_loops = NumLoops;
+    context_config.network_loop_policy = netio::NetworkLoopPolicy_LeastLoaded;
+
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    {
+        Receiver receiver(context, receiver_config);
+        CHECK(receiver.valid());
+
+        // sharding is disabled by default, ports are distributed
+        // between loops according to policy
+        address::EndpointUri source_endp1(allocator);
+        parse_uri(source_endp1, "rtp://127.0.0.1:0");
+        CHECK(receiver.bind(0, address::Iface_AudioSource, source_endp1));
+
+        UNSIGNED_LONGS_EQUAL(1, context.network_loop(0).num_ports());
+        UNSIGNED_LONGS_EQUAL(0, context.network_loop(1).num_ports());
+        UNSIGNED_LONGS_EQUAL(0, context.network_loop(2).num_ports());
+
+        address::EndpointUri source_endp2(allocator);
+        parse_uri(source_endp2, "rtp://127.0.0.1:0");
+        CHECK(receiver.bind(1, address::Iface_AudioSource, source_endp2));
+
+        UNSIGNED_LONGS_EQUAL(1, context.network_loop(0).num_ports());
+        UNSIGNED_LONGS_EQUAL(1, context.network_loop(1).num_ports());
+        UNSIGNED_LONGS_EQUAL(0, context.network_loop(2).num_ports());
+    }
+
+    for (size_t n = 0; n < NumLoops; n++) {
+        UNSIGNED_LONGS_EQUAL(0, context.network_loop(n).num_ports());
+    }
+}
+
+TEST(receiver, bind_sharding) {
+    enum { NumLoops = 3 };
+
+    context_config.num_network_loops = NumLoops;
+    context_config.receiver_port_sharding = true;
+
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    {
+        Receiver receiver(context, receiver_config);
+        CHECK(receiver.valid());
+
+        address::EndpointUri source_endp(allocator);
+        parse_uri(source_endp, "rtp://127.0.0.1:0");
+
+        CHECK(receiver.bind(DefaultSlot, address::Iface_AudioSource, source_endp));
+        CHECK(source_endp.port() != 0);
+
+        // port is bound in every loop
+        for (size_t n = 0; n < NumLoops; n++) {
+            UNSIGNED_LONGS_EQUAL(1, context.network_loop(n).num_ports());
+        }
+
+        // address is owned by receiver and can't be shared by somebody else
+        Receiver receiver2(context, receiver_config);
+        CHECK(receiver2.valid());
+
+        CHECK(!receiver2.bind(DefaultSlot, address::Iface_AudioSource, source_endp));
+
+        for (size_t n = 0; n < NumLoops; n++) {
+            UNSIGNED_LONGS_EQUAL(1, context.network_loop(n).num_ports());
+        }
+    }
+
+    for (size_t n = 0; n < NumLoops; n++) {
+        UNSIGNED_LONGS_EQUAL(0, context.network_loop(n).num_ports());
+    }
+}
+
+TEST(receiver, bind_sharding_multicast) {
+    enum { NumLoops = 3 };
+
+    context_config.num_network_loops = NumLoops;
+    context_config.receiver_port_sharding = true;
+
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    {
+        Receiver receiver(context, receiver_config);
+        CHECK(receiver.valid());
+
+        address::EndpointUri source_endp(allocator);
+        parse_uri(source_endp, "rtp://224.0.0.1:0");
+
+        CHECK(receiver.bind(DefaultSlot, address::Iface_AudioSource, source_endp));
+
+        // multicast ports are not sharded
+        UNSIGNED_LONGS_EQUAL(1, context.network_loop(0).num_ports());
+        UNSIGNED_LONGS_EQUAL(0, context.network_loop(1).num_ports());
+        UNSIGNED_LONGS_EQUAL(0, context.network_loop(2).num_ports());
+    }
+}
+
 TEST(receiver, endpoints_no_fec) {
     Context context(context_config, allocator);
     CHECK(context.valid());
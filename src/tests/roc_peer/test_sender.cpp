@@ -8,8 +8,10 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_audio/frame.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_fec/codec_map.h"
+#include "roc_netio/socket_ops.h"
 #include "roc_peer/context.h"
 #include "roc_peer/sender.h"
 
@@ -26,6 +28,37 @@ void parse_uri(address::EndpointUri& uri, const char* str) {
     CHECK(address::parse_endpoint_uri(str, address::EndpointUri::Subset_Full, uri));
 }
 
+void parse_uri(address::EndpointUri& uri, const char* proto, int port) {
+    char str[64] = {};
+    snprintf(str, sizeof(str), "%s://127.0.0.1:%d", proto, port);
+    parse_uri(uri, str);
+}
+
+netio::SocketHandle new_recv_socket(address::SocketAddr& addr) {
+    CHECK(addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+
+    netio::SocketHandle sock = netio::SocketInvalid;
+    CHECK(netio::socket_create(addr.family(), netio::SocketType_Udp, sock));
+    CHECK(netio::socket_bind(sock, addr));
+
+    return sock;
+}
+
+size_t count_datagrams(netio::SocketHandle sock) {
+    uint8_t buf[2048];
+
+    netio::SocketDatagram dgm;
+    dgm.buf = buf;
+    dgm.bufsz = sizeof(buf);
+
+    size_t n_dgms = 0;
+    while (netio::socket_try_recv_batch(sock, &dgm, 1) == 1) {
+        n_dgms++;
+    }
+
+    return n_dgms;
+}
+
 } // namespace
 
 TEST_GROUP(sender) {
@@ -91,6 +124,38 @@ TEST(sender, connect_slots) {
     UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 0);
 }
 
+TEST(sender, connect_loop_pool) {
+    context_config.num_network_loops = 2;
+    context_config.network_loop_policy = netio::NetworkLoopPolicy_LeastLoaded;
+
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    UNSIGNED_LONGS_EQUAL(context.num_network_loops(), 2);
+
+    {
+        Sender sender(context, sender_config);
+        CHECK(sender.valid());
+
+        address::EndpointUri source_endp1(allocator);
+        parse_uri(source_endp1, "rtp://127.0.0.1:111");
+        CHECK(sender.connect(0, address::Iface_AudioSource, source_endp1));
+
+        UNSIGNED_LONGS_EQUAL(context.network_loop(0).num_ports(), 1);
+        UNSIGNED_LONGS_EQUAL(context.network_loop(1).num_ports(), 0);
+
+        address::EndpointUri source_endp2(allocator);
+        parse_uri(source_endp2, "rtp://127.0.0.1:222");
+        CHECK(sender.connect(1, address::Iface_AudioSource, source_endp2));
+
+        UNSIGNED_LONGS_EQUAL(context.network_loop(0).num_ports(), 1);
+        UNSIGNED_LONGS_EQUAL(context.network_loop(1).num_ports(), 1);
+    }
+
+    UNSIGNED_LONGS_EQUAL(context.network_loop(0).num_ports(), 0);
+    UNSIGNED_LONGS_EQUAL(context.network_loop(1).num_ports(), 0);
+}
+
 TEST(sender, endpoints_no_fec) {
     Context context(context_config, allocator);
     CHECK(context.valid());
@@ -364,5 +429,66 @@ TEST(sender, port_sharing) {
     UNSIGNED_LONGS_EQUAL(context.network_loop().num_ports(), 0);
 }
 
+TEST(sender, flush_on_close) {
+    enum {
+        NumBlocks = 3,
+        SourcePackets = 10,
+        RepairPackets = 5,
+        SamplesPerPacket = 441,
+        NumCh = 2
+    };
+
+    if (!fec::CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8)) {
+        return;
+    }
+
+    // packets of last block are buffered in encoder thread and interleaver
+    // and should be written before ports are closed
+    sender_config.fec_encoder.scheme = packet::FEC_ReedSolomon_M8;
+    sender_config.fec_writer.n_source_packets = SourcePackets;
+    sender_config.fec_writer.n_repair_packets = RepairPackets;
+    sender_config.fec_writer.async_encoding = true;
+    sender_config.interleaving = true;
+    sender_config.packet_length = SamplesPerPacket * core::Second
+        / (core::nanoseconds_t)sender_config.input_sample_spec.sample_rate();
+
+    address::SocketAddr source_addr;
+    netio::SocketHandle source_sock = new_recv_socket(source_addr);
+
+    address::SocketAddr repair_addr;
+    netio::SocketHandle repair_sock = new_recv_socket(repair_addr);
+
+    Context context(context_config, allocator);
+    CHECK(context.valid());
+
+    {
+        Sender sender(context, sender_config);
+        CHECK(sender.valid());
+
+        address::EndpointUri source_endp(allocator);
+        parse_uri(source_endp, "rtp+rs8m", source_addr.port());
+
+        address::EndpointUri repair_endp(allocator);
+        parse_uri(repair_endp, "rs8m", repair_addr.port());
+
+        CHECK(sender.connect(DefaultSlot, address::Iface_AudioSource, source_endp));
+        CHECK(sender.connect(DefaultSlot, address::Iface_AudioRepair, repair_endp));
+        CHECK(sender.is_ready());
+
+        audio::sample_t samples[SamplesPerPacket * NumCh] = {};
+
+        for (size_t n = 0; n < NumBlocks * SourcePackets; n++) {
+            audio::Frame frame(samples, SamplesPerPacket * NumCh);
+            sender.sink().write(frame);
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumBlocks * SourcePackets, count_datagrams(source_sock));
+    UNSIGNED_LONGS_EQUAL(NumBlocks * RepairPackets, count_datagrams(repair_sock));
+
+    CHECK(netio::socket_close(source_sock));
+    CHECK(netio::socket_close(repair_sock));
+}
+
 } // namespace peer
 } // namespace roc
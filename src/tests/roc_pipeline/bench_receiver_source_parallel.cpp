@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_audio/iframe_encoder.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/receiver_source.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// This benchmark measures how many receiver sessions can be processed in real
+// time depending on the number of session threads.
+//
+// Every iteration delivers one packet to every session and reads one frame
+// from receiver. The "sessions_rt" counter is the number of seconds of session
+// audio processed per second of wall time, i.e. how many sessions of this kind
+// the receiver could handle without falling behind.
+//
+// Resampling is enabled, so that every session does a noticeable amount of
+// work, as it happens with real senders.
+
+enum {
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumCh = 2,
+
+    FrameSamples = SampleRate / 100,
+    FrameSize = FrameSamples * NumCh,
+
+    LatencyFrames = 4,
+
+    MaxBufSize = 4096,
+    MaxSessions = 64
+};
+
+const core::nanoseconds_t FrameDuration = 10 * core::Millisecond;
+
+const rtp::PayloadType PayloadType = rtp::PayloadType_L16_Stereo;
+
+core::HeapAllocator allocator;
+core::BufferFactory<audio::sample_t> sample_buffer_factory(allocator, MaxBufSize, false);
+core::BufferFactory<uint8_t> byte_buffer_factory(allocator, MaxBufSize, false);
+packet::PacketFactory packet_factory(allocator, false);
+
+rtp::FormatMap format_map;
+rtp::Composer rtp_composer(NULL);
+
+class SessionSender {
+public:
+    SessionSender()
+        : writer_(NULL)
+        , seqnum_(0)
+        , timestamp_(0) {
+    }
+
+    void init(packet::IWriter& writer, int index) {
+        writer_ = &writer;
+
+        encoder_.reset(format_map.format(PayloadType)->new_encoder(allocator), allocator);
+        roc_panic_if(!encoder_);
+
+        if (!src_addr_.set_host_port(address::Family_IPv4, "127.0.0.1", 10000 + index)
+            || !dst_addr_.set_host_port(address::Family_IPv4, "127.0.0.1", 20000)) {
+            roc_panic("bench: can't set address");
+        }
+
+        source_ = packet::source_t(index + 1);
+
+        for (size_t n = 0; n < FrameSize; n++) {
+            samples_[n] = audio::sample_t(index + 1) * 0.001f * ((n % 7) - 3.0f);
+        }
+    }
+
+    void send_packet() {
+        // compose packet as sender would do
+        packet::PacketPtr pp = packet_factory.new_packet();
+        roc_panic_if(!pp);
+
+        core::Slice<uint8_t> bp = byte_buffer_factory.new_buffer();
+        roc_panic_if(!bp);
+
+        if (!rtp_composer.prepare(*pp, bp, encoder_->encoded_byte_count(FrameSamples))) {
+            roc_panic("bench: can't prepare packet");
+        }
+
+        pp->set_data(bp);
+
+        pp->rtp()->source = source_;
+        pp->rtp()->seqnum = seqnum_++;
+        pp->rtp()->timestamp = timestamp_;
+        pp->rtp()->payload_type = PayloadType;
+
+        timestamp_ += FrameSamples;
+
+        encoder_->begin(pp->rtp()->payload.data(), pp->rtp()->payload.size());
+        encoder_->write(samples_, FrameSamples);
+        encoder_->end();
+
+        if (!rtp_composer.compose(*pp)) {
+            roc_panic("bench: can't compose packet");
+        }
+
+        // deliver raw bytes as network thread would do
+        packet::PacketPtr rp = packet_factory.new_packet();
+        roc_panic_if(!rp);
+
+        rp->add_flags(packet::Packet::FlagUDP);
+
+        rp->udp()->src_addr = src_addr_;
+        rp->udp()->dst_addr = dst_addr_;
+
+        rp->set_data(pp->data());
+
+        writer_->write(rp);
+    }
+
+private:
+    packet::IWriter* writer_;
+
+    core::ScopedPtr<audio::IFrameEncoder> encoder_;
+
+    address::SocketAddr src_addr_;
+    address::SocketAddr dst_addr_;
+
+    packet::source_t source_;
+    packet::seqnum_t seqnum_;
+    packet::timestamp_t timestamp_;
+
+    audio::sample_t samples_[FrameSize];
+};
+
+void BM_ReceiverSource_Sessions(benchmark::State& state) {
+    const size_t num_sessions = (size_t)state.range(0);
+    const size_t num_threads = (size_t)state.range(1);
+
+    ReceiverConfig config;
+
+    config.common.output_sample_spec = audio::SampleSpec(SampleRate, ChMask);
+    config.common.internal_frame_length = FrameDuration;
+    config.common.resampling = true;
+    config.common.timing = false;
+    config.common.session_threads = num_threads;
+
+    config.default_session.target_latency = FrameDuration * LatencyFrames;
+    config.default_session.latency_monitor.min_latency = -core::Second;
+    config.default_session.latency_monitor.max_latency = +core::Second;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+    if (!receiver.valid()) {
+        state.SkipWithError("can't create receiver");
+        return;
+    }
+
+    ReceiverSlot* slot = receiver.create_slot();
+    roc_panic_if(!slot);
+
+    ReceiverEndpoint* endpoint =
+        slot->create_endpoint(address::Iface_AudioSource, address::Proto_RTP);
+    roc_panic_if(!endpoint);
+
+    SessionSender senders[MaxSessions];
+
+    for (size_t ns = 0; ns < num_sessions; ns++) {
+        senders[ns].init(endpoint->writer(), (int)ns);
+    }
+
+    audio::sample_t samples[FrameSize];
+
+    // prefill latency and let sessions start playback
+    for (size_t nf = 0; nf < LatencyFrames * 2; nf++) {
+        for (size_t ns = 0; ns < num_sessions; ns++) {
+            senders[ns].send_packet();
+        }
+        if (nf >= LatencyFrames) {
+            audio::Frame frame(samples, FrameSize);
+            receiver.read(frame);
+        }
+    }
+
+    while (state.KeepRunning()) {
+        for (size_t ns = 0; ns < num_sessions; ns++) {
+            senders[ns].send_packet();
+        }
+
+        audio::Frame frame(samples, FrameSize);
+        receiver.read(frame);
+    }
+
+    if (receiver.num_sessions() != num_sessions) {
+        state.SkipWithError("some sessions were terminated");
+        return;
+    }
+
+    state.counters["sessions_rt"] = benchmark::Counter(
+        double(num_sessions) * double(state.iterations()) * double(FrameDuration)
+            / double(core::Second),
+        benchmark::Counter::kIsRate);
+}
+
+void sessions_args(benchmark::internal::Benchmark* b) {
+    std::vector<std::string> names;
+    names.push_back("sessions");
+    names.push_back("threads");
+    b->ArgNames(names);
+
+    const int64_t sessions[] = { 1, 4, 16, 64 };
+    const int64_t threads[] = { 0, 1, 3, 7 };
+
+    for (size_t n_sess = 0; n_sess < ROC_ARRAY_SIZE(sessions); n_sess++) {
+        for (size_t n_thr = 0; n_thr < ROC_ARRAY_SIZE(threads); n_thr++) {
+            b->ArgPair(sessions[n_sess], threads[n_thr]);
+        }
+    }
+}
+
+BENCHMARK(BM_ReceiverSource_Sessions)
+    ->Apply(sessions_args)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/packet_writer.h"
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/receiver_session_pool.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum { MaxBufSize = 500, PoolSize = 3 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<audio::sample_t> sample_buffer_factory(allocator, MaxBufSize, true);
+core::BufferFactory<uint8_t> byte_buffer_factory(allocator, MaxBufSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+rtp::FormatMap format_map;
+
+void wait_ready(ReceiverSessionPool& pool, size_t num_ready) {
+    while (pool.num_ready() != num_ready) {
+        core::sleep_for(core::ClockMonotonic, core::Microsecond * 100);
+    }
+}
+
+void wait_retired(ReceiverSessionPool& pool, size_t num_retired) {
+    while (pool.num_retired() != num_retired) {
+        core::sleep_for(core::ClockMonotonic, core::Microsecond * 100);
+    }
+}
+
+// take() doesn't wait for background thread, so it may fail while
+// pool is being refilled
+core::SharedPtr<ReceiverSession> take_session(ReceiverSessionPool& pool,
+                                              const ReceiverSessionConfig& config,
+                                              const address::SocketAddr& addr) {
+    for (;;) {
+        core::SharedPtr<ReceiverSession> sess = pool.take(config, addr);
+        if (sess) {
+            return sess;
+        }
+        core::sleep_for(core::ClockMonotonic, core::Microsecond * 100);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(receiver_session_pool) {
+    ReceiverConfig config;
+
+    void setup() {
+        config.common.resampling = false;
+        config.common.timing = false;
+    }
+};
+
+TEST(receiver_session_pool, disabled) {
+    config.default_session.payload_type = rtp::PayloadType_L16_Stereo;
+
+    ReceiverSessionPool pool(0, config, format_map, packet_factory,
+                             byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    UNSIGNED_LONGS_EQUAL(0, pool.num_ready());
+    CHECK(!pool.take(config.default_session, test::new_address(1)));
+
+    core::SharedPtr<ReceiverSession> sess = new (allocator) ReceiverSession(
+        config.default_session, config.common, test::new_address(1), format_map,
+        packet_factory, byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(sess->valid());
+
+    // disabled pool doesn't keep sessions
+    pool.release(sess);
+    UNSIGNED_LONGS_EQUAL(0, pool.num_retired());
+}
+
+TEST(receiver_session_pool, take) {
+    config.default_session.payload_type = rtp::PayloadType_L16_Stereo;
+
+    ReceiverSessionPool pool(PoolSize, config, format_map, packet_factory,
+                             byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    wait_ready(pool, PoolSize);
+
+    for (int n = 0; n < PoolSize * 2; n++) {
+        const address::SocketAddr addr = test::new_address(n + 1);
+
+        core::SharedPtr<ReceiverSession> sess =
+            take_session(pool, config.default_session, addr);
+        CHECK(sess->valid());
+        CHECK(sess->src_address() == addr);
+
+        // taken session is replaced in background
+        wait_ready(pool, PoolSize);
+    }
+}
+
+TEST(receiver_session_pool, release) {
+    config.default_session.payload_type = rtp::PayloadType_L16_Stereo;
+
+    ReceiverSessionPool pool(PoolSize, config, format_map, packet_factory,
+                             byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    wait_ready(pool, PoolSize);
+
+    for (int n = 0; n < PoolSize * 2; n++) {
+        core::SharedPtr<ReceiverSession> sess =
+            take_session(pool, config.default_session, test::new_address(n + 1));
+
+        wait_ready(pool, PoolSize);
+
+        // pool doesn't destroy session while we still hold a reference
+        pool.release(sess);
+        sess = NULL;
+
+        // and then destroyed in background
+        wait_retired(pool, 0);
+    }
+
+    UNSIGNED_LONGS_EQUAL(PoolSize, pool.num_ready());
+}
+
+TEST(receiver_session_pool, learn_encoding) {
+    // payload type is not known in advance
+    ReceiverSessionPool pool(PoolSize, config, format_map, packet_factory,
+                             byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    UNSIGNED_LONGS_EQUAL(0, pool.num_ready());
+
+    ReceiverSessionConfig sess_config = config.default_session;
+    sess_config.payload_type = rtp::PayloadType_L16_Stereo;
+
+    // first request only tells pool what to prepare
+    CHECK(!pool.take(sess_config, test::new_address(1)));
+
+    wait_ready(pool, PoolSize);
+
+    CHECK(take_session(pool, sess_config, test::new_address(1)));
+}
+
+TEST(receiver_session_pool, prepare) {
+    // payload type is not known in advance
+    ReceiverSessionPool pool(PoolSize, config, format_map, packet_factory,
+                             byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    // endpoint is bound, sessions are prepared before first packet
+    pool.prepare(packet::FEC_ReedSolomon_M8);
+
+    wait_ready(pool, PoolSize);
+
+    // payload type is guessed from output channels
+    ReceiverSessionConfig sess_config = config.default_session;
+    sess_config.payload_type = rtp::PayloadType_L16_Stereo;
+    sess_config.fec_decoder.scheme = packet::FEC_ReedSolomon_M8;
+
+    CHECK(take_session(pool, sess_config, test::new_address(1)));
+}
+
+TEST(receiver_session_pool, prepare_mono) {
+    config.common.output_sample_spec =
+        audio::SampleSpec(DefaultSampleRate, packet::channel_mask_t(0x1));
+
+    ReceiverSessionPool pool(PoolSize, config, format_map, packet_factory,
+                             byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    pool.prepare(packet::FEC_None);
+
+    wait_ready(pool, PoolSize);
+
+    ReceiverSessionConfig sess_config = config.default_session;
+    sess_config.payload_type = rtp::PayloadType_L16_Mono;
+
+    CHECK(take_session(pool, sess_config, test::new_address(1)));
+}
+
+TEST(receiver_session_pool, switch_encoding) {
+    config.default_session.payload_type = rtp::PayloadType_L16_Stereo;
+
+    ReceiverSessionPool pool(PoolSize, config, format_map, packet_factory,
+                             byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(pool.valid());
+
+    wait_ready(pool, PoolSize);
+
+    ReceiverSessionConfig sess_config = config.default_session;
+    sess_config.payload_type = rtp::PayloadType_L16_Mono;
+
+    // prepared sessions don't match, so they're dropped and rebuilt
+    CHECK(!pool.take(sess_config, test::new_address(1)));
+    CHECK(take_session(pool, sess_config, test::new_address(1)));
+
+    // and back
+    CHECK(!pool.take(config.default_session, test::new_address(2)));
+    CHECK(take_session(pool, config.default_session, test::new_address(2)));
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -14,6 +14,7 @@
 #include "roc_core/atomic.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
 #include "roc_core/time.h"
 #include "roc_fec/codec_map.h"
 #include "roc_packet/packet_factory.h"
@@ -75,6 +76,37 @@ create_endpoint(ReceiverSlot* slot, address::Interface iface, address::Protocol
     return &endpoint->writer();
 }
 
+// Collects packets and passes them to another writer as a batch,
+// like network thread does with datagrams received by one system call.
+class BatchWriter : public packet::IWriter {
+public:
+    enum { MaxPackets = 64 };
+
+    explicit BatchWriter(packet::IWriter& writer)
+        : writer_(writer)
+        , n_packets_(0) {
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        CHECK(n_packets_ < MaxPackets);
+        packets_[n_packets_++] = pp;
+    }
+
+    void flush() {
+        writer_.write_batch(packets_, n_packets_);
+
+        for (size_t n = 0; n < n_packets_; n++) {
+            packets_[n] = NULL;
+        }
+        n_packets_ = 0;
+    }
+
+private:
+    packet::IWriter& writer_;
+    packet::PacketPtr packets_[MaxPackets];
+    size_t n_packets_;
+};
+
 } // namespace
 
 TEST_GROUP(receiver_source) {
@@ -392,6 +424,53 @@ TEST(receiver_source, two_sessions_synchronous) {
     }
 }
 
+TEST(receiver_source, two_sessions_batched) {
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    BatchWriter batch_writer(*endpoint1_writer);
+
+    test::PacketWriter packet_writer1(allocator, batch_writer, rtp_composer, format_map,
+                                      packet_factory, byte_buffer_factory, PayloadType,
+                                      src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, batch_writer, rtp_composer, format_map,
+                                      packet_factory, byte_buffer_factory, PayloadType,
+                                      src2, dst1);
+
+    // every batch has runs of packets from both senders
+    packet_writer1.write_packets(Latency / SamplesPerPacket / 2, SamplesPerPacket,
+                                 SampleSpecs);
+    packet_writer2.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                 SampleSpecs);
+    packet_writer1.write_packets(Latency / SamplesPerPacket / 2, SamplesPerPacket,
+                                 SampleSpecs);
+    batch_writer.flush();
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 2);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+        batch_writer.flush();
+    }
+}
+
 TEST(receiver_source, two_sessions_overlapping) {
     ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
                             sample_buffer_factory, allocator);
@@ -583,6 +662,159 @@ TEST(receiver_source, two_sessions_same_address_different_streams) {
     }
 }
 
+TEST(receiver_source, many_sessions) {
+    enum { NumSessions = 4 };
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    core::ScopedPtr<test::PacketWriter> packet_writers[NumSessions];
+
+    for (size_t ns = 0; ns < NumSessions; ns++) {
+        packet_writers[ns].reset(
+            new (allocator) test::PacketWriter(
+                allocator, *endpoint_writer, rtp_composer, format_map, packet_factory,
+                byte_buffer_factory, PayloadType, test::new_address(int(100 + ns)), dst1),
+            allocator);
+
+        packet_writers[ns]->set_source(packet::source_t(100 + ns));
+    }
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        for (size_t ns = 0; ns < NumSessions; ns++) {
+            packet_writers[ns]->write_packets(1, SamplesPerPacket, SampleSpecs);
+        }
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, NumSessions);
+
+            UNSIGNED_LONGS_EQUAL(NumSessions, receiver.num_sessions());
+        }
+
+        for (size_t ns = 0; ns < NumSessions; ns++) {
+            packet_writers[ns]->write_packets(1, SamplesPerPacket, SampleSpecs);
+        }
+    }
+}
+
+TEST(receiver_source, session_pool) {
+    enum { NumSessions = 4, PoolSize = 2 };
+
+    config.common.session_pool_size = PoolSize;
+    config.default_session.payload_type = PayloadType;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    core::ScopedPtr<test::PacketWriter> packet_writers[NumSessions];
+
+    for (size_t ns = 0; ns < NumSessions; ns++) {
+        packet_writers[ns].reset(
+            new (allocator) test::PacketWriter(
+                allocator, *endpoint_writer, rtp_composer, format_map, packet_factory,
+                byte_buffer_factory, PayloadType, test::new_address(int(100 + ns)), dst1),
+            allocator);
+
+        packet_writers[ns]->set_source(packet::source_t(100 + ns));
+    }
+
+    // more sessions than pool size, so some of them may be taken from pool,
+    // and others are built on the fly, but all of them should work the same
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        for (size_t ns = 0; ns < NumSessions; ns++) {
+            packet_writers[ns]->write_packets(1, SamplesPerPacket, SampleSpecs);
+        }
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, NumSessions);
+
+            UNSIGNED_LONGS_EQUAL(NumSessions, receiver.num_sessions());
+        }
+
+        for (size_t ns = 0; ns < NumSessions; ns++) {
+            packet_writers[ns]->write_packets(1, SamplesPerPacket, SampleSpecs);
+        }
+    }
+}
+
+TEST(receiver_source, session_threads) {
+    enum { NumSessions = 4, NumThreads = 2 };
+
+    config.common.session_threads = NumThreads;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    core::ScopedPtr<test::PacketWriter> packet_writers[NumSessions];
+
+    for (size_t ns = 0; ns < NumSessions; ns++) {
+        packet_writers[ns].reset(
+            new (allocator) test::PacketWriter(
+                allocator, *endpoint_writer, rtp_composer, format_map, packet_factory,
+                byte_buffer_factory, PayloadType, test::new_address(int(100 + ns)), dst1),
+            allocator);
+
+        packet_writers[ns]->set_source(packet::source_t(100 + ns));
+    }
+
+    // sessions are read on different threads, and result is the same
+    // as if they were read sequentially
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        for (size_t ns = 0; ns < NumSessions; ns++) {
+            packet_writers[ns]->write_packets(1, SamplesPerPacket, SampleSpecs);
+        }
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, NumSessions);
+
+            UNSIGNED_LONGS_EQUAL(NumSessions, receiver.num_sessions());
+        }
+
+        for (size_t ns = 0; ns < NumSessions; ns++) {
+            packet_writers[ns]->write_packets(1, SamplesPerPacket, SampleSpecs);
+        }
+    }
+}
+
 TEST(receiver_source, seqnum_overflow) {
     ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
                             sample_buffer_factory, allocator);
@@ -1271,6 +1503,86 @@ TEST(receiver_source, corrupted_packets_existing_session) {
     }
 }
 
+TEST(receiver_source, endpoint_queue_overflow) {
+    enum { QueueSize = 4, NumPackets = QueueSize * 3 };
+
+    config.common.endpoint_queue_size = QueueSize;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    ReceiverEndpoint* endpoint =
+        slot->create_endpoint(address::Iface_AudioSource, proto1);
+    CHECK(endpoint);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer(allocator, endpoint->writer(), rtp_composer,
+                                     format_map, packet_factory, byte_buffer_factory,
+                                     PayloadType, src1, dst1);
+
+    // packets that don't fit into queue are dropped
+    packet_writer.write_packets(NumPackets, SamplesPerPacket, SampleSpecs);
+
+    UNSIGNED_LONGS_EQUAL(NumPackets - QueueSize, endpoint->num_dropped_packets());
+
+    frame_reader.skip_zeros(SamplesPerFrame * NumCh);
+
+    UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+
+    // queue was drained and accepts packets again
+    packet_writer.write_packets(QueueSize, SamplesPerPacket, SampleSpecs);
+
+    UNSIGNED_LONGS_EQUAL(NumPackets - QueueSize, endpoint->num_dropped_packets());
+}
+
+TEST(receiver_source, endpoint_queue_overflow_batch) {
+    enum { QueueSize = 4, NumPackets = QueueSize * 3 };
+
+    config.common.endpoint_queue_size = QueueSize;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    ReceiverEndpoint* endpoint =
+        slot->create_endpoint(address::Iface_AudioSource, proto1);
+    CHECK(endpoint);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    BatchWriter batch_writer(endpoint->writer());
+
+    test::PacketWriter packet_writer(allocator, batch_writer, rtp_composer, format_map,
+                                     packet_factory, byte_buffer_factory, PayloadType,
+                                     src1, dst1);
+
+    // packets of batch that don't fit into queue are dropped
+    packet_writer.write_packets(NumPackets, SamplesPerPacket, SampleSpecs);
+    batch_writer.flush();
+
+    UNSIGNED_LONGS_EQUAL(NumPackets - QueueSize, endpoint->num_dropped_packets());
+
+    frame_reader.skip_zeros(SamplesPerFrame * NumCh);
+
+    UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+
+    // queue was drained and accepts packets again
+    packet_writer.write_packets(QueueSize, SamplesPerPacket, SampleSpecs);
+    batch_writer.flush();
+
+    UNSIGNED_LONGS_EQUAL(NumPackets - QueueSize, endpoint->num_dropped_packets());
+}
+
 TEST(receiver_source, status) {
     ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
                             sample_buffer_factory, allocator);
@@ -43,7 +43,8 @@ enum {
     Latency = SamplesPerPacket * SourcePackets,
     Timeout = Latency * 20,
 
-    ManyFrames = Latency / SamplesPerFrame * 10
+    ManyFrames = Latency / SamplesPerFrame * 10,
+    OneBlockFrames = SourcePackets * FramesPerPacket
 };
 
 const audio::SampleSpec SampleSpecs = audio::SampleSpec(SampleRate, ChMask);
@@ -71,7 +72,13 @@ enum {
     FlagReedSolomon = (1 << 4),
 
     // enable LDPC-Staircase FEC scheme on sender
-    FlagLDPC = (1 << 5)
+    FlagLDPC = (1 << 5),
+
+    // enable sliding window RLC FEC scheme on sender
+    FlagRLC = (1 << 6),
+
+    // encode repair packets in separate thread on sender
+    FlagAsyncEncoding = (1 << 7)
 };
 
 core::HeapAllocator allocator;
@@ -95,8 +102,13 @@ SenderConfig sender_config(int flags) {
         config.fec_encoder.scheme = packet::FEC_LDPC_Staircase;
     }
 
+    if (flags & FlagRLC) {
+        config.fec_encoder.scheme = packet::FEC_RLC;
+    }
+
     config.fec_writer.n_source_packets = SourcePackets;
     config.fec_writer.n_repair_packets = RepairPackets;
+    config.fec_writer.async_encoding = (flags & FlagAsyncEncoding);
 
     config.interleaving = (flags & FlagInterleaving);
     config.timing = false;
@@ -130,6 +142,9 @@ address::Protocol select_source_proto(int flags) {
     if (flags & FlagLDPC) {
         return address::Proto_RTP_LDPC_Source;
     }
+    if (flags & FlagRLC) {
+        return address::Proto_RTP_RLC_Source;
+    }
     return address::Proto_RTP;
 }
 
@@ -140,6 +155,9 @@ address::Protocol select_repair_proto(int flags) {
     if (flags & FlagLDPC) {
         return address::Proto_LDPC_Repair;
     }
+    if (flags & FlagRLC) {
+        return address::Proto_RLC_Repair;
+    }
     return address::Proto_None;
 }
 
@@ -153,11 +171,28 @@ bool is_fec_supported(int flags) {
     return true;
 }
 
+// For block codes, losses are chosen by encoding symbol id instead of position
+// in stream, because with interleaving the position of a packet is random. If
+// the lost packet was the first or the last one of a single-block stream, delayed
+// reader would never collect enough samples to start playback.
+bool is_lost(int flags, const packet::Packet& packet, size_t counter) {
+    if (!(flags & FlagLosses)) {
+        return false;
+    }
+
+    if (packet.fec() && packet.fec()->source_block_length != 0) {
+        return (packet.flags() & packet::Packet::FlagAudio)
+            && packet.fec()->encoding_symbol_id == 1;
+    }
+
+    return counter % (SourcePackets + RepairPackets) == 1;
+}
+
 void filter_packets(int flags, packet::IReader& reader, packet::IWriter& writer) {
     size_t counter = 0;
 
     while (packet::PacketPtr pp = reader.read()) {
-        if ((flags & FlagLosses) && counter++ % (SourcePackets + RepairPackets) == 1) {
+        if (is_lost(flags, *pp, counter++)) {
             continue;
         }
 
@@ -175,9 +210,7 @@ void filter_packets(int flags, packet::IReader& reader, packet::IWriter& writer)
     }
 }
 
-void send_receive(int flags, size_t num_sessions) {
-    packet::Queue queue;
-
+void send_frames(int flags, packet::IWriter& writer, size_t num_frames) {
     address::Protocol source_proto = select_source_proto(flags);
     address::Protocol repair_proto = select_repair_proto(flags);
 
@@ -199,7 +232,7 @@ void send_receive(int flags, size_t num_sessions) {
         sender_slot->create_endpoint(address::Iface_AudioSource, source_proto);
     CHECK(sender_source_endpoint);
 
-    sender_source_endpoint->set_destination_writer(queue);
+    sender_source_endpoint->set_destination_writer(writer);
     sender_source_endpoint->set_destination_address(receiver_source_addr);
 
     if (repair_proto != address::Proto_None) {
@@ -207,10 +240,28 @@ void send_receive(int flags, size_t num_sessions) {
             sender_slot->create_endpoint(address::Iface_AudioRepair, repair_proto);
         CHECK(sender_repair_endpoint);
 
-        sender_repair_endpoint->set_destination_writer(queue);
+        sender_repair_endpoint->set_destination_writer(writer);
         sender_repair_endpoint->set_destination_address(receiver_repair_addr);
     }
 
+    test::FrameWriter frame_writer(sender, sample_buffer_factory);
+
+    for (size_t nf = 0; nf < num_frames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    // write packets that are still buffered in encoder and interleaver
+    sender.flush();
+}
+
+void send_receive(int flags, size_t num_sessions, size_t num_frames = ManyFrames) {
+    packet::Queue queue;
+
+    send_frames(flags, queue, num_frames);
+
+    address::Protocol source_proto = select_source_proto(flags);
+    address::Protocol repair_proto = select_repair_proto(flags);
+
     ReceiverSource receiver(receiver_config(), format_map, packet_factory,
                             byte_buffer_factory, sample_buffer_factory, allocator);
 
@@ -237,12 +288,6 @@ void send_receive(int flags, size_t num_sessions) {
         receiver_repair_endpoint_writer = &receiver_repair_endpoint->writer();
     }
 
-    test::FrameWriter frame_writer(sender, sample_buffer_factory);
-
-    for (size_t nf = 0; nf < ManyFrames; nf++) {
-        frame_writer.write_samples(SamplesPerFrame * NumCh);
-    }
-
     test::PacketSender packet_sender(packet_factory, receiver_source_endpoint_writer,
                                      receiver_repair_endpoint_writer);
 
@@ -252,7 +297,7 @@ void send_receive(int flags, size_t num_sessions) {
 
     packet_sender.deliver(Latency / SamplesPerPacket);
 
-    for (size_t np = 0; np < ManyFrames / FramesPerPacket; np++) {
+    for (size_t np = 0; np < num_frames / FramesPerPacket; np++) {
         for (size_t nf = 0; nf < FramesPerPacket; nf++) {
             frame_reader.read_samples(SamplesPerFrame * NumCh, num_sessions);
 
@@ -287,6 +332,10 @@ TEST(sender_sink_receiver_source, fec_ldpc) {
     }
 }
 
+TEST(sender_sink_receiver_source, fec_rlc) {
+    send_receive(FlagRLC, 1);
+}
+
 TEST(sender_sink_receiver_source, fec_interleaving) {
     if (is_fec_supported(FlagReedSolomon)) {
         send_receive(FlagReedSolomon | FlagInterleaving, 1);
@@ -311,5 +360,36 @@ TEST(sender_sink_receiver_source, fec_drop_repair) {
     }
 }
 
+TEST(sender_sink_receiver_source, fec_async) {
+    if (is_fec_supported(FlagReedSolomon)) {
+        send_receive(FlagReedSolomon | FlagAsyncEncoding, 1);
+    }
+}
+
+TEST(sender_sink_receiver_source, fec_async_loss_last_block) {
+    // Stream consists of a single block, so the packet is lost in the last
+    // block, which repair packets are written only when sender is flushed.
+    if (is_fec_supported(FlagReedSolomon)) {
+        send_receive(FlagReedSolomon | FlagAsyncEncoding | FlagLosses, 1,
+                     OneBlockFrames);
+    }
+}
+
+TEST(sender_sink_receiver_source, fec_async_interleaving_loss_last_block) {
+    if (is_fec_supported(FlagReedSolomon)) {
+        send_receive(FlagReedSolomon | FlagAsyncEncoding | FlagInterleaving
+                         | FlagLosses,
+                     1, OneBlockFrames);
+    }
+}
+
+TEST(sender_sink_receiver_source, fec_rlc_loss) {
+    send_receive(FlagRLC | FlagLosses, 1);
+}
+
+TEST(sender_sink_receiver_source, fec_rlc_drop_repair) {
+    send_receive(FlagRLC | FlagDropRepair, 1);
+}
+
 } // namespace pipeline
 } // namespace roc
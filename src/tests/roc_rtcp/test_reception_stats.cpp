@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_rtcp/reception_stats.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+enum { SampleRate = 1000, PacketSamples = 10 };
+
+const core::nanoseconds_t PacketDuration = PacketSamples * core::Millisecond;
+
+void add_packet(ReceptionStats& stats,
+                packet::seqnum_t sn,
+                core::nanoseconds_t jitter = 0) {
+    packet::RTP rtp;
+    rtp.seqnum = sn;
+    rtp.timestamp = packet::timestamp_t(sn) * PacketSamples;
+
+    stats.add_packet(rtp, core::Second + core::nanoseconds_t(sn) * PacketDuration
+                              + jitter);
+}
+
+} // namespace
+
+TEST_GROUP(reception_stats) {};
+
+TEST(reception_stats, no_packets) {
+    ReceptionStats stats(SampleRate);
+    CHECK(!stats.has_packets());
+
+    ReceptionMetrics metrics;
+    stats.build_metrics(metrics);
+
+    DOUBLES_EQUAL(0, metrics.fract_loss, 0);
+    LONGS_EQUAL(0, metrics.cum_loss);
+    UNSIGNED_LONGS_EQUAL(0, metrics.ext_last_seqnum);
+    UNSIGNED_LONGS_EQUAL(0, metrics.jitter);
+}
+
+TEST(reception_stats, no_losses) {
+    ReceptionStats stats(SampleRate);
+
+    for (packet::seqnum_t sn = 100; sn < 200; sn++) {
+        add_packet(stats, sn);
+    }
+
+    CHECK(stats.has_packets());
+
+    ReceptionMetrics metrics;
+    stats.build_metrics(metrics);
+
+    DOUBLES_EQUAL(0, metrics.fract_loss, 0);
+    LONGS_EQUAL(0, metrics.cum_loss);
+    UNSIGNED_LONGS_EQUAL(199, metrics.ext_last_seqnum);
+    UNSIGNED_LONGS_EQUAL(0, metrics.jitter);
+}
+
+TEST(reception_stats, losses) {
+    ReceptionStats stats(SampleRate);
+
+    // lose every 4th packet
+    for (packet::seqnum_t sn = 0; sn < 100; sn++) {
+        if (sn % 4 != 3) {
+            add_packet(stats, sn);
+        }
+    }
+    add_packet(stats, 100);
+
+    ReceptionMetrics metrics;
+    stats.build_metrics(metrics);
+
+    DOUBLES_EQUAL(0.25, metrics.fract_loss, 0.01);
+    LONGS_EQUAL(25, metrics.cum_loss);
+    UNSIGNED_LONGS_EQUAL(100, metrics.ext_last_seqnum);
+}
+
+TEST(reception_stats, interval) {
+    ReceptionStats stats(SampleRate);
+
+    ReceptionMetrics metrics;
+
+    // first interval: half of packets lost
+    for (packet::seqnum_t sn = 0; sn < 100; sn++) {
+        if (sn % 2 == 0) {
+            add_packet(stats, sn);
+        }
+    }
+    add_packet(stats, 100);
+
+    stats.build_metrics(metrics);
+    DOUBLES_EQUAL(0.5, metrics.fract_loss, 0.01);
+    LONGS_EQUAL(50, metrics.cum_loss);
+
+    // second interval: no losses
+    for (packet::seqnum_t sn = 101; sn < 200; sn++) {
+        add_packet(stats, sn);
+    }
+
+    stats.build_metrics(metrics);
+    DOUBLES_EQUAL(0, metrics.fract_loss, 0);
+    LONGS_EQUAL(50, metrics.cum_loss);
+    UNSIGNED_LONGS_EQUAL(199, metrics.ext_last_seqnum);
+
+    // no packets since previous report
+    stats.build_metrics(metrics);
+    DOUBLES_EQUAL(0, metrics.fract_loss, 0);
+    UNSIGNED_LONGS_EQUAL(199, metrics.ext_last_seqnum);
+}
+
+TEST(reception_stats, wrap) {
+    ReceptionStats stats(SampleRate);
+
+    for (packet::seqnum_t sn = 65500; sn != 100; sn++) {
+        if (sn != 10) {
+            add_packet(stats, sn);
+        }
+    }
+
+    ReceptionMetrics metrics;
+    stats.build_metrics(metrics);
+
+    LONGS_EQUAL(1, metrics.cum_loss);
+    UNSIGNED_LONGS_EQUAL(65536 + 99, metrics.ext_last_seqnum);
+}
+
+TEST(reception_stats, reordered_and_duplicate) {
+    ReceptionStats stats(SampleRate);
+
+    add_packet(stats, 0);
+    add_packet(stats, 2);
+    add_packet(stats, 1);
+    add_packet(stats, 3);
+    add_packet(stats, 3);
+
+    ReceptionMetrics metrics;
+    stats.build_metrics(metrics);
+
+    // duplicates make loss negative
+    LONGS_EQUAL(-1, metrics.cum_loss);
+    DOUBLES_EQUAL(0, metrics.fract_loss, 0);
+    UNSIGNED_LONGS_EQUAL(3, metrics.ext_last_seqnum);
+}
+
+TEST(reception_stats, resync) {
+    ReceptionStats stats(SampleRate);
+
+    for (packet::seqnum_t sn = 0; sn < 10; sn++) {
+        add_packet(stats, sn);
+    }
+
+    // single packet with a large jump is ignored
+    add_packet(stats, 30000);
+
+    ReceptionMetrics metrics;
+    stats.build_metrics(metrics);
+    UNSIGNED_LONGS_EQUAL(9, metrics.ext_last_seqnum);
+
+    // two sequential packets after a large jump cause resync
+    add_packet(stats, 40000);
+    add_packet(stats, 40001);
+    add_packet(stats, 40002);
+
+    stats.build_metrics(metrics);
+    UNSIGNED_LONGS_EQUAL(40002, metrics.ext_last_seqnum);
+    LONGS_EQUAL(0, metrics.cum_loss);
+}
+
+TEST(reception_stats, jitter) {
+    ReceptionStats stats(SampleRate);
+
+    // every second packet is delayed by 4ms, i.e. 4 timestamp units
+    for (packet::seqnum_t sn = 0; sn < 1000; sn++) {
+        add_packet(stats, sn, sn % 2 ? 4 * core::Millisecond : 0);
+    }
+
+    ReceptionMetrics metrics;
+    stats.build_metrics(metrics);
+
+    // jitter converges to mean deviation of transit time
+    CHECK(metrics.jitter >= 3 && metrics.jitter <= 4);
+}
+
+} // namespace rtcp
+} // namespace roc
@@ -393,6 +393,35 @@ TEST(rtcp, loopback_rr_sdes_xr) {
     CHECK_EQUAL(Traverser::Iterator::END, it.next());
 }
 
+TEST(rtcp, reception_block_losses) {
+    header::ReceptionReportBlock blk;
+
+    blk.set_last_seqnum(0xFFFFFFFF);
+
+    blk.set_fract_loss(1, 4);
+    blk.set_cumloss(-5);
+
+    DOUBLES_EQUAL(0.25, blk.fract_loss(), 0.0001);
+    LONGS_EQUAL(-5, blk.cumloss());
+
+    blk.set_cumloss(0x123456);
+    DOUBLES_EQUAL(0.25, blk.fract_loss(), 0.0001);
+    LONGS_EQUAL(0x123456, blk.cumloss());
+
+    blk.set_fract_loss(255, 256);
+    DOUBLES_EQUAL(255. / 256., blk.fract_loss(), 0.0001);
+    LONGS_EQUAL(0x123456, blk.cumloss());
+
+    // cumulative loss is clamped to 24-bit signed range
+    blk.set_cumloss(100000000);
+    LONGS_EQUAL(0x7FFFFF, blk.cumloss());
+    blk.set_cumloss(-100000000);
+    LONGS_EQUAL(-0x7FFFFF, blk.cumloss());
+
+    DOUBLES_EQUAL(255. / 256., blk.fract_loss(), 0.0001);
+    UNSIGNED_LONGS_EQUAL(0xFFFFFFFF, blk.last_seqnum());
+}
+
 // Check bye.
 TEST(rtcp, loopback_bye) {
     core::Slice<uint8_t> buff = new_buffer(NULL, 0).subslice(0, 0);
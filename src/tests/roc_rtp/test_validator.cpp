@@ -299,5 +299,35 @@ TEST(validator, timestamp_late) {
     CHECK(!queue.read());
 }
 
+TEST(validator, read_batch) {
+    enum { NumPackets = 5 };
+
+    packet::Queue queue;
+    Validator validator(queue, config, SampleSpecs);
+
+    packet::PacketPtr packets[NumPackets] = {
+        new_packet(Pt1, Src1, 1, 1), new_packet(Pt2, Src1, 2, 2),
+        new_packet(Pt1, Src1, 3, 3), new_packet(Pt1, Src2, 4, 4),
+        new_packet(Pt1, Src1, 5, 5),
+    };
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        queue.write(packets[n]);
+    }
+
+    packet::PacketPtr batch[NumPackets];
+
+    // packets with payload type and source jumps are dropped
+    UNSIGNED_LONGS_EQUAL(3, validator.read_batch(batch, NumPackets));
+
+    CHECK(batch[0] == packets[0]);
+    CHECK(batch[1] == packets[2]);
+    CHECK(batch[2] == packets[4]);
+    CHECK(!batch[3]);
+    CHECK(!batch[4]);
+
+    CHECK(!queue.read());
+}
+
 } // namespace rtp
 } // namespace roc
@@ -150,6 +150,9 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speex:
         converter_config.resampler_backend = audio::ResamplerBackend_Speex;
         break;
+    case resampler_backend_arg_polyphase:
+        converter_config.resampler_backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
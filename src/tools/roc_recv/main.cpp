@@ -63,6 +63,11 @@ int main(int argc, char** argv) {
         break;
     }
 
+    // don't block realtime threads on slow log output
+    if (!core::Logger::instance().set_async(true)) {
+        return 1;
+    }
+
     peer::ContextConfig context_config;
 
     context_config.poisoning = args.poisoning_flag;
@@ -195,6 +200,10 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speex:
         receiver_config.default_session.resampler_backend = audio::ResamplerBackend_Speex;
         break;
+    case resampler_backend_arg_polyphase:
+        receiver_config.default_session.resampler_backend =
+            audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -221,6 +230,22 @@ int main(int argc, char** argv) {
     receiver_config.common.profiling = args.profiling_flag;
     receiver_config.common.beeping = args.beeping_flag;
 
+    if (args.sess_pool_given) {
+        if (args.sess_pool_arg < 0) {
+            roc_log(LogError, "invalid --sess-pool: should be >= 0");
+            return 1;
+        }
+        receiver_config.common.session_pool_size = (size_t)args.sess_pool_arg;
+    }
+
+    if (args.sess_threads_given) {
+        if (args.sess_threads_arg < 0) {
+            roc_log(LogError, "invalid --sess-threads: should be >= 0");
+            return 1;
+        }
+        receiver_config.common.session_threads = (size_t)args.sess_threads_arg;
+    }
+
     sndio::Config io_config;
     io_config.frame_length = receiver_config.common.internal_frame_length;
     io_config.sample_spec.set_channel_mask(
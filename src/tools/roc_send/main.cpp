@@ -63,6 +63,11 @@ int main(int argc, char** argv) {
         break;
     }
 
+    // don't block realtime threads on slow log output
+    if (!core::Logger::instance().set_async(true)) {
+        return 1;
+    }
+
     peer::ContextConfig context_config;
 
     context_config.poisoning = args.poisoning_flag;
@@ -164,6 +169,14 @@ int main(int argc, char** argv) {
         sender_config.fec_writer.n_repair_packets = (size_t)args.nbrpr_arg;
     }
 
+    if (args.fec_async_flag) {
+        if (sender_config.fec_encoder.scheme == packet::FEC_None) {
+            roc_log(LogError, "--fec-async can't be used when fec is disabled");
+            return 1;
+        }
+        sender_config.fec_writer.async_encoding = true;
+    }
+
     sender_config.resampling = !args.no_resampling_flag;
 
     switch (args.resampler_backend_arg) {
@@ -176,6 +189,9 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speex:
         sender_config.resampler_backend = audio::ResamplerBackend_Speex;
         break;
+    case resampler_backend_arg_polyphase:
+        sender_config.resampler_backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }